@@ -126,7 +126,9 @@ class TreeResolver(
         }
 
         else -> {
-            addResourceIdentifierToResolve(navigateTo)
+            if (exportable) {
+                addResourceIdentifierToResolve(navigateTo)
+            }
             null
         }
     }
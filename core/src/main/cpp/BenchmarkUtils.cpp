@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "BenchmarkUtils"
+
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include <mutex>
+#include "BenchmarkUtils.h"
+#include "Benchmarks.h"
+
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+/**
+ * Benchmarks load the whole CPU or GPU, running two at once would make both results
+ * meaningless. Every module's library has its own copy of this, so it only serializes the
+ * benchmarks of a module, BenchmarkLock.kt serializes them across modules.
+ */
+static std::mutex sBenchmarkMutex;
+
+static bool (*sPrepare)() = nullptr;
+
+/**
+ * Run a benchmark on the calling thread, blocking until it's done.
+ *
+ * @return The report in CSV format, see BenchmarkReport.h, null if the benchmark doesn't exist
+ */
+static jstring runBenchmark(JNIEnv *env, jobject thiz, jstring name) {
+    auto nameChars = env->GetStringUTFChars(name, nullptr);
+    if (nameChars == nullptr) {
+        return nullptr;
+    }
+
+    auto benchmark = findBenchmark(nameChars);
+    if (benchmark == nullptr) {
+        LOGE("Unknown benchmark %s", nameChars);
+    }
+
+    env->ReleaseStringUTFChars(name, nameChars);
+
+    if (benchmark == nullptr) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(sBenchmarkMutex);
+
+    if (sPrepare != nullptr && !sPrepare()) {
+        LOGE("Failed to prepare benchmark %s", benchmark->name);
+        return nullptr;
+    }
+
+    LOGI("Running benchmark %s", benchmark->name);
+
+    auto report = benchmark->run();
+
+    return env->NewStringUTF(report.serialize(BenchmarkReport::Format::CSV).c_str());
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"runBenchmark", "(Ljava/lang/String;)Ljava/lang/String;",
+                reinterpret_cast<void *>(runBenchmark)},
+};
+
+jint registerBenchmarkUtilsNatives(JNIEnv *env, const char *className, bool (*prepare)()) {
+    sPrepare = prepare;
+
+    auto clazz = env->FindClass(className);
+    if (clazz == nullptr) {
+        return JNI_ERR;
+    }
+
+    auto result = env->RegisterNatives(clazz, kMethods, std::size(kMethods));
+    env->DeleteLocalRef(clazz);
+
+    return result;
+}
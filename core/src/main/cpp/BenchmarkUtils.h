@@ -0,0 +1,18 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <jni.h>
+
+/**
+ * Bind the native methods of a module's BenchmarkUtils, which run the benchmarks of the
+ * module's Benchmarks.cpp.
+ *
+ * @param className The BenchmarkUtils class of the module
+ * @param prepare Called before running a benchmark, if it returns false the benchmark isn't run
+ */
+jint registerBenchmarkUtilsNatives(JNIEnv *env, const char *className,
+                                   bool (*prepare)() = nullptr);
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <unordered_map>
+#include "BenchmarkReport.h"
+
+template<typename T>
+static void append(std::string &output, T value) {
+    output.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static std::string serializeBinary(const BenchmarkReport &report) {
+    std::vector<const std::string *> strings;
+    std::unordered_map<std::string, uint32_t> stringToIndex;
+
+    auto getIndex = [&](const std::string &string) {
+        auto [it, inserted] = stringToIndex.emplace(string, strings.size());
+        if (inserted) {
+            strings.push_back(&it->first);
+        }
+        return it->second;
+    };
+
+    std::string sections;
+    append<uint32_t>(sections, report.sections.size());
+    for (auto &section: report.sections) {
+        append<uint32_t>(sections, getIndex(section.name));
+        append<uint32_t>(sections, section.entries.size());
+
+        for (auto &entry: section.entries) {
+            append<uint32_t>(sections, getIndex(entry.name));
+            append<uint8_t>(sections, static_cast<uint8_t>(entry.unit));
+            append<double>(sections, entry.value);
+        }
+    }
+
+    std::string output;
+    append<uint32_t>(output, BenchmarkReport::kBinaryMagic);
+    append<uint32_t>(output, BenchmarkReport::kBinaryVersion);
+    append<uint32_t>(output, strings.size());
+    for (auto string: strings) {
+        auto length = static_cast<uint16_t>(std::min<size_t>(string->size(), UINT16_MAX));
+        append<uint16_t>(output, length);
+        output.append(*string, 0, length);
+    }
+    output += sections;
+
+    return output;
+}
+
+const char *BenchmarkReport::getUnitName(Unit unit) {
+    switch (unit) {
+        case Unit::NONE:
+            return "";
+        case Unit::OPS_PER_SECOND:
+            return "op/s";
+        case Unit::FLOPS:
+            return "FLOP/s";
+        case Unit::NANOSECONDS:
+            return "ns";
+        case Unit::BYTES:
+            return "B";
+        case Unit::BYTES_PER_SECOND:
+            return "B/s";
+        case Unit::HERTZ:
+            return "Hz";
+        case Unit::RATIO:
+            return "ratio";
+        case Unit::UARCH:
+            return "uarch";
+        case Unit::BOOLEAN:
+            return "bool";
+    }
+
+    return "";
+}
+
+std::string BenchmarkReport::serialize(Format format) const {
+    if (format == Format::BINARY) {
+        return serializeBinary(*this);
+    }
+
+    std::string output;
+    char line[256];
+
+    if (format == Format::CSV) {
+        output += "section,entry,unit,value\n";
+    }
+
+    for (auto &section: sections) {
+        if (format == Format::TEXT) {
+            output += section.name;
+            output += '\n';
+        }
+
+        for (auto &entry: section.entries) {
+            switch (format) {
+                case Format::TEXT:
+                    if (entry.unit == Unit::UARCH) {
+                        snprintf(line, sizeof(line), "  %-32s 0x%08x\n", entry.name.c_str(),
+                                 static_cast<uint32_t>(entry.value));
+                    } else {
+                        snprintf(line, sizeof(line), "  %-32s %.6g %s\n", entry.name.c_str(),
+                                 entry.value, getUnitName(entry.unit));
+                    }
+                    break;
+                case Format::CSV:
+                    snprintf(line, sizeof(line), "%s,%s,%s,%.9g\n", section.name.c_str(),
+                             entry.name.c_str(), getUnitName(entry.unit), entry.value);
+                    break;
+                case Format::BINARY:
+                    break;
+            }
+
+            output += line;
+        }
+    }
+
+    return output;
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Result of a benchmark: named sections of named values, each with a unit.
+ * Names must not contain commas or newlines, they're written as is in the CSV output.
+ *
+ * Shared by the modules with native benchmarks, must be kept in sync with BenchmarkReport.kt.
+ */
+class BenchmarkReport {
+public:
+    enum class Unit : uint32_t {
+        NONE = 0,
+        OPS_PER_SECOND,
+        FLOPS,
+        NANOSECONDS,
+        BYTES,
+        BYTES_PER_SECOND,
+        HERTZ,
+        /**
+         * Usually from 0 to 1, but may go past 1, e.g. an effective to requested frequency ratio.
+         */
+        RATIO,
+        /**
+         * A cpuinfo_uarch value, only reported by CPU benchmarks.
+         */
+        UARCH,
+        BOOLEAN,
+    };
+
+    struct Entry {
+        std::string name;
+        Unit unit;
+        double value;
+    };
+
+    struct Section {
+        std::string name;
+        std::vector<Entry> entries;
+
+        Section &add(std::string entryName, Unit unit, double value) {
+            entries.push_back({std::move(entryName), unit, value});
+            return *this;
+        }
+    };
+
+    enum class Format {
+        TEXT,
+        CSV,
+        /**
+         * Native endian, see serialize().
+         */
+        BINARY,
+    };
+
+    static constexpr uint32_t kBinaryMagic = 0x50524241; // "ABRP"
+    static constexpr uint32_t kBinaryVersion = 1;
+
+    std::vector<Section> sections;
+
+    Section &addSection(std::string name) {
+        return sections.emplace_back(Section{std::move(name), {}});
+    }
+
+    /**
+     * Format the report. CSV has a header and then one "section,entry,unit,value" row per entry.
+     * BINARY deduplicates names, which makes it compact for matrices:
+     * - uint32 magic, uint32 version
+     * - uint32 string count, then for each string a uint16 length and the bytes
+     * - uint32 section count, then for each section a uint32 name index, a uint32 entry count
+     *   and for each entry a uint32 name index, a uint8 unit and a float64 value
+     */
+    std::string serialize(Format format) const;
+
+    void print(FILE *file, Format format) const {
+        auto data = serialize(format);
+        fwrite(data.data(), 1, data.size(), file);
+    }
+
+    static const char *getUnitName(Unit unit);
+};
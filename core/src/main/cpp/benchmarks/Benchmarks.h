@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "BenchmarkReport.h"
+
+/**
+ * A benchmark that can be run both from the app and from the command line.
+ */
+struct BenchmarkDefinition {
+    const char *name;
+    const char *description;
+    BenchmarkReport (*run)();
+};
+
+/**
+ * Get all the available benchmarks, each module defines its own in its Benchmarks.cpp.
+ */
+const BenchmarkDefinition *getBenchmarks(size_t *count);
+
+/**
+ * @return The benchmark with the given name, nullptr if not found
+ */
+const BenchmarkDefinition *findBenchmark(const char *name);
@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include "BenchmarkReport.h"
+
+/**
+ * The CSV output is parsed by BenchmarkReport.kt and the binary one by external tools, both
+ * must keep their layout.
+ */
+class BenchmarkReportTest : public testing::Test {
+protected:
+    void SetUp() override {
+        mReport.addSection("memory")
+                .add("latency", BenchmarkReport::Unit::NANOSECONDS, 1.5)
+                .add("bandwidth", BenchmarkReport::Unit::BYTES_PER_SECOND, 12.5e9);
+        mReport.addSection("core")
+                .add("uarch", BenchmarkReport::Unit::UARCH, 0x00300100)
+                .add("latency", BenchmarkReport::Unit::NANOSECONDS, 42);
+    }
+
+    template<typename T>
+    static T read(const std::string &data, size_t &offset) {
+        T value;
+        memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    BenchmarkReport mReport;
+};
+
+TEST_F(BenchmarkReportTest, Csv) {
+    EXPECT_EQ(mReport.serialize(BenchmarkReport::Format::CSV),
+              "section,entry,unit,value\n"
+              "memory,latency,ns,1.5\n"
+              "memory,bandwidth,B/s,1.25e+10\n"
+              "core,uarch,uarch,3145984\n"
+              "core,latency,ns,42\n");
+}
+
+TEST_F(BenchmarkReportTest, Text) {
+    EXPECT_EQ(mReport.serialize(BenchmarkReport::Format::TEXT),
+              "memory\n"
+              "  latency                          1.5 ns\n"
+              "  bandwidth                        1.25e+10 B/s\n"
+              "core\n"
+              "  uarch                            0x00300100\n"
+              "  latency                          42 ns\n");
+}
+
+TEST_F(BenchmarkReportTest, Binary) {
+    auto data = mReport.serialize(BenchmarkReport::Format::BINARY);
+
+    size_t offset = 0;
+    EXPECT_EQ(read<uint32_t>(data, offset), BenchmarkReport::kBinaryMagic);
+    EXPECT_EQ(read<uint32_t>(data, offset), BenchmarkReport::kBinaryVersion);
+
+    // "latency" is shared by both sections
+    std::vector<std::string> strings(read<uint32_t>(data, offset));
+    ASSERT_EQ(strings.size(), 5u);
+    for (auto &string: strings) {
+        auto length = read<uint16_t>(data, offset);
+        string = data.substr(offset, length);
+        offset += length;
+    }
+    EXPECT_EQ(strings, (std::vector<std::string>{"memory", "latency", "bandwidth", "core",
+                                                 "uarch"}));
+
+    ASSERT_EQ(read<uint32_t>(data, offset), mReport.sections.size());
+    for (auto &section: mReport.sections) {
+        EXPECT_EQ(strings[read<uint32_t>(data, offset)], section.name);
+        ASSERT_EQ(read<uint32_t>(data, offset), section.entries.size());
+
+        for (auto &entry: section.entries) {
+            EXPECT_EQ(strings[read<uint32_t>(data, offset)], entry.name);
+            EXPECT_EQ(read<uint8_t>(data, offset), static_cast<uint8_t>(entry.unit));
+            EXPECT_EQ(read<double>(data, offset), entry.value);
+        }
+    }
+
+    EXPECT_EQ(offset, data.size());
+}
+
+TEST_F(BenchmarkReportTest, UnitNames) {
+    // Parsed back by BenchmarkReport.ValueUnit.fromNative()
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::NONE), "");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::OPS_PER_SECOND), "op/s");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::FLOPS), "FLOP/s");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::NANOSECONDS), "ns");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::BYTES), "B");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::BYTES_PER_SECOND), "B/s");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::HERTZ), "Hz");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::RATIO), "ratio");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::UARCH), "uarch");
+    EXPECT_STREQ(BenchmarkReport::getUnitName(BenchmarkReport::Unit::BOOLEAN), "bool");
+}
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.core.models
+
+import androidx.annotation.StringRes
+import dev.sebaubuntu.athena.core.R
+
+/**
+ * Result of a native benchmark: named sections of named values.
+ *
+ * Shared by the modules with native benchmarks, must be kept in sync with BenchmarkReport.h.
+ */
+data class BenchmarkReport(
+    val sections: List<Section>,
+) {
+    data class Section(
+        val name: String,
+        val entries: List<Entry>,
+    ) {
+        fun getEntry(name: String) = entries.firstOrNull { it.name == name }
+
+        /**
+         * @param toValue Convert an entry, for the units the caller knows better, like
+         *   [ValueUnit.UARCH]
+         */
+        fun getCardElement(toValue: (Entry) -> Value<*> = { it.toValue() }) = Element.Card(
+            name = name,
+            title = LocalizedString(name),
+            elements = entries.map {
+                Element.Item(
+                    name = it.name,
+                    title = LocalizedString(it.name),
+                    value = toValue(it),
+                )
+            },
+        )
+    }
+
+    data class Entry(
+        val name: String,
+        val unit: ValueUnit,
+        val value: Double,
+    ) {
+        fun toValue(): Value<*> = when (unit) {
+            ValueUnit.NONE -> when (value % 1.0 == 0.0) {
+                true -> Value(value.toLong())
+                false -> Value(value)
+            }
+
+            ValueUnit.OPS_PER_SECOND -> siValue(R.string.benchmark_ops_per_second)
+            ValueUnit.FLOPS -> siValue(R.string.benchmark_flops)
+            ValueUnit.NANOSECONDS -> Value("$value", R.string.benchmark_nanoseconds, value)
+            ValueUnit.BYTES -> Value.Bytes(value.toLong())
+            ValueUnit.BYTES_PER_SECOND -> siValue(R.string.benchmark_bytes_per_second)
+            ValueUnit.HERTZ -> Value.FrequencyValue(value.toLong())
+            ValueUnit.RATIO -> (value * 100).let {
+                Value("$it", R.string.benchmark_percentage, it)
+            }
+
+            ValueUnit.UARCH -> Value(value.toLong())
+            ValueUnit.BOOLEAN -> Value(value != 0.0)
+        }
+
+        /**
+         * Format a rate with an SI prefix, the string must take the scaled value and the prefix.
+         */
+        private fun siValue(@StringRes stringResId: Int): Value<*> {
+            val (divider, prefix) = SI_PREFIXES.firstOrNull { (divider, _) ->
+                value >= divider
+            } ?: SI_PREFIXES.last()
+
+            return Value("$value", stringResId, value / divider, prefix)
+        }
+    }
+
+    enum class ValueUnit(
+        val nativeName: String,
+    ) {
+        NONE(""),
+        OPS_PER_SECOND("op/s"),
+        FLOPS("FLOP/s"),
+        NANOSECONDS("ns"),
+        BYTES("B"),
+        BYTES_PER_SECOND("B/s"),
+        HERTZ("Hz"),
+
+        /**
+         * A ratio, shown as a percentage. Usually from 0 to 1, but may go past 1, e.g. an
+         * effective to requested frequency ratio.
+         */
+        RATIO("ratio"),
+
+        /**
+         * A cpuinfo_uarch value, only reported by CPU benchmarks.
+         */
+        UARCH("uarch"),
+        BOOLEAN("bool");
+
+        companion object {
+            fun fromNative(nativeName: String) = entries.firstOrNull {
+                it.nativeName == nativeName
+            } ?: NONE
+        }
+    }
+
+    companion object {
+        private val SI_PREFIXES = listOf(
+            1e12 to "T",
+            1e9 to "G",
+            1e6 to "M",
+            1e3 to "k",
+            1.0 to "",
+        )
+
+        /**
+         * Parse the output of BenchmarkReport::serialize(Format::CSV), a header and then one
+         * "section,entry,unit,value" row per entry, with the rows of a section next to each other.
+         */
+        fun fromCsv(csv: String) = BenchmarkReport(
+            csv.lineSequence().drop(1).filter { it.isNotEmpty() }.mapNotNull { line ->
+                line.split(',').takeIf { it.size == 4 }
+            }.fold(mutableListOf<Pair<String, MutableList<Entry>>>()) { sections, row ->
+                val (section, name, unit, value) = row
+
+                val entries = sections.lastOrNull()?.takeIf { it.first == section }?.second
+                    ?: mutableListOf<Entry>().also { sections.add(section to it) }
+
+                value.toDoubleOrNull()?.let {
+                    entries.add(Entry(name, ValueUnit.fromNative(unit), it))
+                }
+
+                sections
+            }.map { (name, entries) -> Section(name, entries) }
+        )
+    }
+}
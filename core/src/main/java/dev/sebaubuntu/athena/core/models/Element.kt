@@ -21,6 +21,7 @@ sealed interface Element {
         override val name: String,
         override val title: LocalizedString,
         override val navigateTo: Resource.Identifier? = null,
+        override val exportable: Boolean = true,
         @DrawableRes val drawableResId: Int? = null,
         val value: Value<*>? = null,
     ) : Element
@@ -32,6 +33,7 @@ sealed interface Element {
         override val name: String,
         override val title: LocalizedString,
         override val navigateTo: Resource.Identifier? = null,
+        override val exportable: Boolean = true,
         val elements: List<Item>,
     ) : Element
 
@@ -49,4 +51,10 @@ sealed interface Element {
      * Whether clicking on this element should navigate to the specified [Resource.Identifier].
      */
     val navigateTo: Resource.Identifier?
+
+    /**
+     * Whether [navigateTo] should be followed when exporting data. Set it to false when resolving
+     * the target has side effects, like running a benchmark.
+     */
+    val exportable: Boolean
 }
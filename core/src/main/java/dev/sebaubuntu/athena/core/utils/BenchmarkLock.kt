@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.core.utils
+
+/**
+ * Serializes the benchmarks of every module. Each native library only knows about its own
+ * benchmarks, yet a GPU benchmark running next to a CPU one would skew both.
+ */
+object BenchmarkLock {
+    fun <T> withLock(block: () -> T) = synchronized(this, block)
+}
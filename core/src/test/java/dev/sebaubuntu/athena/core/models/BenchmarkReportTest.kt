@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.core.models
+
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertTrue
+import org.junit.Test
+
+/**
+ * Parses CSV reports laid out like BenchmarkReport.cpp writes them.
+ */
+class BenchmarkReportTest {
+    @Test
+    fun parsesSectionsInOrder() {
+        val report = BenchmarkReport.fromCsv(CSV)
+
+        assertEquals(listOf("memory", "core"), report.sections.map { it.name })
+        assertEquals(
+            listOf("latency", "bandwidth"),
+            report.sections[0].entries.map { it.name },
+        )
+    }
+
+    @Test
+    fun parsesUnitsAndValues() {
+        val memory = BenchmarkReport.fromCsv(CSV).sections[0]
+
+        assertEquals(
+            BenchmarkReport.Entry("latency", BenchmarkReport.ValueUnit.NANOSECONDS, 1.5),
+            memory.getEntry("latency"),
+        )
+        assertEquals(
+            BenchmarkReport.Entry("bandwidth", BenchmarkReport.ValueUnit.BYTES_PER_SECOND, 1.25e10),
+            memory.getEntry("bandwidth"),
+        )
+    }
+
+    @Test
+    fun fallsBackToNoUnit() {
+        val core = BenchmarkReport.fromCsv(CSV).sections[1]
+
+        assertEquals(BenchmarkReport.ValueUnit.NONE, core.getEntry("future")?.unit)
+    }
+
+    @Test
+    fun skipsMalformedRows() {
+        val core = BenchmarkReport.fromCsv(CSV).sections[1]
+
+        assertEquals(listOf("uarch", "future"), core.entries.map { it.name })
+    }
+
+    @Test
+    fun parsesEmptyReport() {
+        assertTrue(BenchmarkReport.fromCsv("section,entry,unit,value\n").sections.isEmpty())
+    }
+
+    companion object {
+        private const val CSV = """section,entry,unit,value
+memory,latency,ns,1.5
+memory,bandwidth,B/s,1.25e+10
+core,uarch,uarch,3145984
+core,future,parsecs,12
+core,bad,ns,not a number
+core,truncated,ns
+"""
+    }
+}
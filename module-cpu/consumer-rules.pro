@@ -7,3 +7,7 @@
 -keep public class dev.sebaubuntu.athena.modules.cpu.models.* {
     public *;
 }
+
+-keep class dev.sebaubuntu.athena.modules.cpu.utils.CpuHotplugUtils {
+    private static void onOnlineCpusChanged(java.lang.String);
+}
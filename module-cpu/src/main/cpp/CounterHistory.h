@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Ring of timestamped snapshots of monotonic counters, used to compute deltas over an arbitrary
+ * window without having to wait for it.
+ *
+ * A snapshot is kept only if the previous kept one is older than the interval, so that many
+ * callers reading fast don't shorten the history, which spans about count * interval.
+ */
+class CounterHistory {
+public:
+    /**
+     * Marks a counter that couldn't be read, deltas involving it are unknown too.
+     */
+    static constexpr int64_t kUnknown = -1;
+
+    CounterHistory(size_t snapshotCount, std::chrono::nanoseconds interval)
+            : mSnapshotCount(snapshotCount), mIntervalNs(interval.count()),
+              mTimestamps(snapshotCount) {}
+
+    /**
+     * Set the number of counters of a snapshot, dropping the history.
+     */
+    void resize(size_t counterCount) {
+        mCounterCount = counterCount;
+        mCounters.assign(mSnapshotCount * mCounterCount, 0);
+        mHead = 0;
+        mSize = 0;
+    }
+
+    /**
+     * Get the newest snapshot at least windowNs older than nowNs, or the oldest one available.
+     *
+     * @param baselineNs Output, the timestamp of the returned snapshot, nowNs if none
+     * @return The snapshot counters, nullptr if there's no snapshot yet
+     */
+    const int64_t *getBaseline(int64_t nowNs, int64_t windowNs, int64_t &baselineNs) const {
+        const int64_t *baseline = nullptr;
+        baselineNs = nowNs;
+
+        for (size_t i = 0; i < mSize; i++) {
+            auto index = (mHead + mSnapshotCount - 1 - i) % mSnapshotCount;
+
+            baseline = &mCounters[index * mCounterCount];
+            baselineNs = mTimestamps[index];
+
+            if (nowNs - baselineNs >= windowNs) {
+                break;
+            }
+        }
+
+        return baseline;
+    }
+
+    /**
+     * Store a snapshot, if the previous kept one is old enough.
+     */
+    void push(int64_t nowNs, const int64_t *counters) {
+        if (mSize > 0 && nowNs - mTimestamps[(mHead + mSnapshotCount - 1) % mSnapshotCount]
+                         < mIntervalNs) {
+            return;
+        }
+
+        memcpy(&mCounters[mHead * mCounterCount], counters, mCounterCount * sizeof(int64_t));
+        mTimestamps[mHead] = nowNs;
+
+        mHead = (mHead + 1) % mSnapshotCount;
+        mSize = std::min(mSize + 1, mSnapshotCount);
+    }
+
+    /**
+     * Delta of a counter against a baseline returned by getBaseline().
+     * Counters going backwards (e.g. reset by hotplug) are clamped to 0.
+     *
+     * @return The delta, 0 if there's no baseline, kUnknown if either value is unknown
+     */
+    static int64_t delta(const int64_t *counters, const int64_t *baseline, size_t index) {
+        if (counters[index] == kUnknown) {
+            return kUnknown;
+        }
+        if (baseline == nullptr) {
+            return 0;
+        }
+        if (baseline[index] == kUnknown) {
+            return kUnknown;
+        }
+
+        return std::max<int64_t>(counters[index] - baseline[index], 0);
+    }
+
+private:
+    const size_t mSnapshotCount;
+    const int64_t mIntervalNs;
+    size_t mCounterCount = 0;
+
+    std::vector<int64_t> mTimestamps;
+    std::vector<int64_t> mCounters;
+    size_t mHead = 0;
+    size_t mSize = 0;
+};
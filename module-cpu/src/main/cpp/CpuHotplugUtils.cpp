@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "CpuHotplugUtils"
+
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include "CpuHotplugUtils.h"
+#include "CpuInfoUtils.h"
+#include "HotplugMonitor.h"
+#include "jni_utils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+#define CPU_HOTPLUG_UTILS_CLASS CPU_UTILS_PACKAGE "/CpuHotplugUtils"
+
+static JavaVM *sJavaVM = nullptr;
+
+static struct {
+    jclass clazz;
+    jmethodID onOnlineCpusChanged;
+} gCpuHotplugUtilsClassInfo;
+
+/**
+ * Runs on the monitoring thread, which only lives while someone listens. Hotplug events are rare,
+ * so it's attached for the call and detached right after, rather than on thread exit.
+ */
+static void onOnlineCpusChanged(const std::string &onlineCpus) {
+    JNIEnv *env = nullptr;
+    if (sJavaVM->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        LOGE("Failed to attach the hotplug thread");
+        return;
+    }
+
+    auto string = env->NewStringUTF(onlineCpus.c_str());
+    if (string != nullptr) {
+        env->CallStaticVoidMethod(gCpuHotplugUtilsClassInfo.clazz,
+                                  gCpuHotplugUtilsClassInfo.onOnlineCpusChanged, string);
+        env->DeleteLocalRef(string);
+    }
+
+    if (env->ExceptionCheck()) {
+        // Don't take the process down from a background thread
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+    }
+
+    sJavaVM->DetachCurrentThread();
+}
+
+static void startMonitoring(JNIEnv *env, jobject thiz) {
+    HotplugMonitor::getInstance().start();
+}
+
+static void stopMonitoring(JNIEnv *env, jobject thiz) {
+    HotplugMonitor::getInstance().stop();
+}
+
+static jstring getOnlineCpus(JNIEnv *env, jobject thiz) {
+    return env->NewStringUTF(HotplugMonitor::getInstance().getOnlineCpus().c_str());
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"startMonitoring", "()V", reinterpret_cast<void *>(startMonitoring)},
+        {"stopMonitoring", "()V", reinterpret_cast<void *>(stopMonitoring)},
+        {"getOnlineCpus", "()" STRING_CLASS_SIG, reinterpret_cast<void *>(getOnlineCpus)},
+};
+
+jint registerCpuHotplugUtilsNatives(JNIEnv *env) {
+    auto result = registerNatives(env, CPU_HOTPLUG_UTILS_CLASS, kMethods, std::size(kMethods));
+    if (result != JNI_OK) {
+        return result;
+    }
+
+    if (env->GetJavaVM(&sJavaVM) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    auto clazz = env->FindClass(CPU_HOTPLUG_UTILS_CLASS);
+    JNI_CHECK(env);
+
+    gCpuHotplugUtilsClassInfo.clazz = static_cast<jclass>(env->NewGlobalRef(clazz));
+    env->DeleteLocalRef(clazz);
+
+    gCpuHotplugUtilsClassInfo.onOnlineCpusChanged = env->GetStaticMethodID(
+            gCpuHotplugUtilsClassInfo.clazz, "onOnlineCpusChanged", "(" STRING_CLASS_SIG ")V");
+    JNI_CHECK(env);
+
+    HotplugMonitor::getInstance().setCallback(onOnlineCpusChanged);
+
+    return JNI_OK;
+}
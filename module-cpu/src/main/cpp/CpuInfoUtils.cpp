@@ -6,46 +6,172 @@
 #define LOG_TAG "CpuUtils"
 
 #include <android/log.h>
+#include <cstring>
 #include <cpuinfo.h>
+#include <iterator>
 #include <jni.h>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "CpuInfoUtils.h"
 #include "CpuJni.h"
+#include "HotplugMonitor.h"
+#include "IsaFeatures.h"
+#include "TlbBenchmark.h"
+#include "TopologyBuffer.h"
 #include "jni_utils.h"
 
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
 
-#define CPUINFO_JNI_FUNC(func_name, clazz_lowercase, cpuinfo_func_name)                         \
-    extern "C"                                                                                  \
-    JNIEXPORT void JNICALL                                                                      \
-    Java_dev_sebaubuntu_athena_modules_cpu_utils_CpuInfoUtils_get##func_name(JNIEnv *env,       \
-                                                                 jobject thiz,                  \
-                                                                 jobject arraylist) {           \
-        auto cpuJni = CpuJni(env);                                                              \
-        auto addMethodID = getArrayListAddMethodID(env, arraylist);                             \
-                                                                                                \
-        cpuinfo_initialize();                                                                   \
-                                                                                                \
-        auto elements_count = cpuinfo_get_##cpuinfo_func_name##_count();                        \
-                                                                                                \
-        auto elements = cpuinfo_get_##cpuinfo_func_name();                                      \
-                                                                                                \
-        for (int i = 0; i < elements_count; i++) {                                              \
-            env->CallBooleanMethod(                                                             \
-                    arraylist, addMethodID,                                                     \
-                    cpuJni.clazz_lowercase##ToJava(&elements[i]));                              \
-            JNI_CHECK(env);                                                                     \
-        }                                                                                       \
-                                                                                                \
-        cpuinfo_deinitialize();                                                                 \
-    }
-
-CPUINFO_JNI_FUNC(Processors, processor, processors)
-CPUINFO_JNI_FUNC(Cores, core, cores)
-CPUINFO_JNI_FUNC(Clusters, cluster, clusters)
-CPUINFO_JNI_FUNC(Packages, package, packages)
-CPUINFO_JNI_FUNC(Uarchs, uarchInfo, uarchs)
-CPUINFO_JNI_FUNC(L1iCaches, cache, l1i_caches)
-CPUINFO_JNI_FUNC(L1dCaches, cache, l1d_caches)
-CPUINFO_JNI_FUNC(L2Caches, cache, l2_caches)
-CPUINFO_JNI_FUNC(L3Caches, cache, l3_caches)
-CPUINFO_JNI_FUNC(L4Caches, cache, l4_caches)
+/**
+ * cpuinfo parses /proc/cpuinfo and sysfs only once per process, serializing its state is what's
+ * expensive, so we keep the serialized snapshot around until the set of online CPUs changes, as
+ * reported by HotplugMonitor. Only the online state of the processors differs between rebuilds.
+ */
+static std::mutex sTopologyBufferMutex;
+static std::vector<uint8_t> sTopologyBuffer;
+static uint64_t sTopologyBufferGeneration = 0;
+
+/**
+ * TLBs don't change, each processor is only measured successfully once.
+ * The measurement takes about a second, it's serialized per processor so that callers asking
+ * for other processors don't wait for it, nor two measurements fight for the same processor.
+ */
+struct DataTlbsEntry {
+    std::mutex mutex;
+    std::vector<DataTlbLevel> levels;
+};
+
+/**
+ * Only guards the map, entries are never removed so they can be used after unlocking it.
+ */
+static std::mutex sDataTlbsMutex;
+static std::map<uint32_t, DataTlbsEntry> sDataTlbs;
+
+/**
+ * Copy the serialized topology into a direct ByteBuffer.
+ *
+ * @return The size of the serialized topology, if it's bigger than the buffer capacity
+ *         nothing is written and the caller should retry with a bigger buffer, -1 on error
+ */
+static jint fillTopologyBuffer(JNIEnv *env, jobject thiz, jobject buffer) {
+    std::lock_guard lock(sTopologyBufferMutex);
+
+    auto generation = HotplugMonitor::getInstance().getGeneration();
+
+    if (sTopologyBuffer.empty() || generation != sTopologyBufferGeneration) {
+        if (!cpuinfo_initialize()) {
+            LOGE("Failed to initialize cpuinfo");
+            return -1;
+        }
+
+        sTopologyBuffer = TopologyBuffer::build(HotplugMonitor::getInstance().getOnlineCpus());
+        sTopologyBufferGeneration = generation;
+    }
+
+    auto size = static_cast<jint>(sTopologyBuffer.size());
+
+    if (buffer == nullptr || env->GetDirectBufferCapacity(buffer) < size) {
+        return size;
+    }
+
+    auto address = env->GetDirectBufferAddress(buffer);
+    if (address == nullptr) {
+        LOGE("Buffer isn't a direct buffer");
+        return -1;
+    }
+
+    memcpy(address, sTopologyBuffer.data(), sTopologyBuffer.size());
+
+    return size;
+}
+
+/**
+ * @return The generation of the serialized topology, changes only when the online CPUs do
+ */
+static jlong getTopologyGeneration(JNIEnv *env, jobject thiz) {
+    return static_cast<jlong>(HotplugMonitor::getInstance().getGeneration());
+}
+
+/**
+ * @return The IsaFeature bitmask, 0 on error
+ */
+static jlong getIsaFeatureMask(JNIEnv *env, jobject thiz) {
+    if (!cpuinfo_initialize()) {
+        LOGE("Failed to initialize cpuinfo");
+        return 0;
+    }
+
+    return static_cast<jlong>(getIsaFeatures());
+}
+
+/**
+ * Measure the data TLBs of a processor, cpuinfo doesn't expose the ones it knows about.
+ * The first successful call for each processor takes about a second.
+ */
+static jobjectArray getDataTlbs(JNIEnv *env, jobject thiz, jint linuxId) {
+    if (!cpuinfo_initialize()) {
+        LOGE("Failed to initialize cpuinfo");
+        return nullptr;
+    }
+
+    DataTlbsEntry *entry;
+    {
+        std::lock_guard lock(sDataTlbsMutex);
+        entry = &sDataTlbs[linuxId];
+    }
+
+    std::vector<DataTlbLevel> levels;
+    {
+        std::lock_guard lock(entry->mutex);
+
+        if (entry->levels.empty()) {
+            entry->levels = measureDataTlbs(linuxId);
+            if (entry->levels.empty()) {
+                // e.g. the processor is offline, try again next time
+                LOGI("Failed to measure the data TLBs of CPU %d", linuxId);
+                return nullptr;
+            }
+
+            LOGI("Measured %zu data TLB levels on CPU %d", entry->levels.size(), linuxId);
+        }
+
+        levels = entry->levels;
+    }
+
+    auto cpuJni = CpuJni(env);
+
+    auto array = env->NewObjectArray(static_cast<jsize>(levels.size()), cpuJni.tlbClazz, nullptr);
+    if (array == nullptr) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < levels.size(); i++) {
+        auto &level = levels[i];
+
+        cpuinfo_tlb tlb = {
+                .entries = level.entries,
+                .associativity = 0,
+                .pages = level.pageSize,
+        };
+
+        auto object = cpuJni.tlbToJava(&tlb);
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), object);
+        env->DeleteLocalRef(object);
+    }
+
+    return array;
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"fillTopologyBuffer", "(Ljava/nio/ByteBuffer;)I", reinterpret_cast<void *>(fillTopologyBuffer)},
+        {"getTopologyGeneration", "()J", reinterpret_cast<void *>(getTopologyGeneration)},
+        {"getIsaFeatureMask", "()J", reinterpret_cast<void *>(getIsaFeatureMask)},
+        {"getDataTlbs", "(I)[" CPU_CLASS_SIG(Tlb), reinterpret_cast<void *>(getDataTlbs)},
+};
+
+jint registerCpuInfoUtilsNatives(JNIEnv *env) {
+    return registerNatives(env, CPU_UTILS_PACKAGE "/CpuInfoUtils", kMethods, std::size(kMethods));
+}
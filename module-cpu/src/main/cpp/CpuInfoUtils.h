@@ -0,0 +1,15 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <jni.h>
+
+#define CPU_UTILS_PACKAGE "dev/sebaubuntu/athena/modules/cpu/utils"
+
+/**
+ * Bind the native methods of CpuInfoUtils.
+ */
+jint registerCpuInfoUtilsNatives(JNIEnv *env);
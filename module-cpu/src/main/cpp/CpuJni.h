@@ -29,83 +29,41 @@
             return methodID;                                                                       \
         }
 
-DECLARE_CPU_CLASS(Cache, "IIIIIIII")
-
-DECLARE_CPU_CLASS(Cluster, "IIIII" CPU_CLASS_SIG(Package) "IIIIJ")
-
-DECLARE_CPU_CLASS(Core, "III" CPU_CLASS_SIG(Cluster) CPU_CLASS_SIG(Package) "IIIIJ")
-
-DECLARE_CPU_CLASS(Package, STRING_CLASS_SIG "IIIIII")
-
-DECLARE_CPU_CLASS(Processor,
-                  "I" CPU_CLASS_SIG(Core) CPU_CLASS_SIG(Cluster) CPU_CLASS_SIG(
-                          Package) "II" CPU_CLASS_SIG(ProcessorCache))
-
-DECLARE_CPU_CLASS(ProcessorCache,
-                  CPU_CLASS_SIG(Cache) CPU_CLASS_SIG(Cache) CPU_CLASS_SIG(Cache) CPU_CLASS_SIG(
-                          Cache) CPU_CLASS_SIG(Cache))
-
 DECLARE_CPU_CLASS(Tlb, "IIJ")
 
-DECLARE_CPU_CLASS(TraceCache, "II")
-
-DECLARE_CPU_CLASS(Uarch, "I")
-
-DECLARE_CPU_CLASS(UarchInfo, "IIIII")
-
-DECLARE_CPU_CLASS(Vendor, "I")
-
-#define DEFINE_CLASS_ATTRIBUTES(clazz_lowercase)    \
-    jclass clazz_lowercase##Clazz;                  \
-    jmethodID clazz_lowercase##FromCpuInfoMethodID;
-
-#define FILL_CLASS_ATTRIBUTES(env, clazz_lowercase, clazz)                \
-    this->clazz_lowercase##Clazz = get##clazz##Class(env);                \
-    this->clazz_lowercase##FromCpuInfoMethodID =                          \
+#define DEFINE_CLASS_ATTRIBUTES(clazz_lowercase)                  \
+    static inline jclass clazz_lowercase##Clazz = nullptr;        \
+    static inline jmethodID clazz_lowercase##FromCpuInfoMethodID = nullptr;
+
+#define FILL_CLASS_ATTRIBUTES(env, clazz_lowercase, clazz)                           \
+    {                                                                                \
+        auto localClazz = get##clazz##Class(env);                                    \
+        clazz_lowercase##Clazz = static_cast<jclass>(env->NewGlobalRef(localClazz)); \
+        env->DeleteLocalRef(localClazz);                                             \
+    }                                                                                \
+    clazz_lowercase##FromCpuInfoMethodID =                                           \
             get##clazz##FromCpuInfoMethodID(env, clazz_lowercase##Clazz);
 
 struct CpuJni {
-    explicit CpuJni(JNIEnv *env) : mEnv(env) {
-        FILL_CLASS_ATTRIBUTES(env, cache, Cache)
-        FILL_CLASS_ATTRIBUTES(env, cluster, Cluster)
-        FILL_CLASS_ATTRIBUTES(env, core, Core)
-        FILL_CLASS_ATTRIBUTES(env, package, Package)
-        FILL_CLASS_ATTRIBUTES(env, processor, Processor)
-        FILL_CLASS_ATTRIBUTES(env, processorCache, ProcessorCache)
+    explicit CpuJni(JNIEnv *env) : mEnv(env) {}
+
+    /**
+     * Resolve all the classes and method IDs we need and pin them for the lifetime of the
+     * library. Must be called once from JNI_OnLoad.
+     */
+    static void registerClasses(JNIEnv *env) {
         FILL_CLASS_ATTRIBUTES(env, tlb, Tlb)
-        FILL_CLASS_ATTRIBUTES(env, traceCache, TraceCache)
-        FILL_CLASS_ATTRIBUTES(env, uarch, Uarch)
-        FILL_CLASS_ATTRIBUTES(env, uarchInfo, UarchInfo)
-        FILL_CLASS_ATTRIBUTES(env, vendor, Vendor)
     }
 
     JNIEnv *mEnv;
 
-    DEFINE_CLASS_ATTRIBUTES(cache)
-    DEFINE_CLASS_ATTRIBUTES(cluster)
-    DEFINE_CLASS_ATTRIBUTES(core)
-    DEFINE_CLASS_ATTRIBUTES(package)
-    DEFINE_CLASS_ATTRIBUTES(processor)
-    DEFINE_CLASS_ATTRIBUTES(processorCache)
     DEFINE_CLASS_ATTRIBUTES(tlb)
-    DEFINE_CLASS_ATTRIBUTES(traceCache)
-    DEFINE_CLASS_ATTRIBUTES(uarch)
-    DEFINE_CLASS_ATTRIBUTES(uarchInfo)
-    DEFINE_CLASS_ATTRIBUTES(vendor)
-
-    jobject cacheToJava(const struct cpuinfo_cache *cache);
-
-    jobject clusterToJava(const struct cpuinfo_cluster *cluster);
-
-    jobject coreToJava(const struct cpuinfo_core *core);
-
-    jobject packageToJava(const struct cpuinfo_package *package);
-
-    jobject processorToJava(const struct cpuinfo_processor *processor);
-
-    jobject processorCacheToJava(const struct cpuinfo_processor *processor);
 
-    jobject uarchInfoToJava(const struct cpuinfo_uarch_info *uarchInfo);
+    /**
+     * cpuinfo doesn't expose the TLBs it parses, this converts the struct when it comes from
+     * elsewhere, like the TLB benchmark.
+     */
+    jobject tlbToJava(const struct cpuinfo_tlb *tlb);
 };
 
 #undef DEFINE_CLASS_ATTRIBUTES
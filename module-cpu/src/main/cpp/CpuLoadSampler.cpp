@@ -0,0 +1,210 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "CpuLoadSampler.h"
+
+#define PROC_STAT_PATH "/proc/stat"
+
+/**
+ * /proc/stat columns, in order.
+ */
+enum StatColumn : uint32_t {
+    STAT_USER = 0,
+    STAT_NICE,
+    STAT_SYSTEM,
+    STAT_IDLE,
+    STAT_IOWAIT,
+    STAT_IRQ,
+    STAT_SOFTIRQ,
+    STAT_COLUMN_COUNT,
+};
+
+/**
+ * Enough for the "cpu" lines, which come first, the rest of the file is never read.
+ */
+static constexpr size_t kBufferBaseSize = 256;
+static constexpr size_t kBufferSizePerCpu = 192;
+
+static constexpr uint32_t kNoIndex = UINT32_MAX;
+
+static const char *parseUInt64(const char *begin, const char *end, uint64_t &value) {
+    while (begin < end && *begin == ' ') {
+        begin++;
+    }
+
+    value = 0;
+    for (; begin < end && *begin >= '0' && *begin <= '9'; begin++) {
+        value = value * 10 + (*begin - '0');
+    }
+
+    return begin;
+}
+
+CpuLoadSampler &CpuLoadSampler::getInstance() {
+    static CpuLoadSampler instance;
+    return instance;
+}
+
+CpuLoadSampler::CpuLoadSampler() : mStatFile(PROC_STAT_PATH) {
+    uint32_t maxId = 0;
+    readCpuList(CPU_BASE_PATH "/possible", [&](uint32_t first, uint32_t last) {
+        for (auto id = first; id <= last; id++) {
+            mCpus.push_back({.id = id});
+        }
+
+        maxId = std::max(maxId, last);
+    });
+
+    mCpuIndexes.resize(maxId + 1, kNoIndex);
+    for (uint32_t i = 0; i < mCpus.size(); i++) {
+        mCpuIndexes[mCpus[i].id] = i;
+    }
+
+    mBuffer.resize(kBufferBaseSize + mCpus.size() * kBufferSizePerCpu);
+    mHistory.resize(mCpus.size() * kHistoryLength * FIELD_COUNT, NAN);
+}
+
+void CpuLoadSampler::parseLine(const char *begin, const char *end) {
+    // Skip the aggregated "cpu" line
+    if (begin == end || *begin < '0' || *begin > '9') {
+        return;
+    }
+
+    uint64_t id;
+    auto position = parseUInt64(begin, end, id);
+    if (position == begin || id >= mCpuIndexes.size() || mCpuIndexes[id] == kNoIndex) {
+        return;
+    }
+
+    uint64_t columns[STAT_COLUMN_COUNT] = {};
+    for (auto &column: columns) {
+        position = parseUInt64(position, end, column);
+    }
+
+    uint64_t counters[FIELD_COUNT];
+    counters[USER] = columns[STAT_USER] + columns[STAT_NICE];
+    counters[SYSTEM] = columns[STAT_SYSTEM];
+    counters[IOWAIT] = columns[STAT_IOWAIT];
+    counters[IRQ] = columns[STAT_IRQ] + columns[STAT_SOFTIRQ];
+    counters[IDLE] = columns[STAT_IDLE];
+
+    auto &cpu = mCpus[mCpuIndexes[id]];
+    auto sample = &mHistory[(mCpuIndexes[id] * kHistoryLength + mHistoryHead) * FIELD_COUNT];
+
+    if (cpu.hasCounters) {
+        // Idle and iowait may go backwards across hotplug, clamp instead of wrapping around
+        uint64_t deltas[FIELD_COUNT];
+        uint64_t total = 0;
+        for (size_t i = 0; i < FIELD_COUNT; i++) {
+            deltas[i] = counters[i] > cpu.counters[i] ? counters[i] - cpu.counters[i] : 0;
+            total += deltas[i];
+        }
+
+        if (total > 0) {
+            for (size_t i = 0; i < FIELD_COUNT; i++) {
+                sample[i] = static_cast<float>(deltas[i]) / static_cast<float>(total);
+            }
+        }
+    }
+
+    memcpy(cpu.counters, counters, sizeof(counters));
+    cpu.hasCounters = true;
+    cpu.sampled = true;
+}
+
+void CpuLoadSampler::sample() {
+    std::lock_guard lock(mMutex);
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - mLastSample < kMinimumInterval) {
+        return;
+    }
+
+    auto size = mStatFile.read(mBuffer.data(), mBuffer.size());
+    if (size <= 0) {
+        return;
+    }
+
+    mLastSample = now;
+
+    // Start from an empty slot, CPUs missing from /proc/stat are offline
+    for (size_t i = 0; i < mCpus.size(); i++) {
+        std::fill_n(&mHistory[(i * kHistoryLength + mHistoryHead) * FIELD_COUNT], FIELD_COUNT, NAN);
+        mCpus[i].sampled = false;
+    }
+
+    const char *begin = mBuffer.data();
+    auto end = begin + size;
+
+    while (begin < end) {
+        auto lineEnd = static_cast<const char *>(memchr(begin, '\n', end - begin));
+        if (lineEnd == nullptr) {
+            // Truncated, we either have all the CPU lines already or the buffer is too small
+            break;
+        }
+
+        if (lineEnd - begin < 3 || memcmp(begin, "cpu", 3) != 0) {
+            break;
+        }
+
+        parseLine(begin + 3, lineEnd);
+
+        begin = lineEnd + 1;
+    }
+
+    for (auto &cpu: mCpus) {
+        if (!cpu.sampled) {
+            cpu.hasCounters = false;
+        }
+    }
+
+    mHistoryHead = (mHistoryHead + 1) % kHistoryLength;
+}
+
+size_t CpuLoadSampler::read(float *values, size_t capacity) {
+    std::lock_guard lock(mMutex);
+
+    if (capacity < mCpus.size() * kRecordSize) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < mCpus.size(); i++) {
+        *values++ = static_cast<float>(mCpus[i].id);
+
+        auto history = &mHistory[i * kHistoryLength * FIELD_COUNT];
+
+        // Oldest first
+        auto tailCount = (kHistoryLength - mHistoryHead) * FIELD_COUNT;
+        memcpy(values, history + mHistoryHead * FIELD_COUNT, tailCount * sizeof(float));
+        values += tailCount;
+
+        auto headCount = mHistoryHead * FIELD_COUNT;
+        memcpy(values, history, headCount * sizeof(float));
+        values += headCount;
+    }
+
+    return mCpus.size();
+}
+
+size_t CpuLoadSampler::readBusy(float *values, size_t capacity) {
+    std::lock_guard lock(mMutex);
+
+    if (capacity < mCpus.size()) {
+        return 0;
+    }
+
+    auto latest = (mHistoryHead + kHistoryLength - 1) % kHistoryLength;
+
+    for (size_t i = 0; i < mCpus.size(); i++) {
+        auto sample = &mHistory[(i * kHistoryLength + latest) * FIELD_COUNT];
+
+        values[i] = sample[USER] + sample[SYSTEM] + sample[IRQ];
+    }
+
+    return mCpus.size();
+}
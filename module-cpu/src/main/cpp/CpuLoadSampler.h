@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "SysfsFile.h"
+
+/**
+ * Per-CPU utilization computed from the /proc/stat jiffies counters.
+ *
+ * Every sample is the share of the time spent in each state since the previous sample, a
+ * fixed-size history of samples is kept for each possible CPU. Buffers are allocated once, so
+ * sampling at a high rate only costs a pread() and a parse.
+ *
+ * Every sample() restarts the deltas, so anything sampling at its own pace must own an instance
+ * instead of sharing getInstance() with the UI.
+ *
+ * Must be kept in sync with LinuxCpuUtils.kt.
+ */
+class CpuLoadSampler {
+public:
+    enum Field : uint32_t {
+        USER = 0,
+        SYSTEM,
+        IOWAIT,
+        IRQ,
+        IDLE,
+        FIELD_COUNT,
+    };
+
+    static constexpr size_t kHistoryLength = 64;
+
+    /**
+     * Values per CPU returned by read(): the Linux CPU ID followed by kHistoryLength samples of
+     * FIELD_COUNT values, oldest first. Missing samples (e.g. the CPU was offline) are NaN.
+     */
+    static constexpr size_t kRecordSize = 1 + kHistoryLength * FIELD_COUNT;
+
+    /**
+     * Samples closer than this to the previous one are skipped, the jiffies counters don't
+     * have enough resolution for them.
+     */
+    static constexpr std::chrono::milliseconds kMinimumInterval{40};
+
+    CpuLoadSampler();
+
+    CpuLoadSampler(const CpuLoadSampler &) = delete;
+    CpuLoadSampler &operator=(const CpuLoadSampler &) = delete;
+
+    static CpuLoadSampler &getInstance();
+
+    /**
+     * @return The number of possible CPUs
+     */
+    size_t getCpuCount() const { return mCpus.size(); }
+
+    /**
+     * Take a new sample, unless the previous one is too recent.
+     */
+    void sample();
+
+    /**
+     * Copy the history of every CPU.
+     *
+     * @param values Output, must hold at least getCpuCount() * kRecordSize values
+     * @return The number of CPUs written
+     */
+    size_t read(float *values, size_t capacity);
+
+    /**
+     * Copy the busy share (user + system + irq) of the latest sample of every CPU, NaN if missing.
+     *
+     * @param values Output, must hold at least getCpuCount() values
+     * @return The number of CPUs written
+     */
+    size_t readBusy(float *values, size_t capacity);
+
+private:
+    struct Cpu {
+        uint32_t id;
+
+        /**
+         * Jiffies of each state at the previous sample, valid only if hasCounters is set.
+         */
+        uint64_t counters[FIELD_COUNT];
+        bool hasCounters;
+
+        /**
+         * Whether this CPU appeared in the current sample.
+         */
+        bool sampled;
+    };
+
+    void parseLine(const char *begin, const char *end);
+
+    std::mutex mMutex;
+
+    SysfsFile mStatFile;
+    std::vector<char> mBuffer;
+
+    std::vector<Cpu> mCpus;
+
+    /**
+     * Index in mCpus by Linux CPU ID.
+     */
+    std::vector<uint32_t> mCpuIndexes;
+
+    /**
+     * Ring of kHistoryLength samples for each CPU, mHistoryHead being the next slot to write.
+     */
+    std::vector<float> mHistory;
+    size_t mHistoryHead = 0;
+
+    std::chrono::steady_clock::time_point mLastSample;
+};
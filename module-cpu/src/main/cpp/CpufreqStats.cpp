@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <time.h>
+#include <unistd.h>
+#include "CpufreqStats.h"
+
+#define CPUFREQ_PATH CPU_BASE_PATH "/cpufreq"
+
+static constexpr int64_t kNsPerSecond = 1000000000;
+static constexpr int64_t kMsPerSecond = 1000;
+
+static constexpr size_t kHeaderSize = 3;
+
+/**
+ * Space per time_in_state line ("<frequency> <time>\n").
+ */
+static constexpr size_t kLineSize = 32;
+
+static int64_t nowNs(clockid_t clock) {
+    timespec time{};
+    clock_gettime(clock, &time);
+    return time.tv_sec * kNsPerSecond + time.tv_nsec;
+}
+
+/**
+ * Parse "<frequency> <time>" lines, calling callback(index, frequency, time) for each one.
+ *
+ * @return The number of lines parsed
+ */
+template<typename Callback>
+static size_t parseTimeInState(const char *begin, const char *end, Callback &&callback) {
+    size_t count = 0;
+
+    while (begin < end) {
+        auto lineEnd = static_cast<const char *>(memchr(begin, '\n', end - begin));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+
+        auto separator = static_cast<const char *>(memchr(begin, ' ', lineEnd - begin));
+
+        int64_t frequency;
+        int64_t time;
+        if (separator != nullptr && parseInt64(begin, separator, frequency)
+            && parseInt64(separator + 1, lineEnd, time)) {
+            callback(count++, frequency, time);
+        }
+
+        begin = lineEnd + 1;
+    }
+
+    return count;
+}
+
+CpufreqStats &CpufreqStats::getInstance() {
+    static CpufreqStats instance;
+    return instance;
+}
+
+CpufreqStats::CpufreqStats() : mClockTicksPerSecond(sysconf(_SC_CLK_TCK)) {
+    if (mClockTicksPerSecond <= 0) {
+        mClockTicksPerSecond = 100;
+    }
+
+    if (auto dir = opendir(CPUFREQ_PATH)) {
+        while (auto entry = readdir(dir)) {
+            uint32_t id;
+            if (sscanf(entry->d_name, "policy%u", &id) != 1) {
+                continue;
+            }
+
+            auto &policy = mPolicies.emplace_back();
+            policy.id = id;
+
+            auto basePath = std::string(CPUFREQ_PATH "/") + entry->d_name;
+
+            // Unlike the other CPU lists, related_cpus is space separated
+            char buffer[256];
+            auto size = SysfsFile(basePath + "/related_cpus").read(buffer, sizeof(buffer));
+            for (ssize_t begin = 0, end = 0; end <= size; end++) {
+                if (end == size || buffer[end] == ' ' || buffer[end] == '\n') {
+                    int64_t cpu;
+                    if (parseInt64(buffer + begin, buffer + end, cpu)) {
+                        policy.relatedCpus.push_back(static_cast<uint32_t>(cpu));
+                    }
+                    begin = end + 1;
+                }
+            }
+
+            policy.timeInStateFile = SysfsFile(basePath + "/stats/time_in_state");
+            policy.totalTransFile = SysfsFile(basePath + "/stats/total_trans");
+        }
+
+        closedir(dir);
+    }
+
+    std::sort(mPolicies.begin(), mPolicies.end(), [](const Policy &a, const Policy &b) {
+        return a.id < b.id;
+    });
+
+    // The frequency table is fixed for the lifetime of a policy, get it once
+    size_t maxStateCount = 0;
+    for (auto &policy: mPolicies) {
+        std::vector<char> buffer(4096);
+
+        auto size = policy.timeInStateFile.read(buffer.data(), buffer.size());
+        if (size > 0) {
+            parseTimeInState(buffer.data(), buffer.data() + size,
+                             [&](size_t, int64_t frequency, int64_t) {
+                                 policy.frequenciesKhz.push_back(frequency);
+                             });
+        }
+
+        policy.counterOffset = mCounterCount;
+        mCounterCount += 1 + policy.frequenciesKhz.size();
+
+        maxStateCount = std::max(maxStateCount, policy.frequenciesKhz.size());
+
+        mOutputSize += 2 + policy.relatedCpus.size() + 2 + policy.frequenciesKhz.size() * 2;
+    }
+    mOutputSize += kHeaderSize;
+
+    mBuffer.resize(std::max<size_t>(maxStateCount * kLineSize, kLineSize));
+    mCounters.resize(mCounterCount);
+    mHistory.resize(mCounterCount);
+}
+
+void CpufreqStats::readPolicy(Policy &policy, int64_t *counters) {
+    if (!policy.totalTransFile.readInt64(counters[0])) {
+        counters[0] = kUnknown;
+    }
+
+    auto times = counters + 1;
+    std::fill_n(times, policy.frequenciesKhz.size(), kUnknown);
+
+    auto size = policy.timeInStateFile.read(mBuffer.data(), mBuffer.size());
+    if (size <= 0) {
+        return;
+    }
+
+    auto valid = true;
+    auto count = parseTimeInState(mBuffer.data(), mBuffer.data() + size,
+                                  [&](size_t index, int64_t frequency, int64_t time) {
+                                      if (index >= policy.frequenciesKhz.size()
+                                          || policy.frequenciesKhz[index] != frequency) {
+                                          valid = false;
+                                          return;
+                                      }
+
+                                      times[index] = time * kMsPerSecond / mClockTicksPerSecond;
+                                  });
+
+    if (!valid || count != policy.frequenciesKhz.size()) {
+        std::fill_n(times, policy.frequenciesKhz.size(), kUnknown);
+    }
+}
+
+size_t CpufreqStats::read(int64_t windowNs, int64_t *values, size_t capacity) {
+    std::lock_guard lock(mMutex);
+
+    if (capacity < mOutputSize) {
+        return 0;
+    }
+
+    auto startNs = nowNs(CLOCK_MONOTONIC);
+
+    auto current = mCounters.data();
+    for (auto &policy: mPolicies) {
+        readPolicy(policy, current + policy.counterOffset);
+    }
+
+    int64_t baselineNs;
+    auto baseline = mHistory.getBaseline(startNs, windowNs, baselineNs);
+
+    auto output = values;
+    *output++ = static_cast<int64_t>(mPolicies.size());
+    *output++ = startNs - baselineNs;
+    auto overhead = output++;
+
+    for (auto &policy: mPolicies) {
+        auto counters = current + policy.counterOffset;
+        auto baselineCounters = baseline != nullptr ? baseline + policy.counterOffset : nullptr;
+
+        auto delta = [&](size_t index) {
+            return CounterHistory::delta(counters, baselineCounters, index);
+        };
+
+        *output++ = policy.id;
+        *output++ = static_cast<int64_t>(policy.relatedCpus.size());
+        for (auto cpu: policy.relatedCpus) {
+            *output++ = cpu;
+        }
+
+        *output++ = delta(0);
+        *output++ = static_cast<int64_t>(policy.frequenciesKhz.size());
+        for (size_t i = 0; i < policy.frequenciesKhz.size(); i++) {
+            *output++ = policy.frequenciesKhz[i];
+            *output++ = delta(1 + i);
+        }
+    }
+
+    mHistory.push(startNs, current);
+
+    *overhead = nowNs(CLOCK_MONOTONIC) - startNs;
+
+    return static_cast<size_t>(output - values);
+}
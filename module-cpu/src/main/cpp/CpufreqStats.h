@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "CounterHistory.h"
+#include "SysfsFile.h"
+
+/**
+ * cpufreq residency engine, based on each policy's stats/time_in_state and stats/total_trans.
+ *
+ * Every read() refreshes the counters and reports the time spent at each frequency and the
+ * number of transitions over the requested window, computed against a ring of previous
+ * snapshots. Policies without stats (CONFIG_CPU_FREQ_STAT disabled, unreadable nodes) are still
+ * reported, just without states and transitions.
+ *
+ * Output layout (int64 values):
+ * - Header: policy count, actual window in ns, overhead of this read in ns
+ * - For each policy: policy ID, related CPU count, related CPU IDs, transitions (-1 if unknown),
+ *   state count, then frequency in kHz and residency in ms for each state
+ *
+ * Must be kept in sync with CpufreqUtils.kt.
+ */
+class CpufreqStats {
+public:
+    static constexpr int64_t kUnknown = CounterHistory::kUnknown;
+
+    /**
+     * History kept, windows are clamped to about kSnapshotCount * kSnapshotInterval.
+     */
+    static constexpr std::chrono::milliseconds kSnapshotInterval{250};
+    static constexpr size_t kSnapshotCount = 128;
+
+    static CpufreqStats &getInstance();
+
+    /**
+     * @return The number of values read() will write
+     */
+    size_t getOutputSize() const { return mOutputSize; }
+
+    /**
+     * Refresh the counters and write the residency over the last windowNs nanoseconds.
+     * If not enough history is available, the longest available window is used instead.
+     *
+     * @return The number of values written, 0 on error
+     */
+    size_t read(int64_t windowNs, int64_t *values, size_t capacity);
+
+private:
+    struct Policy {
+        uint32_t id;
+        std::vector<uint32_t> relatedCpus;
+
+        SysfsFile timeInStateFile;
+        SysfsFile totalTransFile;
+
+        std::vector<int64_t> frequenciesKhz;
+
+        /**
+         * Offset of this policy's counters in a snapshot, the transitions followed by the
+         * time spent in each state.
+         */
+        size_t counterOffset;
+    };
+
+    CpufreqStats();
+
+    /**
+     * Read the current counters of a policy into counters, unknown values are set to kUnknown.
+     */
+    void readPolicy(Policy &policy, int64_t *counters);
+
+    std::mutex mMutex;
+
+    std::vector<Policy> mPolicies;
+    size_t mCounterCount = 0;
+    size_t mOutputSize = 0;
+
+    std::vector<char> mBuffer;
+
+    std::vector<int64_t> mCounters;
+    CounterHistory mHistory{kSnapshotCount, kSnapshotInterval};
+
+    int64_t mClockTicksPerSecond;
+};
@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "CpufreqUtils"
+
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include <vector>
+#include "CpuInfoUtils.h"
+#include "CpufreqStats.h"
+#include "CpufreqUtils.h"
+#include "jni_utils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+/**
+ * Get the cpufreq residency of every policy over the last windowMs milliseconds.
+ *
+ * @return See CpufreqStats for the layout
+ */
+static jlongArray getCpufreqResidency(JNIEnv *env, jobject thiz, jlong windowMs) {
+    auto &stats = CpufreqStats::getInstance();
+
+    std::vector<jlong> values(stats.getOutputSize());
+
+    auto written = stats.read(windowMs * 1000000, reinterpret_cast<int64_t *>(values.data()),
+                              values.size());
+    if (written != values.size()) {
+        LOGE("Failed to read cpufreq residency");
+        return nullptr;
+    }
+
+    return toJLongArray(env, values);
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"getCpufreqResidency", "(J)[J", reinterpret_cast<void *>(getCpufreqResidency)},
+};
+
+jint registerCpufreqUtilsNatives(JNIEnv *env) {
+    return registerNatives(env, CPU_UTILS_PACKAGE "/CpufreqUtils", kMethods, std::size(kMethods));
+}
@@ -0,0 +1,13 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <jni.h>
+
+/**
+ * Bind the native methods of CpufreqUtils.
+ */
+jint registerCpufreqUtilsNatives(JNIEnv *env);
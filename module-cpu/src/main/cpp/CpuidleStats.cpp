@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "CpuidleStats"
+
+#include <algorithm>
+#include <android/log.h>
+#include <cpuinfo.h>
+#include <time.h>
+#include <unistd.h>
+#include "CpuidleStats.h"
+#include "HotplugMonitor.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+static constexpr int64_t kNsPerSecond = 1000000000;
+
+static constexpr size_t kHeaderSize = 4;
+
+static int64_t nowNs(clockid_t clock) {
+    timespec time{};
+    clock_gettime(clock, &time);
+    return time.tv_sec * kNsPerSecond + time.tv_nsec;
+}
+
+CpuidleStats &CpuidleStats::getInstance() {
+    static CpuidleStats instance;
+    return instance;
+}
+
+CpuidleStats::CpuidleStats(std::string cpuBasePath) : mCpuBasePath(std::move(cpuBasePath)) {
+    if (!cpuinfo_initialize()) {
+        LOGE("Failed to initialize cpuinfo");
+        return;
+    }
+
+    std::vector<uint32_t> cpuIds;
+    for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+        cpuIds.push_back(static_cast<uint32_t>(cpuinfo_get_processor(i)->linux_id));
+    }
+    std::sort(cpuIds.begin(), cpuIds.end());
+    cpuIds.erase(std::unique(cpuIds.begin(), cpuIds.end()), cpuIds.end());
+
+    for (auto id: cpuIds) {
+        mCpus.push_back({.id = id});
+    }
+}
+
+size_t CpuidleStats::getOutputSize() {
+    std::lock_guard lock(mMutex);
+
+    refresh();
+
+    return mOutputSize;
+}
+
+bool CpuidleStats::getStateNames(uint64_t generation, std::vector<std::string> &names) {
+    std::lock_guard lock(mMutex);
+
+    refresh();
+    if (generation != mGeneration) {
+        return false;
+    }
+
+    names.clear();
+    for (auto &cpu: mCpus) {
+        for (auto &state: cpu.states) {
+            names.push_back(state.name);
+        }
+    }
+
+    return true;
+}
+
+void CpuidleStats::refresh() {
+    auto &monitor = HotplugMonitor::getInstance();
+
+    // Read first, a change in between is caught by the next call
+    auto generation = monitor.getGeneration();
+    if (generation != mGeneration) {
+        enumerate(generation, monitor.getOnlineCpus());
+    }
+}
+
+void CpuidleStats::enumerate(uint64_t generation, const std::string &onlineCpus) {
+    std::vector<bool> online;
+    parseCpuList(onlineCpus.data(), onlineCpus.data() + onlineCpus.size(),
+                 [&](uint32_t first, uint32_t last) {
+                     if (online.size() <= last) {
+                         online.resize(last + 1);
+                     }
+                     std::fill(online.begin() + first, online.begin() + last + 1, true);
+                 });
+
+    size_t counterCount = 0;
+    mOutputSize = kHeaderSize;
+
+    for (auto &cpu: mCpus) {
+        // The nodes of a CPU that went offline and back in between are gone, reopen them all
+        cpu.states.clear();
+        if (cpu.id < online.size() && online[cpu.id]) {
+            listStates(cpu);
+        }
+
+        cpu.counterOffset = counterCount;
+
+        counterCount += cpu.states.size() * 2;
+        mOutputSize += 2 + cpu.states.size() * 3;
+    }
+
+    // The counters moved around, deltas against older snapshots would be meaningless
+    mCounters.resize(counterCount);
+    mHistory.resize(counterCount);
+
+    mGeneration = generation;
+}
+
+void CpuidleStats::listStates(Cpu &cpu) {
+    auto cpuidlePath = mCpuBasePath + "/cpu" + std::to_string(cpu.id) + "/cpuidle/";
+
+    for (uint32_t index = 0;; index++) {
+        auto statePath = cpuidlePath + "state" + std::to_string(index) + "/";
+
+        // Presence of the state is given by its usage node
+        SysfsFile usageFile(statePath + "usage");
+        if (!usageFile.isOpen()) {
+            break;
+        }
+
+        char name[64];
+        auto nameSize = SysfsFile(statePath + "name").read(name, sizeof(name));
+        while (nameSize > 0 && name[nameSize - 1] == '\n') {
+            nameSize--;
+        }
+
+        int64_t exitLatencyUs;
+        if (!SysfsFile(statePath + "latency").readInt64(exitLatencyUs)) {
+            exitLatencyUs = kUnknown;
+        }
+
+        cpu.states.push_back({
+                .name = std::string(name, std::max<ssize_t>(nameSize, 0)),
+                .exitLatencyUs = exitLatencyUs,
+                .usageFile = std::move(usageFile),
+                .timeFile = SysfsFile(statePath + "time"),
+        });
+    }
+}
+
+size_t CpuidleStats::read(int64_t windowNs, int64_t *values, size_t capacity) {
+    std::lock_guard lock(mMutex);
+
+    refresh();
+
+    if (capacity < mOutputSize) {
+        return 0;
+    }
+
+    auto startNs = nowNs(CLOCK_MONOTONIC);
+
+    auto current = mCounters.data();
+    for (auto &cpu: mCpus) {
+        auto counters = current + cpu.counterOffset;
+
+        for (auto &state: cpu.states) {
+            if (!state.usageFile.readInt64(*counters++)) {
+                counters[-1] = kUnknown;
+            }
+            if (!state.timeFile.readInt64(*counters++)) {
+                counters[-1] = kUnknown;
+            }
+        }
+    }
+
+    int64_t baselineNs;
+    auto baseline = mHistory.getBaseline(startNs, windowNs, baselineNs);
+
+    auto output = values;
+    *output++ = static_cast<int64_t>(mCpus.size());
+    *output++ = static_cast<int64_t>(mGeneration);
+    *output++ = startNs - baselineNs;
+    auto overhead = output++;
+
+    for (auto &cpu: mCpus) {
+        auto counters = current + cpu.counterOffset;
+        auto baselineCounters = baseline != nullptr ? baseline + cpu.counterOffset : nullptr;
+
+        *output++ = cpu.id;
+        *output++ = static_cast<int64_t>(cpu.states.size());
+
+        for (size_t i = 0; i < cpu.states.size(); i++) {
+            *output++ = cpu.states[i].exitLatencyUs;
+            *output++ = CounterHistory::delta(counters, baselineCounters, i * 2);
+            *output++ = CounterHistory::delta(counters, baselineCounters, i * 2 + 1);
+        }
+    }
+
+    mHistory.push(startNs, current);
+
+    *overhead = nowNs(CLOCK_MONOTONIC) - startNs;
+
+    return static_cast<size_t>(output - values);
+}
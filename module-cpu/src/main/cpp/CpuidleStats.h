@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CounterHistory.h"
+#include "SysfsFile.h"
+
+/**
+ * cpuidle residency engine, based on each CPU's cpuidle/stateK/{usage,time} counters.
+ *
+ * The counters of every idle state of every online processor reported by cpuinfo are kept open
+ * and refreshed with pread(), deltas are computed over the requested window against a ring of
+ * previous snapshots. Each idle state entry ends with a wakeup, so the usage delta summed over
+ * the states is the number of wakeups.
+ *
+ * Offline CPUs have no states. The states are listed again, and the history dropped, whenever
+ * the HotplugMonitor generation changes, so the layout is tied to that generation.
+ *
+ * Output layout (int64 values):
+ * - Header: CPU count, layout generation, actual window in ns, overhead of this read in ns
+ * - For each CPU: Linux CPU ID, state count, then exit latency in us, entries and time spent in
+ *   us for each state
+ *
+ * State names are returned separately by getStateNames(), in the same order.
+ *
+ * Must be kept in sync with CpuidleUtils.kt.
+ */
+class CpuidleStats {
+public:
+    static constexpr int64_t kUnknown = CounterHistory::kUnknown;
+
+    /**
+     * History kept, windows are clamped to about kSnapshotCount * kSnapshotInterval.
+     */
+    static constexpr std::chrono::milliseconds kSnapshotInterval{100};
+    static constexpr size_t kSnapshotCount = 256;
+
+    static CpuidleStats &getInstance();
+
+    /**
+     * @return The number of values read() will write, as of the current online CPUs
+     */
+    size_t getOutputSize();
+
+    /**
+     * Get the name of each state of each CPU, flattened in output order.
+     *
+     * @param generation The layout generation of the output the names are for
+     * @return Whether the layout still is the requested one
+     */
+    bool getStateNames(uint64_t generation, std::vector<std::string> &names);
+
+    /**
+     * Refresh the counters and write the residency over the last windowNs nanoseconds.
+     * If not enough history is available, the longest available window is used instead.
+     *
+     * @return The number of values written, 0 on error or if the layout grew past capacity
+     */
+    size_t read(int64_t windowNs, int64_t *values, size_t capacity);
+
+private:
+    friend class CpuidleStatsTest;
+
+    struct State {
+        std::string name;
+        int64_t exitLatencyUs;
+        SysfsFile usageFile;
+        SysfsFile timeFile;
+    };
+
+    struct Cpu {
+        uint32_t id;
+        std::vector<State> states;
+
+        /**
+         * Offset of this CPU's counters in a snapshot, usage and time for each state.
+         */
+        size_t counterOffset;
+    };
+
+    explicit CpuidleStats(std::string cpuBasePath = CPU_BASE_PATH);
+
+    /**
+     * List the states again if the online CPUs changed. Must hold mMutex.
+     */
+    void refresh();
+
+    /**
+     * Open the states of the online CPUs and drop the ones of the offline CPUs.
+     */
+    void enumerate(uint64_t generation, const std::string &onlineCpus);
+
+    void listStates(Cpu &cpu);
+
+    std::mutex mMutex;
+
+    std::string mCpuBasePath;
+    std::vector<Cpu> mCpus;
+    size_t mOutputSize = 0;
+
+    /**
+     * The HotplugMonitor generation the states were listed at.
+     */
+    uint64_t mGeneration = UINT64_MAX;
+
+    std::vector<int64_t> mCounters;
+    CounterHistory mHistory{kSnapshotCount, kSnapshotInterval};
+};
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "CpuidleUtils"
+
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include <string>
+#include <vector>
+#include "CpuInfoUtils.h"
+#include "CpuidleStats.h"
+#include "CpuidleUtils.h"
+#include "jni_utils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+/**
+ * Get the cpuidle residency of every CPU over the last windowMs milliseconds.
+ *
+ * @return See CpuidleStats for the layout
+ */
+static jlongArray getCpuidleResidency(JNIEnv *env, jobject thiz, jlong windowMs) {
+    auto &stats = CpuidleStats::getInstance();
+
+    std::vector<jlong> values;
+    size_t written;
+
+    // A CPU may come online in between, growing the output
+    do {
+        values.resize(stats.getOutputSize());
+        written = stats.read(windowMs * 1000000, reinterpret_cast<int64_t *>(values.data()),
+                             values.size());
+    } while (written == 0 && values.size() < stats.getOutputSize());
+
+    if (written == 0) {
+        LOGE("Failed to read cpuidle residency");
+        return nullptr;
+    }
+
+    values.resize(written);
+
+    return toJLongArray(env, values);
+}
+
+/**
+ * @return The name of each idle state, in the same order as getCpuidleResidency() with the
+ *         given layout generation, null if the layout changed since
+ */
+static jobjectArray getCpuidleStateNames(JNIEnv *env, jobject thiz, jlong generation) {
+    std::vector<std::string> names;
+    if (!CpuidleStats::getInstance().getStateNames(static_cast<uint64_t>(generation), names)) {
+        return nullptr;
+    }
+
+    auto stringClazz = env->FindClass("java/lang/String");
+    JNI_CHECK(env);
+
+    auto array = env->NewObjectArray(static_cast<jsize>(names.size()), stringClazz, nullptr);
+    env->DeleteLocalRef(stringClazz);
+    if (array == nullptr) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < names.size(); i++) {
+        auto name = env->NewStringUTF(names[i].c_str());
+        JNI_CHECK(env);
+
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), name);
+        env->DeleteLocalRef(name);
+    }
+
+    return array;
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"getCpuidleResidency", "(J)[J", reinterpret_cast<void *>(getCpuidleResidency)},
+        {"getCpuidleStateNames", "(J)[" STRING_CLASS_SIG, reinterpret_cast<void *>(getCpuidleStateNames)},
+};
+
+jint registerCpuidleUtilsNatives(JNIEnv *env) {
+    return registerNatives(env, CPU_UTILS_PACKAGE "/CpuidleUtils", kMethods, std::size(kMethods));
+}
@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "HotplugMonitor"
+
+#include <android/log.h>
+#include <cerrno>
+#include <cstring>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <pthread.h>
+#include <string_view>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "HotplugMonitor.h"
+
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+/**
+ * Big enough for a single uevent, bigger ones are truncated and ignored.
+ */
+static constexpr size_t kUeventBufferSize = 2048;
+
+static int openUeventSocket() {
+    auto fd = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+    if (fd < 0) {
+        return -1;
+    }
+
+    sockaddr_nl address = {
+            .nl_family = AF_NETLINK,
+            .nl_pid = 0,
+            .nl_groups = 1,
+    };
+
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * Whether a uevent is about a CPU going online or offline. A uevent is a "ACTION@DEVPATH" header
+ * followed by NUL separated KEY=VALUE pairs.
+ */
+static bool isCpuHotplugUevent(const char *buffer, size_t size) {
+    bool isCpu = false;
+    bool isHotplug = false;
+
+    for (auto entry = buffer; entry < buffer + size; entry += strlen(entry) + 1) {
+        if (strcmp(entry, "SUBSYSTEM=cpu") == 0) {
+            isCpu = true;
+        } else if (strcmp(entry, "ACTION=online") == 0 || strcmp(entry, "ACTION=offline") == 0
+                   || strcmp(entry, "ACTION=add") == 0 || strcmp(entry, "ACTION=remove") == 0) {
+            isHotplug = true;
+        }
+    }
+
+    return isCpu && isHotplug;
+}
+
+HotplugMonitor &HotplugMonitor::getInstance() {
+    // Leaked on purpose, the monitoring thread may still be running at exit
+    static auto instance = new HotplugMonitor();
+    return *instance;
+}
+
+HotplugMonitor::HotplugMonitor()
+        : mOnlineFile(CPU_BASE_PATH "/online"), mStopFd(eventfd(0, EFD_CLOEXEC)) {
+    refresh();
+}
+
+void HotplugMonitor::setCallback(Callback callback) {
+    std::lock_guard lock(mStateMutex);
+
+    mCallback = std::move(callback);
+}
+
+void HotplugMonitor::start() {
+    std::lock_guard lock(mStateMutex);
+
+    if (mUsers++ > 0) {
+        return;
+    }
+
+    if (mStopFd < 0) {
+        LOGE("Can't create the stop eventfd, online CPUs will be read on demand");
+        return;
+    }
+
+    auto socketFd = openUeventSocket();
+    if (socketFd < 0) {
+        LOGI("Can't listen for uevents (%s), polling online CPUs instead", strerror(errno));
+    }
+
+    mRunning.store(true, std::memory_order_release);
+    mThread = std::thread(&HotplugMonitor::run, this, socketFd);
+}
+
+void HotplugMonitor::stop() {
+    std::lock_guard lock(mStateMutex);
+
+    if (mUsers == 0 || --mUsers > 0 || !mThread.joinable()) {
+        return;
+    }
+
+    uint64_t value = 1;
+    write(mStopFd, &value, sizeof(value));
+
+    mThread.join();
+
+    read(mStopFd, &value, sizeof(value));
+}
+
+uint64_t HotplugMonitor::getGeneration() {
+    refreshIfUnmonitored();
+
+    return mGeneration.load(std::memory_order_acquire);
+}
+
+std::string HotplugMonitor::getOnlineCpus() {
+    refreshIfUnmonitored();
+
+    std::lock_guard lock(mMutex);
+    return mOnlineCpus;
+}
+
+void HotplugMonitor::refreshIfUnmonitored() {
+    if (!mRunning.load(std::memory_order_acquire)) {
+        refresh();
+    }
+}
+
+bool HotplugMonitor::refresh() {
+    char buffer[256];
+
+    auto size = mOnlineFile.read(buffer, sizeof(buffer));
+    while (size > 0 && buffer[size - 1] == '\n') {
+        size--;
+    }
+
+    std::lock_guard lock(mMutex);
+
+    auto onlineCpus = size > 0 ? std::string_view(buffer, size) : std::string_view();
+    if (onlineCpus == mOnlineCpus) {
+        return false;
+    }
+
+    mOnlineCpus = onlineCpus;
+    mGeneration.fetch_add(1, std::memory_order_acq_rel);
+
+    return true;
+}
+
+void HotplugMonitor::run(int socketFd) {
+    pthread_setname_np(pthread_self(), "AthenaHotplug");
+
+    char buffer[kUeventBufferSize];
+
+    // Catch up with what happened while nobody was listening
+    auto changed = refresh();
+
+    while (true) {
+        if (changed) {
+            auto onlineCpus = getOnlineCpus();
+
+            LOGI("Online CPUs changed: %s", onlineCpus.c_str());
+
+            if (mCallback) {
+                mCallback(onlineCpus);
+            }
+        }
+
+        pollfd fds[] = {
+                {.fd = mStopFd, .events = POLLIN, .revents = 0},
+                {.fd = socketFd, .events = POLLIN, .revents = 0},
+        };
+
+        auto timeoutMs = socketFd >= 0 ? -1 : static_cast<int>(kPollInterval.count());
+        if (poll(fds, socketFd >= 0 ? 2 : 1, timeoutMs) < 0 && errno != EINTR) {
+            LOGE("Failed to wait for uevents (%s)", strerror(errno));
+            break;
+        }
+
+        if (fds[0].revents != 0) {
+            break;
+        }
+
+        changed = false;
+
+        if (fds[1].revents != 0) {
+            auto size = recv(socketFd, buffer, sizeof(buffer) - 1, MSG_DONTWAIT);
+            if (size < 0) {
+                if (errno == EINTR || errno == EAGAIN) {
+                    continue;
+                }
+
+                if (errno != ENOBUFS) {
+                    LOGE("Failed to receive uevent (%s), polling online CPUs instead",
+                         strerror(errno));
+                    close(socketFd);
+                    socketFd = -1;
+                }
+
+                // On ENOBUFS we dropped events, just re-read the online CPUs
+            } else {
+                buffer[size] = '\0';
+                if (!isCpuHotplugUevent(buffer, size)) {
+                    continue;
+                }
+            }
+        } else if (socketFd >= 0) {
+            // Interrupted
+            continue;
+        }
+
+        changed = refresh();
+    }
+
+    if (socketFd >= 0) {
+        close(socketFd);
+    }
+
+    // Back to reading on demand, also if we bailed out on our own
+    mRunning.store(false, std::memory_order_release);
+}
@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "SysfsFile.h"
+
+/**
+ * Tracks the set of online CPUs from a background thread.
+ *
+ * The thread listens for CPU uevents on a NETLINK_KOBJECT_UEVENT socket, so it sleeps until a
+ * CPU actually goes online or offline. Where the socket can't be bound (e.g. blocked by the
+ * SELinux policy), /sys/devices/system/cpu/online is polled instead. The thread only runs while
+ * someone listens for changes, otherwise the online CPUs are re-read on demand.
+ *
+ * Caches derived from the topology should be keyed on getGeneration(), which changes only when
+ * the set of online CPUs does.
+ */
+class HotplugMonitor {
+public:
+    using Callback = std::function<void(const std::string &onlineCpus)>;
+
+    static constexpr std::chrono::milliseconds kPollInterval{500};
+
+    static HotplugMonitor &getInstance();
+
+    /**
+     * Set the function called from the monitoring thread after the set of online CPUs changed.
+     * Must be called before the first start().
+     */
+    void setCallback(Callback callback);
+
+    /**
+     * Start the monitoring thread if needed.
+     * Calls are reference counted, every start() must be paired with a stop().
+     */
+    void start();
+
+    void stop();
+
+    /**
+     * @return A counter incremented every time the set of online CPUs changes
+     */
+    uint64_t getGeneration();
+
+    /**
+     * @return The current online CPUs list, as in /sys/devices/system/cpu/online
+     */
+    std::string getOnlineCpus();
+
+private:
+    HotplugMonitor();
+
+    void run(int socketFd);
+
+    /**
+     * Re-read the online CPUs, unless the monitoring thread is already keeping them up to date.
+     */
+    void refreshIfUnmonitored();
+
+    /**
+     * Re-read the online CPUs.
+     *
+     * @return Whether they changed
+     */
+    bool refresh();
+
+    SysfsFile mOnlineFile;
+
+    std::mutex mMutex;
+    std::string mOnlineCpus;
+    std::atomic<uint64_t> mGeneration = 0;
+
+    Callback mCallback;
+
+    std::mutex mStateMutex;
+    uint32_t mUsers = 0;
+    std::thread mThread;
+    std::atomic<bool> mRunning = false;
+
+    /**
+     * eventfd waking the monitoring thread up when it has to stop.
+     */
+    int mStopFd = -1;
+};
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "CpuJniOnLoad"
+
+#include <android/log.h>
+#include <cpuinfo.h>
+#include <jni.h>
+#include "BenchmarkUtils.h"
+#include "CpuHotplugUtils.h"
+#include "CpuInfoUtils.h"
+#include "CpuJni.h"
+#include "CpufreqUtils.h"
+#include "CpuidleUtils.h"
+#include "LinuxCpuUtils.h"
+#include "PerfUtils.h"
+#include "TelemetryUtils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+extern "C"
+JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
+    if (vm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    CpuJni::registerClasses(env);
+
+    if (registerCpuInfoUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register CpuInfoUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerBenchmarkUtilsNatives(env, CPU_UTILS_PACKAGE "/BenchmarkUtils",
+                                      [] { return cpuinfo_initialize(); }) != JNI_OK) {
+        LOGE("Failed to register BenchmarkUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerCpuHotplugUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register CpuHotplugUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerCpufreqUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register CpufreqUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerCpuidleUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register CpuidleUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerLinuxCpuUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register LinuxCpuUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerPerfUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register PerfUtils natives");
+        return JNI_ERR;
+    }
+
+    if (registerTelemetryUtilsNatives(env) != JNI_OK) {
+        LOGE("Failed to register TelemetryUtils natives");
+        return JNI_ERR;
+    }
+
+    return JNI_VERSION_1_6;
+}
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include "LinuxCpuReader.h"
+
+static const char *const kFrequencyNodes[] = {
+        "cpufreq/cpuinfo_cur_freq",
+        "cpufreq/cpuinfo_min_freq",
+        "cpufreq/cpuinfo_max_freq",
+        "cpufreq/scaling_cur_freq",
+        "cpufreq/scaling_min_freq",
+        "cpufreq/scaling_max_freq",
+};
+
+static_assert(std::size(kFrequencyNodes) == LinuxCpuReader::FIELD_COUNT - LinuxCpuReader::CPUINFO_CURRENT_FREQ);
+
+LinuxCpuReader &LinuxCpuReader::getInstance() {
+    static LinuxCpuReader instance;
+    return instance;
+}
+
+LinuxCpuReader::LinuxCpuReader() : mOnlineFile(CPU_BASE_PATH "/online") {
+    uint32_t maxId = 0;
+    readCpuList(CPU_BASE_PATH "/possible", [&](uint32_t first, uint32_t last) {
+        for (auto id = first; id <= last; id++) {
+            auto &cpu = mCpus.emplace_back();
+            cpu.id = id;
+
+            auto basePath = std::string(CPU_BASE_PATH "/cpu") + std::to_string(id) + "/";
+            for (size_t i = 0; i < kFrequencyFieldCount; i++) {
+                cpu.frequencyFiles[i] = SysfsFile(basePath + kFrequencyNodes[i]);
+            }
+        }
+
+        maxId = std::max(maxId, last);
+    });
+
+    mOnline.resize(maxId + 1);
+}
+
+void LinuxCpuReader::reopenMissing() {
+    for (auto &cpu: mCpus) {
+        if (!mOnline[cpu.id]) {
+            continue;
+        }
+
+        for (auto &file: cpu.frequencyFiles) {
+            if (!file.isOpen()) {
+                file.reopen();
+            }
+        }
+    }
+}
+
+size_t LinuxCpuReader::read(int64_t *values, size_t capacity) {
+    static constexpr Field kAllFields[] = {
+            ID,
+            ONLINE,
+            CPUINFO_CURRENT_FREQ,
+            CPUINFO_MINIMUM_FREQ,
+            CPUINFO_MAXIMUM_FREQ,
+            SCALING_CURRENT_FREQ,
+            SCALING_MINIMUM_FREQ,
+            SCALING_MAXIMUM_FREQ,
+    };
+    static_assert(std::size(kAllFields) == FIELD_COUNT);
+
+    return read(kAllFields, FIELD_COUNT, values, capacity);
+}
+
+size_t LinuxCpuReader::read(const Field *fields, size_t fieldCount, int64_t *values,
+                            size_t capacity) {
+    std::lock_guard lock(mMutex);
+
+    if (capacity < mCpus.size() * fieldCount) {
+        return 0;
+    }
+
+    char buffer[sizeof(mOnlineCpus)];
+    auto size = mOnlineFile.read(buffer, sizeof(buffer));
+
+    auto onlineChanged = size != mOnlineCpusSize
+                         || (size > 0 && memcmp(buffer, mOnlineCpus.data(), size) != 0);
+    if (onlineChanged) {
+        std::fill(mOnline.begin(), mOnline.end(), 0);
+
+        if (size > 0) {
+            parseCpuList(buffer, buffer + size, [&](uint32_t first, uint32_t last) {
+                for (auto id = first; id <= last && id < mOnline.size(); id++) {
+                    mOnline[id] = 1;
+                }
+            });
+            memcpy(mOnlineCpus.data(), buffer, size);
+        }
+        mOnlineCpusSize = size;
+
+        reopenMissing();
+    }
+
+    for (auto &cpu: mCpus) {
+        for (size_t i = 0; i < fieldCount; i++) {
+            auto field = fields[i];
+
+            if (field == ID) {
+                *values++ = cpu.id;
+                continue;
+            }
+
+            if (field == ONLINE) {
+                *values++ = size > 0 ? mOnline[cpu.id] : kUnknown;
+                continue;
+            }
+
+            auto &file = cpu.frequencyFiles[field - CPUINFO_CURRENT_FREQ];
+
+            int64_t value;
+            if (file.readInt64(value)) {
+                *values++ = value;
+            } else {
+                // The node went away (e.g. the policy got offlined), it'll be reopened on the
+                // next online CPUs change
+                file.close();
+                *values++ = kUnknown;
+            }
+        }
+    }
+
+    return mCpus.size();
+}
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "SysfsFile.h"
+
+/**
+ * Batched reader of the per-CPU Linux state exposed in /sys/devices/system/cpu.
+ *
+ * Every node is opened once and refreshed with pread(). Nodes that can't be opened
+ * (missing cpufreq policy, root-only cpuinfo_cur_freq) are retried only when the set of online
+ * CPUs changes, so a steady state poll costs one syscall per available value.
+ *
+ * Must be kept in sync with LinuxCpuUtils.kt.
+ */
+class LinuxCpuReader {
+public:
+    enum Field : uint32_t {
+        ID = 0,
+        ONLINE,
+        CPUINFO_CURRENT_FREQ,
+        CPUINFO_MINIMUM_FREQ,
+        CPUINFO_MAXIMUM_FREQ,
+        SCALING_CURRENT_FREQ,
+        SCALING_MINIMUM_FREQ,
+        SCALING_MAXIMUM_FREQ,
+        FIELD_COUNT,
+    };
+
+    /**
+     * Value of a field that couldn't be read.
+     */
+    static constexpr int64_t kUnknown = -1;
+
+    static LinuxCpuReader &getInstance();
+
+    /**
+     * @return The number of possible CPUs
+     */
+    size_t getCpuCount() const { return mCpus.size(); }
+
+    /**
+     * Refresh every CPU, writing FIELD_COUNT values per CPU.
+     *
+     * @param values Output, must hold at least getCpuCount() * FIELD_COUNT values
+     * @return The number of CPUs written
+     */
+    size_t read(int64_t *values, size_t capacity);
+
+    /**
+     * Refresh only the given fields of every CPU, in the given order.
+     *
+     * @param values Output, must hold at least getCpuCount() * fieldCount values
+     * @return The number of CPUs written
+     */
+    size_t read(const Field *fields, size_t fieldCount, int64_t *values, size_t capacity);
+
+private:
+    static constexpr uint32_t kFrequencyFieldCount = FIELD_COUNT - CPUINFO_CURRENT_FREQ;
+
+    struct Cpu {
+        uint32_t id;
+        std::array<SysfsFile, kFrequencyFieldCount> frequencyFiles;
+    };
+
+    LinuxCpuReader();
+
+    void reopenMissing();
+
+    std::mutex mMutex;
+
+    std::vector<Cpu> mCpus;
+
+    SysfsFile mOnlineFile;
+    std::array<char, 256> mOnlineCpus{};
+    ssize_t mOnlineCpusSize = -1;
+
+    /**
+     * Online state indexed by Linux CPU ID, allocated once.
+     */
+    std::vector<uint8_t> mOnline;
+};
@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "LinuxCpuUtils"
+
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include <vector>
+#include "CpuInfoUtils.h"
+#include "CpuLoadSampler.h"
+#include "FrequencyBenchmark.h"
+#include "LinuxCpuReader.h"
+#include "LinuxCpuUtils.h"
+#include "PageInfo.h"
+#include "jni_utils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+/**
+ * Read the state of every possible CPU in one go.
+ *
+ * @return LinuxCpuReader::FIELD_COUNT values per CPU, see LinuxCpuReader::Field
+ */
+static jlongArray getCpuValues(JNIEnv *env, jobject thiz) {
+    auto &reader = LinuxCpuReader::getInstance();
+
+    std::vector<jlong> values(reader.getCpuCount() * LinuxCpuReader::FIELD_COUNT);
+
+    auto cpuCount = reader.read(reinterpret_cast<int64_t *>(values.data()), values.size());
+    if (cpuCount * LinuxCpuReader::FIELD_COUNT != values.size()) {
+        LOGE("Failed to read CPU values");
+        return nullptr;
+    }
+
+    return toJLongArray(env, values);
+}
+
+/**
+ * Take a new utilization sample and return the history of every possible CPU.
+ *
+ * @return CpuLoadSampler::kRecordSize values per CPU, see CpuLoadSampler::read()
+ */
+static jfloatArray getCpuLoadHistory(JNIEnv *env, jobject thiz) {
+    auto &sampler = CpuLoadSampler::getInstance();
+
+    sampler.sample();
+
+    std::vector<jfloat> values(sampler.getCpuCount() * CpuLoadSampler::kRecordSize);
+
+    auto cpuCount = sampler.read(values.data(), values.size());
+    if (cpuCount * CpuLoadSampler::kRecordSize != values.size()) {
+        LOGE("Failed to read CPU load history");
+        return nullptr;
+    }
+
+    return toJFloatArray(env, values);
+}
+
+/**
+ * Measure the effective frequency of a CPU, see measureEffectiveFrequency().
+ *
+ * @return The frequency in Hz, -1 if the CPU is offline or can't be measured
+ */
+static jlong getEffectiveFrequency(JNIEnv *env, jobject thiz, jint id) {
+    if (id < 0) {
+        return -1;
+    }
+
+    return measureEffectiveFrequency(static_cast<uint32_t>(id));
+}
+
+/**
+ * Get the page size and the transparent huge page configuration.
+ *
+ * @return [page size, THP mode, THP size, mTHP count, (mTHP size, mTHP mode)...],
+ *         see page_info::ThpMode
+ */
+static jlongArray getPageInfoValues(JNIEnv *env, jobject thiz) {
+    auto mthpSizes = page_info::getMthpSizes();
+
+    std::vector<jlong> values = {
+            static_cast<jlong>(page_info::getPageSize()),
+            page_info::getThpMode(),
+            static_cast<jlong>(page_info::getThpSize()),
+            static_cast<jlong>(mthpSizes.size()),
+    };
+    for (auto &mthpSize: mthpSizes) {
+        values.push_back(static_cast<jlong>(mthpSize.size));
+        values.push_back(mthpSize.mode);
+    }
+
+    return toJLongArray(env, values);
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"getCpuValues", "()[J", reinterpret_cast<void *>(getCpuValues)},
+        {"getCpuLoadHistory", "()[F", reinterpret_cast<void *>(getCpuLoadHistory)},
+        {"getEffectiveFrequency", "(I)J", reinterpret_cast<void *>(getEffectiveFrequency)},
+        {"getPageInfoValues", "()[J", reinterpret_cast<void *>(getPageInfoValues)},
+};
+
+jint registerLinuxCpuUtilsNatives(JNIEnv *env) {
+    return registerNatives(env, CPU_UTILS_PACKAGE "/LinuxCpuUtils", kMethods, std::size(kMethods));
+}
@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "PerfMonitor"
+
+#include <android/log.h>
+#include <cpuinfo.h>
+#include <cstring>
+#include <ctime>
+#include "HotplugMonitor.h"
+#include "PerfMonitor.h"
+
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+
+static int64_t getBoottimeNs() {
+    timespec time{};
+    clock_gettime(CLOCK_BOOTTIME, &time);
+    return time.tv_sec * 1000000000LL + time.tv_nsec;
+}
+
+PerfMonitor &PerfMonitor::getInstance() {
+    static PerfMonitor instance;
+    return instance;
+}
+
+PerfMonitor::PerfMonitor() {
+    if (!cpuinfo_initialize()) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+        auto processor = cpuinfo_get_processor(i);
+
+        mCpus.push_back({
+                .linuxId = static_cast<uint32_t>(processor->linux_id),
+                .vendor = processor->core->vendor,
+                .uarch = processor->core->uarch,
+                .counters = {},
+                .previousValues = {},
+        });
+    }
+}
+
+void PerfMonitor::reopen() {
+    mError = 0;
+
+    auto opened = false;
+    for (auto &cpu: mCpus) {
+        cpu.previousValues.fill(kUnknown);
+
+        auto result = cpu.counters.open(-1, static_cast<int>(cpu.linuxId), cpu.vendor,
+                                         cpu.uarch);
+        if (result == 0) {
+            opened = true;
+        } else if (mError == 0) {
+            mError = -result;
+        }
+    }
+
+    if (opened) {
+        mError = 0;
+    } else {
+        LOGI("Performance counters not available: %s", strerror(mError));
+    }
+
+    mPreviousNs = 0;
+}
+
+size_t PerfMonitor::read(int64_t *values, size_t capacity) {
+    std::lock_guard lock(mMutex);
+
+    if (capacity < getOutputSize()) {
+        return 0;
+    }
+
+    auto generation = HotplugMonitor::getInstance().getGeneration();
+    if (generation != mGeneration) {
+        reopen();
+        mGeneration = generation;
+    }
+
+    auto nowNs = getBoottimeNs();
+
+    values[0] = static_cast<int64_t>(mCpus.size());
+    values[1] = mPreviousNs != 0 ? nowNs - mPreviousNs : 0;
+    values[2] = mError;
+    values[3] = PerfCounters::getParanoidLevel();
+
+    auto output = values + kHeaderSize;
+    for (auto &cpu: mCpus) {
+        output[0] = cpu.linuxId;
+
+        std::array<int64_t, PerfCounters::EVENT_COUNT> currentValues{};
+        cpu.counters.read(currentValues);
+
+        for (uint32_t event = 0; event < PerfCounters::EVENT_COUNT; event++) {
+            auto current = currentValues[event];
+            auto previous = cpu.previousValues[event];
+
+            output[1 + event] = current != kUnknown && previous != kUnknown && current >= previous
+                                ? current - previous : kUnknown;
+        }
+
+        cpu.previousValues = currentValues;
+        output += kRecordSize;
+    }
+
+    mPreviousNs = nowNs;
+
+    return getOutputSize();
+}
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "PerfCounters.h"
+
+/**
+ * System wide hardware counters of every processor, opened once and reopened when the set of
+ * online CPUs changes.
+ *
+ * Counting other processes requires perf_event_paranoid to be 0 or lower (or root), on stock
+ * Android it's 3 so this usually only reports why it isn't available.
+ *
+ * Output layout, must be kept in sync with PerfUtils.kt:
+ * - Header: processor count, ns since the previous read (0 on the first one), errno of the
+ *   first failure if nothing could be opened (0 otherwise), perf_event_paranoid
+ * - For each processor: Linux ID, then the counts of each PerfCounters::Event since the
+ *   previous read, kUnknown if not available
+ */
+class PerfMonitor {
+public:
+    static constexpr int64_t kUnknown = PerfCounters::kUnknown;
+
+    static constexpr size_t kHeaderSize = 4;
+    static constexpr size_t kRecordSize = 1 + PerfCounters::EVENT_COUNT;
+
+    static PerfMonitor &getInstance();
+
+    /**
+     * @return The number of values read() will write
+     */
+    size_t getOutputSize() const { return kHeaderSize + mCpus.size() * kRecordSize; }
+
+    /**
+     * Read the counters of every processor, see the class documentation for the layout.
+     *
+     * @return The number of values written, 0 on error
+     */
+    size_t read(int64_t *values, size_t capacity);
+
+private:
+    struct Cpu {
+        uint32_t linuxId;
+        cpuinfo_vendor vendor;
+        cpuinfo_uarch uarch;
+        PerfCounters counters;
+        std::array<int64_t, PerfCounters::EVENT_COUNT> previousValues;
+    };
+
+    PerfMonitor();
+
+    void reopen();
+
+    std::mutex mMutex;
+
+    std::vector<Cpu> mCpus;
+    uint64_t mGeneration = UINT64_MAX;
+    int mError = 0;
+    int64_t mPreviousNs = 0;
+};
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "PerfUtils"
+
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include <vector>
+#include "CpuInfoUtils.h"
+#include "PerfMonitor.h"
+#include "PerfUtils.h"
+#include "jni_utils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+/**
+ * Get the hardware counters of every processor since the previous call.
+ *
+ * @return See PerfMonitor for the layout
+ */
+static jlongArray getPerfCounters(JNIEnv *env, jobject thiz) {
+    auto &monitor = PerfMonitor::getInstance();
+
+    std::vector<jlong> values(monitor.getOutputSize());
+
+    auto written = monitor.read(reinterpret_cast<int64_t *>(values.data()), values.size());
+    if (written != values.size()) {
+        LOGE("Failed to read performance counters");
+        return nullptr;
+    }
+
+    return toJLongArray(env, values);
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"getPerfCounters", "()[J", reinterpret_cast<void *>(getPerfCounters)},
+};
+
+jint registerPerfUtilsNatives(JNIEnv *env) {
+    return registerNatives(env, CPU_UTILS_PACKAGE "/PerfUtils", kMethods, std::size(kMethods));
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * Lock-free single-producer/single-consumer ring of fixed-size records.
+ *
+ * The producer never blocks: when the ring is full the record is dropped and counted as an
+ * overrun. Head and tail are free-running counters, the slot is the counter modulo the capacity.
+ */
+class SpscRingBuffer {
+public:
+    /**
+     * @param recordSize Size of a record in bytes
+     * @param capacity Number of records, rounded up to a power of two
+     */
+    SpscRingBuffer(size_t recordSize, size_t capacity)
+            : mRecordSize(recordSize), mCapacity(roundUpToPowerOfTwo(capacity)),
+              mStorage(mRecordSize * mCapacity) {}
+
+    size_t getRecordSize() const { return mRecordSize; }
+
+    size_t getCapacity() const { return mCapacity; }
+
+    uint64_t getOverruns() const { return mOverruns.load(std::memory_order_relaxed); }
+
+    // Producer
+
+    /**
+     * Get the slot to write the next record into.
+     *
+     * @return The slot, nullptr if the ring is full, in which case the overrun is counted
+     */
+    uint8_t *beginWrite() {
+        auto head = mHead.load(std::memory_order_relaxed);
+
+        if (head - mTail.load(std::memory_order_acquire) >= mCapacity) {
+            mOverruns.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        return &mStorage[(head & (mCapacity - 1)) * mRecordSize];
+    }
+
+    /**
+     * Publish the record written in the slot returned by beginWrite().
+     */
+    void endWrite() {
+        mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer
+
+    /**
+     * Copy out and release up to maxRecords records, oldest first.
+     *
+     * @return The number of records copied
+     */
+    size_t drain(uint8_t *output, size_t maxRecords) {
+        auto tail = mTail.load(std::memory_order_relaxed);
+        auto available = mHead.load(std::memory_order_acquire) - tail;
+
+        auto count = static_cast<size_t>(std::min<uint64_t>(available, maxRecords));
+
+        auto first = static_cast<size_t>(tail & (mCapacity - 1));
+        auto firstCount = std::min(count, mCapacity - first);
+
+        memcpy(output, &mStorage[first * mRecordSize], firstCount * mRecordSize);
+        memcpy(output + firstCount * mRecordSize, mStorage.data(),
+               (count - firstCount) * mRecordSize);
+
+        mTail.store(tail + count, std::memory_order_release);
+
+        return count;
+    }
+
+    /**
+     * Drop every pending record. Must only be called by the consumer.
+     */
+    void clear() {
+        mTail.store(mHead.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t mRecordSize;
+    const size_t mCapacity;
+    std::vector<uint8_t> mStorage;
+
+    // Keep the producer and consumer indexes on different cache lines
+    alignas(64) std::atomic<uint64_t> mHead{0};
+    alignas(64) std::atomic<uint64_t> mTail{0};
+    alignas(64) std::atomic<uint64_t> mOverruns{0};
+};
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+#include "SysfsFile.h"
+
+SysfsFile::SysfsFile(std::string path) : mPath(std::move(path)) {
+    reopen();
+}
+
+SysfsFile::~SysfsFile() {
+    close();
+}
+
+SysfsFile::SysfsFile(SysfsFile &&other) noexcept
+        : mPath(std::move(other.mPath)), mFd(std::exchange(other.mFd, -1)) {}
+
+SysfsFile &SysfsFile::operator=(SysfsFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        mPath = std::move(other.mPath);
+        mFd = std::exchange(other.mFd, -1);
+    }
+
+    return *this;
+}
+
+bool SysfsFile::reopen() {
+    close();
+
+    if (mPath.empty()) {
+        return false;
+    }
+
+    mFd = open(mPath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    return mFd >= 0;
+}
+
+void SysfsFile::close() {
+    if (mFd >= 0) {
+        ::close(mFd);
+        mFd = -1;
+    }
+}
+
+ssize_t SysfsFile::read(char *buffer, size_t size) const {
+    if (mFd < 0) {
+        return -1;
+    }
+
+    ssize_t result;
+    do {
+        result = pread(mFd, buffer, size, 0);
+    } while (result < 0 && errno == EINTR);
+
+    return result;
+}
+
+bool SysfsFile::readInt64(int64_t &value) const {
+    char buffer[32];
+
+    auto size = read(buffer, sizeof(buffer));
+    if (size <= 0) {
+        return false;
+    }
+
+    return parseInt64(buffer, buffer + size, value);
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <utility>
+
+#define CPU_BASE_PATH "/sys/devices/system/cpu"
+
+/**
+ * A sysfs (or procfs) node kept open across reads.
+ * sysfs regenerates the content of an attribute on every read at offset 0, so refreshing it only
+ * costs a pread() instead of an open()/read()/close() round trip.
+ */
+class SysfsFile {
+public:
+    SysfsFile() = default;
+    explicit SysfsFile(std::string path);
+    ~SysfsFile();
+
+    SysfsFile(const SysfsFile &) = delete;
+    SysfsFile &operator=(const SysfsFile &) = delete;
+
+    SysfsFile(SysfsFile &&other) noexcept;
+    SysfsFile &operator=(SysfsFile &&other) noexcept;
+
+    bool isOpen() const { return mFd >= 0; }
+
+    /**
+     * (Re)open the node, e.g. after the attribute went away because its CPU got offlined.
+     */
+    bool reopen();
+
+    void close();
+
+    /**
+     * Read the node content from the start.
+     *
+     * @return The number of bytes read, -1 on error
+     */
+    ssize_t read(char *buffer, size_t size) const;
+
+    /**
+     * Read a single integer value.
+     */
+    bool readInt64(int64_t &value) const;
+
+private:
+    std::string mPath;
+    int mFd = -1;
+};
+
+/**
+ * Parse a decimal integer, leading and trailing whitespace is ignored.
+ */
+inline bool parseInt64(const char *begin, const char *end, int64_t &value) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) {
+        begin++;
+    }
+    while (end > begin && (end[-1] == '\n' || end[-1] == ' ' || end[-1] == '\t')) {
+        end--;
+    }
+
+    bool negative = begin < end && *begin == '-';
+    if (negative) {
+        begin++;
+    }
+
+    if (begin == end) {
+        return false;
+    }
+
+    uint64_t result = 0;
+    for (; begin < end; begin++) {
+        if (*begin < '0' || *begin > '9') {
+            return false;
+        }
+        result = result * 10 + (*begin - '0');
+    }
+
+    value = negative ? -static_cast<int64_t>(result) : static_cast<int64_t>(result);
+
+    return true;
+}
+
+/**
+ * Parse a kernel CPU list (e.g. "0-3,6"), calling callback(first, last) for each range.
+ */
+template<typename Callback>
+bool parseCpuList(const char *begin, const char *end, Callback &&callback) {
+    while (end > begin && (end[-1] == '\n' || end[-1] == ' ')) {
+        end--;
+    }
+
+    while (begin < end) {
+        auto rangeEnd = begin;
+        while (rangeEnd < end && *rangeEnd != ',') {
+            rangeEnd++;
+        }
+
+        auto separator = begin;
+        while (separator < rangeEnd && *separator != '-') {
+            separator++;
+        }
+
+        int64_t first;
+        int64_t last;
+        if (!parseInt64(begin, separator, first)) {
+            return false;
+        }
+        if (separator == rangeEnd) {
+            last = first;
+        } else if (!parseInt64(separator + 1, rangeEnd, last)) {
+            return false;
+        }
+
+        if (first < 0 || last < first) {
+            return false;
+        }
+
+        callback(static_cast<uint32_t>(first), static_cast<uint32_t>(last));
+
+        begin = rangeEnd < end ? rangeEnd + 1 : end;
+    }
+
+    return true;
+}
+
+/**
+ * Read and parse a kernel CPU list node, see parseCpuList().
+ */
+template<typename Callback>
+bool readCpuList(const char *path, Callback &&callback) {
+    char buffer[256];
+
+    auto size = SysfsFile(path).read(buffer, sizeof(buffer));
+    if (size <= 0) {
+        return false;
+    }
+
+    return parseCpuList(buffer, buffer + size, std::forward<Callback>(callback));
+}
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <pthread.h>
+#include <time.h>
+#include "LinuxCpuReader.h"
+#include "TelemetrySampler.h"
+
+static constexpr int64_t kNsPerSecond = 1000000000;
+
+static constexpr LinuxCpuReader::Field kFields[] = {
+        LinuxCpuReader::ONLINE,
+        LinuxCpuReader::SCALING_CURRENT_FREQ,
+};
+
+static int64_t toNs(const timespec &time) {
+    return time.tv_sec * kNsPerSecond + time.tv_nsec;
+}
+
+static int64_t nowNs(clockid_t clock) {
+    timespec time{};
+    clock_gettime(clock, &time);
+    return toNs(time);
+}
+
+TelemetrySampler &TelemetrySampler::getInstance() {
+    static TelemetrySampler instance;
+    return instance;
+}
+
+TelemetrySampler::TelemetrySampler()
+        : mRing(sizeof(int64_t)
+                + LinuxCpuReader::getInstance().getCpuCount() * sizeof(CpuSample),
+                kRingCapacity) {
+    auto &reader = LinuxCpuReader::getInstance();
+
+    static constexpr LinuxCpuReader::Field kIdField[] = {LinuxCpuReader::ID};
+
+    std::vector<int64_t> ids(reader.getCpuCount());
+    reader.read(kIdField, std::size(kIdField), ids.data(), ids.size());
+    mCpuIds.assign(ids.begin(), ids.end());
+
+    mValues.resize(reader.getCpuCount() * std::size(kFields));
+    mBusy.resize(mLoadSampler.getCpuCount());
+}
+
+void TelemetrySampler::start(uint32_t rateHz) {
+    std::lock_guard lock(mStateMutex);
+
+    mRateHz.store(std::clamp(rateHz, kMinRateHz, kMaxRateHz), std::memory_order_relaxed);
+
+    if (mUsers++ > 0) {
+        return;
+    }
+
+    {
+        // Don't hand out records from a previous session
+        std::lock_guard drainLock(mDrainMutex);
+        mRing.clear();
+    }
+
+    mRunning.store(true, std::memory_order_release);
+    mThread = std::thread(&TelemetrySampler::run, this);
+}
+
+void TelemetrySampler::stop() {
+    std::lock_guard lock(mStateMutex);
+
+    if (mUsers == 0 || --mUsers > 0) {
+        return;
+    }
+
+    mRunning.store(false, std::memory_order_release);
+    mThread.join();
+}
+
+size_t TelemetrySampler::drain(uint8_t *output, size_t size) {
+    std::lock_guard lock(mDrainMutex);
+
+    return mRing.drain(output, size / mRing.getRecordSize());
+}
+
+void TelemetrySampler::run() {
+    pthread_setname_np(pthread_self(), "AthenaTelemetry");
+
+    auto deadlineNs = nowNs(CLOCK_MONOTONIC);
+
+    while (mRunning.load(std::memory_order_acquire)) {
+        sample();
+
+        deadlineNs += kNsPerSecond / mRateHz.load(std::memory_order_relaxed);
+
+        // Don't try to catch up after a stall, just skip the missed periods
+        deadlineNs = std::max(deadlineNs, nowNs(CLOCK_MONOTONIC));
+
+        timespec deadline = {
+                .tv_sec = static_cast<time_t>(deadlineNs / kNsPerSecond),
+                .tv_nsec = static_cast<long>(deadlineNs % kNsPerSecond),
+        };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR);
+    }
+}
+
+void TelemetrySampler::sample() {
+    auto timestampNs = nowNs(CLOCK_BOOTTIME);
+
+    mLoadSampler.sample();
+    auto busyCount = mLoadSampler.readBusy(mBusy.data(), mBusy.size());
+
+    auto cpuCount = LinuxCpuReader::getInstance().read(
+            kFields, std::size(kFields), mValues.data(), mValues.size());
+
+    auto record = mRing.beginWrite();
+    if (record == nullptr) {
+        return;
+    }
+
+    memcpy(record, &timestampNs, sizeof(timestampNs));
+
+    auto cpuSamples = reinterpret_cast<CpuSample *>(record + sizeof(timestampNs));
+    for (size_t i = 0; i < mCpuIds.size(); i++) {
+        auto values = &mValues[i * std::size(kFields)];
+
+        cpuSamples[i] = {
+                .frequencyKhz = i < cpuCount ? static_cast<int32_t>(values[1]) : -1,
+                .online = i < cpuCount ? static_cast<int32_t>(values[0]) : -1,
+                .busy = i < busyCount ? mBusy[i] : NAN,
+        };
+    }
+
+    mRing.endWrite();
+}
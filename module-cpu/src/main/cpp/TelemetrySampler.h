@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CpuLoadSampler.h"
+#include "SpscRingBuffer.h"
+
+/**
+ * Background sampler of the per-CPU frequency, load and online state.
+ *
+ * A dedicated thread samples at a fixed rate and writes records into a lock-free SPSC ring,
+ * consumers drain it in bulk. The sampling thread never waits on a consumer, records that don't
+ * fit are counted as overruns.
+ *
+ * Record layout (native byte order): int64 CLOCK_BOOTTIME timestamp in ns, followed by a
+ * CpuSample for each possible CPU, ordered like getCpuIds().
+ *
+ * Must be kept in sync with TelemetryUtils.kt.
+ */
+class TelemetrySampler {
+public:
+    struct CpuSample {
+        /**
+         * scaling_cur_freq, in kHz, -1 if unknown.
+         */
+        int32_t frequencyKhz;
+
+        /**
+         * 1 if online, 0 if offline, -1 if unknown.
+         */
+        int32_t online;
+
+        /**
+         * Busy share of the latest /proc/stat sample, from 0 to 1, NaN if unknown.
+         */
+        float busy;
+    };
+
+    static constexpr uint32_t kMinRateHz = 1;
+    static constexpr uint32_t kMaxRateHz = 1000;
+
+    /**
+     * Records kept in the ring, about 4 seconds at the maximum rate.
+     */
+    static constexpr size_t kRingCapacity = 4096;
+
+    static TelemetrySampler &getInstance();
+
+    const std::vector<uint32_t> &getCpuIds() const { return mCpuIds; }
+
+    size_t getRecordSize() const { return mRing.getRecordSize(); }
+
+    /**
+     * Start sampling, or update the rate if already started.
+     * Calls are reference counted, every start() must be paired with a stop().
+     */
+    void start(uint32_t rateHz);
+
+    void stop();
+
+    /**
+     * Move pending records to output, oldest first.
+     *
+     * @param size Size of output in bytes
+     * @return The number of records written
+     */
+    size_t drain(uint8_t *output, size_t size);
+
+private:
+    TelemetrySampler();
+
+    void run();
+
+    void sample();
+
+    std::vector<uint32_t> mCpuIds;
+
+    SpscRingBuffer mRing;
+
+    // Owned by the sampling thread
+    std::vector<int64_t> mValues;
+    CpuLoadSampler mLoadSampler;
+    std::vector<float> mBusy;
+
+    std::mutex mStateMutex;
+    uint32_t mUsers = 0;
+    std::thread mThread;
+    std::atomic<bool> mRunning = false;
+    std::atomic<uint32_t> mRateHz = kMinRateHz;
+
+    /**
+     * Serializes consumers, the ring only supports one.
+     */
+    std::mutex mDrainMutex;
+};
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "TelemetryUtils"
+
+#include <algorithm>
+#include <android/log.h>
+#include <iterator>
+#include <jni.h>
+#include <vector>
+#include "CpuInfoUtils.h"
+#include "TelemetrySampler.h"
+#include "TelemetryUtils.h"
+#include "jni_utils.h"
+
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+static void startTelemetry(JNIEnv *env, jobject thiz, jint rateHz) {
+    TelemetrySampler::getInstance().start(static_cast<uint32_t>(std::max(rateHz, 0)));
+}
+
+static void stopTelemetry(JNIEnv *env, jobject thiz) {
+    TelemetrySampler::getInstance().stop();
+}
+
+static jintArray getTelemetryCpuIds(JNIEnv *env, jobject thiz) {
+    auto &cpuIds = TelemetrySampler::getInstance().getCpuIds();
+
+    auto array = env->NewIntArray(static_cast<jsize>(cpuIds.size()));
+    if (array == nullptr) {
+        return nullptr;
+    }
+
+    std::vector<jint> values(cpuIds.begin(), cpuIds.end());
+    env->SetIntArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+
+    return array;
+}
+
+static jint getTelemetryRecordSize(JNIEnv *env, jobject thiz) {
+    return static_cast<jint>(TelemetrySampler::getInstance().getRecordSize());
+}
+
+/**
+ * Move pending telemetry records into a direct ByteBuffer.
+ *
+ * @return The number of records written, -1 on error
+ */
+static jint drainTelemetry(JNIEnv *env, jobject thiz, jobject buffer) {
+    auto address = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+    if (address == nullptr) {
+        LOGE("Buffer isn't a direct buffer");
+        return -1;
+    }
+
+    auto capacity = env->GetDirectBufferCapacity(buffer);
+
+    return static_cast<jint>(TelemetrySampler::getInstance().drain(
+            address, static_cast<size_t>(capacity)));
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"startTelemetry", "(I)V", reinterpret_cast<void *>(startTelemetry)},
+        {"stopTelemetry", "()V", reinterpret_cast<void *>(stopTelemetry)},
+        {"getTelemetryCpuIds", "()[I", reinterpret_cast<void *>(getTelemetryCpuIds)},
+        {"getTelemetryRecordSize", "()I", reinterpret_cast<void *>(getTelemetryRecordSize)},
+        {"drainTelemetry", "(Ljava/nio/ByteBuffer;)I", reinterpret_cast<void *>(drainTelemetry)},
+};
+
+jint registerTelemetryUtilsNatives(JNIEnv *env) {
+    return registerNatives(env, CPU_UTILS_PACKAGE "/TelemetryUtils", kMethods, std::size(kMethods));
+}
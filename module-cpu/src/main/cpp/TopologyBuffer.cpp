@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "TopologyBuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <cpuinfo.h>
+#include <cstring>
+#include "SysfsFile.h"
+
+#define U32 sizeof(uint32_t)
+#define U64 sizeof(uint64_t)
+
+namespace {
+
+enum ProcessorColumn : uint32_t {
+    PROCESSOR_SMT_ID = 0,
+    PROCESSOR_CORE,
+    PROCESSOR_CLUSTER,
+    PROCESSOR_PACKAGE,
+    PROCESSOR_LINUX_ID,
+    PROCESSOR_APIC_ID,
+    PROCESSOR_L1I,
+    PROCESSOR_L1D,
+    PROCESSOR_L2,
+    PROCESSOR_L3,
+    PROCESSOR_L4,
+    PROCESSOR_ONLINE,
+};
+
+enum CoreColumn : uint32_t {
+    CORE_PROCESSOR_START = 0,
+    CORE_PROCESSOR_COUNT,
+    CORE_CORE_ID,
+    CORE_CLUSTER,
+    CORE_PACKAGE,
+    CORE_VENDOR,
+    CORE_UARCH,
+    CORE_CPUID,
+    CORE_MIDR,
+    CORE_FREQUENCY,
+};
+
+enum ClusterColumn : uint32_t {
+    CLUSTER_PROCESSOR_START = 0,
+    CLUSTER_PROCESSOR_COUNT,
+    CLUSTER_CORE_START,
+    CLUSTER_CORE_COUNT,
+    CLUSTER_CLUSTER_ID,
+    CLUSTER_PACKAGE,
+    CLUSTER_VENDOR,
+    CLUSTER_UARCH,
+    CLUSTER_CPUID,
+    CLUSTER_MIDR,
+    CLUSTER_FREQUENCY,
+};
+
+enum PackageColumn : uint32_t {
+    PACKAGE_NAME = 0,
+    PACKAGE_PROCESSOR_START,
+    PACKAGE_PROCESSOR_COUNT,
+    PACKAGE_CORE_START,
+    PACKAGE_CORE_COUNT,
+    PACKAGE_CLUSTER_START,
+    PACKAGE_CLUSTER_COUNT,
+};
+
+enum UarchColumn : uint32_t {
+    UARCH_UARCH = 0,
+    UARCH_CPUID,
+    UARCH_MIDR,
+    UARCH_PROCESSOR_COUNT,
+    UARCH_CORE_COUNT,
+};
+
+enum CacheColumn : uint32_t {
+    CACHE_SIZE = 0,
+    CACHE_ASSOCIATIVITY,
+    CACHE_SETS,
+    CACHE_PARTITIONS,
+    CACHE_LINE_SIZE,
+    CACHE_FLAGS,
+    CACHE_PROCESSOR_START,
+    CACHE_PROCESSOR_COUNT,
+};
+
+const std::vector<size_t> kCacheColumnWidths = {U32, U32, U32, U32, U32, U32, U32, U32};
+
+const std::array<std::vector<size_t>, TopologyBuffer::TABLE_COUNT> kColumnWidths = {
+        // Processors
+        std::vector<size_t>{U32, U32, U32, U32, U32, U32, U32, U32, U32, U32, U32, U32},
+        // Cores
+        std::vector<size_t>{U32, U32, U32, U32, U32, U32, U32, U32, U32, U64},
+        // Clusters
+        std::vector<size_t>{U32, U32, U32, U32, U32, U32, U32, U32, U32, U32, U64},
+        // Packages
+        std::vector<size_t>{CPUINFO_PACKAGE_NAME_MAX, U32, U32, U32, U32, U32, U32},
+        // Uarchs
+        std::vector<size_t>{U32, U32, U32, U32, U32},
+        // Caches
+        kCacheColumnWidths,
+        kCacheColumnWidths,
+        kCacheColumnWidths,
+        kCacheColumnWidths,
+        kCacheColumnWidths,
+};
+
+constexpr size_t align8(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+class Writer {
+public:
+    explicit Writer(const std::array<uint32_t, TopologyBuffer::TABLE_COUNT> &rowCounts) {
+        size_t headerFields = 4;
+        for (const auto &columnWidths: kColumnWidths) {
+            headerFields += 2 + columnWidths.size() * 2;
+        }
+
+        size_t offset = align8(headerFields * U32);
+        for (uint32_t table = 0; table < TopologyBuffer::TABLE_COUNT; table++) {
+            for (auto width: kColumnWidths[table]) {
+                mColumnOffsets[table].push_back(offset);
+                offset = align8(offset + width * rowCounts[table]);
+            }
+        }
+
+        mData.resize(offset, 0);
+
+        size_t headerOffset = 0;
+        putHeader(headerOffset, TopologyBuffer::kMagic);
+        putHeader(headerOffset, TopologyBuffer::kVersion);
+        putHeader(headerOffset, static_cast<uint32_t>(mData.size()));
+        putHeader(headerOffset, TopologyBuffer::TABLE_COUNT);
+        for (uint32_t table = 0; table < TopologyBuffer::TABLE_COUNT; table++) {
+            putHeader(headerOffset, rowCounts[table]);
+            putHeader(headerOffset, static_cast<uint32_t>(mColumnOffsets[table].size()));
+            for (auto columnOffset: mColumnOffsets[table]) {
+                putHeader(headerOffset, static_cast<uint32_t>(columnOffset));
+            }
+            for (auto width: kColumnWidths[table]) {
+                putHeader(headerOffset, static_cast<uint32_t>(width));
+            }
+        }
+    }
+
+    void put(uint32_t table, uint32_t column, uint32_t row, uint32_t value) {
+        putBytes(table, column, row, &value, U32);
+    }
+
+    void put(uint32_t table, uint32_t column, uint32_t row, uint64_t value) {
+        putBytes(table, column, row, &value, U64);
+    }
+
+    void putBytes(uint32_t table, uint32_t column, uint32_t row, const void *value, size_t size) {
+        auto width = kColumnWidths[table][column];
+        memcpy(&mData[mColumnOffsets[table][column] + row * width], value,
+               size < width ? size : width);
+    }
+
+    std::vector<uint8_t> finish() {
+        return std::move(mData);
+    }
+
+private:
+    void putHeader(size_t &offset, uint32_t value) {
+        memcpy(&mData[offset], &value, U32);
+        offset += U32;
+    }
+
+    std::array<std::vector<size_t>, TopologyBuffer::TABLE_COUNT> mColumnOffsets;
+    std::vector<uint8_t> mData;
+};
+
+template<typename T>
+uint32_t indexOf(const T *element, const T *base) {
+    if (element == nullptr || base == nullptr) {
+        return TopologyBuffer::kNoIndex;
+    }
+
+    return static_cast<uint32_t>(element - base);
+}
+
+void putCaches(Writer &writer, uint32_t table, const struct cpuinfo_cache *caches,
+               uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        auto cache = &caches[i];
+
+        writer.put(table, CACHE_SIZE, i, cache->size);
+        writer.put(table, CACHE_ASSOCIATIVITY, i, cache->associativity);
+        writer.put(table, CACHE_SETS, i, cache->sets);
+        writer.put(table, CACHE_PARTITIONS, i, cache->partitions);
+        writer.put(table, CACHE_LINE_SIZE, i, cache->line_size);
+        writer.put(table, CACHE_FLAGS, i, cache->flags);
+        writer.put(table, CACHE_PROCESSOR_START, i, cache->processor_start);
+        writer.put(table, CACHE_PROCESSOR_COUNT, i, cache->processor_count);
+    }
+}
+
+} // namespace
+
+std::vector<uint8_t> TopologyBuffer::build(const std::string &onlineCpus) {
+    auto processors = cpuinfo_get_processors();
+    auto cores = cpuinfo_get_cores();
+    auto clusters = cpuinfo_get_clusters();
+    auto packages = cpuinfo_get_packages();
+    auto uarchs = cpuinfo_get_uarchs();
+    auto l1iCaches = cpuinfo_get_l1i_caches();
+    auto l1dCaches = cpuinfo_get_l1d_caches();
+    auto l2Caches = cpuinfo_get_l2_caches();
+    auto l3Caches = cpuinfo_get_l3_caches();
+    auto l4Caches = cpuinfo_get_l4_caches();
+
+    const std::array<uint32_t, TABLE_COUNT> rowCounts = {
+            cpuinfo_get_processors_count(),
+            cpuinfo_get_cores_count(),
+            cpuinfo_get_clusters_count(),
+            cpuinfo_get_packages_count(),
+            cpuinfo_get_uarchs_count(),
+            cpuinfo_get_l1i_caches_count(),
+            cpuinfo_get_l1d_caches_count(),
+            cpuinfo_get_l2_caches_count(),
+            cpuinfo_get_l3_caches_count(),
+            cpuinfo_get_l4_caches_count(),
+    };
+
+    std::vector<bool> online;
+    parseCpuList(onlineCpus.data(), onlineCpus.data() + onlineCpus.size(),
+                 [&](uint32_t first, uint32_t last) {
+                     if (online.size() <= last) {
+                         online.resize(last + 1);
+                     }
+                     std::fill(online.begin() + first, online.begin() + last + 1, true);
+                 });
+
+    Writer writer(rowCounts);
+
+    for (uint32_t i = 0; i < rowCounts[PROCESSORS]; i++) {
+        auto processor = &processors[i];
+
+        writer.put(PROCESSORS, PROCESSOR_SMT_ID, i, processor->smt_id);
+        writer.put(PROCESSORS, PROCESSOR_CORE, i, indexOf(processor->core, cores));
+        writer.put(PROCESSORS, PROCESSOR_CLUSTER, i, indexOf(processor->cluster, clusters));
+        writer.put(PROCESSORS, PROCESSOR_PACKAGE, i, indexOf(processor->package, packages));
+        writer.put(PROCESSORS, PROCESSOR_LINUX_ID, i, static_cast<uint32_t>(processor->linux_id));
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+        writer.put(PROCESSORS, PROCESSOR_APIC_ID, i, processor->apic_id);
+#endif
+        writer.put(PROCESSORS, PROCESSOR_L1I, i, indexOf(processor->cache.l1i, l1iCaches));
+        writer.put(PROCESSORS, PROCESSOR_L1D, i, indexOf(processor->cache.l1d, l1dCaches));
+        writer.put(PROCESSORS, PROCESSOR_L2, i, indexOf(processor->cache.l2, l2Caches));
+        writer.put(PROCESSORS, PROCESSOR_L3, i, indexOf(processor->cache.l3, l3Caches));
+        writer.put(PROCESSORS, PROCESSOR_L4, i, indexOf(processor->cache.l4, l4Caches));
+
+        auto linuxId = static_cast<uint32_t>(processor->linux_id);
+        writer.put(PROCESSORS, PROCESSOR_ONLINE, i,
+                   static_cast<uint32_t>(linuxId < online.size() && online[linuxId]));
+    }
+
+    for (uint32_t i = 0; i < rowCounts[CORES]; i++) {
+        auto core = &cores[i];
+
+        writer.put(CORES, CORE_PROCESSOR_START, i, core->processor_start);
+        writer.put(CORES, CORE_PROCESSOR_COUNT, i, core->processor_count);
+        writer.put(CORES, CORE_CORE_ID, i, core->core_id);
+        writer.put(CORES, CORE_CLUSTER, i, indexOf(core->cluster, clusters));
+        writer.put(CORES, CORE_PACKAGE, i, indexOf(core->package, packages));
+        writer.put(CORES, CORE_VENDOR, i, static_cast<uint32_t>(core->vendor));
+        writer.put(CORES, CORE_UARCH, i, static_cast<uint32_t>(core->uarch));
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+        writer.put(CORES, CORE_CPUID, i, core->cpuid);
+#endif
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+        writer.put(CORES, CORE_MIDR, i, core->midr);
+#endif
+        writer.put(CORES, CORE_FREQUENCY, i, static_cast<uint64_t>(core->frequency));
+    }
+
+    for (uint32_t i = 0; i < rowCounts[CLUSTERS]; i++) {
+        auto cluster = &clusters[i];
+
+        writer.put(CLUSTERS, CLUSTER_PROCESSOR_START, i, cluster->processor_start);
+        writer.put(CLUSTERS, CLUSTER_PROCESSOR_COUNT, i, cluster->processor_count);
+        writer.put(CLUSTERS, CLUSTER_CORE_START, i, cluster->core_start);
+        writer.put(CLUSTERS, CLUSTER_CORE_COUNT, i, cluster->core_count);
+        writer.put(CLUSTERS, CLUSTER_CLUSTER_ID, i, cluster->cluster_id);
+        writer.put(CLUSTERS, CLUSTER_PACKAGE, i, indexOf(cluster->package, packages));
+        writer.put(CLUSTERS, CLUSTER_VENDOR, i, static_cast<uint32_t>(cluster->vendor));
+        writer.put(CLUSTERS, CLUSTER_UARCH, i, static_cast<uint32_t>(cluster->uarch));
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+        writer.put(CLUSTERS, CLUSTER_CPUID, i, cluster->cpuid);
+#endif
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+        writer.put(CLUSTERS, CLUSTER_MIDR, i, cluster->midr);
+#endif
+        writer.put(CLUSTERS, CLUSTER_FREQUENCY, i, static_cast<uint64_t>(cluster->frequency));
+    }
+
+    for (uint32_t i = 0; i < rowCounts[PACKAGES]; i++) {
+        auto package = &packages[i];
+
+        writer.putBytes(PACKAGES, PACKAGE_NAME, i, package->name, strnlen(
+                package->name, CPUINFO_PACKAGE_NAME_MAX));
+        writer.put(PACKAGES, PACKAGE_PROCESSOR_START, i, package->processor_start);
+        writer.put(PACKAGES, PACKAGE_PROCESSOR_COUNT, i, package->processor_count);
+        writer.put(PACKAGES, PACKAGE_CORE_START, i, package->core_start);
+        writer.put(PACKAGES, PACKAGE_CORE_COUNT, i, package->core_count);
+        writer.put(PACKAGES, PACKAGE_CLUSTER_START, i, package->cluster_start);
+        writer.put(PACKAGES, PACKAGE_CLUSTER_COUNT, i, package->cluster_count);
+    }
+
+    for (uint32_t i = 0; i < rowCounts[UARCHS]; i++) {
+        auto uarch = &uarchs[i];
+
+        writer.put(UARCHS, UARCH_UARCH, i, static_cast<uint32_t>(uarch->uarch));
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+        writer.put(UARCHS, UARCH_CPUID, i, uarch->cpuid);
+#endif
+#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+        writer.put(UARCHS, UARCH_MIDR, i, uarch->midr);
+#endif
+        writer.put(UARCHS, UARCH_PROCESSOR_COUNT, i, uarch->processor_count);
+        writer.put(UARCHS, UARCH_CORE_COUNT, i, uarch->core_count);
+    }
+
+    putCaches(writer, L1I_CACHES, l1iCaches, rowCounts[L1I_CACHES]);
+    putCaches(writer, L1D_CACHES, l1dCaches, rowCounts[L1D_CACHES]);
+    putCaches(writer, L2_CACHES, l2Caches, rowCounts[L2_CACHES]);
+    putCaches(writer, L3_CACHES, l3Caches, rowCounts[L3_CACHES]);
+    putCaches(writer, L4_CACHES, l4Caches, rowCounts[L4_CACHES]);
+
+    return writer.finish();
+}
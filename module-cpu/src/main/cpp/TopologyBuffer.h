@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Structure-of-arrays serialization of the cpuinfo topology.
+ *
+ * Layout (native byte order, every field is a uint32 unless stated otherwise):
+ * - Header: magic, version, total size, table count
+ * - For each table: row count, column count, the byte offset of each column, then the width in
+ *   bytes of each column
+ * - Columns: row count fixed-width values each, every column starts 8-byte aligned
+ *
+ * Strings are stored NUL padded to their column width, readers must take it from the header.
+ *
+ * References between tables (e.g. a processor's core) are stored as row indexes in the
+ * referenced table, missing references as kNoIndex.
+ *
+ * Must be kept in sync with TopologyBuffer.kt.
+ */
+class TopologyBuffer {
+public:
+    static constexpr uint32_t kMagic = 0x54435441; // "ATCT"
+    static constexpr uint32_t kVersion = 3;
+
+    static constexpr uint32_t kNoIndex = UINT32_MAX;
+
+    enum Table : uint32_t {
+        PROCESSORS = 0,
+        CORES,
+        CLUSTERS,
+        PACKAGES,
+        UARCHS,
+        L1I_CACHES,
+        L1D_CACHES,
+        L2_CACHES,
+        L3_CACHES,
+        L4_CACHES,
+        TABLE_COUNT,
+    };
+
+    /**
+     * Serialize the current cpuinfo state. cpuinfo must be initialized.
+     *
+     * cpuinfo only parses the topology once, the online state of each processor comes from
+     * onlineCpus instead.
+     *
+     * @param onlineCpus The online CPUs list, as in /sys/devices/system/cpu/online
+     */
+    static std::vector<uint8_t> build(const std::string &onlineCpus);
+
+private:
+    TopologyBuffer() = delete;
+};
@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cpuinfo.h>
+#include <sys/mman.h>
+#include "BenchmarkHarness.h"
+
+namespace benchmark_harness {
+
+ScopedAffinity::ScopedAffinity(const std::vector<uint32_t> &linuxIds) {
+    CPU_ZERO(&mPreviousSet);
+    mHasPreviousSet = sched_getaffinity(0, sizeof(mPreviousSet), &mPreviousSet) == 0;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto linuxId: linuxIds) {
+        if (linuxId < CPU_SETSIZE) {
+            CPU_SET(linuxId, &set);
+        }
+    }
+
+    mPinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+ScopedAffinity::~ScopedAffinity() {
+    if (mPinned && mHasPreviousSet) {
+        sched_setaffinity(0, sizeof(mPreviousSet), &mPreviousSet);
+    }
+}
+
+AlignedMapping::AlignedMapping(size_t size, size_t alignment) : mSize(size) {
+    mMappingSize = size + alignment;
+    mMapping = mmap(nullptr, mMappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                    -1, 0);
+    if (mMapping == MAP_FAILED) {
+        mMapping = nullptr;
+        return;
+    }
+
+    auto address = reinterpret_cast<uintptr_t>(mMapping);
+    mData = reinterpret_cast<uint8_t *>((address + alignment - 1) / alignment * alignment);
+}
+
+AlignedMapping::~AlignedMapping() {
+    if (mMapping != nullptr) {
+        munmap(mMapping, mMappingSize);
+    }
+}
+
+Measurement measure(const std::function<uint64_t(uint64_t iterations)> &kernel,
+                    const MeasureOptions &options) {
+    // Grow the iteration count until a run is long enough to be timed reliably, then scale it
+    // to the target duration
+    uint64_t iterations = 1;
+    int64_t elapsedNs;
+    while (true) {
+        auto startNs = nowNs();
+        kernel(iterations);
+        elapsedNs = nowNs() - startNs;
+
+        if (elapsedNs >= options.targetNs / 8 || iterations >= (UINT64_MAX >> 2)) {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    iterations = std::max<uint64_t>(
+            1, static_cast<uint64_t>(static_cast<double>(iterations) * options.targetNs
+                                     / std::max<int64_t>(elapsedNs, 1)));
+
+    for (uint32_t i = 0; i < options.warmups; i++) {
+        kernel(iterations);
+    }
+
+    std::vector<double> opsPerSecond;
+    for (uint32_t i = 0; i < std::max<uint32_t>(options.repetitions, 1); i++) {
+        auto startNs = nowNs();
+        auto ops = kernel(iterations);
+        auto runNs = std::max<int64_t>(nowNs() - startNs, 1);
+
+        opsPerSecond.push_back(static_cast<double>(ops) * kNsPerSecond / runNs);
+    }
+
+    std::sort(opsPerSecond.begin(), opsPerSecond.end());
+
+    return {
+            .iterations = iterations,
+            .bestOpsPerSecond = opsPerSecond.back(),
+            .medianOpsPerSecond = opsPerSecond[opsPerSecond.size() / 2],
+    };
+}
+
+std::vector<ClusterInfo> getClusters() {
+    std::vector<ClusterInfo> clusters;
+
+    for (uint32_t i = 0; i < cpuinfo_get_clusters_count(); i++) {
+        auto cluster = cpuinfo_get_cluster(i);
+
+        ClusterInfo info = {
+                .index = i,
+                .clusterId = cluster->cluster_id,
+                .uarch = static_cast<uint32_t>(cluster->uarch),
+                .frequency = cluster->frequency,
+                .linuxIds = {},
+        };
+
+        for (uint32_t j = 0; j < cluster->processor_count; j++) {
+            auto processor = cpuinfo_get_processor(cluster->processor_start + j);
+            info.linuxIds.push_back(static_cast<uint32_t>(processor->linux_id));
+        }
+
+        clusters.push_back(std::move(info));
+    }
+
+    return clusters;
+}
+
+std::vector<ClusterInfo> getUarchClusters() {
+    std::vector<ClusterInfo> clusters;
+
+    for (auto &cluster: getClusters()) {
+        auto found = std::any_of(clusters.begin(), clusters.end(), [&](const ClusterInfo &other) {
+            return other.uarch == cluster.uarch;
+        });
+
+        if (!found) {
+            clusters.push_back(std::move(cluster));
+        }
+    }
+
+    return clusters;
+}
+
+} // namespace benchmark_harness
@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sched.h>
+#include <time.h>
+#include <vector>
+
+namespace benchmark_harness {
+
+constexpr int64_t kNsPerSecond = 1000000000;
+
+/**
+ * Current time in ns, from a clock that isn't slewed by NTP.
+ */
+inline int64_t nowNs() {
+    timespec time{};
+    clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+    return time.tv_sec * kNsPerSecond + time.tv_nsec;
+}
+
+/**
+ * Keep the compiler from optimizing away a value or the computation producing it.
+ */
+template<typename T>
+inline void doNotOptimize(T &value) {
+#if defined(__clang__)
+    asm volatile("" : "+r,m"(value) : : "memory");
+#else
+    asm volatile("" : "+m,r"(value) : : "memory");
+#endif
+}
+
+/**
+ * Tell the CPU the thread is busy waiting, so it can save power or let the sibling thread run.
+ */
+inline void cpuRelax() {
+#if defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#elif defined(__x86_64__) || defined(__i386__)
+    asm volatile("pause" ::: "memory");
+#endif
+}
+
+/**
+ * Pin the calling thread to a set of CPUs until destroyed, then restore the previous affinity.
+ */
+class ScopedAffinity {
+public:
+    explicit ScopedAffinity(const std::vector<uint32_t> &linuxIds);
+    explicit ScopedAffinity(uint32_t linuxId) : ScopedAffinity(std::vector<uint32_t>{linuxId}) {}
+    ~ScopedAffinity();
+
+    ScopedAffinity(const ScopedAffinity &) = delete;
+    ScopedAffinity &operator=(const ScopedAffinity &) = delete;
+
+    /**
+     * @return Whether the thread is actually pinned
+     */
+    bool isPinned() const { return mPinned; }
+
+private:
+    cpu_set_t mPreviousSet;
+    bool mHasPreviousSet;
+    bool mPinned;
+};
+
+/**
+ * An anonymous private mapping whose data is aligned to the requested boundary, unmapped when
+ * destroyed. data() is null if mmap() failed.
+ */
+class AlignedMapping {
+public:
+    AlignedMapping(size_t size, size_t alignment);
+    ~AlignedMapping();
+
+    AlignedMapping(const AlignedMapping &) = delete;
+    AlignedMapping &operator=(const AlignedMapping &) = delete;
+
+    uint8_t *data() const { return mData; }
+
+    size_t size() const { return mSize; }
+
+private:
+    void *mMapping = nullptr;
+    size_t mMappingSize = 0;
+    uint8_t *mData = nullptr;
+    size_t mSize;
+};
+
+struct MeasureOptions {
+    /**
+     * Duration of each timed run.
+     */
+    int64_t targetNs = 20000000;
+    uint32_t warmups = 2;
+    uint32_t repetitions = 5;
+};
+
+struct Measurement {
+    /**
+     * Iterations per timed run, after calibration.
+     */
+    uint64_t iterations;
+
+    /**
+     * Operations per second of the best and median runs.
+     */
+    double bestOpsPerSecond;
+    double medianOpsPerSecond;
+};
+
+/**
+ * Run a kernel calibrated to last about options.targetNs per run, with warmups and repetitions.
+ *
+ * @param kernel Runs the given number of iterations and returns the number of operations done
+ */
+Measurement measure(const std::function<uint64_t(uint64_t iterations)> &kernel,
+                    const MeasureOptions &options = {});
+
+/**
+ * A cpuinfo cluster, with the Linux IDs of its processors.
+ */
+struct ClusterInfo {
+    uint32_t index;
+    uint32_t clusterId;
+    uint32_t uarch;
+    uint64_t frequency;
+    std::vector<uint32_t> linuxIds;
+};
+
+/**
+ * Get the clusters reported by cpuinfo, in cpuinfo order. cpuinfo must be initialized.
+ */
+std::vector<ClusterInfo> getClusters();
+
+/**
+ * Get the first cluster of each distinct microarchitecture, in cpuinfo order.
+ */
+std::vector<ClusterInfo> getUarchClusters();
+
+} // namespace benchmark_harness
@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <iterator>
+#include "Benchmarks.h"
+#include "ComputeBenchmark.h"
+#include "ContentionBenchmark.h"
+#include "CoreToCoreBenchmark.h"
+#include "FrequencyBenchmark.h"
+#include "IsaBenchmark.h"
+#include "MemoryBenchmark.h"
+#include "PageFaultBenchmark.h"
+#include "PerfBenchmark.h"
+#include "StreamBenchmark.h"
+#include "TlbBenchmark.h"
+
+/**
+ * cpuinfo must be initialized before running any of them.
+ */
+static const BenchmarkDefinition kBenchmarks[] = {
+        {"compute", "Integer, floating point, vector and branch throughput per microarchitecture",
+         [] { return runComputeBenchmark(false); }},
+        {"compute-per-core", "Same as compute, for every core",
+         [] { return runComputeBenchmark(true); }},
+        {"contention", "Atomic and lock throughput from 1 to N threads per cluster combination",
+         runContentionBenchmark},
+        {"core-to-core", "Cache line transfer latency between every pair of processors",
+         runCoreToCoreBenchmark},
+        {"frequency", "Effective clock of every processor next to what cpufreq reports",
+         runFrequencyBenchmark},
+        {"isa", "Instruction set extensions, checked and timed against scalar code",
+         runIsaBenchmark},
+        {"memory", "Cache and memory latency and bandwidth sweep per microarchitecture",
+         runMemoryBenchmark},
+        {"pages", "Page size, transparent huge pages and page fault cost per microarchitecture",
+         runPageFaultBenchmark},
+        {"perf", "Hardware performance counters available on each microarchitecture",
+         runPerfBenchmark},
+        {"stream", "STREAM memory bandwidth as threads are added per cluster and across clusters",
+         runStreamBenchmark},
+        {"tlb", "Data TLB reach and page walk cost with 4 KiB, 16 KiB and huge pages",
+         runTlbBenchmark},
+};
+
+const BenchmarkDefinition *getBenchmarks(size_t *count) {
+    *count = std::size(kBenchmarks);
+    return kBenchmarks;
+}
+
+const BenchmarkDefinition *findBenchmark(const char *name) {
+    for (auto &benchmark: kBenchmarks) {
+        if (strcmp(benchmark.name, name) == 0) {
+            return &benchmark;
+        }
+    }
+
+    return nullptr;
+}
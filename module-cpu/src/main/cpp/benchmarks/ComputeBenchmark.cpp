@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpuinfo.h>
+#include <string>
+#include "BenchmarkHarness.h"
+#include "ComputeBenchmark.h"
+
+#if defined(__aarch64__) && defined(__clang__) && __clang_major__ >= 18 \
+        && __has_include(<arm_sve.h>)
+#include <arm_sve.h>
+#define HAS_SVE_KERNEL
+#endif
+
+using namespace benchmark_harness;
+
+/**
+ * Constraint keeping a scalar or vector floating point value in a register, so that the
+ * compiler can't merge independent chains into SIMD operations or fold them.
+ */
+#if defined(__aarch64__) || defined(__arm__)
+#define FP_REGISTER "+w"
+#elif defined(__x86_64__)
+#define FP_REGISTER "+x"
+#else
+#define FP_REGISTER "+m"
+#endif
+
+#define BARRIER4(constraint, a, b, c, d) \
+        asm volatile("" : constraint(a), constraint(b), constraint(c), constraint(d))
+
+/**
+ * Kernels run 8 independent dependency chains, enough to hide the latency of the operation and
+ * fill all the pipes on current cores, so we measure throughput.
+ */
+
+static uint64_t integerAdd(uint64_t iterations) {
+    uint64_t a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8;
+    uint64_t x = iterations;
+    doNotOptimize(x);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        a += x; b += x; c += x; d += x;
+        e += x; f += x; g += x; h += x;
+        BARRIER4("+r", a, b, c, d);
+        BARRIER4("+r", e, f, g, h);
+    }
+
+    auto sum = a ^ b ^ c ^ d ^ e ^ f ^ g ^ h;
+    doNotOptimize(sum);
+
+    return iterations * 8;
+}
+
+static uint64_t integerMultiply(uint64_t iterations) {
+    uint64_t a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8;
+    uint64_t x = iterations | 1;
+    doNotOptimize(x);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        a *= x; b *= x; c *= x; d *= x;
+        e *= x; f *= x; g *= x; h *= x;
+        BARRIER4("+r", a, b, c, d);
+        BARRIER4("+r", e, f, g, h);
+    }
+
+    auto sum = a ^ b ^ c ^ d ^ e ^ f ^ g ^ h;
+    doNotOptimize(sum);
+
+    return iterations * 8;
+}
+
+/**
+ * Multiply-add chains, contracted to FMA where the target supports it.
+ * Counted as 2 floating point operations per lane.
+ */
+template<typename T, uint64_t kLanes>
+static uint64_t multiplyAdd(uint64_t iterations) {
+    T a = T{} + 1, b = T{} + 2, c = T{} + 3, d = T{} + 4;
+    T e = T{} + 5, f = T{} + 6, g = T{} + 7, h = T{} + 8;
+    T m = T{} + 0.999f, k = T{} + 0.001f;
+    BARRIER4(FP_REGISTER, m, k, a, b);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        a = a * m + k; b = b * m + k; c = c * m + k; d = d * m + k;
+        e = e * m + k; f = f * m + k; g = g * m + k; h = h * m + k;
+        BARRIER4(FP_REGISTER, a, b, c, d);
+        BARRIER4(FP_REGISTER, e, f, g, h);
+    }
+
+    T sum = a + b + c + d + e + f + g + h;
+    asm volatile("" : : "m"(sum));
+
+    return iterations * 8 * kLanes * 2;
+}
+
+typedef float Float32x4 __attribute__((vector_size(16)));
+typedef double Float64x2 __attribute__((vector_size(16)));
+
+#if defined(__x86_64__)
+typedef float Float32x8 __attribute__((vector_size(32)));
+
+__attribute__((target("avx2,fma")))
+static uint64_t multiplyAddAvx2(uint64_t iterations) {
+    Float32x8 a = Float32x8{} + 1, b = Float32x8{} + 2, c = Float32x8{} + 3, d = Float32x8{} + 4;
+    Float32x8 e = Float32x8{} + 5, f = Float32x8{} + 6, g = Float32x8{} + 7, h = Float32x8{} + 8;
+    Float32x8 m = Float32x8{} + 0.999f, k = Float32x8{} + 0.001f;
+    BARRIER4("+x", m, k, a, b);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        a = a * m + k; b = b * m + k; c = c * m + k; d = d * m + k;
+        e = e * m + k; f = f * m + k; g = g * m + k; h = h * m + k;
+        BARRIER4("+x", a, b, c, d);
+        BARRIER4("+x", e, f, g, h);
+    }
+
+    Float32x8 sum = a + b + c + d + e + f + g + h;
+    asm volatile("" : : "m"(sum));
+
+    return iterations * 8 * 8 * 2;
+}
+#endif
+
+#ifdef HAS_SVE_KERNEL
+__attribute__((target("+sve")))
+static uint64_t multiplyAddSve(uint64_t iterations) {
+    auto pg = svptrue_b32();
+    auto a = svdup_f32(1), b = svdup_f32(2), c = svdup_f32(3), d = svdup_f32(4);
+    auto e = svdup_f32(5), f = svdup_f32(6), g = svdup_f32(7), h = svdup_f32(8);
+    auto m = svdup_f32(0.999f), k = svdup_f32(0.001f);
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        a = svmad_f32_x(pg, a, m, k); b = svmad_f32_x(pg, b, m, k);
+        c = svmad_f32_x(pg, c, m, k); d = svmad_f32_x(pg, d, m, k);
+        e = svmad_f32_x(pg, e, m, k); f = svmad_f32_x(pg, f, m, k);
+        g = svmad_f32_x(pg, g, m, k); h = svmad_f32_x(pg, h, m, k);
+    }
+
+    auto sum = svaddv_f32(pg, svadd_f32_x(pg, svadd_f32_x(pg, a, b), svadd_f32_x(pg, c, d)))
+               + svaddv_f32(pg, svadd_f32_x(pg, svadd_f32_x(pg, e, f), svadd_f32_x(pg, g, h)));
+    doNotOptimize(sum);
+
+    return iterations * 8 * svcntw() * 2;
+}
+#endif
+
+/**
+ * Branches on the top bit of an LCG, either alternating (always predicted) or random.
+ * The empty asm statements keep the compiler from turning the branch into a select.
+ */
+template<bool kRandom>
+static uint64_t branch(uint64_t iterations) {
+    uint32_t state = 0x12345678;
+    uint64_t taken = 0, notTaken = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        state = state * 1664525 + 1013904223;
+
+        if (kRandom ? (state & 0x80000000) != 0 : (i & 1) != 0) {
+            asm volatile("");
+            taken++;
+        } else {
+            asm volatile("");
+            notTaken++;
+        }
+    }
+
+    auto sum = taken ^ notTaken;
+    doNotOptimize(sum);
+
+    return iterations;
+}
+
+static void runKernels(BenchmarkReport::Section &section) {
+    using Unit = BenchmarkReport::Unit;
+
+    section.add("int64_add", Unit::OPS_PER_SECOND, measure(integerAdd).bestOpsPerSecond);
+    section.add("int64_mul", Unit::OPS_PER_SECOND, measure(integerMultiply).bestOpsPerSecond);
+    section.add("fp32_fma", Unit::FLOPS, measure(multiplyAdd<float, 1>).bestOpsPerSecond);
+    section.add("fp64_fma", Unit::FLOPS, measure(multiplyAdd<double, 1>).bestOpsPerSecond);
+
+    // 128-bit vectors are NEON on ARM and SSE on x86, both baseline on 64-bit targets
+#if defined(__aarch64__) || defined(__x86_64__) || (defined(__arm__) && defined(__ARM_NEON))
+    section.add("vec128_fp32_fma", Unit::FLOPS,
+                measure(multiplyAdd<Float32x4, 4>).bestOpsPerSecond);
+    section.add("vec128_fp64_fma", Unit::FLOPS,
+                measure(multiplyAdd<Float64x2, 2>).bestOpsPerSecond);
+#endif
+
+#if defined(__x86_64__)
+    if (cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
+        section.add("avx2_fp32_fma", Unit::FLOPS, measure(multiplyAddAvx2).bestOpsPerSecond);
+    }
+#endif
+
+#ifdef HAS_SVE_KERNEL
+    if (cpuinfo_has_arm_sve()) {
+        section.add("sve_fp32_fma", Unit::FLOPS, measure(multiplyAddSve).bestOpsPerSecond);
+    }
+#endif
+
+    section.add("branch_predictable", Unit::OPS_PER_SECOND,
+                measure(branch<false>).bestOpsPerSecond);
+    section.add("branch_random", Unit::OPS_PER_SECOND, measure(branch<true>).bestOpsPerSecond);
+}
+
+BenchmarkReport runComputeBenchmark(bool perCore) {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    for (auto &cluster: getClusters()) {
+        // One worker per cluster uses the first core, the scheduler could otherwise move the
+        // thread between cores with different frequencies or cache states mid-run
+        auto linuxIds = perCore ? cluster.linuxIds : std::vector<uint32_t>{cluster.linuxIds[0]};
+
+        for (auto linuxId: linuxIds) {
+            auto &section = report.addSection(
+                    perCore ? "CPU " + std::to_string(linuxId)
+                            : "Cluster " + std::to_string(cluster.index));
+
+            ScopedAffinity affinity(linuxId);
+
+            section.add("cpu", Unit::NONE, linuxId);
+            section.add("uarch", Unit::UARCH, cluster.uarch);
+            section.add("pinned", Unit::BOOLEAN, affinity.isPinned());
+            if (cluster.frequency != 0) {
+                section.add("nominal_frequency", Unit::HERTZ,
+                            static_cast<double>(cluster.frequency));
+            }
+
+            runKernels(section);
+        }
+    }
+
+    return report;
+}
@@ -0,0 +1,16 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Measure integer, floating point, vector and branch throughput with the calling thread pinned
+ * to the first core of each cluster in turn, or to each core if perCore is true. Clusters sharing
+ * a microarchitecture are measured separately, since they can differ in frequency and caches.
+ * cpuinfo must be initialized.
+ */
+BenchmarkReport runComputeBenchmark(bool perCore);
@@ -0,0 +1,494 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cpuinfo.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkHarness.h"
+#include "ContentionBenchmark.h"
+
+using namespace benchmark_harness;
+
+static constexpr int64_t kRunNs = 10000000;
+static constexpr uint32_t kRepetitions = 3;
+
+/**
+ * Operations done between two checks of the stop flag.
+ */
+static constexpr uint32_t kBatchSize = 64;
+
+/**
+ * Give up if the threads aren't all running by then, a CPU went offline or is busy.
+ */
+static constexpr int64_t kStartTimeoutNs = 100000000;
+
+/**
+ * Test and test-and-set, spinning on a plain load so waiters don't steal the line from the owner.
+ */
+class SpinLock {
+public:
+    void lock() {
+        while (mLocked.exchange(true, std::memory_order_acquire)) {
+            while (mLocked.load(std::memory_order_relaxed)) {
+                cpuRelax();
+            }
+        }
+    }
+
+    void unlock() {
+        mLocked.store(false, std::memory_order_release);
+    }
+
+private:
+    std::atomic<bool> mLocked{false};
+};
+
+/**
+ * Everything the threads fight over, each on its own cache line.
+ */
+struct Shared {
+    alignas(64) std::atomic<uint64_t> counter{0};
+    alignas(64) SpinLock spinLock;
+    alignas(64) std::mutex mutex;
+    alignas(64) uint64_t protectedValue = 0;
+};
+
+struct alignas(64) StateLine {
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<bool> failed{false};
+};
+
+struct alignas(64) ThreadLine {
+    uint64_t ops = 0;
+};
+
+/**
+ * Do count operations on the shared state.
+ */
+using Kernel = void (*)(Shared &shared, uint32_t count);
+
+static void fetchAdd(Shared &shared, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        shared.counter.fetch_add(1, std::memory_order_seq_cst);
+    }
+}
+
+static void compareExchange(Shared &shared, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        auto expected = shared.counter.load(std::memory_order_relaxed);
+        while (!shared.counter.compare_exchange_weak(expected, expected + 1,
+                                                     std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed)) {}
+    }
+}
+
+static void lockSpinLock(Shared &shared, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        shared.spinLock.lock();
+        shared.protectedValue++;
+        shared.spinLock.unlock();
+    }
+}
+
+/**
+ * std::mutex is a futex on both bionic and glibc, waiters sleep in the kernel.
+ */
+static void lockMutex(Shared &shared, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        shared.mutex.lock();
+        shared.protectedValue++;
+        shared.mutex.unlock();
+    }
+}
+
+#if defined(__aarch64__)
+// The compiler picks LL/SC or LSE (directly or through outline atomics) on its own, spell both
+// out so they can be compared on the same CPU
+
+static inline uint64_t *getCounterAddress(Shared &shared) {
+    return reinterpret_cast<uint64_t *>(&shared.counter);
+}
+
+static void fetchAddLlsc(Shared &shared, uint32_t count) {
+    auto address = getCounterAddress(shared);
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t value;
+        uint32_t status;
+        asm volatile(
+                "1: ldaxr %[value], %[address]\n"
+                "add %[value], %[value], #1\n"
+                "stlxr %w[status], %[value], %[address]\n"
+                "cbnz %w[status], 1b\n"
+                : [value] "=&r"(value), [status] "=&r"(status), [address] "+Q"(*address)
+                :
+                : "memory");
+    }
+}
+
+static void compareExchangeLlsc(Shared &shared, uint32_t count) {
+    auto address = getCounterAddress(shared);
+
+    for (uint32_t i = 0; i < count; i++) {
+        auto expected = __atomic_load_n(address, __ATOMIC_RELAXED);
+
+        for (;;) {
+            uint64_t previous;
+            uint32_t status;
+            asm volatile(
+                    "1: ldaxr %[previous], %[address]\n"
+                    "cmp %[previous], %[expected]\n"
+                    "b.ne 2f\n"
+                    "stlxr %w[status], %[desired], %[address]\n"
+                    "cbnz %w[status], 1b\n"
+                    "b 3f\n"
+                    "2: clrex\n"
+                    "3:\n"
+                    : [previous] "=&r"(previous), [status] "=&r"(status),
+                      [address] "+Q"(*address)
+                    : [expected] "r"(expected), [desired] "r"(expected + 1)
+                    : "cc", "memory");
+
+            if (previous == expected) {
+                break;
+            }
+            expected = previous;
+        }
+    }
+}
+
+static void fetchAddLse(Shared &shared, uint32_t count) {
+    auto address = getCounterAddress(shared);
+    uint64_t one = 1;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t previous;
+        asm volatile(
+                ".arch_extension lse\n"
+                "ldaddal %[one], %[previous], %[address]\n"
+                : [previous] "=r"(previous), [address] "+Q"(*address)
+                : [one] "r"(one)
+                : "memory");
+    }
+}
+
+static void compareExchangeLse(Shared &shared, uint32_t count) {
+    auto address = getCounterAddress(shared);
+
+    for (uint32_t i = 0; i < count; i++) {
+        auto expected = __atomic_load_n(address, __ATOMIC_RELAXED);
+
+        for (;;) {
+            auto previous = expected;
+            asm volatile(
+                    ".arch_extension lse\n"
+                    "casal %[previous], %[desired], %[address]\n"
+                    : [previous] "+r"(previous), [address] "+Q"(*address)
+                    : [desired] "r"(expected + 1)
+                    : "memory");
+
+            if (previous == expected) {
+                break;
+            }
+            expected = previous;
+        }
+    }
+}
+#endif
+
+static bool isAlwaysSupported() {
+    return true;
+}
+
+struct Operation {
+    const char *name;
+    Kernel kernel;
+    bool (*isSupported)();
+
+    /**
+     * Whether it's a lock, for which fairness between threads is reported too.
+     */
+    bool isLock;
+};
+
+static const Operation kOperations[] = {
+        {"fetch_add", fetchAdd, isAlwaysSupported, false},
+        {"cas", compareExchange, isAlwaysSupported, false},
+#if defined(__aarch64__)
+        {"fetch_add_llsc", fetchAddLlsc, isAlwaysSupported, false},
+        {"cas_llsc", compareExchangeLlsc, isAlwaysSupported, false},
+        {"fetch_add_lse", fetchAddLse, cpuinfo_has_arm_atomics, false},
+        {"cas_lse", compareExchangeLse, cpuinfo_has_arm_atomics, false},
+#endif
+        {"spinlock", lockSpinLock, isAlwaysSupported, true},
+        {"mutex", lockMutex, isAlwaysSupported, true},
+};
+
+struct RunResult {
+    /**
+     * Operations per second of all the threads together, NAN if the run failed.
+     */
+    double opsPerSecond;
+
+    /**
+     * Operations of the slowest thread over the ones of the fastest.
+     */
+    double fairness;
+};
+
+/**
+ * Run the kernel on one thread pinned to each of the given processors for kRunNs.
+ */
+static RunResult runThreads(const std::vector<uint32_t> &linuxIds, Kernel kernel) {
+    Shared shared;
+    StateLine state;
+    std::vector<ThreadLine> threadOps(linuxIds.size());
+
+    std::vector<std::thread> threads;
+    threads.reserve(linuxIds.size());
+    for (size_t i = 0; i < linuxIds.size(); i++) {
+        threads.emplace_back([&, i] {
+            ScopedAffinity affinity(linuxIds[i]);
+            if (!affinity.isPinned()) {
+                state.failed.store(true);
+            }
+
+            state.ready.fetch_add(1, std::memory_order_release);
+
+            while (!state.start.load(std::memory_order_acquire)) {
+                if (state.stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                cpuRelax();
+            }
+
+            uint64_t ops = 0;
+            while (!state.stop.load(std::memory_order_relaxed)) {
+                kernel(shared, kBatchSize);
+                ops += kBatchSize;
+            }
+
+            threadOps[i].ops = ops;
+        });
+    }
+
+    auto waitStartNs = nowNs();
+    while (state.ready.load(std::memory_order_acquire) < linuxIds.size()
+           && nowNs() - waitStartNs < kStartTimeoutNs) {
+        std::this_thread::yield();
+    }
+
+    auto ok = state.ready.load(std::memory_order_acquire) == linuxIds.size()
+              && !state.failed.load();
+
+    int64_t elapsedNs = 0;
+    if (ok) {
+        auto startNs = nowNs();
+        state.start.store(true, std::memory_order_release);
+        std::this_thread::sleep_for(std::chrono::nanoseconds(kRunNs));
+        state.stop.store(true, std::memory_order_relaxed);
+        elapsedNs = nowNs() - startNs;
+    } else {
+        state.stop.store(true);
+    }
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    if (!ok) {
+        return {NAN, NAN};
+    }
+
+    uint64_t totalOps = 0;
+    auto minOps = UINT64_MAX;
+    uint64_t maxOps = 0;
+    for (auto &thread: threadOps) {
+        totalOps += thread.ops;
+        minOps = std::min(minOps, thread.ops);
+        maxOps = std::max(maxOps, thread.ops);
+    }
+
+    return {
+            static_cast<double>(totalOps) * kNsPerSecond / static_cast<double>(elapsedNs),
+            maxOps > 0 ? static_cast<double>(minOps) / static_cast<double>(maxOps) : NAN,
+    };
+}
+
+/**
+ * @return The best of kRepetitions runs
+ */
+static RunResult measureThreads(const std::vector<uint32_t> &linuxIds, Kernel kernel) {
+    RunResult best = {NAN, NAN};
+
+    for (uint32_t i = 0; i < kRepetitions; i++) {
+        auto result = runThreads(linuxIds, kernel);
+        if (std::isnan(result.opsPerSecond)) {
+            return {NAN, NAN};
+        }
+
+        if (!(result.opsPerSecond <= best.opsPerSecond)) {
+            best = result;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * Where the threads go, the first N processors are used with N threads.
+ */
+struct Placement {
+    std::string name;
+    std::vector<uint32_t> linuxIds;
+    uint32_t uarch;
+
+    /**
+     * Enough threads to have one on every cluster of the placement.
+     */
+    size_t minThreads;
+};
+
+/**
+ * Take the processors of the clusters in turns, so every cluster gets a thread as soon as
+ * possible and the load stays balanced while ramping up.
+ */
+static std::vector<uint32_t> interleave(const std::vector<const ClusterInfo *> &clusters) {
+    std::vector<uint32_t> linuxIds;
+
+    for (size_t i = 0;; i++) {
+        auto added = false;
+        for (auto cluster: clusters) {
+            if (i < cluster->linuxIds.size()) {
+                linuxIds.push_back(cluster->linuxIds[i]);
+                added = true;
+            }
+        }
+
+        if (!added) {
+            return linuxIds;
+        }
+    }
+}
+
+static std::vector<Placement> getPlacements() {
+    std::vector<Placement> placements;
+
+    auto clusters = getClusters();
+
+    for (auto &cluster: clusters) {
+        placements.push_back({
+                "Cluster " + std::to_string(cluster.index),
+                cluster.linuxIds,
+                cluster.uarch,
+                1,
+        });
+    }
+
+    for (size_t i = 0; i < clusters.size(); i++) {
+        for (size_t j = i + 1; j < clusters.size(); j++) {
+            placements.push_back({
+                    "Clusters " + std::to_string(clusters[i].index) + "+"
+                    + std::to_string(clusters[j].index),
+                    interleave({&clusters[i], &clusters[j]}),
+                    cpuinfo_uarch_unknown,
+                    2,
+            });
+        }
+    }
+
+    if (clusters.size() > 2) {
+        std::vector<const ClusterInfo *> allClusters;
+        for (auto &cluster: clusters) {
+            allClusters.push_back(&cluster);
+        }
+
+        placements.push_back({
+                "All clusters",
+                interleave(allClusters),
+                cpuinfo_uarch_unknown,
+                clusters.size(),
+        });
+    }
+
+    return placements;
+}
+
+BenchmarkReport runContentionBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    auto &system = report.addSection("System");
+    system.add("processors", Unit::NONE, cpuinfo_get_processors_count());
+#if defined(__aarch64__) || defined(__arm__)
+    system.add("lse", Unit::BOOLEAN, cpuinfo_has_arm_atomics());
+#endif
+
+    for (auto &placement: getPlacements()) {
+        auto &section = report.addSection(placement.name);
+
+        section.add("processors", Unit::NONE, placement.linuxIds.size());
+        if (placement.uarch != cpuinfo_uarch_unknown) {
+            section.add("uarch", Unit::UARCH, placement.uarch);
+        }
+
+        for (auto &operation: kOperations) {
+            if (!operation.isSupported()) {
+                continue;
+            }
+
+            auto name = std::string(operation.name);
+
+            double firstOpsPerSecond = NAN;
+            double lastOpsPerSecond = NAN;
+            double peakOpsPerSecond = NAN;
+            size_t peakThreads = 0;
+
+            for (auto threads = placement.minThreads; threads <= placement.linuxIds.size();
+                 threads++) {
+                std::vector<uint32_t> linuxIds(placement.linuxIds.begin(),
+                                               placement.linuxIds.begin()
+                                               + static_cast<ptrdiff_t>(threads));
+
+                auto result = measureThreads(linuxIds, operation.kernel);
+                if (std::isnan(result.opsPerSecond)) {
+                    continue;
+                }
+
+                auto prefix = name + "_" + std::to_string(threads) + "_threads";
+                section.add(prefix, Unit::OPS_PER_SECOND, result.opsPerSecond);
+                if (operation.isLock && threads > 1) {
+                    section.add(prefix + "_fairness", Unit::RATIO, result.fairness);
+                }
+
+                if (std::isnan(firstOpsPerSecond)) {
+                    firstOpsPerSecond = result.opsPerSecond;
+                }
+                lastOpsPerSecond = result.opsPerSecond;
+                if (!(result.opsPerSecond <= peakOpsPerSecond)) {
+                    peakOpsPerSecond = result.opsPerSecond;
+                    peakThreads = threads;
+                }
+            }
+
+            if (peakThreads != 0) {
+                section.add(name + "_peak_threads", Unit::NONE, peakThreads);
+                // Below 1 when contention makes the extra threads a net loss
+                section.add(name + "_scaling", Unit::NONE, lastOpsPerSecond / firstOpsPerSecond);
+            }
+        }
+    }
+
+    return report;
+}
@@ -0,0 +1,20 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Measure how atomic fetch-add, compare-and-swap, a spinlock and a futex based mutex scale
+ * as threads hammering the same cache line go from 1 to N, with the threads placed on a single
+ * cluster, on every pair of clusters and on all of them. On ARM, LL/SC and LSE atomics are
+ * measured separately, the latter only if cpuinfo reports them.
+ * cpuinfo must be initialized.
+ *
+ * The report has one section per placement, with the total throughput of each primitive at
+ * every thread count and the thread count it peaks at.
+ */
+BenchmarkReport runContentionBenchmark();
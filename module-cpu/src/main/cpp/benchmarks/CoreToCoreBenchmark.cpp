@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cpuinfo.h>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkHarness.h"
+#include "CoreToCoreBenchmark.h"
+
+using namespace benchmark_harness;
+
+static constexpr uint32_t kRounds = 1000;
+static constexpr uint32_t kWarmups = 2;
+static constexpr uint32_t kRepetitions = 5;
+
+/**
+ * Give up on a pair if a round trip takes longer than this, the other thread isn't running,
+ * because the CPU went offline or because something else is running on it.
+ */
+static constexpr int64_t kTimeoutNs = 100000000;
+
+struct alignas(64) PingPongLine {
+    std::atomic<uint32_t> value{0};
+};
+
+struct alignas(64) StateLine {
+    std::atomic<bool> ready{false};
+    std::atomic<bool> stop{false};
+};
+
+/**
+ * @return The one-way latency in ns, NAN if the threads couldn't be pinned or timed out
+ */
+static double measurePair(uint32_t initiatorId, uint32_t responderId) {
+    PingPongLine line;
+    StateLine state;
+
+    std::thread responder([&] {
+        ScopedAffinity affinity(responderId);
+        if (!affinity.isPinned()) {
+            state.stop.store(true);
+            return;
+        }
+
+        state.ready.store(true, std::memory_order_release);
+
+        for (uint32_t expected = 1;; expected += 2) {
+            while (line.value.load(std::memory_order_acquire) != expected) {
+                if (state.stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+
+            line.value.store(expected + 1, std::memory_order_release);
+        }
+    });
+
+    auto result = NAN;
+
+    {
+        ScopedAffinity affinity(initiatorId);
+
+        auto startNs = nowNs();
+        while (affinity.isPinned() && !state.ready.load(std::memory_order_acquire)
+               && !state.stop.load() && nowNs() - startNs < kTimeoutNs) {
+            std::this_thread::yield();
+        }
+
+        auto ok = affinity.isPinned() && state.ready.load(std::memory_order_acquire);
+
+        uint32_t value = 1;
+        for (uint32_t i = 0; ok && i < kWarmups + kRepetitions; i++) {
+            startNs = nowNs();
+
+            for (uint32_t round = 0; ok && round < kRounds; round++, value += 2) {
+                line.value.store(value, std::memory_order_release);
+
+                uint32_t spins = 0;
+                while (line.value.load(std::memory_order_acquire) != value + 1) {
+                    if (++spins % 65536 == 0 && nowNs() - startNs > kTimeoutNs) {
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+
+            auto oneWayNs = static_cast<double>(nowNs() - startNs) / kRounds / 2;
+            if (ok && i >= kWarmups && !(oneWayNs >= result)) {
+                result = oneWayNs;
+            }
+        }
+
+        if (!ok) {
+            result = NAN;
+        }
+    }
+
+    state.stop.store(true);
+    responder.join();
+
+    return result;
+}
+
+/**
+ * @return The smallest cache level shared by the two processors, 0 if none
+ */
+static uint32_t getSharedCacheLevel(const cpuinfo_processor *a, const cpuinfo_processor *b) {
+    const cpuinfo_cache *aCaches[] = {a->cache.l1d, a->cache.l2, a->cache.l3, a->cache.l4};
+    const cpuinfo_cache *bCaches[] = {b->cache.l1d, b->cache.l2, b->cache.l3, b->cache.l4};
+
+    for (uint32_t i = 0; i < 4; i++) {
+        if (aCaches[i] != nullptr && aCaches[i] == bCaches[i]) {
+            return i + 1;
+        }
+    }
+
+    return 0;
+}
+
+BenchmarkReport runCoreToCoreBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    auto count = cpuinfo_get_processors_count();
+
+    std::vector<double> latencies(count * count, NAN);
+    for (uint32_t i = 0; i < count; i++) {
+        for (uint32_t j = i + 1; j < count; j++) {
+            auto latency = measurePair(cpuinfo_get_processor(i)->linux_id,
+                                       cpuinfo_get_processor(j)->linux_id);
+
+            // A round trip is symmetric
+            latencies[i * count + j] = latency;
+            latencies[j * count + i] = latency;
+        }
+    }
+
+    BenchmarkReport report;
+
+    // Average latency by smallest shared cache level, to tell how much sharing a cache saves
+    std::map<uint32_t, std::pair<double, uint32_t>> levelLatencies;
+
+    for (uint32_t i = 0; i < count; i++) {
+        auto processor = cpuinfo_get_processor(i);
+
+        auto &section = report.addSection("CPU " + std::to_string(processor->linux_id));
+        section.add("uarch", Unit::UARCH, processor->core->uarch);
+
+        for (uint32_t j = 0; j < count; j++) {
+            if (i == j) {
+                continue;
+            }
+
+            auto other = cpuinfo_get_processor(j);
+            auto name = "cpu" + std::to_string(other->linux_id);
+            auto level = getSharedCacheLevel(processor, other);
+            auto latency = latencies[i * count + j];
+
+            if (!std::isnan(latency)) {
+                section.add(name + "_latency", Unit::NANOSECONDS, latency);
+
+                if (i < j) {
+                    auto &[sum, pairs] = levelLatencies[level];
+                    sum += latency;
+                    pairs++;
+                }
+            }
+            section.add(name + "_shared_cache_level", Unit::NONE, level);
+        }
+    }
+
+    if (!levelLatencies.empty()) {
+        auto &summary = report.addSection("Summary");
+        for (auto &[level, latency]: levelLatencies) {
+            auto &[sum, pairs] = latency;
+            summary.add(level == 0 ? std::string("no_shared_cache_latency")
+                                   : "shared_l" + std::to_string(level) + "_latency",
+                        Unit::NANOSECONDS, sum / pairs);
+        }
+    }
+
+    return report;
+}
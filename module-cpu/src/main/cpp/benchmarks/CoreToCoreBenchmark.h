@@ -0,0 +1,18 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Measure the one-way latency of moving a cache line between every pair of processors, by
+ * bouncing it between two pinned threads, along with the smallest cache level they share.
+ * cpuinfo must be initialized.
+ *
+ * The report has one section per processor, with the latency and shared cache level to every
+ * other processor, so the N×N matrix can be exported with any BenchmarkReport format.
+ */
+BenchmarkReport runCoreToCoreBenchmark();
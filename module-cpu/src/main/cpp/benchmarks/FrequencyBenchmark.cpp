@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cpuinfo.h>
+#include <cstdio>
+#include <string>
+#include "BenchmarkHarness.h"
+#include "FrequencyBenchmark.h"
+
+using namespace benchmark_harness;
+
+/**
+ * Long enough for the timer resolution and the cost of reading it to be noise, short enough to
+ * keep the whole probe well under 1 ms per core.
+ */
+static constexpr int64_t kSampleNs = 100000;
+static constexpr uint32_t kSamples = 2;
+
+static constexpr uint32_t kAddsPerChunk = 4096;
+
+/**
+ * On aarch64 we read the generic timer directly, it's what CLOCK_MONOTONIC_RAW is based on
+ * anyway but without the vDSO call. The TSC isn't used on x86 since its frequency isn't
+ * reported by the kernel, the vDSO reads it for us.
+ */
+#if defined(__aarch64__)
+static inline uint64_t readCounter() {
+    uint64_t value;
+    asm volatile("isb\n\tmrs %0, cntvct_el0" : "=r"(value) : : "memory");
+    return value;
+}
+
+static uint64_t getCounterFrequency() {
+    uint64_t value;
+    asm volatile("mrs %0, cntfrq_el0" : "=r"(value));
+    return value;
+}
+#else
+static inline uint64_t readCounter() {
+    return static_cast<uint64_t>(nowNs());
+}
+
+static uint64_t getCounterFrequency() {
+    return kNsPerSecond;
+}
+#endif
+
+/**
+ * Register to register adds, recent x86 cores execute additions of small immediates at rename
+ * time without using a cycle.
+ */
+#define ADD(x, y) x += y; asm volatile("" : "+r"(x))
+#define ADD8(x, y) ADD(x, y); ADD(x, y); ADD(x, y); ADD(x, y); \
+        ADD(x, y); ADD(x, y); ADD(x, y); ADD(x, y)
+#define ADD32(x, y) ADD8(x, y); ADD8(x, y); ADD8(x, y); ADD8(x, y)
+
+__attribute__((noinline))
+static uint64_t addChain(uint64_t x, uint64_t y) {
+    asm volatile("" : "+r"(y));
+
+    for (uint32_t i = 0; i < kAddsPerChunk / 32; i++) {
+        ADD32(x, y);
+    }
+
+    return x;
+}
+
+/**
+ * @return Cycles per second, or -1 if the counter looks broken
+ */
+static int64_t sample(uint64_t counterFrequency) {
+    auto targetTicks = counterFrequency * kSampleNs / kNsPerSecond;
+
+    uint64_t x = 0;
+    uint64_t adds = 0;
+
+    auto start = readCounter();
+    uint64_t elapsed;
+    do {
+        x = addChain(x, adds | 1);
+        adds += kAddsPerChunk;
+        elapsed = readCounter() - start;
+    } while (elapsed < targetTicks);
+
+    doNotOptimize(x);
+
+    if (elapsed == 0) {
+        return -1;
+    }
+
+    return static_cast<int64_t>(static_cast<double>(adds) * counterFrequency / elapsed);
+}
+
+int64_t measureEffectiveFrequency(uint32_t linuxId) {
+    static const auto counterFrequency = getCounterFrequency();
+
+    // Broken firmware may leave CNTFRQ_EL0 unset
+    auto useCounter = counterFrequency >= 1000000;
+
+    ScopedAffinity affinity(linuxId);
+    if (!affinity.isPinned()) {
+        return -1;
+    }
+
+    // Take the fastest sample, the slower ones were likely interrupted
+    int64_t frequency = -1;
+    for (uint32_t i = 0; i < kSamples; i++) {
+        frequency = std::max(frequency, useCounter ? sample(counterFrequency) : -1);
+    }
+
+    return frequency;
+}
+
+static int64_t readScalingCurrentFrequency(uint32_t linuxId) {
+    auto path = "/sys/devices/system/cpu/cpu" + std::to_string(linuxId)
+                + "/cpufreq/scaling_cur_freq";
+
+    auto file = fopen(path.c_str(), "re");
+    if (file == nullptr) {
+        return -1;
+    }
+
+    long long frequencyKhz;
+    auto result = fscanf(file, "%lld", &frequencyKhz);
+    fclose(file);
+
+    return result == 1 ? frequencyKhz * 1000 : -1;
+}
+
+BenchmarkReport runFrequencyBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+        auto processor = cpuinfo_get_processor(i);
+        auto linuxId = static_cast<uint32_t>(processor->linux_id);
+
+        auto startNs = nowNs();
+        auto effectiveFrequency = measureEffectiveFrequency(linuxId);
+        auto probeNs = nowNs() - startNs;
+
+        // Read right after the probe, when the governor had the most time to react to the load
+        auto scalingFrequency = readScalingCurrentFrequency(linuxId);
+
+        auto &section = report.addSection("CPU " + std::to_string(linuxId));
+        section.add("uarch", Unit::UARCH, processor->core->uarch);
+        if (effectiveFrequency > 0) {
+            section.add("effective_frequency", Unit::HERTZ, effectiveFrequency);
+            section.add("probe_duration", Unit::NANOSECONDS, probeNs);
+        }
+        if (scalingFrequency > 0) {
+            section.add("scaling_current_frequency", Unit::HERTZ, scalingFrequency);
+        }
+        if (effectiveFrequency > 0 && scalingFrequency > 0) {
+            section.add("effective_to_scaling_ratio", Unit::RATIO,
+                        static_cast<double>(effectiveFrequency) / scalingFrequency);
+        }
+    }
+
+    return report;
+}
@@ -0,0 +1,24 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include "BenchmarkReport.h"
+
+/**
+ * Measure the clock a CPU is actually running at, by pinning the calling thread to it and timing
+ * a chain of dependent adds, which retire one per cycle on every core we care about.
+ * Takes about 250 µs, the previous affinity is restored afterwards.
+ *
+ * @return The effective frequency in Hz, -1 if the thread couldn't be pinned to the CPU
+ */
+int64_t measureEffectiveFrequency(uint32_t linuxId);
+
+/**
+ * Measure the effective frequency of every processor and compare it with what cpufreq reports.
+ * cpuinfo must be initialized.
+ */
+BenchmarkReport runFrequencyBenchmark();
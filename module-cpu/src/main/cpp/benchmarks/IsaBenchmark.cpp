@@ -0,0 +1,599 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <csetjmp>
+#include <csignal>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include "BenchmarkHarness.h"
+#include "IsaBenchmark.h"
+#include "IsaFeatures.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#if defined(__clang__) && __clang_major__ >= 18
+#include <arm_acle.h>
+#define HAS_ARM_EXTENSION_KERNELS
+#if __has_include(<arm_sve.h>)
+#include <arm_sve.h>
+#define HAS_SVE_KERNELS
+#endif
+#endif
+#endif
+
+using namespace benchmark_harness;
+
+static constexpr size_t kSelfTestSize = 4096;
+
+static constexpr uint64_t kPextMask = 0x0f0ff00ff0f0ff0fULL;
+
+/**
+ * Inputs shared by every kernel. Bytes are small enough for any dot product of them to be exact
+ * in fp32 and bf16, so that vector kernels can be compared with the scalar ones bit for bit
+ * regardless of the order they add things up in.
+ */
+struct SelfTestData {
+    alignas(64) uint8_t bytesA[kSelfTestSize];
+    alignas(64) uint8_t bytesB[kSelfTestSize];
+    alignas(64) float floatsA[kSelfTestSize];
+    alignas(64) float floatsB[kSelfTestSize];
+    alignas(64) uint16_t bf16A[kSelfTestSize];
+    alignas(64) uint16_t bf16B[kSelfTestSize];
+    alignas(64) uint64_t words[kSelfTestSize / sizeof(uint64_t)];
+};
+
+/**
+ * @return A checksum of what the kernel computed
+ */
+typedef uint64_t (*SelfTestKernel)(const SelfTestData &data);
+
+struct SelfTest {
+    IsaFeature feature;
+    SelfTestKernel kernel;
+    SelfTestKernel reference;
+};
+
+static std::unique_ptr<SelfTestData> createSelfTestData() {
+    auto data = std::make_unique<SelfTestData>();
+
+    for (size_t i = 0; i < kSelfTestSize; i++) {
+        data->bytesA[i] = (i * 7 + 3) & 0xf;
+        data->bytesB[i] = (i * 13 + 5) & 0xf;
+        data->floatsA[i] = data->bytesA[i];
+        data->floatsB[i] = data->bytesB[i];
+
+        // Small integers are exact in bf16, which is the top half of an fp32
+        uint32_t bits;
+        memcpy(&bits, &data->floatsA[i], sizeof(bits));
+        data->bf16A[i] = bits >> 16;
+        memcpy(&bits, &data->floatsB[i], sizeof(bits));
+        data->bf16B[i] = bits >> 16;
+    }
+
+    uint64_t state = 0x9e3779b97f4a7c15ULL;
+    for (auto &word: data->words) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        word = state ^ (state >> 29);
+    }
+
+    return data;
+}
+
+/**
+ * Scalar references, the empty asm statements keep the compiler from vectorizing them.
+ */
+
+[[maybe_unused]] static uint64_t dotU8Scalar(const SelfTestData &data) {
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < kSelfTestSize; i++) {
+        sum += data.bytesA[i] * data.bytesB[i];
+        asm volatile("" : "+r"(sum));
+    }
+
+    return sum;
+}
+
+[[maybe_unused]] static uint64_t dotF32Scalar(const SelfTestData &data) {
+    float sum = 0;
+
+    // Not vectorized without -ffast-math, as that would change the rounding
+    for (size_t i = 0; i < kSelfTestSize; i++) {
+        sum += data.floatsA[i] * data.floatsB[i];
+    }
+
+    return static_cast<uint64_t>(sum);
+}
+
+[[maybe_unused]] static uint64_t crc32cScalar(const SelfTestData &data) {
+    uint32_t crc = 0xffffffff;
+
+    for (auto byte: data.bytesA) {
+        crc ^= byte;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+        }
+    }
+
+    return crc ^ 0xffffffff;
+}
+
+[[maybe_unused]] static uint64_t popcountScalar(const SelfTestData &data) {
+    uint64_t count = 0;
+
+    for (auto word: data.words) {
+        word = word - ((word >> 1) & 0x5555555555555555ULL);
+        word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        count += (word * 0x0101010101010101ULL) >> 56;
+        asm volatile("" : "+r"(count));
+    }
+
+    return count;
+}
+
+[[maybe_unused]] static uint64_t pextScalar(const SelfTestData &data) {
+    uint64_t checksum = 0;
+
+    for (auto word: data.words) {
+        uint64_t result = 0;
+        uint64_t mask = kPextMask;
+
+        for (uint64_t bit = 1; mask != 0; bit <<= 1) {
+            if (word & mask & (0 - mask)) {
+                result |= bit;
+            }
+            mask &= mask - 1;
+        }
+
+        checksum = (checksum * 31) ^ result;
+    }
+
+    return checksum;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+static uint64_t crc32cSse42(const SelfTestData &data) {
+    uint64_t crc = 0xffffffff;
+
+    for (size_t i = 0; i < kSelfTestSize; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data.bytesA + i, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+    }
+
+    return crc ^ 0xffffffff;
+}
+
+__attribute__((target("popcnt")))
+static uint64_t popcountPopcnt(const SelfTestData &data) {
+    uint64_t count = 0;
+
+    for (auto word: data.words) {
+        count += __builtin_popcountll(word);
+    }
+
+    return count;
+}
+
+__attribute__((target("bmi2")))
+static uint64_t pextBmi2(const SelfTestData &data) {
+    uint64_t checksum = 0;
+
+    for (auto word: data.words) {
+        checksum = (checksum * 31) ^ _pext_u64(word, kPextMask);
+    }
+
+    return checksum;
+}
+
+__attribute__((target("avx")))
+static uint64_t dotF32Avx(const SelfTestData &data) {
+    auto sum = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 8) {
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_load_ps(data.floatsA + i),
+                                               _mm256_load_ps(data.floatsB + i)));
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sum);
+
+    float total = 0;
+    for (auto lane: lanes) {
+        total += lane;
+    }
+
+    return static_cast<uint64_t>(total);
+}
+
+__attribute__((target("avx,fma")))
+static uint64_t dotF32Fma3(const SelfTestData &data) {
+    auto sum = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 8) {
+        sum = _mm256_fmadd_ps(_mm256_load_ps(data.floatsA + i), _mm256_load_ps(data.floatsB + i),
+                              sum);
+    }
+
+    alignas(32) float lanes[8];
+    _mm256_store_ps(lanes, sum);
+
+    float total = 0;
+    for (auto lane: lanes) {
+        total += lane;
+    }
+
+    return static_cast<uint64_t>(total);
+}
+
+__attribute__((target("avx2")))
+static uint64_t dotU8Avx2(const SelfTestData &data) {
+    auto ones = _mm256_set1_epi16(1);
+    auto sum = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 32) {
+        auto a = _mm256_load_si256(reinterpret_cast<const __m256i *>(data.bytesA + i));
+        auto b = _mm256_load_si256(reinterpret_cast<const __m256i *>(data.bytesB + i));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(a, b), ones));
+    }
+
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+
+    uint64_t total = 0;
+    for (auto lane: lanes) {
+        total += lane;
+    }
+
+    return total;
+}
+
+__attribute__((target("avx2,avxvnni")))
+static uint64_t dotU8AvxVnni(const SelfTestData &data) {
+    auto sum = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 32) {
+        auto a = _mm256_load_si256(reinterpret_cast<const __m256i *>(data.bytesA + i));
+        auto b = _mm256_load_si256(reinterpret_cast<const __m256i *>(data.bytesB + i));
+        sum = _mm256_dpbusd_avx_epi32(sum, a, b);
+    }
+
+    alignas(32) uint32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+
+    uint64_t total = 0;
+    for (auto lane: lanes) {
+        total += lane;
+    }
+
+    return total;
+}
+
+__attribute__((target("avx512f")))
+static uint64_t dotF32Avx512(const SelfTestData &data) {
+    auto sum = _mm512_setzero_ps();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 16) {
+        sum = _mm512_fmadd_ps(_mm512_load_ps(data.floatsA + i), _mm512_load_ps(data.floatsB + i),
+                              sum);
+    }
+
+    return static_cast<uint64_t>(_mm512_reduce_add_ps(sum));
+}
+
+__attribute__((target("avx512f,avx512vnni")))
+static uint64_t dotU8Avx512Vnni(const SelfTestData &data) {
+    auto sum = _mm512_setzero_si512();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 64) {
+        sum = _mm512_dpbusd_epi32(sum, _mm512_load_si512(data.bytesA + i),
+                                  _mm512_load_si512(data.bytesB + i));
+    }
+
+    return static_cast<uint32_t>(_mm512_reduce_add_epi32(sum));
+}
+
+__attribute__((target("avx512f,avx512bf16")))
+static uint64_t dotBf16Avx512(const SelfTestData &data) {
+    auto sum = _mm512_setzero_ps();
+
+    for (size_t i = 0; i < kSelfTestSize; i += 32) {
+        auto a = (__m512bh) _mm512_load_si512(data.bf16A + i);
+        auto b = (__m512bh) _mm512_load_si512(data.bf16B + i);
+        sum = _mm512_dpbf16_ps(sum, a, b);
+    }
+
+    return static_cast<uint64_t>(_mm512_reduce_add_ps(sum));
+}
+#endif
+
+#if defined(__aarch64__)
+static uint64_t dotU8Neon(const SelfTestData &data) {
+    auto sum = vdupq_n_u32(0);
+
+    for (size_t i = 0; i < kSelfTestSize; i += 16) {
+        auto a = vld1q_u8(data.bytesA + i);
+        auto b = vld1q_u8(data.bytesB + i);
+        sum = vpadalq_u16(sum, vmull_u8(vget_low_u8(a), vget_low_u8(b)));
+        sum = vpadalq_u16(sum, vmull_high_u8(a, b));
+    }
+
+    return vaddlvq_u32(sum);
+}
+
+static uint64_t dotF32Neon(const SelfTestData &data) {
+    auto sum = vdupq_n_f32(0);
+
+    for (size_t i = 0; i < kSelfTestSize; i += 4) {
+        sum = vfmaq_f32(sum, vld1q_f32(data.floatsA + i), vld1q_f32(data.floatsB + i));
+    }
+
+    return static_cast<uint64_t>(vaddvq_f32(sum));
+}
+#endif
+
+#ifdef HAS_ARM_EXTENSION_KERNELS
+__attribute__((target("+dotprod")))
+static uint64_t dotU8NeonDot(const SelfTestData &data) {
+    auto sum = vdupq_n_u32(0);
+
+    for (size_t i = 0; i < kSelfTestSize; i += 16) {
+        sum = vdotq_u32(sum, vld1q_u8(data.bytesA + i), vld1q_u8(data.bytesB + i));
+    }
+
+    return vaddlvq_u32(sum);
+}
+
+/**
+ * UMMLA multiplies a 2x8 matrix by the transpose of another, the diagonal of the 2x2 result
+ * (lanes 0 and 3) is the dot product of the 16 bytes.
+ */
+__attribute__((target("+i8mm")))
+static uint64_t dotU8I8mm(const SelfTestData &data) {
+    auto sum = vdupq_n_u32(0);
+
+    for (size_t i = 0; i < kSelfTestSize; i += 16) {
+        sum = vmmlaq_u32(sum, vld1q_u8(data.bytesA + i), vld1q_u8(data.bytesB + i));
+    }
+
+    return static_cast<uint64_t>(vgetq_lane_u32(sum, 0)) + vgetq_lane_u32(sum, 3);
+}
+
+__attribute__((target("+bf16")))
+static uint64_t dotBf16Neon(const SelfTestData &data) {
+    auto sum = vdupq_n_f32(0);
+
+    for (size_t i = 0; i < kSelfTestSize; i += 8) {
+        auto a = vreinterpretq_bf16_u16(vld1q_u16(data.bf16A + i));
+        auto b = vreinterpretq_bf16_u16(vld1q_u16(data.bf16B + i));
+        sum = vbfdotq_f32(sum, a, b);
+    }
+
+    return static_cast<uint64_t>(vaddvq_f32(sum));
+}
+
+__attribute__((target("+crc")))
+static uint64_t crc32cArm(const SelfTestData &data) {
+    uint32_t crc = 0xffffffff;
+
+    for (size_t i = 0; i < kSelfTestSize; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data.bytesA + i, sizeof(word));
+        crc = __crc32cd(crc, word);
+    }
+
+    return crc ^ 0xffffffff;
+}
+#endif
+
+#ifdef HAS_SVE_KERNELS
+__attribute__((target("+sve")))
+static uint64_t dotF32Sve(const SelfTestData &data) {
+    auto sum = svdup_f32(0);
+
+    for (uint64_t i = 0; i < kSelfTestSize; i += svcntw()) {
+        auto pg = svwhilelt_b32_u64(i, kSelfTestSize);
+        sum = svmla_f32_m(pg, sum, svld1_f32(pg, data.floatsA + i),
+                          svld1_f32(pg, data.floatsB + i));
+    }
+
+    return static_cast<uint64_t>(svaddv_f32(svptrue_b32(), sum));
+}
+
+/**
+ * Bytes are widened to 16 bits by the loads, then multiplied and accumulated to 32 bits by the
+ * SVE2 widening multiply-add, even elements first and odd ones second.
+ */
+__attribute__((target("+sve2")))
+static uint64_t dotU8Sve2(const SelfTestData &data) {
+    auto sum = svdup_u32(0);
+
+    for (uint64_t i = 0; i < kSelfTestSize; i += svcnth()) {
+        auto pg = svwhilelt_b16_u64(i, kSelfTestSize);
+        auto a = svld1ub_u16(pg, data.bytesA + i);
+        auto b = svld1ub_u16(pg, data.bytesB + i);
+        sum = svmlalb_u32(sum, a, b);
+        sum = svmlalt_u32(sum, a, b);
+    }
+
+    return svaddv_u32(svptrue_b32(), sum);
+}
+#endif
+
+/**
+ * Features without a kernel here are only reported as detected.
+ */
+static const SelfTest kSelfTests[] = {
+#if defined(__x86_64__)
+        {X86_SSE4_2, crc32cSse42, crc32cScalar},
+        {X86_POPCNT, popcountPopcnt, popcountScalar},
+        {X86_BMI2, pextBmi2, pextScalar},
+        {X86_AVX, dotF32Avx, dotF32Scalar},
+        {X86_FMA3, dotF32Fma3, dotF32Scalar},
+        {X86_AVX2, dotU8Avx2, dotU8Scalar},
+        {X86_AVXVNNI, dotU8AvxVnni, dotU8Scalar},
+        {X86_AVX512F, dotF32Avx512, dotF32Scalar},
+        {X86_AVX512VNNI, dotU8Avx512Vnni, dotU8Scalar},
+        {X86_AVX512BF16, dotBf16Avx512, dotF32Scalar},
+#elif defined(__aarch64__)
+        {ARM_NEON, dotU8Neon, dotU8Scalar},
+        {ARM_NEON_FMA, dotF32Neon, dotF32Scalar},
+#ifdef HAS_ARM_EXTENSION_KERNELS
+        {ARM_NEON_DOT, dotU8NeonDot, dotU8Scalar},
+        {ARM_I8MM, dotU8I8mm, dotU8Scalar},
+        {ARM_NEON_BF16, dotBf16Neon, dotF32Scalar},
+        {ARM_CRC32, crc32cArm, crc32cScalar},
+#endif
+#ifdef HAS_SVE_KERNELS
+        {ARM_SVE, dotF32Sve, dotF32Scalar},
+        {ARM_SVE2, dotU8Sve2, dotU8Scalar},
+#endif
+#endif
+        // Keeps the array from being empty on other architectures
+        {IsaFeature(UINT32_MAX), nullptr, nullptr},
+};
+
+static thread_local sigjmp_buf *tIllegalInstructionJump = nullptr;
+static struct sigaction sPreviousIllegalInstructionAction;
+
+static void onIllegalInstruction(int signal) {
+    if (tIllegalInstructionJump != nullptr) {
+        siglongjmp(*tIllegalInstructionJump, 1);
+    }
+
+    // Not raised by a self-test, let the previous handler deal with it when the instruction is
+    // executed again
+    sigaction(SIGILL, &sPreviousIllegalInstructionAction, nullptr);
+}
+
+/**
+ * Run a kernel once, catching SIGILL in case the CPU doesn't implement what it claims to.
+ *
+ * @return Whether the kernel ran, result is only set if true
+ */
+static bool tryRun(SelfTestKernel kernel, const SelfTestData &data, uint64_t &result) {
+    struct sigaction action{};
+    action.sa_handler = onIllegalInstruction;
+    sigemptyset(&action.sa_mask);
+
+    sigaction(SIGILL, &action, &sPreviousIllegalInstructionAction);
+
+    sigjmp_buf jump;
+    if (sigsetjmp(jump, 1) != 0) {
+        tIllegalInstructionJump = nullptr;
+        sigaction(SIGILL, &sPreviousIllegalInstructionAction, nullptr);
+        return false;
+    }
+
+    tIllegalInstructionJump = &jump;
+    result = kernel(data);
+    tIllegalInstructionJump = nullptr;
+
+    sigaction(SIGILL, &sPreviousIllegalInstructionAction, nullptr);
+
+    return true;
+}
+
+static double measureKernel(SelfTestKernel kernel, const SelfTestData &data) {
+    MeasureOptions options;
+    options.targetNs = 5000000;
+    options.warmups = 1;
+    options.repetitions = 3;
+
+    return measure([&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            auto result = kernel(data);
+            doNotOptimize(result);
+        }
+
+        return iterations * kSelfTestSize;
+    }, options).bestOpsPerSecond;
+}
+
+static const char *getFeatureName(IsaFeature feature) {
+    size_t count;
+    auto infos = getIsaFeatureInfos(&count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (infos[i].feature == feature) {
+            return infos[i].name;
+        }
+    }
+
+    return "unknown";
+}
+
+static void runSelfTests(BenchmarkReport::Section &section, uint64_t features,
+                         const SelfTestData &data) {
+    using Unit = BenchmarkReport::Unit;
+
+    // Scalar references are shared by several kernels, measure each of them once
+    std::map<SelfTestKernel, double> referenceOpsPerSecond;
+
+    for (auto &selfTest: kSelfTests) {
+        if (selfTest.kernel == nullptr || (features & (UINT64_C(1) << selfTest.feature)) == 0) {
+            continue;
+        }
+
+        std::string name = getFeatureName(selfTest.feature);
+
+        uint64_t result;
+        auto verified = tryRun(selfTest.kernel, data, result)
+                        && result == selfTest.reference(data);
+
+        section.add(name + "_verified", Unit::BOOLEAN, verified);
+        if (!verified) {
+            continue;
+        }
+
+        auto reference = referenceOpsPerSecond.find(selfTest.reference);
+        if (reference == referenceOpsPerSecond.end()) {
+            reference = referenceOpsPerSecond.emplace(
+                    selfTest.reference, measureKernel(selfTest.reference, data)).first;
+        }
+
+        section.add(name + "_speedup", Unit::NONE,
+                    measureKernel(selfTest.kernel, data) / reference->second);
+    }
+}
+
+BenchmarkReport runIsaBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    auto features = getIsaFeatures();
+
+    size_t count;
+    auto infos = getIsaFeatureInfos(&count);
+
+    auto &featuresSection = report.addSection("Features");
+    for (size_t i = 0; i < count; i++) {
+        featuresSection.add(infos[i].name, Unit::BOOLEAN,
+                            (features & (UINT64_C(1) << infos[i].feature)) != 0);
+    }
+
+    auto data = createSelfTestData();
+
+    for (auto &cluster: getUarchClusters()) {
+        auto &section = report.addSection("Cluster " + std::to_string(cluster.index));
+
+        ScopedAffinity affinity(cluster.linuxIds[0]);
+
+        section.add("cpu", Unit::NONE, cluster.linuxIds[0]);
+        section.add("uarch", Unit::UARCH, cluster.uarch);
+        section.add("pinned", Unit::BOOLEAN, affinity.isPinned());
+
+        runSelfTests(section, features, *data);
+    }
+
+    return report;
+}
@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Report the instruction set extensions cpuinfo detected, then on each microarchitecture run a
+ * small kernel compiled for every extension that has one, check its result against a scalar
+ * implementation and measure the speedup over it.
+ * A kernel that raises SIGILL is reported as not verified instead of crashing the process.
+ * cpuinfo must be initialized.
+ */
+BenchmarkReport runIsaBenchmark();
@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpuinfo.h>
+#include <iterator>
+#include "IsaFeatures.h"
+
+static const IsaFeatureInfo kIsaFeatureInfos[] = {
+#if defined(__aarch64__) || defined(__arm__)
+        {ARM_NEON, "neon", cpuinfo_has_arm_neon},
+        {ARM_NEON_FMA, "neon_fma", cpuinfo_has_arm_neon_fma},
+        {ARM_NEON_FP16_ARITH, "neon_fp16_arith", cpuinfo_has_arm_neon_fp16_arith},
+        {ARM_NEON_RDM, "neon_rdm", cpuinfo_has_arm_neon_rdm},
+        {ARM_NEON_DOT, "neon_dot", cpuinfo_has_arm_neon_dot},
+        {ARM_I8MM, "i8mm", cpuinfo_has_arm_i8mm},
+        {ARM_NEON_BF16, "neon_bf16", cpuinfo_has_arm_neon_bf16},
+        {ARM_FHM, "fhm", cpuinfo_has_arm_fhm},
+        {ARM_ATOMICS, "atomics", cpuinfo_has_arm_atomics},
+        {ARM_CRC32, "crc32", cpuinfo_has_arm_crc32},
+        {ARM_AES, "aes", cpuinfo_has_arm_aes},
+        {ARM_PMULL, "pmull", cpuinfo_has_arm_pmull},
+        {ARM_SHA1, "sha1", cpuinfo_has_arm_sha1},
+        {ARM_SHA2, "sha2", cpuinfo_has_arm_sha2},
+        {ARM_SVE, "sve", cpuinfo_has_arm_sve},
+        {ARM_SVE2, "sve2", cpuinfo_has_arm_sve2},
+        {ARM_SVE_BF16, "sve_bf16", cpuinfo_has_arm_sve_bf16},
+        {ARM_SME, "sme", cpuinfo_has_arm_sme},
+        {ARM_SME2, "sme2", cpuinfo_has_arm_sme2},
+#elif defined(__riscv)
+        {RISCV_V, "v", cpuinfo_has_riscv_v},
+#elif defined(__x86_64__) || defined(__i386__)
+        {X86_SSE2, "sse2", cpuinfo_has_x86_sse2},
+        {X86_SSSE3, "ssse3", cpuinfo_has_x86_ssse3},
+        {X86_SSE4_1, "sse4_1", cpuinfo_has_x86_sse4_1},
+        {X86_SSE4_2, "sse4_2", cpuinfo_has_x86_sse4_2},
+        {X86_POPCNT, "popcnt", cpuinfo_has_x86_popcnt},
+        {X86_AES, "aes", cpuinfo_has_x86_aes},
+        {X86_SHA, "sha", cpuinfo_has_x86_sha},
+        {X86_F16C, "f16c", cpuinfo_has_x86_f16c},
+        {X86_FMA3, "fma3", cpuinfo_has_x86_fma3},
+        {X86_BMI2, "bmi2", cpuinfo_has_x86_bmi2},
+        {X86_AVX, "avx", cpuinfo_has_x86_avx},
+        {X86_AVX2, "avx2", cpuinfo_has_x86_avx2},
+        {X86_AVX512F, "avx512f", cpuinfo_has_x86_avx512f},
+        {X86_AVX512DQ, "avx512dq", cpuinfo_has_x86_avx512dq},
+        {X86_AVX512BW, "avx512bw", cpuinfo_has_x86_avx512bw},
+        {X86_AVX512VL, "avx512vl", cpuinfo_has_x86_avx512vl},
+        {X86_AVX512VNNI, "avx512vnni", cpuinfo_has_x86_avx512vnni},
+        {X86_AVX512BF16, "avx512bf16", cpuinfo_has_x86_avx512bf16},
+        {X86_AVX512FP16, "avx512fp16", cpuinfo_has_x86_avx512fp16},
+        {X86_AVXVNNI, "avxvnni", cpuinfo_has_x86_avxvnni},
+        {X86_AMX_TILE, "amx_tile", cpuinfo_has_x86_amx_tile},
+#endif
+};
+
+const IsaFeatureInfo *getIsaFeatureInfos(size_t *count) {
+    *count = std::size(kIsaFeatureInfos);
+    return kIsaFeatureInfos;
+}
+
+uint64_t getIsaFeatures() {
+    uint64_t features = 0;
+
+    for (auto &info: kIsaFeatureInfos) {
+        if (info.isSupported()) {
+            features |= UINT64_C(1) << info.feature;
+        }
+    }
+
+    return features;
+}
@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Instruction set extensions reported by cpuinfo, as bit indices of a 64 bit mask.
+ * ARM extensions use bits 0-23, RISC-V ones bits 24-31 and x86 ones the high 32 bits, values
+ * are never reused.
+ *
+ * Must be kept in sync with IsaFeature.kt.
+ */
+enum IsaFeature : uint32_t {
+    ARM_NEON = 0,
+    ARM_NEON_FMA = 1,
+    ARM_NEON_FP16_ARITH = 2,
+    ARM_NEON_RDM = 3,
+    ARM_NEON_DOT = 4,
+    ARM_I8MM = 5,
+    ARM_NEON_BF16 = 6,
+    ARM_FHM = 7,
+    ARM_ATOMICS = 8,
+    ARM_CRC32 = 9,
+    ARM_AES = 10,
+    ARM_PMULL = 11,
+    ARM_SHA1 = 12,
+    ARM_SHA2 = 13,
+    ARM_SVE = 14,
+    ARM_SVE2 = 15,
+    ARM_SVE_BF16 = 16,
+    ARM_SME = 17,
+    ARM_SME2 = 18,
+
+    RISCV_V = 24,
+
+    X86_SSE2 = 32,
+    X86_SSSE3 = 33,
+    X86_SSE4_1 = 34,
+    X86_SSE4_2 = 35,
+    X86_POPCNT = 36,
+    X86_AES = 37,
+    X86_SHA = 38,
+    X86_F16C = 39,
+    X86_FMA3 = 40,
+    X86_BMI2 = 41,
+    X86_AVX = 42,
+    X86_AVX2 = 43,
+    X86_AVX512F = 44,
+    X86_AVX512DQ = 45,
+    X86_AVX512BW = 46,
+    X86_AVX512VL = 47,
+    X86_AVX512VNNI = 48,
+    X86_AVX512BF16 = 49,
+    X86_AVX512FP16 = 50,
+    X86_AVXVNNI = 51,
+    X86_AMX_TILE = 52,
+};
+
+struct IsaFeatureInfo {
+    IsaFeature feature;
+    /**
+     * Lowercase name, usable as a benchmark report entry.
+     */
+    const char *name;
+    bool (*isSupported)();
+};
+
+/**
+ * Get the features that apply to the architecture this was built for.
+ */
+const IsaFeatureInfo *getIsaFeatureInfos(size_t *count);
+
+/**
+ * Get the mask of the features supported by every processor. cpuinfo must be initialized.
+ */
+uint64_t getIsaFeatures();
@@ -0,0 +1,315 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cpuinfo.h>
+#include <cstring>
+#include <random>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <utility>
+#include "BenchmarkHarness.h"
+#include "MemoryBenchmark.h"
+
+using namespace benchmark_harness;
+
+static constexpr size_t kMinimumSize = 4 * 1024;
+static constexpr size_t kMaximumSize = 256 * 1024 * 1024;
+
+/**
+ * Working sets are sized at 1, 1.25, 1.5 and 1.75 times each power of two, which includes the
+ * non power of two sizes caches commonly come in (48 KiB, 12 MiB...).
+ */
+static constexpr size_t kStepsPerOctave = 4;
+
+/**
+ * A latency at least this many times the previous point marks the start of a transition to the
+ * next level, which ends once the curve is flat again.
+ */
+static constexpr double kKneeRatio = 1.25;
+static constexpr double kPlateauRatio = 1.1;
+
+static const MeasureOptions kMeasureOptions = {
+        .targetNs = 5000000,
+        .warmups = 1,
+        .repetitions = 3,
+};
+
+using Curve = std::vector<std::pair<size_t, double>>;
+
+static std::vector<size_t> getSizes(size_t maximumSize, size_t stepsPerOctave) {
+    std::vector<size_t> sizes;
+
+    for (size_t octave = kMinimumSize; octave <= maximumSize; octave *= 2) {
+        for (size_t step = 0; step < stepsPerOctave; step++) {
+            auto size = octave + octave * step / stepsPerOctave;
+            if (size <= maximumSize) {
+                sizes.push_back(size);
+            }
+        }
+    }
+
+    return sizes;
+}
+
+/**
+ * Don't ask for more than a quarter of the RAM, the system would start killing apps.
+ */
+static size_t getMaximumSize() {
+    auto physicalPages = sysconf(_SC_PHYS_PAGES);
+    auto pageSize = sysconf(_SC_PAGESIZE);
+    if (physicalPages <= 0 || pageSize <= 0) {
+        return kMaximumSize;
+    }
+
+    auto quarter = static_cast<size_t>(physicalPages) * static_cast<size_t>(pageSize) / 4;
+
+    size_t size = kMinimumSize;
+    while (size * 2 <= std::min(quarter, kMaximumSize)) {
+        size *= 2;
+    }
+
+    return size;
+}
+
+/**
+ * Link the first size bytes of the buffer into a single random cycle with one pointer per
+ * stride bytes, so that every load depends on the previous one and prefetchers can't help.
+ *
+ * @return The start of the cycle
+ */
+static void *buildChain(uint8_t *buffer, size_t size, size_t stride) {
+    auto count = size / stride;
+
+    // Sattolo's algorithm, yields a permutation made of a single cycle
+    std::vector<uint32_t> next(count);
+    for (size_t i = 0; i < count; i++) {
+        next[i] = static_cast<uint32_t>(i);
+    }
+
+    std::mt19937_64 random(count);
+    for (size_t i = count - 1; i > 0; i--) {
+        std::swap(next[i], next[random() % i]);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        *reinterpret_cast<void **>(buffer + i * stride) = buffer + next[i] * stride;
+    }
+
+    return buffer;
+}
+
+static uint64_t chase(void *&pointer, uint64_t iterations) {
+    auto p = pointer;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+    }
+
+    pointer = p;
+
+    return iterations * 8;
+}
+
+static uint64_t readBuffer(const uint64_t *data, size_t words, uint64_t iterations) {
+    uint64_t a = 0, b = 0, c = 0, d = 0;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (size_t j = 0; j < words; j += 4) {
+            a += data[j];
+            b += data[j + 1];
+            c += data[j + 2];
+            d += data[j + 3];
+        }
+        doNotOptimize(a);
+    }
+
+    auto sum = a + b + c + d;
+    doNotOptimize(sum);
+
+    return iterations * words * sizeof(uint64_t);
+}
+
+static uint64_t writeBuffer(uint64_t *data, size_t words, uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        for (size_t j = 0; j < words; j++) {
+            data[j] = i;
+        }
+        doNotOptimize(data);
+    }
+
+    return iterations * words * sizeof(uint64_t);
+}
+
+/**
+ * Copy half of the working set to the other half, counted as the bytes read plus the bytes
+ * written like the other kernels.
+ */
+static uint64_t copyBuffer(uint8_t *data, size_t size, uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        memcpy(data + size / 2, data, size / 2);
+        doNotOptimize(data);
+    }
+
+    return iterations * size;
+}
+
+/**
+ * Find where the latency curve starts climbing to the next level.
+ *
+ * @return The largest working set of each level, with the lowest latency seen in the level
+ */
+static Curve findKnees(const Curve &latencies) {
+    Curve knees;
+
+    auto rising = false;
+    double levelLatency = INFINITY;
+    for (size_t i = 0; i + 1 < latencies.size(); i++) {
+        auto ratio = latencies[i + 1].second / latencies[i].second;
+
+        if (!rising) {
+            levelLatency = std::min(levelLatency, latencies[i].second);
+        }
+
+        if (!rising && ratio >= kKneeRatio) {
+            knees.emplace_back(latencies[i].first, levelLatency);
+            rising = true;
+        } else if (rising && ratio < kPlateauRatio) {
+            rising = false;
+            levelLatency = INFINITY;
+        }
+    }
+
+    return knees;
+}
+
+/**
+ * Add the size reported by cpuinfo for a cache level next to the closest knee, if there's one
+ * within a factor of 2.
+ */
+static void addCache(BenchmarkReport::Section &section, const char *name,
+                     const cpuinfo_cache *cache,
+                     const Curve &knees) {
+    using Unit = BenchmarkReport::Unit;
+
+    if (cache == nullptr) {
+        return;
+    }
+
+    section.add(std::string(name) + "_reported_size", Unit::BYTES, cache->size);
+
+    const std::pair<size_t, double> *closest = nullptr;
+    double closestDistance = 0;
+    for (auto &knee: knees) {
+        auto distance = std::fabs(std::log2(static_cast<double>(knee.first) / cache->size));
+        if (distance <= 1 && (closest == nullptr || distance < closestDistance)) {
+            closest = &knee;
+            closestDistance = distance;
+        }
+    }
+
+    if (closest != nullptr) {
+        section.add(std::string(name) + "_detected_size", Unit::BYTES, closest->first);
+        section.add(std::string(name) + "_latency", Unit::NANOSECONDS, closest->second);
+    }
+}
+
+BenchmarkReport runMemoryBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    auto maximumSize = getMaximumSize();
+
+    auto buffer = static_cast<uint8_t *>(mmap(nullptr, maximumSize, PROT_READ | PROT_WRITE,
+                                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (buffer == MAP_FAILED) {
+        return report;
+    }
+
+    // Fault everything in now, so that page faults don't end up in the measurements
+    memset(buffer, 1, maximumSize);
+
+    for (auto &cluster: getUarchClusters()) {
+        auto processor = cpuinfo_get_processor(cpuinfo_get_cluster(cluster.index)->processor_start);
+
+        size_t stride = 64;
+        if (processor->cache.l1d != nullptr && processor->cache.l1d->line_size > stride) {
+            stride = processor->cache.l1d->line_size;
+        }
+
+        auto clusterName = "Cluster " + std::to_string(cluster.index);
+
+        ScopedAffinity affinity(cluster.linuxIds[0]);
+
+        Curve latencies;
+        for (auto size: getSizes(maximumSize, kStepsPerOctave)) {
+            auto pointer = buildChain(buffer, size, stride);
+
+            auto measurement = measure([&](uint64_t iterations) {
+                return chase(pointer, iterations);
+            }, kMeasureOptions);
+
+            doNotOptimize(pointer);
+
+            latencies.emplace_back(size, kNsPerSecond / measurement.bestOpsPerSecond);
+        }
+
+        Curve readBandwidths, writeBandwidths, copyBandwidths;
+        for (auto size: getSizes(maximumSize, 1)) {
+            auto data = reinterpret_cast<uint64_t *>(buffer);
+            auto words = size / sizeof(uint64_t);
+
+            readBandwidths.emplace_back(size, measure([&](uint64_t iterations) {
+                return readBuffer(data, words, iterations);
+            }, kMeasureOptions).bestOpsPerSecond);
+
+            writeBandwidths.emplace_back(size, measure([&](uint64_t iterations) {
+                return writeBuffer(data, words, iterations);
+            }, kMeasureOptions).bestOpsPerSecond);
+
+            copyBandwidths.emplace_back(size, measure([&](uint64_t iterations) {
+                return copyBuffer(buffer, size, iterations);
+            }, kMeasureOptions).bestOpsPerSecond);
+        }
+
+        auto knees = findKnees(latencies);
+
+        auto &caches = report.addSection(clusterName + " caches");
+        caches.add("cpu", Unit::NONE, cluster.linuxIds[0]);
+        caches.add("uarch", Unit::UARCH, cluster.uarch);
+        caches.add("pinned", Unit::BOOLEAN, affinity.isPinned());
+        addCache(caches, "l1d", processor->cache.l1d, knees);
+        addCache(caches, "l2", processor->cache.l2, knees);
+        addCache(caches, "l3", processor->cache.l3, knees);
+        addCache(caches, "l4", processor->cache.l4, knees);
+        for (size_t i = 0; i < knees.size(); i++) {
+            caches.add("knee_" + std::to_string(i), Unit::BYTES, knees[i].first);
+        }
+        caches.add("memory_latency", Unit::NANOSECONDS, latencies.back().second);
+
+        auto &latency = report.addSection(clusterName + " latency");
+        for (auto &[size, value]: latencies) {
+            latency.add("latency_" + std::to_string(size), Unit::NANOSECONDS, value);
+        }
+
+        auto &bandwidth = report.addSection(clusterName + " bandwidth");
+        for (size_t i = 0; i < readBandwidths.size(); i++) {
+            auto size = std::to_string(readBandwidths[i].first);
+            bandwidth.add("read_" + size, Unit::BYTES_PER_SECOND, readBandwidths[i].second);
+            bandwidth.add("write_" + size, Unit::BYTES_PER_SECOND, writeBandwidths[i].second);
+            bandwidth.add("copy_" + size, Unit::BYTES_PER_SECOND, copyBandwidths[i].second);
+        }
+    }
+
+    munmap(buffer, maximumSize);
+
+    return report;
+}
@@ -0,0 +1,18 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Sweep working sets from 4 KiB to a few hundred MiB with the calling thread pinned to each
+ * microarchitecture in turn, measuring load-to-use latency with a random pointer chase and
+ * read, write and copy bandwidth.
+ *
+ * Knees of the latency curve are matched against the cache sizes reported by cpuinfo, so that
+ * wrong vendor data can be spotted. cpuinfo must be initialized.
+ */
+BenchmarkReport runMemoryBenchmark();
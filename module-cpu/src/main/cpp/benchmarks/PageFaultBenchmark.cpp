@@ -0,0 +1,302 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "BenchmarkHarness.h"
+#include "PageFaultBenchmark.h"
+#include "PageInfo.h"
+
+// Linux 5.14+, not in older headers
+#ifndef MADV_POPULATE_READ
+#define MADV_POPULATE_READ 22
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+using namespace benchmark_harness;
+
+static constexpr size_t kRegionSize = 64 * 1024 * 1024;
+
+/**
+ * Fault measurements need a fresh mapping each time, so they can't go through measure().
+ */
+static constexpr uint32_t kRepetitions = 5;
+
+static const size_t kChurnSizes[] = {
+        0, // Page size
+        64 * 1024,
+        1024 * 1024,
+        16 * 1024 * 1024,
+};
+
+static const MeasureOptions kChurnMeasureOptions = {
+        .targetNs = 5000000,
+        .warmups = 1,
+        .repetitions = 3,
+};
+
+/**
+ * Don't ask for more than an eighth of the RAM, the region is mapped and faulted repeatedly.
+ */
+static size_t getRegionSize(size_t granularity) {
+    size_t size = kRegionSize;
+
+    auto physicalPages = sysconf(_SC_PHYS_PAGES);
+    if (physicalPages > 0) {
+        size = std::min(size, static_cast<size_t>(physicalPages) * page_info::getPageSize() / 8);
+    }
+
+    return size / granularity * granularity;
+}
+
+static void touchPages(uint8_t *data, size_t size, size_t pageSize) {
+    for (size_t offset = 0; offset < size; offset += pageSize) {
+        data[offset] = 1;
+    }
+}
+
+/**
+ * Time an operation on a new mapping, best of kRepetitions.
+ *
+ * @param operation Returns false if it isn't supported
+ * @return The best duration in ns, -1 if the mapping or the operation failed
+ */
+static int64_t measureFreshMapping(size_t size, size_t alignment, bool hugePages,
+                                   const std::function<bool(uint8_t *data)> &operation) {
+    int64_t bestNs = -1;
+
+    for (uint32_t i = 0; i < kRepetitions; i++) {
+        AlignedMapping mapping(size, alignment);
+        if (mapping.data() == nullptr) {
+            return -1;
+        }
+
+        if (hugePages) {
+            madvise(mapping.data(), size, MADV_HUGEPAGE);
+        }
+
+        auto startNs = nowNs();
+        if (!operation(mapping.data())) {
+            return -1;
+        }
+        auto elapsedNs = nowNs() - startNs;
+
+        if (bestNs < 0 || elapsedNs < bestNs) {
+            bestNs = elapsedNs;
+        }
+    }
+
+    return bestNs;
+}
+
+static int64_t measureMapPopulate(size_t size) {
+    int64_t bestNs = -1;
+
+    for (uint32_t i = 0; i < kRepetitions; i++) {
+        auto startNs = nowNs();
+        auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        auto elapsedNs = nowNs() - startNs;
+
+        if (data == MAP_FAILED) {
+            return -1;
+        }
+        munmap(data, size);
+
+        if (bestNs < 0 || elapsedNs < bestNs) {
+            bestNs = elapsedNs;
+        }
+    }
+
+    return bestNs;
+}
+
+static double measureThpBackedRatio(size_t size, size_t thpSize) {
+    AlignedMapping mapping(size, thpSize);
+    if (mapping.data() == nullptr) {
+        return 0;
+    }
+
+    madvise(mapping.data(), size, MADV_HUGEPAGE);
+    touchPages(mapping.data(), size, page_info::getPageSize());
+
+    return static_cast<double>(page_info::getAnonHugePagesSize(mapping.data(), size))
+           / static_cast<double>(size);
+}
+
+/**
+ * @param touch Whether to write to every page before unmapping
+ * @return mmap()/munmap() pairs per second, 0 if mmap() failed
+ */
+static double measureChurn(size_t size, bool touch) {
+    auto pageSize = page_info::getPageSize();
+    auto failed = false;
+
+    auto measurement = measure([&](uint64_t iterations) {
+        for (uint64_t i = 0; i < iterations; i++) {
+            auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                             -1, 0);
+            if (data == MAP_FAILED) {
+                failed = true;
+                return iterations;
+            }
+
+            if (touch) {
+                touchPages(static_cast<uint8_t *>(data), size, pageSize);
+            }
+
+            munmap(data, size);
+        }
+
+        return iterations;
+    }, kChurnMeasureOptions);
+
+    return failed ? 0 : measurement.bestOpsPerSecond;
+}
+
+static double toBytesPerSecond(size_t size, int64_t ns) {
+    return static_cast<double>(size) * kNsPerSecond / static_cast<double>(std::max<int64_t>(ns, 1));
+}
+
+/**
+ * mTHP sizes that inherit the top level mode are reported with the mode they end up with.
+ */
+static void addThpMode(BenchmarkReport::Section &section, const std::string &name,
+                       page_info::ThpMode mode) {
+    using Unit = BenchmarkReport::Unit;
+
+    if (mode == page_info::INHERIT) {
+        mode = page_info::getThpMode();
+    }
+
+    section.add(name + "_enabled", Unit::BOOLEAN,
+                mode == page_info::MADVISE || mode == page_info::ALWAYS);
+    section.add(name + "_always", Unit::BOOLEAN, mode == page_info::ALWAYS);
+}
+
+static void addFaults(BenchmarkReport::Section &section, size_t thpSize) {
+    using Unit = BenchmarkReport::Unit;
+
+    auto pageSize = page_info::getPageSize();
+    auto size = getRegionSize(std::max(pageSize, thpSize));
+    if (size == 0) {
+        return;
+    }
+
+    section.add("region_size", Unit::BYTES, size);
+
+    auto touchNs = measureFreshMapping(size, pageSize, false, [&](uint8_t *data) {
+        touchPages(data, size, pageSize);
+        return true;
+    });
+    if (touchNs >= 0) {
+        section.add("first_touch_fault", Unit::NANOSECONDS,
+                    static_cast<double>(touchNs) / static_cast<double>(size / pageSize));
+        section.add("first_touch_throughput", Unit::BYTES_PER_SECOND,
+                    toBytesPerSecond(size, touchNs));
+    }
+
+    auto populateWriteNs = measureFreshMapping(size, pageSize, false, [&](uint8_t *data) {
+        return madvise(data, size, MADV_POPULATE_WRITE) == 0;
+    });
+    section.add("populate_write_supported", Unit::BOOLEAN, populateWriteNs >= 0);
+    if (populateWriteNs >= 0) {
+        section.add("populate_write_throughput", Unit::BYTES_PER_SECOND,
+                    toBytesPerSecond(size, populateWriteNs));
+        if (touchNs >= 0) {
+            section.add("populate_write_speedup", Unit::NONE,
+                        static_cast<double>(touchNs) / std::max<int64_t>(populateWriteNs, 1));
+        }
+    }
+
+    auto populateReadNs = measureFreshMapping(size, pageSize, false, [&](uint8_t *data) {
+        return madvise(data, size, MADV_POPULATE_READ) == 0;
+    });
+    section.add("populate_read_supported", Unit::BOOLEAN, populateReadNs >= 0);
+    if (populateReadNs >= 0) {
+        section.add("populate_read_throughput", Unit::BYTES_PER_SECOND,
+                    toBytesPerSecond(size, populateReadNs));
+    }
+
+    auto mapPopulateNs = measureMapPopulate(size);
+    if (mapPopulateNs >= 0) {
+        section.add("map_populate_throughput", Unit::BYTES_PER_SECOND,
+                    toBytesPerSecond(size, mapPopulateNs));
+    }
+
+    if (thpSize == 0) {
+        return;
+    }
+
+    auto thpTouchNs = measureFreshMapping(size, thpSize, true, [&](uint8_t *data) {
+        touchPages(data, size, pageSize);
+        return true;
+    });
+    if (thpTouchNs >= 0) {
+        section.add("thp_backed", Unit::RATIO, measureThpBackedRatio(size, thpSize));
+        section.add("thp_first_touch_fault", Unit::NANOSECONDS,
+                    static_cast<double>(thpTouchNs) / static_cast<double>(size / thpSize));
+        section.add("thp_first_touch_throughput", Unit::BYTES_PER_SECOND,
+                    toBytesPerSecond(size, thpTouchNs));
+    }
+}
+
+static void addChurn(BenchmarkReport::Section &section) {
+    using Unit = BenchmarkReport::Unit;
+
+    for (auto size: kChurnSizes) {
+        if (size == 0) {
+            size = page_info::getPageSize();
+        }
+
+        auto name = std::to_string(size);
+
+        section.add("mmap_munmap_" + name, Unit::OPS_PER_SECOND, measureChurn(size, false));
+        section.add("mmap_touch_munmap_" + name, Unit::OPS_PER_SECOND, measureChurn(size, true));
+    }
+}
+
+BenchmarkReport runPageFaultBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    auto thpMode = page_info::getThpMode();
+    auto thpSize = page_info::getThpSize();
+
+    auto &system = report.addSection("System");
+    system.add("page_size", Unit::BYTES, page_info::getPageSize());
+    addThpMode(system, "thp", thpMode);
+    if (thpSize != 0) {
+        system.add("thp_size", Unit::BYTES, thpSize);
+    }
+    for (auto &mthpSize: page_info::getMthpSizes()) {
+        addThpMode(system, "mthp_" + std::to_string(mthpSize.size), mthpSize.mode);
+    }
+
+    // Huge pages can be asked for with madvise() in both modes
+    auto usableThpSize = thpMode == page_info::MADVISE || thpMode == page_info::ALWAYS
+                         ? thpSize : 0;
+
+    for (auto &cluster: getUarchClusters()) {
+        auto &section = report.addSection("Cluster " + std::to_string(cluster.index));
+
+        ScopedAffinity affinity(cluster.linuxIds[0]);
+
+        section.add("cpu", Unit::NONE, cluster.linuxIds[0]);
+        section.add("uarch", Unit::UARCH, cluster.uarch);
+        section.add("pinned", Unit::BOOLEAN, affinity.isPinned());
+
+        addFaults(section, usableThpSize);
+        addChurn(section);
+    }
+
+    return report;
+}
@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Report the page size and the transparent huge page configuration, then on each
+ * microarchitecture measure the cost of first touch page faults with base and huge pages,
+ * the throughput of prefaulting with MADV_POPULATE_READ/WRITE and MAP_POPULATE, and how many
+ * mmap()/munmap() pairs per second go through at different sizes.
+ * cpuinfo must be initialized.
+ */
+BenchmarkReport runPageFaultBenchmark();
@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <string>
+#include <unistd.h>
+#include "PageInfo.h"
+
+namespace page_info {
+
+static constexpr auto kThpPath = "/sys/kernel/mm/transparent_hugepage";
+
+/**
+ * The active mode is the one between brackets, e.g. "always [madvise] never".
+ */
+static ThpMode readThpMode(const std::string &path) {
+    char line[128] = {};
+
+    auto file = fopen(path.c_str(), "re");
+    if (file == nullptr) {
+        return UNKNOWN;
+    }
+    auto read = fgets(line, sizeof(line), file);
+    fclose(file);
+
+    if (read == nullptr) {
+        return UNKNOWN;
+    } else if (strstr(line, "[always]") != nullptr) {
+        return ALWAYS;
+    } else if (strstr(line, "[madvise]") != nullptr) {
+        return MADVISE;
+    } else if (strstr(line, "[inherit]") != nullptr) {
+        return INHERIT;
+    } else if (strstr(line, "[never]") != nullptr) {
+        return NEVER;
+    }
+
+    return UNKNOWN;
+}
+
+size_t getPageSize() {
+    return static_cast<size_t>(getpagesize());
+}
+
+ThpMode getThpMode() {
+    return readThpMode(std::string(kThpPath) + "/enabled");
+}
+
+size_t getThpSize() {
+    size_t size = 0;
+
+    auto file = fopen((std::string(kThpPath) + "/hpage_pmd_size").c_str(), "re");
+    if (file == nullptr) {
+        return 0;
+    }
+    if (fscanf(file, "%zu", &size) != 1) {
+        size = 0;
+    }
+    fclose(file);
+
+    return size;
+}
+
+std::vector<MthpSize> getMthpSizes() {
+    std::vector<MthpSize> sizes;
+
+    auto directory = opendir(kThpPath);
+    if (directory == nullptr) {
+        return sizes;
+    }
+
+    while (auto entry = readdir(directory)) {
+        size_t kilobytes;
+        if (sscanf(entry->d_name, "hugepages-%zukB", &kilobytes) != 1) {
+            continue;
+        }
+
+        sizes.push_back({
+                kilobytes * 1024,
+                readThpMode(std::string(kThpPath) + "/" + entry->d_name + "/enabled"),
+        });
+    }
+
+    closedir(directory);
+
+    std::sort(sizes.begin(), sizes.end(), [](const MthpSize &a, const MthpSize &b) {
+        return a.size < b.size;
+    });
+
+    return sizes;
+}
+
+size_t getAnonHugePagesSize(const void *start, size_t size) {
+    auto file = fopen("/proc/self/smaps", "re");
+    if (file == nullptr) {
+        return 0;
+    }
+
+    auto begin = reinterpret_cast<uintptr_t>(start);
+    auto end = begin + size;
+
+    size_t total = 0;
+    auto inRange = false;
+    char line[256];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        uintptr_t from, to;
+        size_t kilobytes;
+
+        if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR " ", &from, &to) == 2) {
+            inRange = from < end && to > begin;
+        } else if (inRange && sscanf(line, "AnonHugePages: %zu kB", &kilobytes) == 1) {
+            total += kilobytes * 1024;
+        }
+    }
+
+    fclose(file);
+
+    return total;
+}
+
+} // namespace page_info
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Page size and transparent huge page configuration of the running kernel.
+ */
+namespace page_info {
+
+/**
+ * Value of a transparent_hugepage "enabled" node.
+ *
+ * Must be kept in sync with PageInfo.kt.
+ */
+enum ThpMode : int32_t {
+    UNKNOWN = -1,
+    NEVER = 0,
+    MADVISE = 1,
+    ALWAYS = 2,
+    /**
+     * mTHP sizes only, follows the top level mode.
+     */
+    INHERIT = 3,
+};
+
+/**
+ * A multi-size THP (mTHP) size, Linux 6.8+.
+ */
+struct MthpSize {
+    size_t size;
+    ThpMode mode;
+};
+
+/**
+ * @return getpagesize(), the base page size of the kernel
+ */
+size_t getPageSize();
+
+ThpMode getThpMode();
+
+/**
+ * @return The PMD sized THP size, 0 if unknown
+ */
+size_t getThpSize();
+
+/**
+ * @return The mTHP sizes the kernel supports, smallest first, empty if none
+ */
+std::vector<MthpSize> getMthpSizes();
+
+/**
+ * @return How many bytes of the range are backed by transparent huge pages, from smaps
+ */
+size_t getAnonHugePagesSize(const void *start, size_t size);
+
+} // namespace page_info
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpuinfo.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BenchmarkHarness.h"
+#include "PerfBenchmark.h"
+#include "PerfCounters.h"
+
+using namespace benchmark_harness;
+
+static constexpr size_t kWorkloadSize = 16 * 1024 * 1024;
+static constexpr uint64_t kWorkloadIterations = 4 * 1024 * 1024;
+
+static constexpr auto kSystemWideSampleDuration = std::chrono::milliseconds(100);
+
+static const char *const kEventNames[PerfCounters::EVENT_COUNT] = {
+        "cycles",
+        "instructions",
+        "branch_misses",
+        "l1d_read_misses",
+        "llc_read_misses",
+        "stalled_cycles_frontend",
+        "stalled_cycles_backend",
+};
+
+/**
+ * Random loads over a buffer bigger than most last level caches, with a data dependent branch,
+ * so that every counter has something to count.
+ */
+static uint64_t runWorkload(const std::vector<uint32_t> &buffer) {
+    uint32_t state = 0x12345678;
+    uint64_t sum = 0;
+
+    for (uint64_t i = 0; i < kWorkloadIterations; i++) {
+        state = state * 1664525 + 1013904223;
+
+        auto value = buffer[state % buffer.size()];
+        if (value & 1) {
+            sum += value;
+        } else {
+            sum ^= value;
+        }
+    }
+
+    doNotOptimize(sum);
+
+    return sum;
+}
+
+static void addCounts(BenchmarkReport::Section &section,
+                      const std::array<int64_t, PerfCounters::EVENT_COUNT> &values) {
+    using Unit = BenchmarkReport::Unit;
+
+    for (uint32_t event = 0; event < PerfCounters::EVENT_COUNT; event++) {
+        if (values[event] != PerfCounters::kUnknown) {
+            section.add(kEventNames[event], Unit::NONE, values[event]);
+        }
+    }
+
+    auto cycles = values[PerfCounters::CYCLES];
+    auto instructions = values[PerfCounters::INSTRUCTIONS];
+    if (cycles > 0 && instructions != PerfCounters::kUnknown) {
+        section.add("ipc", Unit::NONE, static_cast<double>(instructions) / cycles);
+    }
+}
+
+BenchmarkReport runPerfBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    auto &system = report.addSection("System");
+    system.add("perf_event_paranoid", Unit::NONE, PerfCounters::getParanoidLevel());
+
+    std::vector<uint32_t> buffer(kWorkloadSize / sizeof(uint32_t));
+    for (size_t i = 0; i < buffer.size(); i++) {
+        buffer[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+
+    for (auto &cluster: getUarchClusters()) {
+        auto &section = report.addSection("Cluster " + std::to_string(cluster.index));
+
+        ScopedAffinity affinity(cluster.linuxIds[0]);
+
+        section.add("cpu", Unit::NONE, cluster.linuxIds[0]);
+        section.add("uarch", Unit::UARCH, cluster.uarch);
+        section.add("pinned", Unit::BOOLEAN, affinity.isPinned());
+
+        PerfCounters counters;
+        auto info = cpuinfo_get_cluster(cluster.index);
+        auto result = counters.open(0, -1, info->vendor, info->uarch);
+        if (result != 0) {
+            section.add("errno", Unit::NONE, -result);
+            continue;
+        }
+
+        runWorkload(buffer);
+
+        std::array<int64_t, PerfCounters::EVENT_COUNT> values{};
+        counters.read(values);
+
+        for (uint32_t event = 0; event < PerfCounters::EVENT_COUNT; event++) {
+            section.add(std::string(kEventNames[event]) + "_available", Unit::BOOLEAN,
+                        values[event] != PerfCounters::kUnknown);
+        }
+        addCounts(section, values);
+    }
+
+    // System wide, needs perf_event_paranoid <= 0
+    std::vector<std::pair<const cpuinfo_processor *, PerfCounters>> cpus;
+    for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+        auto processor = cpuinfo_get_processor(i);
+
+        PerfCounters counters;
+        if (counters.open(-1, processor->linux_id, processor->core->vendor,
+                          processor->core->uarch) == 0) {
+            cpus.emplace_back(processor, std::move(counters));
+        }
+    }
+
+    if (!cpus.empty()) {
+        std::this_thread::sleep_for(kSystemWideSampleDuration);
+
+        for (auto &[processor, counters]: cpus) {
+            std::array<int64_t, PerfCounters::EVENT_COUNT> values{};
+            counters.read(values);
+
+            auto &section = report.addSection("CPU " + std::to_string(processor->linux_id));
+            section.add("sample_duration", Unit::NANOSECONDS,
+                        std::chrono::nanoseconds(kSystemWideSampleDuration).count());
+            addCounts(section, values);
+        }
+    }
+
+    return report;
+}
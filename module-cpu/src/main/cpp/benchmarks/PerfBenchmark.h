@@ -0,0 +1,15 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Check which hardware counters are available, by counting a reference workload on the calling
+ * thread pinned to each microarchitecture, then sample every processor system wide if
+ * perf_event_paranoid allows it. cpuinfo must be initialized.
+ */
+BenchmarkReport runPerfBenchmark();
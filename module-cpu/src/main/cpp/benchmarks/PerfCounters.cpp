@@ -0,0 +1,261 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+#include "PerfCounters.h"
+
+namespace {
+
+struct EventCode {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr uint64_t cacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+/**
+ * Generic events, mapped by the kernel to whatever the PMU has.
+ */
+constexpr EventCode kGenericEvents[PerfCounters::EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                         PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HW_CACHE, cacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                         PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+};
+
+constexpr uint64_t kNoRawEvent = UINT64_MAX;
+
+/**
+ * Armv8 PMUv3 common events, implemented by Arm designed cores and most custom ones. The kernel
+ * doesn't map the stall and last level cache events to the generic ones on every PMU driver.
+ */
+constexpr uint64_t kArmPmuV3Events[PerfCounters::EVENT_COUNT] = {
+        kNoRawEvent,
+        kNoRawEvent,
+        kNoRawEvent,
+        kNoRawEvent,
+        0x37, // LL_CACHE_MISS_RD
+        0x23, // STALL_FRONTEND
+        0x24, // STALL_BACKEND
+};
+
+/**
+ * Intel Skylake to Sunny Cove, the generic stall events aren't supported there.
+ */
+constexpr uint64_t kIntelSkylakeEvents[PerfCounters::EVENT_COUNT] = {
+        kNoRawEvent,
+        kNoRawEvent,
+        kNoRawEvent,
+        kNoRawEvent,
+        kNoRawEvent,
+        kNoRawEvent,
+        0x040004a3, // CYCLE_ACTIVITY.STALLS_TOTAL
+};
+
+const uint64_t *getRawEvents(cpuinfo_vendor vendor, cpuinfo_uarch uarch) {
+    if (vendor == cpuinfo_vendor_intel && uarch >= cpuinfo_uarch_sky_lake
+        && uarch <= cpuinfo_uarch_sunny_cove) {
+        return kIntelSkylakeEvents;
+    }
+
+#if defined(__aarch64__) || defined(__arm__)
+    // Every Arm licensee but Apple implements PMUv3
+    if (vendor != cpuinfo_vendor_unknown && vendor != cpuinfo_vendor_apple) {
+        return kArmPmuV3Events;
+    }
+#endif
+
+    return nullptr;
+}
+
+/**
+ * Events are grouped so that no group needs more than 4 general purpose counters, cycles are in
+ * both so that each group can be normalized on its own.
+ */
+constexpr PerfCounters::Event kGroups[][4] = {
+        {PerfCounters::CYCLES, PerfCounters::INSTRUCTIONS, PerfCounters::BRANCH_MISSES,
+         PerfCounters::L1D_READ_MISSES},
+        {PerfCounters::CYCLES, PerfCounters::LLC_READ_MISSES,
+         PerfCounters::STALLED_CYCLES_FRONTEND, PerfCounters::STALLED_CYCLES_BACKEND},
+};
+
+int perfEventOpen(perf_event_attr &attr, pid_t pid, int cpu, int groupFd) {
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, pid, cpu, groupFd,
+                                    PERF_FLAG_FD_CLOEXEC));
+}
+
+int openEvent(const EventCode &code, bool excludeKernel, pid_t pid, int cpu, int groupFd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = code.type;
+    attr.config = code.config;
+    attr.disabled = groupFd == -1;
+    attr.exclude_kernel = excludeKernel;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return perfEventOpen(attr, pid, cpu, groupFd);
+}
+
+} // namespace
+
+PerfCounters::PerfCounters(PerfCounters &&other) noexcept
+        : mGroups(std::exchange(other.mGroups, {})) {}
+
+PerfCounters &PerfCounters::operator=(PerfCounters &&other) noexcept {
+    if (this != &other) {
+        close();
+        mGroups = std::exchange(other.mGroups, {});
+    }
+    return *this;
+}
+
+int PerfCounters::open(pid_t pid, int cpu, cpuinfo_vendor vendor, cpuinfo_uarch uarch) {
+    close();
+
+    auto rawEvents = getRawEvents(vendor, uarch);
+
+    // Paranoid level 2 and up only allows user space counting
+    auto excludeKernel = getParanoidLevel() >= 2;
+
+    int firstError = 0;
+
+    for (auto &groupEvents: kGroups) {
+        Group group;
+
+        for (auto event: groupEvents) {
+            int fd = -1;
+            int error = 0;
+
+            // Raw event first, then the generic one
+            for (uint32_t attempt = 0; attempt < 2 && fd < 0; attempt++) {
+                EventCode code = kGenericEvents[event];
+                if (attempt == 0) {
+                    if (rawEvents == nullptr || rawEvents[event] == kNoRawEvent) {
+                        continue;
+                    }
+                    code = {PERF_TYPE_RAW, rawEvents[event]};
+                }
+
+                fd = openEvent(code, excludeKernel, pid, cpu, group.leaderFd);
+                if (fd < 0) {
+                    error = errno;
+                }
+            }
+
+            if (fd < 0) {
+                if (firstError == 0) {
+                    firstError = error;
+                }
+
+                // Without cycles the group can't be normalized
+                if (event == CYCLES) {
+                    break;
+                }
+                continue;
+            }
+
+            if (group.leaderFd < 0) {
+                group.leaderFd = fd;
+            }
+            group.fds.push_back(fd);
+            group.events.push_back(event);
+        }
+
+        if (group.leaderFd < 0) {
+            continue;
+        }
+
+        ioctl(group.leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(group.leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+        mGroups.push_back(std::move(group));
+    }
+
+    if (mGroups.empty()) {
+        return -(firstError != 0 ? firstError : ENOENT);
+    }
+
+    return 0;
+}
+
+void PerfCounters::close() {
+    for (auto &group: mGroups) {
+        for (auto fd: group.fds) {
+            ::close(fd);
+        }
+    }
+
+    mGroups.clear();
+}
+
+bool PerfCounters::read(std::array<int64_t, EVENT_COUNT> &values) const {
+    values.fill(kUnknown);
+
+    if (mGroups.empty()) {
+        return false;
+    }
+
+    for (auto &group: mGroups) {
+        // nr, time_enabled, time_running, then one value per counter
+        uint64_t buffer[3 + EVENT_COUNT];
+
+        auto size = ::read(group.leaderFd, buffer, sizeof(buffer));
+        if (size < static_cast<ssize_t>(3 * sizeof(uint64_t))) {
+            return false;
+        }
+
+        auto count = std::min<uint64_t>(buffer[0], group.events.size());
+        auto timeEnabled = buffer[1];
+        auto timeRunning = buffer[2];
+
+        for (uint64_t i = 0; i < count; i++) {
+            auto event = group.events[i];
+
+            // Both groups count cycles, keep the one from the first
+            if (values[event] != kUnknown) {
+                continue;
+            }
+
+            auto value = static_cast<double>(buffer[3 + i]);
+            if (timeRunning != 0 && timeRunning < timeEnabled) {
+                value = value * timeEnabled / timeRunning;
+            }
+
+            values[event] = timeRunning != 0 ? static_cast<int64_t>(value) : 0;
+        }
+    }
+
+    return true;
+}
+
+int32_t PerfCounters::getParanoidLevel() {
+    auto file = fopen("/proc/sys/kernel/perf_event_paranoid", "re");
+    if (file == nullptr) {
+        return INT32_MIN;
+    }
+
+    int level;
+    auto result = fscanf(file, "%d", &level);
+    fclose(file);
+
+    return result == 1 ? level : INT32_MIN;
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <array>
+#include <cpuinfo.h>
+#include <cstdint>
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * Hardware performance counters of a CPU or of a thread, opened with perf_event_open() and read
+ * in batches with PERF_FORMAT_GROUP.
+ *
+ * Events are split in two groups, each small enough to fit the PMU of every core we care about
+ * (4 general purpose counters plus the fixed cycle counter), the kernel multiplexes them and
+ * values are scaled accordingly. Events the kernel or the PMU don't support are left out.
+ *
+ * Must be kept in sync with PerfCounters.kt.
+ */
+class PerfCounters {
+public:
+    enum Event : uint32_t {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_READ_MISSES,
+        LLC_READ_MISSES,
+        STALLED_CYCLES_FRONTEND,
+        STALLED_CYCLES_BACKEND,
+        EVENT_COUNT,
+    };
+
+    /**
+     * Value of an event that couldn't be opened.
+     */
+    static constexpr int64_t kUnknown = -1;
+
+    PerfCounters() = default;
+    ~PerfCounters() { close(); }
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+    PerfCounters(PerfCounters &&other) noexcept;
+    PerfCounters &operator=(PerfCounters &&other) noexcept;
+
+    /**
+     * Open and start the counters, see perf_event_open(2) for pid and cpu. Raw event codes are
+     * preferred for the given cpuinfo vendor and uarch, falling back to the generic events.
+     * Kernel events are only counted if perf_event_paranoid allows it.
+     *
+     * @return 0 if at least one event was opened, -errno of the first failure otherwise
+     */
+    int open(pid_t pid, int cpu, cpuinfo_vendor vendor, cpuinfo_uarch uarch);
+
+    void close();
+
+    bool isOpen() const { return !mGroups.empty(); }
+
+    /**
+     * Read the counts since open(), scaled for multiplexing.
+     *
+     * @param values Output, kUnknown for events that aren't available
+     * @return Whether the counters could be read
+     */
+    bool read(std::array<int64_t, EVENT_COUNT> &values) const;
+
+    /**
+     * @return The value of /proc/sys/kernel/perf_event_paranoid, INT32_MIN if unknown
+     */
+    static int32_t getParanoidLevel();
+
+private:
+    struct Group {
+        int leaderFd = -1;
+        std::vector<int> fds;
+        /**
+         * Event of each counter, in PERF_FORMAT_GROUP order.
+         */
+        std::vector<Event> events;
+    };
+
+    std::vector<Group> mGroups;
+};
@@ -0,0 +1,511 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cpuinfo.h>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+#include "BenchmarkHarness.h"
+#include "StreamBenchmark.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+using namespace benchmark_harness;
+
+/**
+ * Bounds of each of the three arrays of every thread. The smallest still keeps a thread's arrays
+ * well past its private caches, the largest covers any last level cache cpuinfo reports.
+ */
+static constexpr size_t kMinimumArraySize = 2 * 1024 * 1024;
+static constexpr size_t kMaximumArraySize = 16 * 1024 * 1024;
+
+/**
+ * Used when cpuinfo knows of no cache at all.
+ */
+static constexpr size_t kDefaultLastLevelCacheSize = 8 * 1024 * 1024;
+
+/**
+ * Passes over the arrays in each timed run.
+ */
+static constexpr uint32_t kPasses = 2;
+static constexpr uint32_t kRepetitions = 3;
+
+static constexpr double kScalar = 3.0;
+
+/**
+ * The memory is saturated once adding threads gets less than 5% more bandwidth than the peak.
+ */
+static constexpr double kSaturationRatio = 0.95;
+
+/**
+ * Allocating and touching the arrays takes a while, especially on little cores.
+ */
+static constexpr int64_t kStartTimeoutNs = 1000000000;
+
+enum Operation : uint32_t {
+    COPY,
+    SCALE,
+    ADD,
+    TRIAD,
+    OPERATION_COUNT,
+};
+
+static const char *const kOperationNames[] = {"copy", "scale", "add", "triad"};
+
+/**
+ * Words moved per element, counted the STREAM way: without the write allocate reads.
+ */
+static const size_t kOperationWords[] = {2, 2, 3, 3};
+
+struct Arrays {
+    double *a;
+    double *b;
+    double *c;
+    size_t count;
+};
+
+/**
+ * An opaque index keeps the compiler from vectorizing the loop or turning it into memcpy().
+ */
+static inline void hideIndex(size_t &i) {
+    asm volatile("" : "+r"(i));
+}
+
+static void runScalar(const Arrays &arrays, Operation operation) {
+    auto [a, b, c, count] = arrays;
+
+    switch (operation) {
+        case COPY:
+            for (size_t i = 0; i < count; i++) {
+                c[i] = a[i];
+                hideIndex(i);
+            }
+            break;
+        case SCALE:
+            for (size_t i = 0; i < count; i++) {
+                b[i] = kScalar * c[i];
+                hideIndex(i);
+            }
+            break;
+        case ADD:
+            for (size_t i = 0; i < count; i++) {
+                c[i] = a[i] + b[i];
+                hideIndex(i);
+            }
+            break;
+        case TRIAD:
+            for (size_t i = 0; i < count; i++) {
+                a[i] = b[i] + kScalar * c[i];
+                hideIndex(i);
+            }
+            break;
+        case OPERATION_COUNT:
+            break;
+    }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+static void runAvx2(const Arrays &arrays, Operation operation) {
+    auto [a, b, c, count] = arrays;
+    auto scalar = _mm256_set1_pd(kScalar);
+
+    switch (operation) {
+        case COPY:
+            for (size_t i = 0; i < count; i += 4) {
+                _mm256_store_pd(c + i, _mm256_load_pd(a + i));
+            }
+            break;
+        case SCALE:
+            for (size_t i = 0; i < count; i += 4) {
+                _mm256_store_pd(b + i, _mm256_mul_pd(scalar, _mm256_load_pd(c + i)));
+            }
+            break;
+        case ADD:
+            for (size_t i = 0; i < count; i += 4) {
+                _mm256_store_pd(c + i, _mm256_add_pd(_mm256_load_pd(a + i),
+                                                     _mm256_load_pd(b + i)));
+            }
+            break;
+        case TRIAD:
+            for (size_t i = 0; i < count; i += 4) {
+                _mm256_store_pd(a + i, _mm256_add_pd(
+                        _mm256_load_pd(b + i), _mm256_mul_pd(scalar, _mm256_load_pd(c + i))));
+            }
+            break;
+        case OPERATION_COUNT:
+            break;
+    }
+}
+#elif defined(__aarch64__)
+static void runNeon(const Arrays &arrays, Operation operation) {
+    auto [a, b, c, count] = arrays;
+
+    switch (operation) {
+        case COPY:
+            for (size_t i = 0; i < count; i += 2) {
+                vst1q_f64(c + i, vld1q_f64(a + i));
+            }
+            break;
+        case SCALE:
+            for (size_t i = 0; i < count; i += 2) {
+                vst1q_f64(b + i, vmulq_n_f64(vld1q_f64(c + i), kScalar));
+            }
+            break;
+        case ADD:
+            for (size_t i = 0; i < count; i += 2) {
+                vst1q_f64(c + i, vaddq_f64(vld1q_f64(a + i), vld1q_f64(b + i)));
+            }
+            break;
+        case TRIAD:
+            for (size_t i = 0; i < count; i += 2) {
+                vst1q_f64(a + i, vaddq_f64(vld1q_f64(b + i),
+                                           vmulq_n_f64(vld1q_f64(c + i), kScalar)));
+            }
+            break;
+        case OPERATION_COUNT:
+            break;
+    }
+}
+#endif
+
+static bool isAlwaysSupported() {
+    return true;
+}
+
+struct Implementation {
+    const char *name;
+    void (*run)(const Arrays &arrays, Operation operation);
+    bool (*isSupported)();
+};
+
+static const Implementation kImplementations[] = {
+        {"scalar", runScalar, isAlwaysSupported},
+#if defined(__x86_64__)
+        {"avx2", runAvx2, cpuinfo_has_x86_avx2},
+#elif defined(__aarch64__)
+        {"neon", runNeon, isAlwaysSupported},
+#endif
+};
+
+/**
+ * The three arrays of a thread, in a single mapping. Create it from the thread that will use
+ * it after pinning, the first touch decides where the pages come from.
+ */
+class ThreadArrays {
+public:
+    explicit ThreadArrays(size_t arraySize) : mMapping(arraySize * 3, 4096) {
+        if (mMapping.data() == nullptr) {
+            return;
+        }
+
+        auto count = arraySize / sizeof(double);
+        auto data = reinterpret_cast<double *>(mMapping.data());
+        mArrays = {data, data + count, data + count * 2, count};
+
+        std::fill(mArrays.a, mArrays.a + count, 1.0);
+        std::fill(mArrays.b, mArrays.b + count, 2.0);
+        std::fill(mArrays.c, mArrays.c + count, 0.0);
+    }
+
+    bool isValid() const { return mArrays.count != 0; }
+
+    const Arrays &get() const { return mArrays; }
+
+private:
+    AlignedMapping mMapping;
+    Arrays mArrays = {nullptr, nullptr, nullptr, 0};
+};
+
+struct alignas(64) ControlLine {
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> failed{false};
+    std::atomic<bool> stop{false};
+
+    /**
+     * Bumped to hand out a new task, written with the task below.
+     */
+    std::atomic<uint32_t> generation{0};
+    const Implementation *implementation = nullptr;
+    Operation operation = COPY;
+};
+
+struct alignas(64) DoneLine {
+    std::atomic<uint32_t> count{0};
+};
+
+template<typename Predicate>
+static void spinUntil(Predicate predicate) {
+    for (uint32_t spins = 1; !predicate(); spins++) {
+        // Don't starve whoever we're waiting for if it's on the same processor
+        if (spins % 1024 == 0) {
+            std::this_thread::yield();
+        } else {
+            cpuRelax();
+        }
+    }
+}
+
+static void runPasses(const Implementation &implementation, const Arrays &arrays,
+                      Operation operation) {
+    for (uint32_t i = 0; i < kPasses; i++) {
+        implementation.run(arrays, operation);
+    }
+}
+
+/**
+ * Run every kernel with one thread pinned to each processor, the calling thread taking the first.
+ *
+ * @return Bandwidth in bytes per second by implementation and operation, NAN if unsupported,
+ *         empty if the threads couldn't be pinned or allocate their arrays
+ */
+static std::vector<double> measureThreads(const std::vector<uint32_t> &linuxIds,
+                                          size_t arraySize) {
+    ControlLine control;
+    DoneLine done;
+
+    auto workerCount = static_cast<uint32_t>(linuxIds.size() - 1);
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 1; i < linuxIds.size(); i++) {
+        workers.emplace_back([&, linuxId = linuxIds[i]] {
+            ScopedAffinity affinity(linuxId);
+            ThreadArrays arrays(arraySize);
+            if (!affinity.isPinned() || !arrays.isValid()) {
+                control.failed.store(true);
+            }
+
+            control.ready.fetch_add(1, std::memory_order_release);
+
+            uint32_t generation = 0;
+            for (;;) {
+                spinUntil([&] {
+                    return control.stop.load(std::memory_order_relaxed)
+                           || control.generation.load(std::memory_order_acquire) != generation;
+                });
+                if (control.stop.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                generation++;
+
+                if (arrays.isValid()) {
+                    runPasses(*control.implementation, arrays.get(), control.operation);
+                }
+                done.count.fetch_add(1, std::memory_order_release);
+            }
+        });
+    }
+
+    std::vector<double> bandwidths;
+
+    {
+        ScopedAffinity affinity(linuxIds[0]);
+        ThreadArrays arrays(arraySize);
+
+        auto startNs = nowNs();
+        spinUntil([&] {
+            return control.ready.load(std::memory_order_acquire) == workerCount
+                   || nowNs() - startNs > kStartTimeoutNs;
+        });
+
+        auto ok = affinity.isPinned() && arrays.isValid() && !control.failed.load()
+                  && control.ready.load(std::memory_order_acquire) == workerCount;
+
+        for (auto &implementation: kImplementations) {
+            for (uint32_t operation = 0; ok && operation < OPERATION_COUNT; operation++) {
+                if (!implementation.isSupported()) {
+                    bandwidths.push_back(NAN);
+                    continue;
+                }
+
+                control.implementation = &implementation;
+                control.operation = static_cast<Operation>(operation);
+
+                int64_t bestNs = INT64_MAX;
+                for (uint32_t i = 0; i < kRepetitions; i++) {
+                    done.count.store(0, std::memory_order_relaxed);
+
+                    auto runStartNs = nowNs();
+                    control.generation.fetch_add(1, std::memory_order_release);
+                    runPasses(implementation, arrays.get(), control.operation);
+                    spinUntil([&] {
+                        return done.count.load(std::memory_order_acquire) == workerCount;
+                    });
+
+                    bestNs = std::min(bestNs, nowNs() - runStartNs);
+                }
+
+                auto bytes = static_cast<double>(linuxIds.size()) * kPasses
+                             * static_cast<double>(arrays.get().count)
+                             * kOperationWords[operation] * sizeof(double);
+                bandwidths.push_back(bytes * kNsPerSecond / static_cast<double>(bestNs));
+            }
+        }
+
+        if (!ok) {
+            bandwidths.clear();
+        }
+    }
+
+    control.stop.store(true);
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    return bandwidths;
+}
+
+static size_t getLastLevelCacheSize() {
+    size_t size = 0;
+
+    for (auto [caches, count]: {
+            std::pair(cpuinfo_get_l2_caches(), cpuinfo_get_l2_caches_count()),
+            std::pair(cpuinfo_get_l3_caches(), cpuinfo_get_l3_caches_count()),
+            std::pair(cpuinfo_get_l4_caches(), cpuinfo_get_l4_caches_count()),
+    }) {
+        for (uint32_t i = 0; caches != nullptr && i < count; i++) {
+            size = std::max(size, static_cast<size_t>(caches[i].size));
+        }
+    }
+
+    return size != 0 ? size : kDefaultLastLevelCacheSize;
+}
+
+/**
+ * Size the arrays so that the threads together work on at least four times the last level
+ * cache, as STREAM asks, rather than each of them: the footprint stays about the same while
+ * adding threads. Don't ask for more than a quarter of the RAM either way, the system would
+ * start killing apps.
+ *
+ * @return The size of each array of every thread, 0 if they wouldn't fit
+ */
+static size_t getArraySize(size_t threads) {
+    auto size = std::clamp(getLastLevelCacheSize() * 4 / 3 / threads,
+                           kMinimumArraySize, kMaximumArraySize);
+
+    auto physicalPages = sysconf(_SC_PHYS_PAGES);
+    auto pageSize = sysconf(_SC_PAGESIZE);
+    if (physicalPages > 0 && pageSize > 0) {
+        auto quarter = static_cast<size_t>(physicalPages) * static_cast<size_t>(pageSize) / 4;
+        size = std::min(size, quarter / 3 / threads);
+    }
+
+    // Whole cache lines, so the vector loops have no tail
+    return size / 64 * 64;
+}
+
+/**
+ * Add processors one at a time and report the bandwidth curves.
+ */
+static void addRamp(BenchmarkReport::Section &section, const std::vector<uint32_t> &linuxIds) {
+    using Unit = BenchmarkReport::Unit;
+
+    constexpr auto kImplementationCount = std::size(kImplementations);
+
+    section.add("processors", Unit::NONE, linuxIds.size());
+
+    // Bandwidth by thread count, for each implementation and operation
+    std::vector<std::vector<std::pair<size_t, double>>> curves(
+            kImplementationCount * OPERATION_COUNT);
+
+    for (size_t threads = 1; threads <= linuxIds.size(); threads++) {
+        auto arraySize = getArraySize(threads);
+        if (arraySize == 0) {
+            break;
+        }
+
+        auto bandwidths = measureThreads(
+                std::vector<uint32_t>(linuxIds.begin(),
+                                      linuxIds.begin() + static_cast<ptrdiff_t>(threads)),
+                arraySize);
+        if (bandwidths.empty()) {
+            continue;
+        }
+
+        section.add("array_size_" + std::to_string(threads) + "_threads", Unit::BYTES,
+                    arraySize);
+
+        for (size_t i = 0; i < bandwidths.size(); i++) {
+            if (std::isnan(bandwidths[i])) {
+                continue;
+            }
+
+            section.add(std::string(kImplementations[i / OPERATION_COUNT].name) + "_"
+                        + kOperationNames[i % OPERATION_COUNT] + "_"
+                        + std::to_string(threads) + "_threads",
+                        Unit::BYTES_PER_SECOND, bandwidths[i]);
+            curves[i].emplace_back(threads, bandwidths[i]);
+        }
+    }
+
+    std::vector<double> peaks(curves.size(), NAN);
+
+    for (size_t i = 0; i < curves.size(); i++) {
+        auto &curve = curves[i];
+        if (curve.empty()) {
+            continue;
+        }
+
+        auto name = std::string(kImplementations[i / OPERATION_COUNT].name) + "_"
+                    + kOperationNames[i % OPERATION_COUNT];
+
+        auto peak = std::max_element(curve.begin(), curve.end(), [](auto &a, auto &b) {
+            return a.second < b.second;
+        })->second;
+        peaks[i] = peak;
+
+        auto saturation = std::find_if(curve.begin(), curve.end(), [&](auto &point) {
+            return point.second >= peak * kSaturationRatio;
+        })->first;
+
+        section.add(name + "_peak", Unit::BYTES_PER_SECOND, peak);
+        section.add(name + "_saturation_threads", Unit::NONE, saturation);
+    }
+
+    // The first implementation is the scalar one
+    for (size_t implementation = 1; implementation < kImplementationCount; implementation++) {
+        for (uint32_t operation = 0; operation < OPERATION_COUNT; operation++) {
+            auto vectorPeak = peaks[implementation * OPERATION_COUNT + operation];
+            auto scalarPeak = peaks[operation];
+            if (!std::isnan(vectorPeak) && !std::isnan(scalarPeak)) {
+                section.add(std::string(kImplementations[implementation].name) + "_"
+                            + kOperationNames[operation] + "_speedup",
+                            Unit::NONE, vectorPeak / scalarPeak);
+            }
+        }
+    }
+}
+
+BenchmarkReport runStreamBenchmark() {
+    BenchmarkReport report;
+
+    auto clusters = getClusters();
+
+    std::vector<uint32_t> allLinuxIds;
+    for (auto &cluster: clusters) {
+        auto &section = report.addSection("Cluster " + std::to_string(cluster.index));
+        section.add("uarch", BenchmarkReport::Unit::UARCH, cluster.uarch);
+        addRamp(section, cluster.linuxIds);
+
+        allLinuxIds.insert(allLinuxIds.end(), cluster.linuxIds.begin(), cluster.linuxIds.end());
+    }
+
+    if (clusters.size() > 1) {
+        addRamp(report.addSection("All clusters"), allLinuxIds);
+    }
+
+    return report;
+}
@@ -0,0 +1,22 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * STREAM copy, scale, add and triad with a growing number of threads, first within each
+ * cluster, then across all of them adding processors in cpuinfo order. Every thread works on its
+ * own arrays, allocated and first touched from the processor it's pinned to; together they span
+ * four times the last level cache, never more than a quarter of the RAM.
+ * Each kernel runs both scalar and vectorized (NEON on arm64, AVX2 on x86_64).
+ * cpuinfo must be initialized.
+ *
+ * The report has one section per ramp, with the array size and the bandwidth of every kernel at
+ * each thread count, the peak and the smallest thread count reaching 95% of it, where the
+ * memory saturates.
+ */
+BenchmarkReport runStreamBenchmark();
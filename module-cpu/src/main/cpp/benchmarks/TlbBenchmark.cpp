@@ -0,0 +1,388 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cpuinfo.h>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "BenchmarkHarness.h"
+#include "PageInfo.h"
+#include "TlbBenchmark.h"
+
+using namespace benchmark_harness;
+
+static constexpr size_t kLineSize = 64;
+
+static constexpr uint32_t kMinimumPages = 4;
+static constexpr uint32_t kMaximumPages = 8192;
+static constexpr size_t kMaximumRegionSize = 256 * 1024 * 1024;
+
+static constexpr size_t kStepsPerOctave = 4;
+
+/**
+ * A penalty that grows by at least this much, or by this ratio, marks the start of a
+ * transition to the next level, which ends once consecutive points differ by less than
+ * the plateau thresholds. The penalty of the first level is close to 0, so the ratios alone
+ * wouldn't work there.
+ */
+static constexpr double kKneeNs = 0.5;
+static constexpr double kKneeRatio = 1.5;
+static constexpr double kPlateauNs = 0.25;
+static constexpr double kPlateauRatio = 1.1;
+
+static constexpr size_t kDefaultHugePageSize = 2 * 1024 * 1024;
+
+static const MeasureOptions kMeasureOptions = {
+        .targetNs = 2000000,
+        .warmups = 1,
+        .repetitions = 3,
+};
+
+static const char *const kLevelNames[] = {
+        "l1_dtlb",
+        "l2_tlb",
+};
+
+struct Point {
+    uint32_t pages;
+    double latencyNs;
+
+    /**
+     * Latency over the one of the same number of cache lines packed together, which have the
+     * same data cache behavior but fit in a handful of pages.
+     */
+    double penaltyNs;
+};
+
+/**
+ * Don't ask for more than a quarter of the RAM, the system would start killing apps.
+ */
+static size_t getMaximumRegionSize() {
+    auto physicalPages = sysconf(_SC_PHYS_PAGES);
+    if (physicalPages <= 0) {
+        return kMaximumRegionSize;
+    }
+
+    return std::min(kMaximumRegionSize,
+                    static_cast<size_t>(physicalPages) * page_info::getPageSize() / 4);
+}
+
+/**
+ * @return The PMD huge page size if transparent huge pages can be requested with madvise(),
+ *         0 otherwise
+ */
+static size_t getTransparentHugePageSize() {
+    auto mode = page_info::getThpMode();
+    if (mode != page_info::MADVISE && mode != page_info::ALWAYS) {
+        return 0;
+    }
+
+    auto size = page_info::getThpSize();
+
+    // Without the size, assume the PMD size of 4 KiB page kernels
+    return size != 0 ? size : kDefaultHugePageSize;
+}
+
+static std::vector<uint32_t> getPageCounts(uint32_t maximumPages) {
+    std::vector<uint32_t> counts;
+
+    for (uint32_t octave = kMinimumPages; octave <= maximumPages; octave *= 2) {
+        for (uint32_t step = 0; step < kStepsPerOctave; step++) {
+            auto count = octave + octave * step / kStepsPerOctave;
+            if (count <= maximumPages) {
+                counts.push_back(count);
+            }
+        }
+    }
+
+    return counts;
+}
+
+/**
+ * Link the nodes into a single random cycle, see MemoryBenchmark.cpp.
+ */
+static void *buildChain(const std::vector<uint8_t *> &nodes) {
+    std::vector<uint32_t> next(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        next[i] = static_cast<uint32_t>(i);
+    }
+
+    std::mt19937_64 random(nodes.size());
+    for (size_t i = nodes.size() - 1; i > 0; i--) {
+        std::swap(next[i], next[random() % i]);
+    }
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        *reinterpret_cast<void **>(nodes[i]) = nodes[next[i]];
+    }
+
+    return nodes[0];
+}
+
+static uint64_t chase(void *&pointer, uint64_t iterations) {
+    auto p = pointer;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+        p = *static_cast<void **>(p); p = *static_cast<void **>(p);
+    }
+
+    pointer = p;
+
+    return iterations * 8;
+}
+
+static double measureLatency(const std::vector<uint8_t *> &nodes) {
+    auto pointer = buildChain(nodes);
+
+    auto measurement = measure([&](uint64_t iterations) {
+        return chase(pointer, iterations);
+    }, kMeasureOptions);
+
+    doNotOptimize(pointer);
+
+    return kNsPerSecond / measurement.bestOpsPerSecond;
+}
+
+/**
+ * Each node sits on its own page, at a different offset on each page so that the nodes don't
+ * all compete for the same data cache set.
+ */
+static std::vector<Point> measurePoints(const AlignedMapping &pages, size_t stride,
+                                        const AlignedMapping &lines) {
+    std::vector<Point> points;
+
+    auto maximumPages = static_cast<uint32_t>(std::min<size_t>(
+            kMaximumPages, pages.size() / stride));
+
+    for (auto count: getPageCounts(maximumPages)) {
+        std::vector<uint8_t *> nodes(count);
+        std::vector<uint8_t *> controlNodes(count);
+        for (uint32_t i = 0; i < count; i++) {
+            nodes[i] = pages.data() + i * stride + (i * kLineSize) % stride;
+            controlNodes[i] = lines.data() + i * kLineSize;
+        }
+
+        auto latency = measureLatency(nodes);
+        auto controlLatency = measureLatency(controlNodes);
+
+        points.push_back({count, latency, latency - controlLatency});
+    }
+
+    return points;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/**
+ * Find where the penalty curve climbs to the next level. The level of each plateau is the
+ * median of its points, data cache effects the control chain doesn't cancel out exactly make
+ * the curve noisy after the first level.
+ */
+static std::vector<DataTlbLevel> findLevels(const std::vector<Point> &points, size_t pageSize) {
+    struct Knee {
+        uint32_t pages;
+        double levelNs;
+    };
+
+    std::vector<Knee> knees;
+
+    auto rising = false;
+    std::vector<double> plateau;
+    for (size_t i = 0; i + 1 < points.size(); i++) {
+        auto current = points[i].penaltyNs;
+        auto next = points[i + 1].penaltyNs;
+
+        if (!rising) {
+            plateau.push_back(current);
+            auto level = median(plateau);
+
+            if (next - level >= std::max(kKneeNs, std::fabs(level) * (kKneeRatio - 1))) {
+                knees.push_back({points[i].pages, level});
+                rising = true;
+                plateau.clear();
+            }
+        } else if (std::fabs(next - current)
+                   < std::max(kPlateauNs, std::fabs(current) * (kPlateauRatio - 1))) {
+            rising = false;
+        }
+    }
+
+    // A knee followed by a plateau at about the same level was noise
+    for (size_t i = 0; i < knees.size();) {
+        auto nextLevel = i + 1 < knees.size() ? knees[i + 1].levelNs
+                                              : points.back().penaltyNs;
+        if (nextLevel - knees[i].levelNs < kKneeNs) {
+            knees.erase(knees.begin() + static_cast<ptrdiff_t>(i));
+        } else {
+            i++;
+        }
+    }
+
+    std::vector<DataTlbLevel> levels;
+    for (size_t i = 0; i < knees.size(); i++) {
+        auto nextLevel = i + 1 < knees.size() ? knees[i + 1].levelNs
+                                              : points.back().penaltyNs;
+        levels.push_back({knees[i].pages, pageSize, nextLevel - knees[i].levelNs});
+    }
+
+    return levels;
+}
+
+static void addPoints(BenchmarkReport::Section &section, const std::vector<Point> &points,
+                      size_t stride) {
+    using Unit = BenchmarkReport::Unit;
+
+    if (points.empty()) {
+        return;
+    }
+
+    auto levels = findLevels(points, stride);
+    for (size_t i = 0; i < levels.size(); i++) {
+        auto name = i < std::size(kLevelNames) ? std::string(kLevelNames[i])
+                                               : "level_" + std::to_string(i);
+
+        section.add(name + "_entries", Unit::NONE, levels[i].entries);
+        section.add(name + "_reach", Unit::BYTES,
+                    static_cast<double>(levels[i].entries) * static_cast<double>(stride));
+        section.add(name + "_miss_penalty", Unit::NANOSECONDS, levels[i].missPenaltyNs);
+    }
+
+    section.add("page_walk_penalty", Unit::NANOSECONDS, points.back().penaltyNs);
+    section.add("page_walk_pages", Unit::NONE, points.back().pages);
+
+    for (auto &point: points) {
+        section.add("latency_" + std::to_string(point.pages), Unit::NANOSECONDS,
+                    point.latencyNs);
+        section.add("penalty_" + std::to_string(point.pages), Unit::NANOSECONDS,
+                    point.penaltyNs);
+    }
+}
+
+std::vector<DataTlbLevel> measureDataTlbs(uint32_t linuxId) {
+    auto pageSize = page_info::getPageSize();
+
+    AlignedMapping pages(std::min(getMaximumRegionSize(), kMaximumPages * pageSize), pageSize);
+    AlignedMapping lines(kMaximumPages * kLineSize, pageSize);
+    if (pages.data() == nullptr || lines.data() == nullptr) {
+        return {};
+    }
+
+    // Measuring whatever processor the scheduler picked would be worse than nothing
+    ScopedAffinity affinity(linuxId);
+    if (!affinity.isPinned()) {
+        return {};
+    }
+
+    auto points = measurePoints(pages, pageSize, lines);
+    if (points.empty()) {
+        return {};
+    }
+
+    return findLevels(points, pageSize);
+}
+
+BenchmarkReport runTlbBenchmark() {
+    using Unit = BenchmarkReport::Unit;
+
+    BenchmarkReport report;
+
+    auto pageSize = page_info::getPageSize();
+    auto maximumRegionSize = getMaximumRegionSize();
+    auto hugePageSize = getTransparentHugePageSize();
+
+    auto &system = report.addSection("System");
+    system.add("page_size", Unit::BYTES, pageSize);
+    system.add("thp_available", Unit::BOOLEAN, hugePageSize != 0);
+    if (hugePageSize != 0) {
+        system.add("thp_size", Unit::BYTES, hugePageSize);
+    }
+
+    AlignedMapping lines(kMaximumPages * kLineSize, pageSize);
+
+    // 4 KiB strides only make sense with 4 KiB pages, 16 KiB strides over 4 KiB pages still
+    // touch one page per node
+    std::vector<size_t> strides;
+    for (size_t stride: {4096, 16384}) {
+        if (stride >= pageSize) {
+            strides.push_back(stride);
+        }
+    }
+
+    std::vector<std::unique_ptr<AlignedMapping>> mappings;
+    for (auto stride: strides) {
+        mappings.push_back(std::make_unique<AlignedMapping>(
+                std::min(maximumRegionSize, kMaximumPages * stride), pageSize));
+    }
+
+    std::unique_ptr<AlignedMapping> hugePages;
+    double hugePageBackedRatio = 0;
+    if (hugePageSize != 0 && maximumRegionSize >= kMinimumPages * hugePageSize) {
+        hugePages = std::make_unique<AlignedMapping>(
+                maximumRegionSize / hugePageSize * hugePageSize, hugePageSize);
+
+        if (hugePages->data() != nullptr) {
+            madvise(hugePages->data(), hugePages->size(), MADV_HUGEPAGE);
+
+            // Fault in the whole region now, so that we can tell how much of it the kernel
+            // actually managed to back with huge pages
+            for (size_t offset = 0; offset < hugePages->size(); offset += pageSize) {
+                hugePages->data()[offset] = 1;
+            }
+
+            hugePageBackedRatio = static_cast<double>(
+                    page_info::getAnonHugePagesSize(hugePages->data(), hugePages->size()))
+                                  / static_cast<double>(hugePages->size());
+        }
+    }
+
+    if (lines.data() == nullptr) {
+        return report;
+    }
+
+    for (auto &cluster: getUarchClusters()) {
+        auto clusterName = "Cluster " + std::to_string(cluster.index);
+
+        ScopedAffinity affinity(cluster.linuxIds[0]);
+
+        auto &general = report.addSection(clusterName);
+        general.add("cpu", Unit::NONE, cluster.linuxIds[0]);
+        general.add("uarch", Unit::UARCH, cluster.uarch);
+        general.add("pinned", Unit::BOOLEAN, affinity.isPinned());
+
+        for (size_t i = 0; i < strides.size(); i++) {
+            if (mappings[i]->data() == nullptr) {
+                continue;
+            }
+
+            auto &section = report.addSection(
+                    clusterName + " " + std::to_string(strides[i] / 1024) + " KiB stride");
+            section.add("page_size", Unit::BYTES, pageSize);
+            section.add("stride", Unit::BYTES, strides[i]);
+            addPoints(section, measurePoints(*mappings[i], strides[i], lines), strides[i]);
+        }
+
+        if (hugePages != nullptr && hugePages->data() != nullptr) {
+            auto &section = report.addSection(clusterName + " THP");
+            section.add("page_size", Unit::BYTES, hugePageSize);
+            section.add("stride", Unit::BYTES, hugePageSize);
+            section.add("thp_backed", Unit::RATIO, hugePageBackedRatio);
+            addPoints(section, measurePoints(*hugePages, hugePageSize, lines), hugePageSize);
+        }
+    }
+
+    return report;
+}
@@ -0,0 +1,44 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "BenchmarkReport.h"
+
+/**
+ * A data TLB level, as seen from the latency of loads spread one per page.
+ */
+struct DataTlbLevel {
+    /**
+     * Pages that can be touched before the latency starts rising.
+     */
+    uint32_t entries;
+    uint64_t pageSize;
+
+    /**
+     * Latency added to a load once this level misses and the next one (or the page table walk)
+     * has to translate the address.
+     */
+    double missPenaltyNs;
+};
+
+/**
+ * Measure the data TLB levels of a processor with the kernel base page size.
+ * Takes about a second, cpuinfo must be initialized.
+ *
+ * @return The levels, empty if the thread couldn't be pinned to the processor or the
+ *         measurement failed
+ */
+std::vector<DataTlbLevel> measureDataTlbs(uint32_t linuxId);
+
+/**
+ * On each microarchitecture, chase pointers placed one per 4 KiB, 16 KiB and transparent huge
+ * page over a growing number of pages and compare the latency with the same number of cache
+ * lines packed together, to find the reach of each data TLB level and the cost of a page walk.
+ * cpuinfo must be initialized.
+ */
+BenchmarkReport runTlbBenchmark();
@@ -7,6 +7,7 @@
 
 #include <cstdlib>
 #include <jni.h>
+#include <vector>
 
 #define JNI_CHECK(env)                \
     do {                              \
@@ -19,12 +20,43 @@
 #define OBJECT_CLASS_SIG "Ljava/lang/Object;"
 #define STRING_CLASS_SIG "Ljava/lang/String;"
 
-static jmethodID getArrayListAddMethodID(JNIEnv *env, jobject object) {
-    auto arrayListClazz = env->GetObjectClass(object);
+inline jint registerNatives(JNIEnv *env, const char *className,
+                            const JNINativeMethod *methods, jint methodsCount) {
+    auto clazz = env->FindClass(className);
     JNI_CHECK(env);
 
-    auto methodID = env->GetMethodID(arrayListClazz, "add", "(" OBJECT_CLASS_SIG ")Z");
-    JNI_CHECK(env);
+    auto result = env->RegisterNatives(clazz, methods, methodsCount);
+    env->DeleteLocalRef(clazz);
+
+    return result;
+}
+
+/**
+ * Copy values read natively into a new Java array.
+ *
+ * Readers fill a native buffer first and copy it with a single Set<Type>ArrayRegion() call:
+ * they may take locks or open files, neither of which is allowed while a critical array is
+ * held, as that can stall the garbage collector or deadlock with it.
+ *
+ * @return The array, null if it couldn't be allocated (an OutOfMemoryError is pending)
+ */
+inline jlongArray toJLongArray(JNIEnv *env, const std::vector<jlong> &values) {
+    auto array = env->NewLongArray(static_cast<jsize>(values.size()));
+    if (array != nullptr) {
+        env->SetLongArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+    }
+
+    return array;
+}
+
+/**
+ * @see toJLongArray
+ */
+inline jfloatArray toJFloatArray(JNIEnv *env, const std::vector<jfloat> &values) {
+    auto array = env->NewFloatArray(static_cast<jsize>(values.size()));
+    if (array != nullptr) {
+        env->SetFloatArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+    }
 
-    return methodID;
+    return array;
 }
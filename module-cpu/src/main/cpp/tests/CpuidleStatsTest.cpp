@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CpuidleStats.h"
+#include "HotplugMonitor.h"
+
+/**
+ * Runs against a fake sysfs tree where every CPU has two idle states, the online CPUs come from
+ * the layout generation.
+ */
+class CpuidleStatsTest : public testing::Test {
+protected:
+    void SetUp() override {
+        mBasePath = testing::TempDir() + "cpuidle_stats_test";
+        std::filesystem::remove_all(mBasePath);
+
+        mStats = std::unique_ptr<CpuidleStats>(new CpuidleStats(mBasePath));
+        ASSERT_FALSE(mStats->mCpus.empty());
+
+        for (auto &cpu: mStats->mCpus) {
+            for (auto state: {0, 1}) {
+                auto path = mBasePath + "/cpu" + std::to_string(cpu.id) + "/cpuidle/state"
+                            + std::to_string(state);
+                std::filesystem::create_directories(path);
+
+                std::ofstream(path + "/name") << "state" << state << "\n";
+                std::ofstream(path + "/latency") << state * 100 << "\n";
+                std::ofstream(path + "/usage") << "10\n";
+                std::ofstream(path + "/time") << "1000\n";
+            }
+        }
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(mBasePath);
+    }
+
+    /**
+     * Pretend the states were listed at another generation with these online CPUs.
+     */
+    void enumerate(uint64_t generation, const std::string &onlineCpus) {
+        std::lock_guard lock(mStats->mMutex);
+        mStats->enumerate(generation, onlineCpus);
+    }
+
+    uint64_t getGeneration() const { return mStats->mGeneration; }
+
+    size_t getLayoutSize() const { return mStats->mOutputSize; }
+
+    std::vector<size_t> getStateCounts() const {
+        std::vector<size_t> stateCounts;
+        for (auto &cpu: mStats->mCpus) {
+            stateCounts.push_back(cpu.states.size());
+        }
+        return stateCounts;
+    }
+
+    std::vector<uint32_t> getCpuIds() const {
+        std::vector<uint32_t> cpuIds;
+        for (auto &cpu: mStats->mCpus) {
+            cpuIds.push_back(cpu.id);
+        }
+        return cpuIds;
+    }
+
+    std::vector<int64_t> read() {
+        std::vector<int64_t> values(mStats->getOutputSize());
+        values.resize(mStats->read(0, values.data(), values.size()));
+        return values;
+    }
+
+    static std::vector<bool> parseOnlineCpus(const std::string &onlineCpus) {
+        std::vector<bool> online;
+        parseCpuList(onlineCpus.data(), onlineCpus.data() + onlineCpus.size(),
+                     [&](uint32_t first, uint32_t last) {
+                         online.resize(std::max<size_t>(online.size(), last + 1));
+                         std::fill(online.begin() + first, online.begin() + last + 1, true);
+                     });
+        return online;
+    }
+
+    std::string mBasePath;
+    std::unique_ptr<CpuidleStats> mStats;
+};
+
+TEST_F(CpuidleStatsTest, ListsOnlyOnlineCpus) {
+    auto &monitor = HotplugMonitor::getInstance();
+    auto online = parseOnlineCpus(monitor.getOnlineCpus());
+
+    auto values = read();
+    ASSERT_FALSE(values.empty());
+    EXPECT_EQ(getGeneration(), monitor.getGeneration());
+    EXPECT_EQ(static_cast<uint64_t>(values[1]), getGeneration());
+
+    auto cpuIds = getCpuIds();
+    auto stateCounts = getStateCounts();
+    for (size_t i = 0; i < cpuIds.size(); i++) {
+        auto isOnline = cpuIds[i] < online.size() && online[cpuIds[i]];
+        EXPECT_EQ(stateCounts[i], isOnline ? 2u : 0u) << "CPU " << cpuIds[i];
+    }
+}
+
+TEST_F(CpuidleStatsTest, DropsOfflineCpus) {
+    auto cpuIds = getCpuIds();
+
+    enumerate(1, "0-" + std::to_string(cpuIds.back()));
+    EXPECT_EQ(getStateCounts(), std::vector<size_t>(cpuIds.size(), 2));
+
+    enumerate(2, "");
+    EXPECT_EQ(getStateCounts(), std::vector<size_t>(cpuIds.size(), 0));
+    EXPECT_EQ(getLayoutSize(), 4 + cpuIds.size() * 2);
+}
+
+TEST_F(CpuidleStatsTest, RelistsOnGenerationChange) {
+    auto &monitor = HotplugMonitor::getInstance();
+
+    // As if every CPU was offline when first listed, then the generation moved on
+    enumerate(monitor.getGeneration() + 1, "");
+    EXPECT_EQ(getStateCounts(), std::vector<size_t>(getCpuIds().size(), 0));
+
+    std::vector<std::string> names;
+    EXPECT_FALSE(mStats->getStateNames(monitor.getGeneration() + 1, names));
+
+    auto values = read();
+    ASSERT_FALSE(values.empty());
+    EXPECT_EQ(getGeneration(), monitor.getGeneration());
+    EXPECT_EQ(values.size(), getLayoutSize());
+
+    // The CPUs that are online now got their states
+    size_t stateCount = 0;
+    for (auto count: getStateCounts()) {
+        stateCount += count;
+    }
+    EXPECT_GT(stateCount, 0u);
+
+    ASSERT_TRUE(mStats->getStateNames(getGeneration(), names));
+    ASSERT_EQ(names.size(), stateCount);
+    EXPECT_EQ(names[0], "state0");
+    EXPECT_EQ(names[1], "state1");
+}
@@ -0,0 +1,143 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstring>
+#include <jni.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Just enough of a JNIEnv to call our natives off device.
+ *
+ * Natives are reached through the table handed to RegisterNatives(), like the JVM does, and
+ * primitive arrays are plain native buffers. Only one instance may exist at a time.
+ */
+class FakeJniEnv {
+public:
+    FakeJniEnv() {
+        sInstance = this;
+
+        mFunctions.FindClass = [](JNIEnv *, const char *) -> jclass {
+            return reinterpret_cast<jclass>(&sClass);
+        };
+        mFunctions.DeleteLocalRef = [](JNIEnv *, jobject) {};
+        mFunctions.ExceptionCheck = [](JNIEnv *) -> jboolean { return JNI_FALSE; };
+        mFunctions.RegisterNatives = [](JNIEnv *, jclass, const JNINativeMethod *methods,
+                                        jint count) -> jint {
+            for (jint i = 0; i < count; i++) {
+                sInstance->mNatives[methods[i].name] = methods[i].fnPtr;
+            }
+            return JNI_OK;
+        };
+
+        mFunctions.NewLongArray = [](JNIEnv *, jsize length) {
+            return reinterpret_cast<jlongArray>(sInstance->newArray(length, sizeof(jlong)));
+        };
+        mFunctions.NewIntArray = [](JNIEnv *, jsize length) {
+            return reinterpret_cast<jintArray>(sInstance->newArray(length, sizeof(jint)));
+        };
+        mFunctions.NewFloatArray = [](JNIEnv *, jsize length) {
+            return reinterpret_cast<jfloatArray>(sInstance->newArray(length, sizeof(jfloat)));
+        };
+        mFunctions.SetLongArrayRegion = [](JNIEnv *, jlongArray array, jsize start, jsize length,
+                                           const jlong *values) {
+            setRegion(array, start, length, values);
+        };
+        mFunctions.SetIntArrayRegion = [](JNIEnv *, jintArray array, jsize start, jsize length,
+                                          const jint *values) {
+            setRegion(array, start, length, values);
+        };
+        mFunctions.SetFloatArrayRegion = [](JNIEnv *, jfloatArray array, jsize start,
+                                            jsize length, const jfloat *values) {
+            setRegion(array, start, length, values);
+        };
+        mFunctions.GetArrayLength = [](JNIEnv *, jarray array) -> jsize {
+            return static_cast<jsize>(toArray(array)->length);
+        };
+        mFunctions.GetPrimitiveArrayCritical = [](JNIEnv *, jarray array, jboolean *) -> void * {
+            sInstance->mCriticalCount++;
+            return toArray(array)->data.data();
+        };
+        mFunctions.ReleasePrimitiveArrayCritical = [](JNIEnv *, jarray, void *, jint) {};
+
+        mEnv.functions = &mFunctions;
+    }
+
+    ~FakeJniEnv() {
+        sInstance = nullptr;
+    }
+
+    FakeJniEnv(const FakeJniEnv &) = delete;
+
+    FakeJniEnv &operator=(const FakeJniEnv &) = delete;
+
+    JNIEnv *get() { return &mEnv; }
+
+    /**
+     * Call a native registered through RegisterNatives(), as a static method.
+     */
+    template<typename R, typename... Args>
+    R call(const std::string &name, Args... args) {
+        auto native = mNatives.find(name);
+        if (native == mNatives.end()) {
+            return R();
+        }
+
+        auto function = reinterpret_cast<R (*)(JNIEnv *, jobject, Args...)>(native->second);
+        return function(&mEnv, nullptr, args...);
+    }
+
+    template<typename T>
+    std::vector<T> getArray(jarray array) const {
+        auto fakeArray = toArray(array);
+
+        std::vector<T> values(fakeArray->length);
+        memcpy(values.data(), fakeArray->data.data(), fakeArray->data.size());
+
+        return values;
+    }
+
+    /**
+     * @return How many times a critical array was requested
+     */
+    size_t getCriticalCount() const { return mCriticalCount; }
+
+private:
+    struct Array {
+        size_t length;
+        std::vector<uint8_t> data;
+    };
+
+    static inline FakeJniEnv *sInstance = nullptr;
+    static inline int sClass = 0;
+
+    static Array *toArray(jarray array) {
+        return reinterpret_cast<Array *>(array);
+    }
+
+    template<typename T>
+    static void setRegion(jarray array, jsize start, jsize length, const T *values) {
+        memcpy(toArray(array)->data.data() + start * sizeof(T), values, length * sizeof(T));
+    }
+
+    Array *newArray(jsize length, size_t elementSize) {
+        auto &array = mArrays.emplace_back(std::make_unique<Array>());
+        array->length = static_cast<size_t>(length);
+        array->data.resize(array->length * elementSize);
+
+        return array.get();
+    }
+
+    JNINativeInterface_ mFunctions{};
+    JNIEnv mEnv{};
+
+    std::map<std::string, void *> mNatives;
+    std::vector<std::unique_ptr<Array>> mArrays;
+    size_t mCriticalCount = 0;
+};
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+#include "HotplugMonitor.h"
+
+static std::string readOnlineCpus() {
+    std::string onlineCpus;
+    std::getline(std::ifstream(CPU_BASE_PATH "/online"), onlineCpus);
+
+    return onlineCpus;
+}
+
+TEST(HotplugMonitorTest, ReadsOnDemandWhenUnmonitored) {
+    auto &monitor = HotplugMonitor::getInstance();
+
+    EXPECT_EQ(monitor.getOnlineCpus(), readOnlineCpus());
+    EXPECT_EQ(monitor.getGeneration(), monitor.getGeneration());
+}
+
+TEST(HotplugMonitorTest, StartAndStopAreReferenceCounted) {
+    auto &monitor = HotplugMonitor::getInstance();
+
+    monitor.start();
+    monitor.start();
+    monitor.stop();
+
+    EXPECT_EQ(monitor.getOnlineCpus(), readOnlineCpus());
+
+    // Must join the thread and go back to reading on demand
+    monitor.stop();
+    monitor.stop();
+
+    EXPECT_EQ(monitor.getOnlineCpus(), readOnlineCpus());
+
+    monitor.start();
+    monitor.stop();
+}
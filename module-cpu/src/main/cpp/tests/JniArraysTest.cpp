@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <gtest/gtest.h>
+#include "CpuLoadSampler.h"
+#include "CpufreqStats.h"
+#include "CpufreqUtils.h"
+#include "CpuidleStats.h"
+#include "CpuidleUtils.h"
+#include "FakeJniEnv.h"
+#include "LinuxCpuReader.h"
+#include "LinuxCpuUtils.h"
+#include "PerfMonitor.h"
+#include "PerfUtils.h"
+
+/**
+ * The array natives must fill a native buffer and copy it once, never reading sysfs, procfs
+ * or perf counters while a critical array is held.
+ */
+class JniArraysTest : public testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(registerLinuxCpuUtilsNatives(mEnv.get()), JNI_OK);
+        ASSERT_EQ(registerCpufreqUtilsNatives(mEnv.get()), JNI_OK);
+        ASSERT_EQ(registerCpuidleUtilsNatives(mEnv.get()), JNI_OK);
+        ASSERT_EQ(registerPerfUtilsNatives(mEnv.get()), JNI_OK);
+    }
+
+    void TearDown() override {
+        EXPECT_EQ(mEnv.getCriticalCount(), 0u);
+    }
+
+    FakeJniEnv mEnv;
+};
+
+TEST_F(JniArraysTest, CpuValues) {
+    auto array = mEnv.call<jlongArray>("getCpuValues");
+    ASSERT_NE(array, nullptr);
+
+    auto &reader = LinuxCpuReader::getInstance();
+    auto values = mEnv.getArray<jlong>(array);
+    ASSERT_EQ(values.size(), reader.getCpuCount() * LinuxCpuReader::FIELD_COUNT);
+
+    for (size_t cpu = 0; cpu + 1 < reader.getCpuCount(); cpu++) {
+        EXPECT_LT(values[cpu * LinuxCpuReader::FIELD_COUNT + LinuxCpuReader::ID],
+                  values[(cpu + 1) * LinuxCpuReader::FIELD_COUNT + LinuxCpuReader::ID]);
+    }
+}
+
+TEST_F(JniArraysTest, CpuLoadHistory) {
+    auto array = mEnv.call<jfloatArray>("getCpuLoadHistory");
+    ASSERT_NE(array, nullptr);
+
+    auto values = mEnv.getArray<jfloat>(array);
+    EXPECT_EQ(values.size(),
+              CpuLoadSampler::getInstance().getCpuCount() * CpuLoadSampler::kRecordSize);
+}
+
+TEST_F(JniArraysTest, CpufreqResidency) {
+    auto array = mEnv.call<jlongArray>("getCpufreqResidency", static_cast<jlong>(1000));
+    ASSERT_NE(array, nullptr);
+
+    EXPECT_EQ(mEnv.getArray<jlong>(array).size(), CpufreqStats::getInstance().getOutputSize());
+}
+
+TEST_F(JniArraysTest, CpuidleResidency) {
+    auto array = mEnv.call<jlongArray>("getCpuidleResidency", static_cast<jlong>(1000));
+    ASSERT_NE(array, nullptr);
+
+    EXPECT_EQ(mEnv.getArray<jlong>(array).size(), CpuidleStats::getInstance().getOutputSize());
+}
+
+TEST_F(JniArraysTest, PerfCounters) {
+    auto array = mEnv.call<jlongArray>("getPerfCounters");
+    ASSERT_NE(array, nullptr);
+
+    EXPECT_EQ(mEnv.getArray<jlong>(array).size(), PerfMonitor::getInstance().getOutputSize());
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "SpscRingBuffer.h"
+
+namespace {
+
+bool write(SpscRingBuffer &ring, uint64_t value) {
+    auto record = ring.beginWrite();
+    if (record == nullptr) {
+        return false;
+    }
+
+    memcpy(record, &value, sizeof(value));
+    ring.endWrite();
+
+    return true;
+}
+
+std::vector<uint64_t> drain(SpscRingBuffer &ring, size_t maxRecords) {
+    std::vector<uint64_t> values(maxRecords);
+    values.resize(ring.drain(reinterpret_cast<uint8_t *>(values.data()), maxRecords));
+
+    return values;
+}
+
+} // namespace
+
+TEST(SpscRingBufferTest, RoundsCapacityUp) {
+    SpscRingBuffer ring(sizeof(uint64_t), 5);
+
+    EXPECT_EQ(ring.getCapacity(), 8u);
+    EXPECT_EQ(ring.getRecordSize(), sizeof(uint64_t));
+}
+
+TEST(SpscRingBufferTest, DrainsOldestFirst) {
+    SpscRingBuffer ring(sizeof(uint64_t), 8);
+
+    for (uint64_t i = 0; i < 5; i++) {
+        ASSERT_TRUE(write(ring, i));
+    }
+
+    EXPECT_EQ(drain(ring, 3), (std::vector<uint64_t>{0, 1, 2}));
+    EXPECT_EQ(drain(ring, 8), (std::vector<uint64_t>{3, 4}));
+    EXPECT_TRUE(drain(ring, 8).empty());
+}
+
+TEST(SpscRingBufferTest, CountsOverruns) {
+    SpscRingBuffer ring(sizeof(uint64_t), 4);
+
+    for (uint64_t i = 0; i < 6; i++) {
+        EXPECT_EQ(write(ring, i), i < 4);
+    }
+
+    EXPECT_EQ(ring.getOverruns(), 2u);
+
+    // Records that didn't fit are dropped, not the oldest ones
+    EXPECT_EQ(drain(ring, 8), (std::vector<uint64_t>{0, 1, 2, 3}));
+}
+
+TEST(SpscRingBufferTest, DrainsAcrossTheEnd) {
+    SpscRingBuffer ring(sizeof(uint64_t), 4);
+
+    for (uint64_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(write(ring, i));
+    }
+    ASSERT_EQ(drain(ring, 3).size(), 3u);
+
+    // Slots 3, 0, 1 and 2
+    for (uint64_t i = 3; i < 7; i++) {
+        ASSERT_TRUE(write(ring, i));
+    }
+
+    EXPECT_EQ(drain(ring, 4), (std::vector<uint64_t>{3, 4, 5, 6}));
+}
+
+TEST(SpscRingBufferTest, Clear) {
+    SpscRingBuffer ring(sizeof(uint64_t), 4);
+
+    ASSERT_TRUE(write(ring, 1));
+    ASSERT_TRUE(write(ring, 2));
+    ring.clear();
+
+    EXPECT_TRUE(drain(ring, 4).empty());
+
+    ASSERT_TRUE(write(ring, 3));
+    EXPECT_EQ(drain(ring, 4), (std::vector<uint64_t>{3}));
+}
+
+TEST(SpscRingBufferTest, ConcurrentProducer) {
+    static constexpr uint64_t kRecordCount = 100000;
+
+    SpscRingBuffer ring(sizeof(uint64_t), 64);
+
+    std::thread producer([&] {
+        for (uint64_t i = 0; i < kRecordCount; i++) {
+            while (!write(ring, i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    // Every record must come out once and in order, whatever the interleaving
+    uint64_t expected = 0;
+    bool inOrder = true;
+    while (expected < kRecordCount) {
+        auto values = drain(ring, 16);
+        if (values.empty()) {
+            std::this_thread::yield();
+        }
+
+        for (auto value: values) {
+            inOrder = inOrder && value == expected;
+            expected++;
+        }
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(expected, kRecordCount);
+}
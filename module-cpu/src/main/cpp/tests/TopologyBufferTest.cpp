@@ -0,0 +1,236 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cpuinfo.h>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "TopologyBuffer.h"
+
+namespace {
+
+/**
+ * Minimal reader following the same steps as TopologyBuffer.kt.
+ */
+class Reader {
+public:
+    struct Table {
+        uint32_t rowCount;
+        std::vector<uint32_t> columnOffsets;
+        std::vector<uint32_t> columnWidths;
+    };
+
+    explicit Reader(const std::vector<uint8_t> &data) : mData(data) {
+        size_t offset = 16;
+        for (uint32_t table = 0; table < getHeader(12); table++) {
+            Table info = {
+                    .rowCount = getU32(offset),
+                    .columnOffsets = {},
+                    .columnWidths = {},
+            };
+            auto columnCount = getU32(offset + 4);
+            offset += 8;
+
+            for (uint32_t column = 0; column < columnCount; column++) {
+                info.columnOffsets.push_back(getU32(offset + column * 4));
+            }
+            offset += columnCount * 4;
+
+            for (uint32_t column = 0; column < columnCount; column++) {
+                info.columnWidths.push_back(getU32(offset + column * 4));
+            }
+            offset += columnCount * 4;
+
+            mTables.push_back(std::move(info));
+        }
+    }
+
+    uint32_t getHeader(size_t offset) const { return getU32(offset); }
+
+    const std::vector<Table> &getTables() const { return mTables; }
+
+    uint32_t getInt(uint32_t table, uint32_t column, uint32_t row) const {
+        return getU32(cell(table, column, row, sizeof(uint32_t)));
+    }
+
+    uint64_t getLong(uint32_t table, uint32_t column, uint32_t row) const {
+        return read<uint64_t>(cell(table, column, row, sizeof(uint64_t)));
+    }
+
+    std::string getString(uint32_t table, uint32_t column, uint32_t row) const {
+        auto width = mTables.at(table).columnWidths.at(column);
+        auto offset = cell(table, column, row, width);
+        if (offset + width > mData.size()) {
+            return {};
+        }
+
+        auto begin = reinterpret_cast<const char *>(mData.data() + offset);
+        return {begin, strnlen(begin, width)};
+    }
+
+private:
+    uint32_t getU32(size_t offset) const { return read<uint32_t>(offset); }
+
+    template<typename T>
+    T read(size_t offset) const {
+        T value = 0;
+        if (offset + sizeof(T) > mData.size()) {
+            ADD_FAILURE() << "Offset " << offset << " is out of bounds";
+            return value;
+        }
+
+        memcpy(&value, mData.data() + offset, sizeof(T));
+        return value;
+    }
+
+    size_t cell(uint32_t table, uint32_t column, uint32_t row, size_t width) const {
+        auto &info = mTables.at(table);
+        EXPECT_LT(row, info.rowCount);
+        EXPECT_EQ(info.columnWidths.at(column), width);
+
+        auto offset = info.columnOffsets.at(column) + static_cast<size_t>(row) * width;
+        EXPECT_LE(offset + width, mData.size());
+
+        return offset;
+    }
+
+    const std::vector<uint8_t> &mData;
+    std::vector<Table> mTables;
+};
+
+template<typename T>
+uint32_t indexOf(const T *element, const T *base) {
+    return element == nullptr ? TopologyBuffer::kNoIndex : static_cast<uint32_t>(element - base);
+}
+
+class TopologyBufferTest : public testing::Test {
+protected:
+    static constexpr const char *kOnlineCpus = "0,2-3";
+
+    void SetUp() override {
+        ASSERT_TRUE(cpuinfo_initialize());
+
+        mData = TopologyBuffer::build(kOnlineCpus);
+    }
+
+    std::vector<uint8_t> mData;
+};
+
+} // namespace
+
+TEST_F(TopologyBufferTest, Header) {
+    Reader reader(mData);
+
+    EXPECT_EQ(reader.getHeader(0), TopologyBuffer::kMagic);
+    EXPECT_EQ(reader.getHeader(4), TopologyBuffer::kVersion);
+    EXPECT_EQ(reader.getHeader(8), mData.size());
+    ASSERT_EQ(reader.getHeader(12), TopologyBuffer::TABLE_COUNT);
+
+    for (auto &table: reader.getTables()) {
+        ASSERT_EQ(table.columnOffsets.size(), table.columnWidths.size());
+
+        for (size_t column = 0; column < table.columnOffsets.size(); column++) {
+            EXPECT_EQ(table.columnOffsets[column] % 8, 0u);
+            EXPECT_LE(table.columnOffsets[column] +
+                      static_cast<size_t>(table.columnWidths[column]) * table.rowCount,
+                      mData.size());
+        }
+    }
+}
+
+TEST_F(TopologyBufferTest, RowCounts) {
+    Reader reader(mData);
+    auto &tables = reader.getTables();
+
+    EXPECT_EQ(tables[TopologyBuffer::PROCESSORS].rowCount, cpuinfo_get_processors_count());
+    EXPECT_EQ(tables[TopologyBuffer::CORES].rowCount, cpuinfo_get_cores_count());
+    EXPECT_EQ(tables[TopologyBuffer::CLUSTERS].rowCount, cpuinfo_get_clusters_count());
+    EXPECT_EQ(tables[TopologyBuffer::PACKAGES].rowCount, cpuinfo_get_packages_count());
+    EXPECT_EQ(tables[TopologyBuffer::UARCHS].rowCount, cpuinfo_get_uarchs_count());
+    EXPECT_EQ(tables[TopologyBuffer::L1I_CACHES].rowCount, cpuinfo_get_l1i_caches_count());
+    EXPECT_EQ(tables[TopologyBuffer::L1D_CACHES].rowCount, cpuinfo_get_l1d_caches_count());
+    EXPECT_EQ(tables[TopologyBuffer::L2_CACHES].rowCount, cpuinfo_get_l2_caches_count());
+    EXPECT_EQ(tables[TopologyBuffer::L3_CACHES].rowCount, cpuinfo_get_l3_caches_count());
+    EXPECT_EQ(tables[TopologyBuffer::L4_CACHES].rowCount, cpuinfo_get_l4_caches_count());
+}
+
+TEST_F(TopologyBufferTest, Processors) {
+    Reader reader(mData);
+
+    auto processors = cpuinfo_get_processors();
+    for (uint32_t i = 0; i < cpuinfo_get_processors_count(); i++) {
+        auto &processor = processors[i];
+
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 0, i), processor.smt_id);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 1, i),
+                  indexOf(processor.core, cpuinfo_get_cores()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 2, i),
+                  indexOf(processor.cluster, cpuinfo_get_clusters()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 3, i),
+                  indexOf(processor.package, cpuinfo_get_packages()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 4, i),
+                  static_cast<uint32_t>(processor.linux_id));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 6, i),
+                  indexOf(processor.cache.l1i, cpuinfo_get_l1i_caches()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 7, i),
+                  indexOf(processor.cache.l1d, cpuinfo_get_l1d_caches()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 8, i),
+                  indexOf(processor.cache.l2, cpuinfo_get_l2_caches()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 9, i),
+                  indexOf(processor.cache.l3, cpuinfo_get_l3_caches()));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 10, i),
+                  indexOf(processor.cache.l4, cpuinfo_get_l4_caches()));
+
+        auto online = processor.linux_id == 0 || processor.linux_id == 2
+                      || processor.linux_id == 3;
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PROCESSORS, 11, i), online ? 1u : 0u);
+    }
+}
+
+TEST_F(TopologyBufferTest, Clusters) {
+    Reader reader(mData);
+
+    auto clusters = cpuinfo_get_clusters();
+    for (uint32_t i = 0; i < cpuinfo_get_clusters_count(); i++) {
+        auto &cluster = clusters[i];
+
+        EXPECT_EQ(reader.getInt(TopologyBuffer::CLUSTERS, 0, i), cluster.processor_start);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::CLUSTERS, 1, i), cluster.processor_count);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::CLUSTERS, 4, i), cluster.cluster_id);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::CLUSTERS, 7, i),
+                  static_cast<uint32_t>(cluster.uarch));
+        EXPECT_EQ(reader.getLong(TopologyBuffer::CLUSTERS, 10, i), cluster.frequency);
+    }
+}
+
+TEST_F(TopologyBufferTest, Packages) {
+    Reader reader(mData);
+
+    auto packages = cpuinfo_get_packages();
+    for (uint32_t i = 0; i < cpuinfo_get_packages_count(); i++) {
+        auto &package = packages[i];
+
+        EXPECT_EQ(reader.getString(TopologyBuffer::PACKAGES, 0, i),
+                  std::string(package.name, strnlen(package.name, CPUINFO_PACKAGE_NAME_MAX)));
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PACKAGES, 1, i), package.processor_start);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::PACKAGES, 2, i), package.processor_count);
+    }
+}
+
+TEST_F(TopologyBufferTest, Caches) {
+    Reader reader(mData);
+
+    auto caches = cpuinfo_get_l2_caches();
+    for (uint32_t i = 0; i < cpuinfo_get_l2_caches_count(); i++) {
+        auto &cache = caches[i];
+
+        EXPECT_EQ(reader.getInt(TopologyBuffer::L2_CACHES, 0, i), cache.size);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::L2_CACHES, 1, i), cache.associativity);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::L2_CACHES, 4, i), cache.line_size);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::L2_CACHES, 6, i), cache.processor_start);
+        EXPECT_EQ(reader.getInt(TopologyBuffer::L2_CACHES, 7, i), cache.processor_count);
+    }
+}
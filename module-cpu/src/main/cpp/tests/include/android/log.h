@@ -0,0 +1,37 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdarg>
+#include <cstdio>
+
+/**
+ * Host stand-in for the NDK logging API, so that JNI glue can be unit tested off device.
+ */
+
+enum android_LogPriority {
+    ANDROID_LOG_UNKNOWN = 0,
+    ANDROID_LOG_DEFAULT,
+    ANDROID_LOG_VERBOSE,
+    ANDROID_LOG_DEBUG,
+    ANDROID_LOG_INFO,
+    ANDROID_LOG_WARN,
+    ANDROID_LOG_ERROR,
+    ANDROID_LOG_FATAL,
+    ANDROID_LOG_SILENT,
+};
+
+__attribute__((format(printf, 3, 4)))
+inline int __android_log_print(int priority, const char *tag, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%s: ", tag);
+    auto result = vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+
+    return result;
+}
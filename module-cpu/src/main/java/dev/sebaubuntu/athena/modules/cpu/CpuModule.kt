@@ -8,6 +8,7 @@ package dev.sebaubuntu.athena.modules.cpu
 import android.content.Context
 import android.os.Build
 import androidx.annotation.StringRes
+import dev.sebaubuntu.athena.core.models.BenchmarkReport
 import dev.sebaubuntu.athena.core.models.Element
 import dev.sebaubuntu.athena.core.models.Error
 import dev.sebaubuntu.athena.core.models.LocalizedString
@@ -16,13 +17,34 @@ import dev.sebaubuntu.athena.core.models.Resource
 import dev.sebaubuntu.athena.core.models.Result
 import dev.sebaubuntu.athena.core.models.Screen
 import dev.sebaubuntu.athena.core.models.Value
+import dev.sebaubuntu.athena.core.utils.FrequencyUtils
+import dev.sebaubuntu.athena.modules.cpu.models.Benchmark
 import dev.sebaubuntu.athena.modules.cpu.models.Cache
+import dev.sebaubuntu.athena.modules.cpu.models.CpuLoad.Companion.averageBusy
+import dev.sebaubuntu.athena.modules.cpu.models.CpufreqResidency
+import dev.sebaubuntu.athena.modules.cpu.models.CpuidleResidency
 import dev.sebaubuntu.athena.modules.cpu.models.LinuxCpu
 import dev.sebaubuntu.athena.modules.cpu.models.Midr
+import dev.sebaubuntu.athena.modules.cpu.models.PageInfo
+import dev.sebaubuntu.athena.modules.cpu.models.PerfCounters
+import dev.sebaubuntu.athena.modules.cpu.models.Processor
+import dev.sebaubuntu.athena.modules.cpu.models.TelemetryBatch
+import dev.sebaubuntu.athena.modules.cpu.models.Tlb
+import dev.sebaubuntu.athena.modules.cpu.models.Topology
+import dev.sebaubuntu.athena.modules.cpu.models.Uarch
+import dev.sebaubuntu.athena.modules.cpu.utils.BenchmarkUtils
+import dev.sebaubuntu.athena.modules.cpu.utils.CpuHotplugUtils
 import dev.sebaubuntu.athena.modules.cpu.utils.CpuInfoUtils
+import dev.sebaubuntu.athena.modules.cpu.utils.CpufreqUtils
+import dev.sebaubuntu.athena.modules.cpu.utils.CpuidleUtils
+import dev.sebaubuntu.athena.modules.cpu.utils.LinuxCpuUtils
+import dev.sebaubuntu.athena.modules.cpu.utils.PerfUtils
+import dev.sebaubuntu.athena.modules.cpu.utils.TelemetryUtils
 import kotlinx.coroutines.delay
+import kotlinx.coroutines.flow.emitAll
 import kotlinx.coroutines.flow.flow
 import kotlinx.coroutines.flow.flowOf
+import kotlinx.coroutines.flow.map
 import kotlin.time.Duration
 import kotlin.time.Duration.Companion.seconds
 
@@ -42,11 +64,13 @@ class CpuModule : Module {
     override val requiredPermissions = arrayOf<String>()
 
     override fun resolve(identifier: Resource.Identifier) = when (identifier.path.firstOrNull()) {
-        null -> pollFlow {
+        null -> topologyFlow {
+            val topology = CpuInfoUtils.getLazyTopology()
+
             val screen = Screen.CardListScreen(
                 identifier = identifier,
                 title = name,
-                elements = listOf(
+                elements = listOfNotNull(
                     Element.Card(
                         name = "abi",
                         title = LocalizedString(R.string.cpu_abi),
@@ -66,13 +90,22 @@ class CpuModule : Module {
                                 title = LocalizedString(R.string.cpu_supported_32_bit_abis),
                                 value = Value(Build.SUPPORTED_32_BIT_ABIS),
                             ),
+                            Element.Item(
+                                name = "isa_features",
+                                title = LocalizedString(R.string.cpu_isa_features),
+                                value = Value(
+                                    CpuInfoUtils.getIsaFeatures().map {
+                                        it.displayName
+                                    }.toTypedArray()
+                                ),
+                            ),
                         ),
                     ),
                     Element.Card(
                         name = "general",
                         title = LocalizedString(dev.sebaubuntu.athena.core.R.string.general),
                         elements = listOfNotNull(
-                            CpuInfoUtils.getProcessors().takeIf { it.isNotEmpty() }?.let {
+                            topology.processors.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "processors",
                                     title = LocalizedString(R.string.cpu_processors),
@@ -81,7 +114,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getCores().takeIf { it.isNotEmpty() }?.let {
+                            topology.cores.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "cores",
                                     title = LocalizedString(R.string.cpu_cores),
@@ -90,7 +123,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getClusters().takeIf { it.isNotEmpty() }?.let {
+                            topology.clusters.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "clusters",
                                     title = LocalizedString(R.string.cpu_clusters),
@@ -99,7 +132,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getPackages().takeIf { it.isNotEmpty() }?.let {
+                            topology.packages.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "packages",
                                     title = LocalizedString(R.string.cpu_packages),
@@ -108,7 +141,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getUarchs().takeIf { it.isNotEmpty() }?.let {
+                            topology.uarchs.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "uarchs",
                                     title = LocalizedString(R.string.cpu_uarchs),
@@ -117,7 +150,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getL1iCaches().takeIf { it.isNotEmpty() }?.let {
+                            topology.l1iCaches.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "l1i_caches",
                                     title = LocalizedString(R.string.cpu_l1i_caches),
@@ -126,7 +159,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getL1dCaches().takeIf { it.isNotEmpty() }?.let {
+                            topology.l1dCaches.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "l1d_caches",
                                     title = LocalizedString(R.string.cpu_l1d_caches),
@@ -135,7 +168,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getL2Caches().takeIf { it.isNotEmpty() }?.let {
+                            topology.l2Caches.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "l2_caches",
                                     title = LocalizedString(R.string.cpu_l2_caches),
@@ -144,7 +177,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getL3Caches().takeIf { it.isNotEmpty() }?.let {
+                            topology.l3Caches.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "l3_caches",
                                     title = LocalizedString(R.string.cpu_l3_caches),
@@ -153,7 +186,7 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
-                            CpuInfoUtils.getL4Caches().takeIf { it.isNotEmpty() }?.let {
+                            topology.l4Caches.takeIf { it.isNotEmpty() }?.let {
                                 Element.Item(
                                     name = "l4_caches",
                                     title = LocalizedString(R.string.cpu_l4_caches),
@@ -162,17 +195,103 @@ class CpuModule : Module {
                                     value = Value(it.size),
                                 )
                             },
+                            Element.Item(
+                                name = "benchmarks",
+                                title = LocalizedString(R.string.cpu_benchmarks),
+                                navigateTo = identifier / "benchmarks",
+                                exportable = false,
+                                drawableResId = dev.sebaubuntu.athena.core.R.drawable.ic_build,
+                            ),
                         ),
                     ),
+                    LinuxCpuUtils.getPageInfo()?.let { getPageInfoCardElement(it) },
                 )
             )
 
             Result.Success<Resource, Error>(screen)
         }
 
+        "benchmarks" -> when (identifier.path.getOrNull(1)) {
+            null -> flowOf(
+                Result.Success<Resource, Error>(
+                    Screen.ItemListScreen(
+                        identifier = identifier,
+                        title = LocalizedString(R.string.cpu_benchmarks),
+                        elements = Benchmark.entries.map {
+                            Element.Item(
+                                name = it.nativeName,
+                                title = LocalizedString(benchmarkToStringResId.getValue(it)),
+                                navigateTo = identifier / it.nativeName,
+                                exportable = false,
+                                drawableResId = dev.sebaubuntu.athena.core.R.drawable.ic_build,
+                            )
+                        },
+                    )
+                )
+            )
+
+            else -> Benchmark.entries.firstOrNull {
+                it.nativeName == identifier.path[1]
+            }?.let { benchmark ->
+                when (identifier.path.getOrNull(2)) {
+                    // Nothing runs until the user explicitly asks for it
+                    null -> flowOf(
+                        Result.Success<Resource, Error>(
+                            Screen.ItemListScreen(
+                                identifier = identifier,
+                                title = LocalizedString(
+                                    benchmarkToStringResId.getValue(benchmark)
+                                ),
+                                elements = listOf(
+                                    Element.Item(
+                                        name = "run",
+                                        title = LocalizedString(R.string.cpu_benchmark_run),
+                                        navigateTo = identifier / "run",
+                                        exportable = false,
+                                        drawableResId = dev.sebaubuntu.athena.core.R.drawable.ic_build,
+                                    ),
+                                ),
+                            )
+                        )
+                    )
+
+                    // Runs once per collection, benchmarks take seconds and load the whole CPU
+                    "run" -> flow {
+                        val screen = BenchmarkUtils.run(benchmark)?.let { report ->
+                            Screen.CardListScreen(
+                                identifier = identifier,
+                                title = LocalizedString(
+                                    benchmarkToStringResId.getValue(benchmark)
+                                ),
+                                elements = report.sections.map { section ->
+                                    section.getCardElement { entry ->
+                                        when (entry.unit) {
+                                            BenchmarkReport.ValueUnit.UARCH -> Value(
+                                                Uarch.fromCpuInfo(entry.value.toInt())
+                                            )
+
+                                            else -> entry.toValue()
+                                        }
+                                    }
+                                },
+                            )
+                        }
+
+                        emit(
+                            screen?.let {
+                                Result.Success<Resource, Error>(it)
+                            } ?: Result.Error(Error.NOT_FOUND)
+                        )
+                    }
+
+                    else -> null
+                }
+            } ?: flowOf(Result.Error(Error.NOT_FOUND))
+        }
+
         "clusters" -> when (identifier.path.getOrNull(1)) {
-            null -> pollFlow {
-                val clusters = CpuInfoUtils.getClusters()
+            null -> topologyFlow {
+                val clusters = CpuInfoUtils.getLazyTopology().clusters
 
                 val screen = Screen.ItemListScreen(
                     identifier = identifier,
@@ -197,13 +316,23 @@ class CpuModule : Module {
                 null -> pollFlow {
                     val clusterId = identifier.path[1].toUIntOrNull()
 
+                    val topology = CpuInfoUtils.getLazyTopology()
+
                     val cluster = clusterId?.let { clusterId ->
-                        CpuInfoUtils.getClusters().firstOrNull {
+                        topology.clusters.firstOrNull {
                             it.clusterId == clusterId
                         }
                     }
 
                     val screen = cluster?.let { cluster ->
+                        val processors = topology.processors.filter { it.cluster == cluster }
+
+                        val busy = LinuxCpuUtils.getCpuLoads().averageBusy(processors)
+                        val cpufreqResidency = CpufreqUtils.getResidency(RESIDENCY_WINDOW)
+                        val cpuidleSummary = CpuidleUtils.getResidency(RESIDENCY_WINDOW)?.summarize(
+                            processors
+                        )
+
                         Screen.CardListScreen(
                             identifier = identifier,
                             title = LocalizedString(
@@ -262,9 +391,25 @@ class CpuModule : Module {
                                             title = LocalizedString(R.string.cpu_frequency),
                                             value = Value(cluster.frequency),
                                         ),
+                                        getLoadElement(busy),
                                     ),
                                 ),
+                                cpufreqResidency?.getCardElement(processors),
+                                cpuidleSummary?.getCardElement(),
                                 cluster.midr?.getCardElement(),
+                                Element.Card(
+                                    name = "data_tlbs",
+                                    title = LocalizedString(R.string.cpu_data_tlbs),
+                                    elements = listOf(
+                                        // Pins a thread to the cluster for about a second
+                                        Element.Item(
+                                            name = "measure",
+                                            title = LocalizedString(R.string.cpu_data_tlbs_measure),
+                                            navigateTo = identifier / "data_tlbs",
+                                            exportable = false,
+                                        ),
+                                    ),
+                                ),
                             ),
                         )
                     }
@@ -274,13 +419,41 @@ class CpuModule : Module {
                     } ?: Result.Error(Error.NOT_FOUND)
                 }
 
+                "data_tlbs" -> flow {
+                    val clusterId = identifier.path[1].toUIntOrNull()
+
+                    val topology = CpuInfoUtils.getLazyTopology()
+
+                    val processor = clusterId?.let { clusterId ->
+                        topology.processors.firstOrNull {
+                            it.cluster.clusterId == clusterId
+                        }
+                    }
+
+                    val screen = processor?.let {
+                        Screen.CardListScreen(
+                            identifier = identifier,
+                            title = LocalizedString(R.string.cpu_data_tlbs),
+                            elements = listOfNotNull(
+                                getDataTlbsCardElement(CpuInfoUtils.getDataTlbs(it.linuxId)),
+                            ),
+                        )
+                    }
+
+                    emit(
+                        screen?.let {
+                            Result.Success<Resource, Error>(it)
+                        } ?: Result.Error(Error.NOT_FOUND)
+                    )
+                }
+
                 else -> flowOf(Result.Error(Error.NOT_FOUND))
             }
         }
 
         "cores" -> when (identifier.path.getOrNull(1)) {
-            null -> pollFlow {
-                val cores = CpuInfoUtils.getCores()
+            null -> topologyFlow {
+                val cores = CpuInfoUtils.getLazyTopology().cores
 
                 val screen = Screen.ItemListScreen(
                     identifier = identifier,
@@ -305,13 +478,19 @@ class CpuModule : Module {
                 null -> pollFlow {
                     val coreId = identifier.path[1].toUIntOrNull()
 
+                    val topology = CpuInfoUtils.getLazyTopology()
+
                     val core = coreId?.let { coreId ->
-                        CpuInfoUtils.getCores().firstOrNull {
+                        topology.cores.firstOrNull {
                             it.coreId == coreId
                         }
                     }
 
                     val screen = core?.let { core ->
+                        val cpuidleSummary = CpuidleUtils.getResidency(RESIDENCY_WINDOW)?.summarize(
+                            topology.processors.filter { it.core == core }
+                        )
+
                         Screen.CardListScreen(
                             identifier = identifier,
                             title = LocalizedString(
@@ -367,6 +546,7 @@ class CpuModule : Module {
                                         ),
                                     ),
                                 ),
+                                cpuidleSummary?.getCardElement(),
                             ),
                         )
                     }
@@ -382,42 +562,42 @@ class CpuModule : Module {
 
         "l1d_caches" -> cachePath(
             identifier = identifier,
-            cachesGetter = CpuInfoUtils::getL1dCaches,
+            cachesGetter = Topology::l1dCaches,
             cachesStringResId = R.string.cpu_l1d_caches,
             cacheStringResId = R.string.cpu_l1d_cache_title,
         )
 
         "l1i_caches" -> cachePath(
             identifier = identifier,
-            cachesGetter = CpuInfoUtils::getL1iCaches,
+            cachesGetter = Topology::l1iCaches,
             cachesStringResId = R.string.cpu_l1i_caches,
             cacheStringResId = R.string.cpu_l1i_cache_title,
         )
 
         "l2_caches" -> cachePath(
             identifier = identifier,
-            cachesGetter = CpuInfoUtils::getL2Caches,
+            cachesGetter = Topology::l2Caches,
             cachesStringResId = R.string.cpu_l2_caches,
             cacheStringResId = R.string.cpu_l2_cache_title,
         )
 
         "l3_caches" -> cachePath(
             identifier = identifier,
-            cachesGetter = CpuInfoUtils::getL3Caches,
+            cachesGetter = Topology::l3Caches,
             cachesStringResId = R.string.cpu_l3_caches,
             cacheStringResId = R.string.cpu_l3_cache_title,
         )
 
         "l4_caches" -> cachePath(
             identifier = identifier,
-            cachesGetter = CpuInfoUtils::getL4Caches,
+            cachesGetter = Topology::l4Caches,
             cachesStringResId = R.string.cpu_l4_caches,
             cacheStringResId = R.string.cpu_l4_cache_title,
         )
 
         "packages" -> when (identifier.path.getOrNull(1)) {
-            null -> pollFlow {
-                val packages = CpuInfoUtils.getPackages()
+            null -> topologyFlow {
+                val packages = CpuInfoUtils.getLazyTopology().packages
 
                 val screen = Screen.ItemListScreen(
                     identifier = identifier,
@@ -440,11 +620,11 @@ class CpuModule : Module {
             }
 
             else -> when (identifier.path.getOrNull(2)) {
-                null -> pollFlow {
+                null -> topologyFlow {
                     val packageIndex = identifier.path[1].toIntOrNull()
 
                     val value = packageIndex?.let { packageIndex ->
-                        CpuInfoUtils.getPackages().withIndex().firstOrNull { (index, _) ->
+                        CpuInfoUtils.getLazyTopology().packages.withIndex().firstOrNull { (index, _) ->
                             index == packageIndex
                         }
                     }
@@ -512,8 +692,8 @@ class CpuModule : Module {
         }
 
         "processors" -> when (identifier.path.getOrNull(1)) {
-            null -> pollFlow {
-                val processors = CpuInfoUtils.getProcessors()
+            null -> topologyFlow {
+                val processors = CpuInfoUtils.getLazyTopology().processors
 
                 val screen = Screen.ItemListScreen(
                     identifier = identifier,
@@ -535,131 +715,155 @@ class CpuModule : Module {
             }
 
             else -> when (identifier.path.getOrNull(2)) {
-                null -> pollFlow {
-                    val linuxId = identifier.path[1].toUIntOrNull()
-
-                    val processor = linuxId?.let { linuxId ->
-                        CpuInfoUtils.getProcessors().firstOrNull {
-                            it.linuxId == linuxId
-                        }
+                null -> flow {
+                    // Pins this thread to the processor, measure once instead of on every update
+                    val effectiveFrequencyHz = identifier.path[1].toUIntOrNull()?.let {
+                        LinuxCpuUtils.getEffectiveFrequencyHz(it)
                     }
 
-                    val screen = processor?.let { processor ->
-                        val linuxCpu = LinuxCpu.fromProcessor(processor)
+                    emitAll(telemetryPollFlow { telemetry ->
+                        val linuxId = identifier.path[1].toUIntOrNull()
 
-                        Screen.CardListScreen(
-                            identifier = identifier,
-                            title = LocalizedString(
-                                R.string.cpu_processor,
-                                processor.linuxId,
-                            ),
-                            elements = listOf(
-                                Element.Card(
-                                    name = "general",
-                                    title = LocalizedString(dev.sebaubuntu.athena.core.R.string.general),
-                                    elements = listOfNotNull(
-                                        Element.Item(
-                                            name = "smt_id",
-                                            title = LocalizedString(R.string.cpu_processor_smt_id),
-                                            value = Value(processor.smtId),
-                                        ),
-                                        Element.Item(
-                                            name = "core_id",
-                                            title = LocalizedString(R.string.cpu_core_id),
-                                            value = Value(processor.core.coreId),
-                                        ),
-                                        Element.Item(
-                                            name = "cluster_id",
-                                            title = LocalizedString(R.string.cpu_cluster_id),
-                                            value = Value(processor.cluster.clusterId),
-                                        ),
-                                        Element.Item(
-                                            name = "linux_id",
-                                            title = LocalizedString(R.string.cpu_processor_linux_id),
-                                            value = Value(processor.linuxId),
-                                        ),
-                                        processor.apicId?.let {
-                                            Element.Item(
-                                                name = "apic_id",
-                                                title = LocalizedString(R.string.cpu_processor_apic_id),
-                                                value = Value(it),
-                                            )
-                                        },
-                                        Element.Item(
-                                            name = "cache",
-                                            title = LocalizedString(R.string.cpu_processor_cache),
-                                            value = Value(processor.cache.toString()),
-                                        ),
-                                    ),
+                        val processor = linuxId?.let { linuxId ->
+                            CpuInfoUtils.getLazyTopology().processors.firstOrNull {
+                                it.linuxId == linuxId
+                            }
+                        }
+
+                        val screen = processor?.let { processor ->
+                            val linuxCpu = LinuxCpu.fromProcessor(processor)
+                            val busy = LinuxCpuUtils.getCpuLoads()[processor.linuxId]?.current?.busy
+                            val peakFrequencyHz = telemetry.getPeakFrequencyHz(processor.linuxId)
+                            val perfCounters = PerfUtils.getCounters()
+
+                            Screen.CardListScreen(
+                                identifier = identifier,
+                                title = LocalizedString(
+                                    R.string.cpu_processor,
+                                    processor.linuxId,
                                 ),
-                                Element.Card(
-                                    name = "status",
-                                    title = LocalizedString(R.string.cpu_status),
-                                    elements = listOfNotNull(
-                                        linuxCpu.isOnline?.let {
-                                            Element.Item(
-                                                name = "is_online",
-                                                title = LocalizedString(R.string.cpu_is_online),
-                                                value = Value(it),
-                                            )
-                                        },
-                                        linuxCpu.currentFrequencyHz?.let { currentFrequencyHz ->
+                                elements = listOfNotNull(
+                                    Element.Card(
+                                        name = "general",
+                                        title = LocalizedString(dev.sebaubuntu.athena.core.R.string.general),
+                                        elements = listOfNotNull(
                                             Element.Item(
-                                                name = "current_frequency_hz",
-                                                title = LocalizedString(R.string.cpu_current_frequency),
-                                                value = Value.FrequencyValue(currentFrequencyHz),
-                                            )
-                                        },
-                                        linuxCpu.minimumFrequencyHz?.let { minimumFrequencyHz ->
+                                                name = "smt_id",
+                                                title = LocalizedString(R.string.cpu_processor_smt_id),
+                                                value = Value(processor.smtId),
+                                            ),
                                             Element.Item(
-                                                name = "minimum_frequency_hz",
-                                                title = LocalizedString(R.string.cpu_minimum_frequency),
-                                                value = Value.FrequencyValue(minimumFrequencyHz),
-                                            )
-                                        },
-                                        linuxCpu.maximumFrequencyHz?.let { maximumFrequencyHz ->
+                                                name = "core_id",
+                                                title = LocalizedString(R.string.cpu_core_id),
+                                                value = Value(processor.core.coreId),
+                                            ),
                                             Element.Item(
-                                                name = "maximum_frequency_hz",
-                                                title = LocalizedString(R.string.cpu_maximum_frequency),
-                                                value = Value.FrequencyValue(maximumFrequencyHz),
-                                            )
-                                        },
-                                        linuxCpu.scalingCurrentFrequencyHz?.let { scalingCurrentFrequencyHz ->
+                                                name = "cluster_id",
+                                                title = LocalizedString(R.string.cpu_cluster_id),
+                                                value = Value(processor.cluster.clusterId),
+                                            ),
                                             Element.Item(
-                                                name = "scaling_current_frequency_hz",
-                                                title = LocalizedString(R.string.cpu_scaling_current_frequency),
-                                                value = Value.FrequencyValue(
-                                                    scalingCurrentFrequencyHz
-                                                ),
-                                            )
-                                        },
-                                        linuxCpu.scalingMinimumFrequencyHz?.let { scalingMinimumFrequencyHz ->
+                                                name = "linux_id",
+                                                title = LocalizedString(R.string.cpu_processor_linux_id),
+                                                value = Value(processor.linuxId),
+                                            ),
+                                            processor.apicId?.let {
+                                                Element.Item(
+                                                    name = "apic_id",
+                                                    title = LocalizedString(R.string.cpu_processor_apic_id),
+                                                    value = Value(it),
+                                                )
+                                            },
                                             Element.Item(
-                                                name = "scaling_minimum_frequency_hz",
-                                                title = LocalizedString(R.string.cpu_scaling_minimum_frequency),
-                                                value = Value.FrequencyValue(
-                                                    scalingMinimumFrequencyHz
-                                                ),
-                                            )
-                                        },
-                                        linuxCpu.scalingMaximumFrequencyHz?.let { scalingMaximumFrequencyHz ->
+                                                name = "cache",
+                                                title = LocalizedString(R.string.cpu_processor_cache),
+                                                value = Value(processor.cache.toString()),
+                                            ),
+                                        ),
+                                    ),
+                                    Element.Card(
+                                        name = "status",
+                                        title = LocalizedString(R.string.cpu_status),
+                                        elements = listOfNotNull(
                                             Element.Item(
-                                                name = "scaling_maximum_frequency_hz",
-                                                title = LocalizedString(R.string.cpu_scaling_maximum_frequency),
-                                                value = Value.FrequencyValue(
-                                                    scalingMaximumFrequencyHz
-                                                ),
-                                            )
-                                        },
+                                                name = "is_online",
+                                                title = LocalizedString(R.string.cpu_is_online),
+                                                value = Value(processor.isOnline),
+                                            ),
+                                            getLoadElement(busy),
+                                            linuxCpu?.currentFrequencyHz?.let { currentFrequencyHz ->
+                                                Element.Item(
+                                                    name = "current_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_current_frequency),
+                                                    value = Value.FrequencyValue(currentFrequencyHz),
+                                                )
+                                            },
+                                            peakFrequencyHz?.let {
+                                                Element.Item(
+                                                    name = "peak_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_peak_frequency),
+                                                    value = Value.FrequencyValue(it),
+                                                )
+                                            },
+                                            linuxCpu?.minimumFrequencyHz?.let { minimumFrequencyHz ->
+                                                Element.Item(
+                                                    name = "minimum_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_minimum_frequency),
+                                                    value = Value.FrequencyValue(minimumFrequencyHz),
+                                                )
+                                            },
+                                            linuxCpu?.maximumFrequencyHz?.let { maximumFrequencyHz ->
+                                                Element.Item(
+                                                    name = "maximum_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_maximum_frequency),
+                                                    value = Value.FrequencyValue(maximumFrequencyHz),
+                                                )
+                                            },
+                                            linuxCpu?.scalingCurrentFrequencyHz?.let { scalingCurrentFrequencyHz ->
+                                                Element.Item(
+                                                    name = "scaling_current_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_scaling_current_frequency),
+                                                    value = Value.FrequencyValue(
+                                                        scalingCurrentFrequencyHz
+                                                    ),
+                                                )
+                                            },
+                                            effectiveFrequencyHz?.let {
+                                                Element.Item(
+                                                    name = "effective_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_effective_frequency),
+                                                    value = Value.FrequencyValue(it),
+                                                )
+                                            },
+                                            linuxCpu?.scalingMinimumFrequencyHz?.let { scalingMinimumFrequencyHz ->
+                                                Element.Item(
+                                                    name = "scaling_minimum_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_scaling_minimum_frequency),
+                                                    value = Value.FrequencyValue(
+                                                        scalingMinimumFrequencyHz
+                                                    ),
+                                                )
+                                            },
+                                            linuxCpu?.scalingMaximumFrequencyHz?.let { scalingMaximumFrequencyHz ->
+                                                Element.Item(
+                                                    name = "scaling_maximum_frequency_hz",
+                                                    title = LocalizedString(R.string.cpu_scaling_maximum_frequency),
+                                                    value = Value.FrequencyValue(
+                                                        scalingMaximumFrequencyHz
+                                                    ),
+                                                )
+                                            },
+                                        ),
                                     ),
-                                )
-                            ),
-                        )
-                    }
+                                    perfCounters?.getCardElement(processor.linuxId),
+                                ),
+                            )
+                        }
 
-                    screen?.let {
-                        Result.Success<Resource, Error>(it)
-                    } ?: Result.Error(Error.NOT_FOUND)
+                        screen?.let {
+                            Result.Success<Resource, Error>(it)
+                        } ?: Result.Error(Error.NOT_FOUND)
+                    })
                 }
 
                 else -> flowOf(Result.Error(Error.NOT_FOUND))
@@ -667,8 +871,8 @@ class CpuModule : Module {
         }
 
         "uarchs" -> when (identifier.path.getOrNull(1)) {
-            null -> pollFlow {
-                val uarchs = CpuInfoUtils.getUarchs()
+            null -> topologyFlow {
+                val uarchs = CpuInfoUtils.getLazyTopology().uarchs
 
                 val screen = Screen.ItemListScreen(
                     identifier = identifier,
@@ -694,13 +898,19 @@ class CpuModule : Module {
                 null -> pollFlow {
                     val uarchIndex = identifier.path[1].toIntOrNull()
 
+                    val topology = CpuInfoUtils.getLazyTopology()
+
                     val uarch = uarchIndex?.let { uarchIndex ->
-                        CpuInfoUtils.getUarchs().withIndex().firstOrNull { (index, _) ->
+                        topology.uarchs.withIndex().firstOrNull { (index, _) ->
                             index == uarchIndex
                         }
                     }
 
                     val screen = uarch?.let { (index, uarch) ->
+                        val busy = LinuxCpuUtils.getCpuLoads().averageBusy(
+                            topology.processors.filter { it.core.uarch == uarch.uarch }
+                        )
+
                         Screen.CardListScreen(
                             identifier = identifier,
                             title = LocalizedString(
@@ -734,6 +944,7 @@ class CpuModule : Module {
                                             title = LocalizedString(R.string.cpu_core_count),
                                             value = Value(uarch.coreCount),
                                         ),
+                                        getLoadElement(busy),
                                     ),
                                 ),
                                 uarch.midr?.getCardElement(),
@@ -755,12 +966,12 @@ class CpuModule : Module {
 
     private fun cachePath(
         identifier: Resource.Identifier,
-        cachesGetter: () -> List<Cache>,
+        cachesGetter: (Topology) -> List<Cache>,
         @StringRes cachesStringResId: Int,
         @StringRes cacheStringResId: Int,
     ) = when (identifier.path.getOrNull(1)) {
-        null -> pollFlow {
-            val caches = cachesGetter()
+        null -> topologyFlow {
+            val caches = cachesGetter(CpuInfoUtils.getLazyTopology())
 
             val screen = Screen.ItemListScreen(
                 identifier = identifier,
@@ -782,11 +993,11 @@ class CpuModule : Module {
         }
 
         else -> when (identifier.path.getOrNull(2)) {
-            null -> pollFlow {
+            null -> topologyFlow {
                 val cacheIndex = identifier.path[1].toIntOrNull()
 
                 val cache = cacheIndex?.let { cacheIndex ->
-                    cachesGetter().withIndex().firstOrNull { (index, _) ->
+                    cachesGetter(CpuInfoUtils.getLazyTopology()).withIndex().firstOrNull { (index, _) ->
                         index == cacheIndex
                     }
                 }
@@ -858,6 +1069,196 @@ class CpuModule : Module {
         }
     }
 
+    private fun getLoadElement(busy: Float?) = busy?.let {
+        val percentage = it * 100
+
+        Element.Item(
+            name = "load",
+            title = LocalizedString(R.string.cpu_load),
+            value = Value("$percentage", R.string.cpu_load_percentage, percentage),
+        )
+    }
+
+    private fun CpufreqResidency.getCardElement(
+        processors: List<Processor>,
+    ) = getPolicy(processors)?.takeIf { it.states.isNotEmpty() }?.let { policy ->
+        Element.Card(
+            name = "frequency_residency",
+            title = LocalizedString(R.string.cpu_frequency_residency),
+            elements = listOfNotNull(
+                getTransitionsPerSecond(policy)?.let {
+                    Element.Item(
+                        name = "transitions_per_second",
+                        title = LocalizedString(R.string.cpu_transitions_per_second),
+                        value = Value(it),
+                    )
+                },
+                *policy.states.mapNotNull { state ->
+                    policy.getResidencyShare(state)?.let {
+                        val percentage = it * 100
+
+                        Element.Item(
+                            name = "${state.frequencyHz}",
+                            title = LocalizedString(
+                                FrequencyUtils.toHumanReadable(state.frequencyHz)
+                            ),
+                            value = Value(
+                                "$percentage",
+                                R.string.cpu_load_percentage,
+                                percentage,
+                            ),
+                        )
+                    }
+                }.toTypedArray(),
+            ),
+        )
+    }
+
+    private fun CpuidleResidency.Summary.getCardElement() = Element.Card(
+        name = "idle_states",
+        title = LocalizedString(R.string.cpu_idle_states),
+        elements = listOfNotNull(
+            wakeupsPerSecond?.let {
+                Element.Item(
+                    name = "wakeups_per_second",
+                    title = LocalizedString(R.string.cpu_wakeups_per_second),
+                    value = Value(it),
+                )
+            },
+            *states.map { state ->
+                val percentage = state.residencyShare * 100
+
+                Element.Item(
+                    name = state.name,
+                    title = state.exitLatencyUs?.let {
+                        LocalizedString(R.string.cpu_idle_state_title, state.name, it)
+                    } ?: LocalizedString(state.name),
+                    value = Value("$percentage", R.string.cpu_load_percentage, percentage),
+                )
+            }.toTypedArray(),
+        ),
+    )
+
+    private fun getDataTlbsCardElement(tlbs: List<Tlb>) = tlbs.takeIf {
+        it.isNotEmpty()
+    }?.let {
+        Element.Card(
+            name = "data_tlbs",
+            title = LocalizedString(R.string.cpu_data_tlbs),
+            elements = tlbs.mapIndexed { index, tlb ->
+                Element.Item(
+                    name = "l${index + 1}",
+                    title = LocalizedString(R.string.cpu_data_tlb_title, index + 1),
+                    value = Value(
+                        "${tlb.entries}",
+                        R.string.cpu_data_tlb_entries,
+                        tlb.entries.toLong(),
+                        (tlb.reach / 1024UL).toLong(),
+                    ),
+                )
+            },
+        )
+    }
+
+    private fun getPageInfoCardElement(pageInfo: PageInfo) = Element.Card(
+        name = "pages",
+        title = LocalizedString(R.string.cpu_pages),
+        elements = listOfNotNull(
+            Element.Item(
+                name = "page_size",
+                title = LocalizedString(R.string.cpu_page_size),
+                value = Value.Bytes(pageInfo.pageSize),
+            ),
+            pageInfo.thpMode?.let {
+                Element.Item(
+                    name = "thp_mode",
+                    title = LocalizedString(R.string.cpu_thp_mode),
+                    value = Value(it, thpModeToStringResId),
+                )
+            },
+            pageInfo.thpSize?.let {
+                Element.Item(
+                    name = "thp_size",
+                    title = LocalizedString(R.string.cpu_thp_size),
+                    value = Value.Bytes(it),
+                )
+            },
+            *pageInfo.mthpSizes.mapNotNull { mthpSize ->
+                mthpSize.mode?.let {
+                    Element.Item(
+                        name = "mthp_${mthpSize.size}",
+                        title = LocalizedString(R.string.cpu_mthp_title, mthpSize.size / 1024),
+                        value = Value(it, thpModeToStringResId),
+                    )
+                }
+            }.toTypedArray(),
+        ),
+    )
+
+    private fun PerfCounters.getCardElement(linuxId: UInt) = Element.Card(
+        name = "perf_counters",
+        title = LocalizedString(R.string.cpu_perf_counters),
+        elements = when (isAvailable) {
+            true -> getCpu(linuxId)?.let { cpu ->
+                listOfNotNull(
+                    getCyclesPerSecond(cpu)?.let {
+                        Element.Item(
+                            name = "cycles_per_second",
+                            title = LocalizedString(R.string.cpu_perf_cycles_per_second),
+                            value = Value.FrequencyValue(it),
+                        )
+                    },
+                    cpu.ipc?.let {
+                        Element.Item(
+                            name = "ipc",
+                            title = LocalizedString(R.string.cpu_perf_ipc),
+                            value = Value("$it", R.string.cpu_perf_ratio, it),
+                        )
+                    },
+                    *listOf(
+                        PerfCounters.Event.BRANCH_MISSES to R.string.cpu_perf_branch_mpki,
+                        PerfCounters.Event.L1D_READ_MISSES to R.string.cpu_perf_l1d_mpki,
+                        PerfCounters.Event.LLC_READ_MISSES to R.string.cpu_perf_llc_mpki,
+                    ).mapNotNull { (event, stringResId) ->
+                        cpu.getPerKiloInstructions(event)?.let {
+                            Element.Item(
+                                name = "${event.name.lowercase()}_per_kilo_instructions",
+                                title = LocalizedString(stringResId),
+                                value = Value("$it", R.string.cpu_perf_ratio, it),
+                            )
+                        }
+                    }.toTypedArray(),
+                    *listOf(
+                        PerfCounters.Event.STALLED_CYCLES_FRONTEND to R.string.cpu_perf_stalled_cycles_frontend,
+                        PerfCounters.Event.STALLED_CYCLES_BACKEND to R.string.cpu_perf_stalled_cycles_backend,
+                    ).mapNotNull { (event, stringResId) ->
+                        cpu.getCycleShare(event)?.let {
+                            val percentage = it * 100
+
+                            Element.Item(
+                                name = "${event.name.lowercase()}_share",
+                                title = LocalizedString(stringResId),
+                                value = Value("$percentage", R.string.cpu_load_percentage, percentage),
+                            )
+                        }
+                    }.toTypedArray(),
+                )
+            } ?: listOf()
+
+            false -> listOf(
+                Element.Item(
+                    name = "unavailable",
+                    title = LocalizedString(R.string.cpu_perf_unavailable),
+                    value = Value(
+                        "$paranoidLevel",
+                        R.string.cpu_perf_paranoid_level,
+                        paranoidLevel?.toString() ?: "?",
+                    ),
+                ),
+            )
+        },
+    )
+
     private fun Midr.getCardElement() = Element.Card(
         name = "midr",
         title = LocalizedString(R.string.cpu_midr),
@@ -901,7 +1302,62 @@ class CpuModule : Module {
         }
     }
 
+    /**
+     * Emit [block]'s result now and every time a CPU goes online or offline, for screens that
+     * only show the topology.
+     */
+    private fun <T> topologyFlow(
+        block: suspend () -> T,
+    ) = CpuHotplugUtils.onlineCpus.map { block() }
+
+    /**
+     * Like [pollFlow], but also runs the background telemetry sampler while collected and
+     * passes the samples recorded since the previous update to [block].
+     */
+    private fun <T> telemetryPollFlow(
+        delayDuration: Duration = 1.seconds,
+        rateHz: Int = TELEMETRY_RATE_HZ,
+        block: suspend (TelemetryBatch) -> T,
+    ) = flow {
+        TelemetryUtils.start(rateHz)
+
+        try {
+            while (true) {
+                emit(block(TelemetryUtils.drain()))
+
+                delay(delayDuration)
+            }
+        } finally {
+            TelemetryUtils.stop()
+        }
+    }
+
     companion object {
+        private const val TELEMETRY_RATE_HZ = 200
+
+        private val RESIDENCY_WINDOW = 10.seconds
+
+        private val thpModeToStringResId = mapOf(
+            PageInfo.ThpMode.NEVER to R.string.cpu_thp_mode_never,
+            PageInfo.ThpMode.MADVISE to R.string.cpu_thp_mode_madvise,
+            PageInfo.ThpMode.ALWAYS to R.string.cpu_thp_mode_always,
+            PageInfo.ThpMode.INHERIT to R.string.cpu_thp_mode_inherit,
+        )
+
+        private val benchmarkToStringResId = mapOf(
+            Benchmark.COMPUTE to R.string.cpu_benchmark_compute,
+            Benchmark.COMPUTE_PER_CORE to R.string.cpu_benchmark_compute_per_core,
+            Benchmark.CONTENTION to R.string.cpu_benchmark_contention,
+            Benchmark.CORE_TO_CORE to R.string.cpu_benchmark_core_to_core,
+            Benchmark.FREQUENCY to R.string.cpu_benchmark_frequency,
+            Benchmark.ISA to R.string.cpu_benchmark_isa,
+            Benchmark.MEMORY to R.string.cpu_benchmark_memory,
+            Benchmark.PAGES to R.string.cpu_benchmark_pages,
+            Benchmark.PERF to R.string.cpu_benchmark_perf,
+            Benchmark.STREAM to R.string.cpu_benchmark_stream,
+            Benchmark.TLB to R.string.cpu_benchmark_tlb,
+        )
+
         init {
             System.loadLibrary("athena_cpu")
         }
@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Native benchmarks.
+ *
+ * Must be kept in sync with Benchmarks.cpp.
+ */
+enum class Benchmark(
+    val nativeName: String,
+) {
+    /**
+     * Integer, floating point, vector and branch throughput, once per microarchitecture.
+     */
+    COMPUTE("compute"),
+
+    /**
+     * Same as [COMPUTE], for every core.
+     */
+    COMPUTE_PER_CORE("compute-per-core"),
+
+    /**
+     * Atomic fetch-add, compare-and-swap, spinlock and mutex throughput from 1 to N threads on
+     * each cluster, each pair of clusters and all of them, with LL/SC and LSE atomics apart on ARM.
+     */
+    CONTENTION("contention"),
+
+    /**
+     * Latency of moving a cache line between every pair of processors.
+     */
+    CORE_TO_CORE("core-to-core"),
+
+    /**
+     * Effective clock of every processor next to the one reported by cpufreq.
+     */
+    FREQUENCY("frequency"),
+
+    /**
+     * Instruction set extensions, each checked and timed against scalar code on every
+     * microarchitecture.
+     */
+    ISA("isa"),
+
+    /**
+     * Latency and bandwidth over working sets from 4 KiB to a few hundred MiB, with the knees of
+     * the latency curve matched against the reported cache sizes.
+     */
+    MEMORY("memory"),
+
+    /**
+     * Page size and transparent huge page configuration, then the cost of first touch page
+     * faults, prefaulting and mmap()/munmap() churn on each microarchitecture.
+     */
+    PAGES("pages"),
+
+    /**
+     * Hardware performance counters available on each microarchitecture.
+     */
+    PERF("perf"),
+
+    /**
+     * STREAM copy, scale, add and triad bandwidth as threads are added to each cluster and then
+     * across clusters, scalar and vectorized, with the thread count where memory saturates.
+     */
+    STREAM("stream"),
+
+    /**
+     * Data TLB reach and page walk cost with 4 KiB, 16 KiB and transparent huge pages.
+     */
+    TLB("tlb"),
+}
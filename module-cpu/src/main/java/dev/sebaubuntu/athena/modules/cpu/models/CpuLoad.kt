@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Utilization history of a CPU, computed from /proc/stat.
+ *
+ * @param linuxId Linux CPU ID, matches [Processor.linuxId]
+ * @param history Samples, oldest first, null where the CPU was offline or not sampled yet
+ */
+data class CpuLoad(
+    val linuxId: UInt,
+    val history: List<Sample?>,
+) {
+    /**
+     * Share of the time spent in each state since the previous sample, from 0 to 1.
+     */
+    data class Sample(
+        val user: Float,
+        val system: Float,
+        val iowait: Float,
+        val irq: Float,
+        val idle: Float,
+    ) {
+        /**
+         * Share of the time spent running something.
+         */
+        val busy: Float
+            get() = user + system + irq
+    }
+
+    /**
+     * The latest sample.
+     */
+    val current: Sample?
+        get() = history.lastOrNull()
+
+    companion object {
+        /**
+         * Average current busy share of the given processors, null if none of them has a sample.
+         */
+        fun Map<UInt, CpuLoad>.averageBusy(processors: List<Processor>) = processors.mapNotNull {
+            get(it.linuxId)?.current?.busy
+        }.takeIf { it.isNotEmpty() }?.average()?.toFloat()
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Where each cpufreq policy spent its time over a window.
+ *
+ * @param windowNs Actual length of the window, may be shorter than requested if not enough
+ *   history was available
+ * @param overheadNs Time spent reading the stats for this result
+ * @param policies cpufreq policies
+ */
+data class CpufreqResidency(
+    val windowNs: Long,
+    val overheadNs: Long,
+    val policies: List<Policy>,
+) {
+    /**
+     * @param id Policy ID, as in `cpufreq/policyN`
+     * @param relatedCpus Linux IDs of the CPUs sharing this policy
+     * @param transitions Frequency transitions during the window, null if unknown
+     * @param states Time spent at each frequency, empty if the kernel doesn't expose stats
+     */
+    data class Policy(
+        val id: Int,
+        val relatedCpus: List<UInt>,
+        val transitions: Long?,
+        val states: List<State>,
+    ) {
+        /**
+         * @param frequencyHz Frequency, in Hz
+         * @param residencyMs Time spent at this frequency during the window, in ms, null if unknown
+         */
+        data class State(
+            val frequencyHz: Long,
+            val residencyMs: Long?,
+        )
+
+        private val totalResidencyMs = states.sumOf { it.residencyMs ?: 0 }
+
+        /**
+         * Share of the window spent at the given state, from 0 to 1.
+         */
+        fun getResidencyShare(state: State) = state.residencyMs?.takeIf {
+            totalResidencyMs > 0
+        }?.let {
+            it.toFloat() / totalResidencyMs
+        }
+    }
+
+    /**
+     * Frequency transitions per second of the given policy.
+     */
+    fun getTransitionsPerSecond(policy: Policy) = policy.transitions?.takeIf {
+        windowNs > 0
+    }?.let {
+        it * 1_000_000_000.0 / windowNs
+    }
+
+    /**
+     * Get the policy driving the given processors (e.g. the ones of a [Cluster]).
+     */
+    fun getPolicy(processors: List<Processor>) = policies.firstOrNull { policy ->
+        processors.any { it.linuxId in policy.relatedCpus }
+    }
+}
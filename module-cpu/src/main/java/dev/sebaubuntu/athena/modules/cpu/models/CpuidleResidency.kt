@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Where each CPU spent its idle time over a window.
+ *
+ * @param windowNs Actual length of the window, may be shorter than requested if not enough
+ *   history was available
+ * @param overheadNs Time spent reading the stats for this result
+ * @param cpus CPUs reported by cpuinfo
+ */
+data class CpuidleResidency(
+    val windowNs: Long,
+    val overheadNs: Long,
+    val cpus: List<Cpu>,
+) {
+    /**
+     * @param linuxId Linux CPU ID, matches [Processor.linuxId]
+     * @param states cpuidle states, shallowest first
+     */
+    data class Cpu(
+        val linuxId: UInt,
+        val states: List<State>,
+    )
+
+    /**
+     * @param name State name, e.g. `WFI`
+     * @param exitLatencyUs Worst case exit latency, in us, null if unknown
+     * @param entries Times the state was entered during the window, null if unknown
+     * @param timeUs Time spent in the state during the window, in us, null if unknown
+     */
+    data class State(
+        val name: String,
+        val exitLatencyUs: Long?,
+        val entries: Long?,
+        val timeUs: Long?,
+    )
+
+    /**
+     * Idle behavior of a group of CPUs (e.g. a [Cluster] or a [Core]).
+     *
+     * @param states Per state name, the share of the CPUs' time spent in it, from 0 to 1
+     * @param wakeupsPerSecond Wakeups per second, summed over the CPUs
+     */
+    data class Summary(
+        val states: List<StateSummary>,
+        val wakeupsPerSecond: Double?,
+    )
+
+    data class StateSummary(
+        val name: String,
+        val exitLatencyUs: Long?,
+        val residencyShare: Float,
+    )
+
+    /**
+     * Summarize the idle behavior of the given processors, null if none of them has states.
+     */
+    fun summarize(processors: List<Processor>): Summary? {
+        val linuxIds = processors.map { it.linuxId }.toSet()
+        val groupCpus = cpus.filter { it.linuxId in linuxIds && it.states.isNotEmpty() }
+
+        if (groupCpus.isEmpty() || windowNs <= 0) {
+            return null
+        }
+
+        val windowUs = windowNs / 1000.0 * groupCpus.size
+
+        val states = groupCpus.flatMap { it.states }.groupBy { it.name }.map { (name, states) ->
+            StateSummary(
+                name = name,
+                exitLatencyUs = states.firstNotNullOfOrNull { it.exitLatencyUs },
+                residencyShare = (states.sumOf { it.timeUs ?: 0 } / windowUs).toFloat(),
+            )
+        }
+
+        val entries = groupCpus.flatMap { it.states }.mapNotNull { it.entries }
+
+        return Summary(
+            states = states,
+            wakeupsPerSecond = entries.takeIf { it.isNotEmpty() }?.let {
+                it.sum() * 1_000_000_000.0 / windowNs
+            },
+        )
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Instruction set extensions detected by cpuinfo.
+ *
+ * Must be kept in sync with IsaFeatures.h.
+ *
+ * @param bit Bit index in the native mask
+ * @param displayName Name of the extension, not translatable
+ */
+enum class IsaFeature(
+    val bit: Int,
+    val displayName: String,
+) {
+    ARM_NEON(0, "NEON"),
+    ARM_NEON_FMA(1, "NEON FMA"),
+    ARM_NEON_FP16_ARITH(2, "NEON FP16"),
+    ARM_NEON_RDM(3, "RDM"),
+    ARM_NEON_DOT(4, "DotProd"),
+    ARM_I8MM(5, "I8MM"),
+    ARM_NEON_BF16(6, "BF16"),
+    ARM_FHM(7, "FHM"),
+    ARM_ATOMICS(8, "LSE"),
+    ARM_CRC32(9, "CRC32"),
+    ARM_AES(10, "AES"),
+    ARM_PMULL(11, "PMULL"),
+    ARM_SHA1(12, "SHA1"),
+    ARM_SHA2(13, "SHA2"),
+    ARM_SVE(14, "SVE"),
+    ARM_SVE2(15, "SVE2"),
+    ARM_SVE_BF16(16, "SVE BF16"),
+    ARM_SME(17, "SME"),
+    ARM_SME2(18, "SME2"),
+
+    RISCV_V(24, "V"),
+
+    X86_SSE2(32, "SSE2"),
+    X86_SSSE3(33, "SSSE3"),
+    X86_SSE4_1(34, "SSE4.1"),
+    X86_SSE4_2(35, "SSE4.2"),
+    X86_POPCNT(36, "POPCNT"),
+    X86_AES(37, "AES-NI"),
+    X86_SHA(38, "SHA"),
+    X86_F16C(39, "F16C"),
+    X86_FMA3(40, "FMA3"),
+    X86_BMI2(41, "BMI2"),
+    X86_AVX(42, "AVX"),
+    X86_AVX2(43, "AVX2"),
+    X86_AVX512F(44, "AVX-512F"),
+    X86_AVX512DQ(45, "AVX-512DQ"),
+    X86_AVX512BW(46, "AVX-512BW"),
+    X86_AVX512VL(47, "AVX-512VL"),
+    X86_AVX512VNNI(48, "AVX-512 VNNI"),
+    X86_AVX512BF16(49, "AVX-512 BF16"),
+    X86_AVX512FP16(50, "AVX-512 FP16"),
+    X86_AVXVNNI(51, "AVX-VNNI"),
+    X86_AMX_TILE(52, "AMX-TILE");
+
+    companion object {
+        fun fromMask(mask: Long) = entries.filter {
+            mask and (1L shl it.bit) != 0L
+        }
+    }
+}
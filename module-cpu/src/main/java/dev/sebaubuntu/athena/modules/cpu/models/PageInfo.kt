@@ -0,0 +1,48 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Page size and transparent huge page configuration of the kernel.
+ *
+ * @param pageSize Base page size in bytes
+ * @param thpMode Top level THP mode, null if the kernel doesn't support THP
+ * @param thpSize PMD sized THP size in bytes, null if unknown
+ * @param mthpSizes Multi-size THP sizes, Linux 6.8+
+ */
+data class PageInfo(
+    val pageSize: Long,
+    val thpMode: ThpMode?,
+    val thpSize: Long?,
+    val mthpSizes: List<MthpSize>,
+) {
+    /**
+     * Must be kept in sync with PageInfo.h.
+     */
+    enum class ThpMode(val value: Int) {
+        NEVER(0),
+        MADVISE(1),
+        ALWAYS(2),
+
+        /**
+         * mTHP sizes only, follows the top level mode.
+         */
+        INHERIT(3);
+
+        companion object {
+            fun fromValue(value: Int) = entries.firstOrNull { it.value == value }
+        }
+    }
+
+    /**
+     * @param size Size in bytes
+     * @param mode THP mode of this size, null if unknown
+     */
+    data class MthpSize(
+        val size: Long,
+        val mode: ThpMode?,
+    )
+}
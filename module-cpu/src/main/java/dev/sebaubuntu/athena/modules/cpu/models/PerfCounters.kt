@@ -0,0 +1,81 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Hardware counters of every processor over the interval since the previous read.
+ *
+ * @param intervalNs Length of the interval, 0 on the first read
+ * @param errno Why no counter could be opened, null if at least one was
+ * @param paranoidLevel Value of `perf_event_paranoid`, null if unknown
+ * @param cpus Counters of each processor
+ */
+data class PerfCounters(
+    val intervalNs: Long,
+    val errno: Int?,
+    val paranoidLevel: Int?,
+    val cpus: List<Cpu>,
+) {
+    /**
+     * Must be kept in sync with PerfCounters.h.
+     */
+    enum class Event {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_READ_MISSES,
+        LLC_READ_MISSES,
+        STALLED_CYCLES_FRONTEND,
+        STALLED_CYCLES_BACKEND,
+    }
+
+    /**
+     * @param linuxId Linux CPU ID
+     * @param counts Count of each event during the interval, events that aren't available are
+     *   missing
+     */
+    data class Cpu(
+        val linuxId: UInt,
+        val counts: Map<Event, Long>,
+    ) {
+        /**
+         * Instructions per cycle.
+         */
+        val ipc = counts[Event.INSTRUCTIONS]?.let { instructions ->
+            counts[Event.CYCLES]?.takeIf { it > 0 }?.let { instructions.toDouble() / it }
+        }
+
+        /**
+         * Events per thousand instructions, for misses.
+         */
+        fun getPerKiloInstructions(event: Event) = counts[event]?.let { count ->
+            counts[Event.INSTRUCTIONS]?.takeIf { it > 0 }?.let { count * 1000.0 / it }
+        }
+
+        /**
+         * Share of the cycles counted by the event, from 0 to 1, for stalls.
+         */
+        fun getCycleShare(event: Event) = counts[event]?.let { count ->
+            counts[Event.CYCLES]?.takeIf { it > 0 }?.let { count.toDouble() / it }
+        }
+    }
+
+    val isAvailable = errno == null
+
+    fun getCpu(linuxId: UInt) = cpus.firstOrNull { it.linuxId == linuxId }
+
+    /**
+     * Cycles per second of the given processor, the frequency it actually ran at, averaged over
+     * the time it wasn't idle.
+     * The interval spans since the previous read from anywhere in the process, so the count may
+     * well be past what a Long can hold once multiplied.
+     */
+    fun getCyclesPerSecond(cpu: Cpu) = cpu.counts[Event.CYCLES]?.takeIf {
+        intervalNs > 0
+    }?.let {
+        (it.toDouble() * 1_000_000_000 / intervalNs).toLong()
+    }
+}
@@ -48,6 +48,11 @@ data class Processor(
      * @see ProcessorCache
      */
     val cache: ProcessorCache,
+
+    /**
+     * Whether the processor was online when the topology was read, cpuinfo itself doesn't track it
+     */
+    val isOnline: Boolean,
 ) {
     companion object {
         @JvmStatic
@@ -59,6 +64,7 @@ data class Processor(
             linuxId: Int,
             apicId: Int,
             cache: ProcessorCache,
+            isOnline: Boolean,
         ) = Processor(
             smtId.toUInt(),
             core,
@@ -67,6 +73,7 @@ data class Processor(
             linuxId.toUInt(),
             apicId.takeUnless { it == 0 }?.toUInt(),
             cache,
+            isOnline,
         )
     }
 }
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Samples of the background telemetry sampler, oldest first.
+ * Values are kept in flat arrays indexed by sample and CPU, hundreds of samples are drained every
+ * second and an object for each of them would only feed the garbage collector.
+ *
+ * @param cpuIds Linux ID of every possible CPU, matches [Processor.linuxId]
+ * @param timestampsNs Time of each sample, same base as `SystemClock.elapsedRealtimeNanos()`
+ */
+class TelemetryBatch(
+    val cpuIds: List<UInt>,
+    val timestampsNs: LongArray,
+    private val frequenciesKhz: IntArray,
+) {
+    val size: Int
+        get() = timestampsNs.size
+
+    /**
+     * Highest frequency requested for the given CPU over the whole batch, in Hz.
+     */
+    fun getPeakFrequencyHz(linuxId: UInt): Long? {
+        val cpu = cpuIds.indexOf(linuxId).takeIf { it >= 0 } ?: return null
+
+        var peakKhz = -1
+        for (sample in 0 until size) {
+            peakKhz = maxOf(peakKhz, frequenciesKhz[getIndex(sample, cpu)])
+        }
+
+        return peakKhz.takeUnless { it < 0 }?.let { it * 1000L }
+    }
+
+    private fun getIndex(sample: Int, cpu: Int) = sample * cpuIds.size + cpu
+}
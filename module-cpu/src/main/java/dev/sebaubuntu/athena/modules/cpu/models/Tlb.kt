@@ -7,12 +7,21 @@ package dev.sebaubuntu.athena.modules.cpu.models
 
 /**
  * `struct cpuinfo_tlb`
+ *
+ * @param entries Number of pages the TLB can translate
+ * @param associativity Associativity, 0 if unknown
+ * @param pages Bitmask of the page sizes it holds, each bit is the page size itself
  */
 data class Tlb(
     val entries: UInt,
     val associativity: UInt,
     val pages: ULong,
 ) {
+    /**
+     * Bytes of memory the TLB covers with the biggest page size it holds.
+     */
+    val reach = entries.toULong() * pages.takeHighestOneBit()
+
     companion object {
         @JvmStatic
         fun fromCpuInfo(
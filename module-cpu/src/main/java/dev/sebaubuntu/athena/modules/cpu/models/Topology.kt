@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+/**
+ * Snapshot of everything cpuinfo knows about the CPU topology.
+ */
+data class Topology(
+    /**
+     * Logical processors
+     */
+    val processors: List<Processor>,
+
+    /**
+     * Physical cores
+     */
+    val cores: List<Core>,
+
+    /**
+     * Clusters of cores
+     */
+    val clusters: List<Cluster>,
+
+    /**
+     * Physical packages
+     */
+    val packages: List<Package>,
+
+    /**
+     * Microarchitectures
+     */
+    val uarchs: List<UarchInfo>,
+
+    /**
+     * Level 1 instruction caches
+     */
+    val l1iCaches: List<Cache>,
+
+    /**
+     * Level 1 data caches
+     */
+    val l1dCaches: List<Cache>,
+
+    /**
+     * Level 2 caches
+     */
+    val l2Caches: List<Cache>,
+
+    /**
+     * Level 3 caches
+     */
+    val l3Caches: List<Cache>,
+
+    /**
+     * Level 4 caches
+     */
+    val l4Caches: List<Cache>,
+) {
+    companion object {
+        val EMPTY = Topology(
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+            listOf(),
+        )
+    }
+}
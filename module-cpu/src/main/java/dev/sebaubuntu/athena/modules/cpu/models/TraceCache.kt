@@ -7,6 +7,8 @@ package dev.sebaubuntu.athena.modules.cpu.models
 
 /**
  * `struct cpuinfo_trace_cache`
+ *
+ * cpuinfo doesn't expose it, only Intel NetBurst processors have one.
  */
 data class TraceCache(
     val uops: UInt,
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.MutableStateFlow
+import kotlinx.coroutines.flow.emitAll
+import kotlinx.coroutines.flow.flow
+
+/**
+ * CPU hotplug events.
+ * The native side listens for CPU uevents in the background and pushes changes here, no polling
+ * involved.
+ */
+object CpuHotplugUtils {
+    private val _onlineCpus = MutableStateFlow(getOnlineCpus())
+
+    /**
+     * The online CPUs list, as in /sys/devices/system/cpu/online (e.g. "0-3,6").
+     * Updated when a CPU goes online or offline. The native monitor only runs while at least one
+     * collector is active.
+     */
+    val onlineCpus: Flow<String> = flow {
+        startMonitoring()
+
+        try {
+            // Nothing was pushed while nobody listened
+            _onlineCpus.value = getOnlineCpus()
+
+            emitAll(_onlineCpus)
+        } finally {
+            stopMonitoring()
+        }
+    }
+
+    /**
+     * Called from the native hotplug monitor thread.
+     */
+    @JvmStatic
+    private fun onOnlineCpusChanged(onlineCpus: String) {
+        _onlineCpus.value = onlineCpus
+    }
+
+    private external fun startMonitoring()
+    private external fun stopMonitoring()
+    private external fun getOnlineCpus(): String
+}
@@ -5,62 +5,71 @@
 
 package dev.sebaubuntu.athena.modules.cpu.utils
 
-import dev.sebaubuntu.athena.modules.cpu.models.Cache
-import dev.sebaubuntu.athena.modules.cpu.models.Cluster
-import dev.sebaubuntu.athena.modules.cpu.models.Core
-import dev.sebaubuntu.athena.modules.cpu.models.Package
-import dev.sebaubuntu.athena.modules.cpu.models.Processor
-import dev.sebaubuntu.athena.modules.cpu.models.UarchInfo
+import dev.sebaubuntu.athena.modules.cpu.models.Benchmark
+import dev.sebaubuntu.athena.modules.cpu.models.IsaFeature
+import dev.sebaubuntu.athena.modules.cpu.models.Tlb
+import dev.sebaubuntu.athena.modules.cpu.models.Topology
+import java.nio.ByteBuffer
 
 object CpuInfoUtils {
-    fun getProcessors() = ArrayList<Processor>().apply {
-        getProcessors(this)
-    }.toList()
+    /**
+     * The last decoded topology, reused until the set of online CPUs changes.
+     */
+    private val topologyLock = Any()
+    private var topology: Topology? = null
+    private var topologyGeneration = -1L
 
-    fun getCores() = ArrayList<Core>().apply {
-        getCores(this)
-    }.toList()
+    /**
+     * Get a snapshot of the CPU topology, transferred as a single binary buffer instead of
+     * calling back into Kotlin for each element. Models are only created when accessed.
+     * The snapshot is decoded once and reused until the set of online CPUs changes.
+     */
+    fun getLazyTopology(): Topology = synchronized(topologyLock) {
+        val generation = getTopologyGeneration()
 
-    fun getClusters() = ArrayList<Cluster>().apply {
-        getClusters(this)
-    }.toList()
+        topology?.takeIf { generation == topologyGeneration } ?: readTopology()?.also {
+            topology = it
+            topologyGeneration = generation
+        } ?: Topology.EMPTY
+    }
 
-    fun getPackages() = ArrayList<Package>().apply {
-        getPackages(this)
-    }.toList()
+    /**
+     * Read the serialized topology into a new buffer, previous snapshots still decode from theirs.
+     */
+    private fun readTopology(): Topology? {
+        var buffer: ByteBuffer? = null
 
-    fun getUarchs() = ArrayList<UarchInfo>().apply {
-        getUarchs(this)
-    }.toList()
+        while (true) {
+            val size = fillTopologyBuffer(buffer)
 
-    fun getL1iCaches() = ArrayList<Cache>().apply {
-        getL1iCaches(this)
-    }.toList()
+            when {
+                size < 0 -> return null
+                buffer != null && size <= buffer.capacity() -> return TopologyBuffer(
+                    buffer
+                ).toTopology()
 
-    fun getL1dCaches() = ArrayList<Cache>().apply {
-        getL1dCaches(this)
-    }.toList()
+                else -> buffer = ByteBuffer.allocateDirect(size)
+            }
+        }
+    }
 
-    fun getL2Caches() = ArrayList<Cache>().apply {
-        getL2Caches(this)
-    }.toList()
+    /**
+     * Get the instruction set extensions supported by every processor, in a single call.
+     * Whether they actually work is checked by [Benchmark.ISA].
+     */
+    fun getIsaFeatures() = IsaFeature.fromMask(getIsaFeatureMask())
 
-    fun getL3Caches() = ArrayList<Cache>().apply {
-        getL3Caches(this)
-    }.toList()
+    /**
+     * Get the data TLB levels of a processor, from the smallest to the biggest, empty if they
+     * couldn't be measured (e.g. the processor is offline).
+     * cpuinfo doesn't expose the TLBs, so they're measured, only once per processor; the first
+     * call takes about a second, only call it on explicit user request.
+     * Associativity is always unknown.
+     */
+    fun getDataTlbs(linuxId: UInt) = getDataTlbs(linuxId.toInt())?.toList() ?: listOf()
 
-    fun getL4Caches() = ArrayList<Cache>().apply {
-        getL4Caches(this)
-    }.toList()
-
-    private external fun getProcessors(processors: ArrayList<Processor>)
-    private external fun getCores(cores: ArrayList<Core>)
-    private external fun getClusters(clusters: ArrayList<Cluster>)
-    private external fun getPackages(packages: ArrayList<Package>)
-    private external fun getUarchs(uarchs: ArrayList<UarchInfo>)
-    private external fun getL1iCaches(l1iCaches: ArrayList<Cache>)
-    private external fun getL1dCaches(l1dCaches: ArrayList<Cache>)
-    private external fun getL2Caches(l2Caches: ArrayList<Cache>)
-    private external fun getL3Caches(l3Caches: ArrayList<Cache>)
-    private external fun getL4Caches(l4Caches: ArrayList<Cache>)
+    private external fun fillTopologyBuffer(buffer: ByteBuffer?): Int
+    private external fun getTopologyGeneration(): Long
+    private external fun getIsaFeatureMask(): Long
+    private external fun getDataTlbs(linuxId: Int): Array<Tlb>?
 }
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import dev.sebaubuntu.athena.modules.cpu.models.CpufreqResidency
+import kotlin.time.Duration
+
+object CpufreqUtils {
+    /**
+     * Get the cpufreq residency of every policy over the given window.
+     * The native side keeps a history of the stats, so there's no need to wait for the window.
+     *
+     * Must be kept in sync with CpufreqStats.h.
+     */
+    fun getResidency(window: Duration): CpufreqResidency? {
+        val values = getCpufreqResidency(window.inWholeMilliseconds) ?: return null
+
+        var offset = 0
+        fun next() = values[offset++]
+
+        val policyCount = next().toInt()
+        val windowNs = next()
+        val overheadNs = next()
+
+        val policies = List(policyCount) {
+            val id = next().toInt()
+            val relatedCpus = List(next().toInt()) { next().toUInt() }
+            val transitions = next().takeUnless { it < 0 }
+            val states = List(next().toInt()) {
+                CpufreqResidency.Policy.State(
+                    frequencyHz = next() * 1000,
+                    residencyMs = next().takeUnless { it < 0 },
+                )
+            }
+
+            CpufreqResidency.Policy(id, relatedCpus, transitions, states)
+        }
+
+        return CpufreqResidency(windowNs, overheadNs, policies)
+    }
+
+    private external fun getCpufreqResidency(windowMs: Long): LongArray?
+}
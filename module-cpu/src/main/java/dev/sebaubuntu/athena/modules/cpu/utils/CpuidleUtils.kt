@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import dev.sebaubuntu.athena.modules.cpu.models.CpuidleResidency
+import kotlin.time.Duration
+
+object CpuidleUtils {
+    /**
+     * The state names of the layout with the given generation, which changes on CPU hotplug.
+     */
+    private var stateNames = arrayOf<String>()
+    private var stateNamesGeneration = -1L
+
+    /**
+     * Get the cpuidle residency of every CPU over the given window.
+     * The native side keeps a history of the counters, so there's no need to wait for the window.
+     *
+     * Must be kept in sync with CpuidleStats.h.
+     */
+    fun getResidency(window: Duration): CpuidleResidency? {
+        val values = getCpuidleResidency(window.inWholeMilliseconds) ?: return null
+
+        var offset = 0
+        fun next() = values[offset++]
+
+        var stateIndex = 0
+
+        val cpuCount = next().toInt()
+        val generation = next()
+        val windowNs = next()
+        val overheadNs = next()
+
+        val stateNames = getStateNames(generation) ?: return null
+
+        val cpus = List(cpuCount) {
+            val linuxId = next().toUInt()
+            val states = List(next().toInt()) {
+                CpuidleResidency.State(
+                    name = stateNames.getOrNull(stateIndex++) ?: "",
+                    exitLatencyUs = next().takeUnless { it < 0 },
+                    entries = next().takeUnless { it < 0 },
+                    timeUs = next().takeUnless { it < 0 },
+                )
+            }
+
+            CpuidleResidency.Cpu(linuxId, states)
+        }
+
+        return CpuidleResidency(windowNs, overheadNs, cpus)
+    }
+
+    /**
+     * @return The state names, null if the layout changed again, in which case the residency is
+     *   outdated too
+     */
+    @Synchronized
+    private fun getStateNames(generation: Long) = stateNames.takeIf {
+        generation == stateNamesGeneration
+    } ?: getCpuidleStateNames(generation)?.also {
+        stateNames = it
+        stateNamesGeneration = generation
+    }
+
+    private external fun getCpuidleResidency(windowMs: Long): LongArray?
+    private external fun getCpuidleStateNames(generation: Long): Array<String>?
+}
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import dev.sebaubuntu.athena.modules.cpu.models.CpuLoad
+import dev.sebaubuntu.athena.modules.cpu.models.LinuxCpu
+import dev.sebaubuntu.athena.modules.cpu.models.PageInfo
+
+object LinuxCpuUtils {
+    /**
+     * Get the state of every possible CPU.
+     * All the values are read natively in a single call, reusing open sysfs nodes.
+     *
+     * Must be kept in sync with LinuxCpuReader.h.
+     */
+    fun getLinuxCpus(): List<LinuxCpu> {
+        val values = getCpuValues() ?: return listOf()
+
+        return List(values.size / FIELD_COUNT) {
+            val offset = it * FIELD_COUNT
+
+            fun value(field: Int) = values[offset + field].takeUnless { value -> value < 0 }
+            fun frequencyHz(field: Int) = value(field)?.let { frequencyKhz -> frequencyKhz * 1000 }
+
+            LinuxCpu(
+                id = values[offset + ID].toInt(),
+                isOnline = value(ONLINE)?.let { online -> online != 0L },
+                currentFrequencyHz = frequencyHz(CPUINFO_CURRENT_FREQ),
+                minimumFrequencyHz = frequencyHz(CPUINFO_MINIMUM_FREQ),
+                maximumFrequencyHz = frequencyHz(CPUINFO_MAXIMUM_FREQ),
+                scalingCurrentFrequencyHz = frequencyHz(SCALING_CURRENT_FREQ),
+                scalingMinimumFrequencyHz = frequencyHz(SCALING_MINIMUM_FREQ),
+                scalingMaximumFrequencyHz = frequencyHz(SCALING_MAXIMUM_FREQ),
+            )
+        }
+    }
+
+    fun getLinuxCpu(id: Int) = getLinuxCpus().firstOrNull { it.id == id }
+
+    /**
+     * Measure the clock the CPU is actually running at, which firmware may throttle below what
+     * cpufreq reports. Pins the calling thread to the CPU for about 250 µs, so it shouldn't be
+     * polled.
+     */
+    fun getEffectiveFrequencyHz(id: UInt) = getEffectiveFrequency(id.toInt()).takeUnless {
+        it < 0
+    }
+
+    /**
+     * Take a new utilization sample and get the history of every possible CPU, by Linux CPU ID.
+     * Sampling and the deltas are computed natively, calling this at 10-20 Hz is fine.
+     *
+     * Must be kept in sync with CpuLoadSampler.h.
+     */
+    fun getCpuLoads(): Map<UInt, CpuLoad> {
+        val values = getCpuLoadHistory() ?: return mapOf()
+
+        return List(values.size / LOAD_RECORD_SIZE) {
+            val offset = it * LOAD_RECORD_SIZE
+
+            CpuLoad(
+                linuxId = values[offset].toUInt(),
+                history = List(LOAD_HISTORY_LENGTH) { index ->
+                    val sampleOffset = offset + 1 + index * LOAD_FIELD_COUNT
+
+                    values[sampleOffset].takeUnless { value -> value.isNaN() }?.let {
+                        CpuLoad.Sample(
+                            user = values[sampleOffset + LOAD_USER],
+                            system = values[sampleOffset + LOAD_SYSTEM],
+                            iowait = values[sampleOffset + LOAD_IOWAIT],
+                            irq = values[sampleOffset + LOAD_IRQ],
+                            idle = values[sampleOffset + LOAD_IDLE],
+                        )
+                    }
+                },
+            )
+        }.associateBy { it.linuxId }
+    }
+
+    /**
+     * Get the page size and the transparent huge page configuration.
+     *
+     * Must be kept in sync with LinuxCpuUtils.cpp.
+     */
+    fun getPageInfo() = getPageInfoValues()?.let { values ->
+        val mthpCount = values[MTHP_COUNT].toInt()
+
+        PageInfo(
+            pageSize = values[PAGE_SIZE],
+            thpMode = PageInfo.ThpMode.fromValue(values[THP_MODE].toInt()),
+            thpSize = values[THP_SIZE].takeUnless { it <= 0 },
+            mthpSizes = List(mthpCount) {
+                val offset = MTHP_SIZES + it * 2
+
+                PageInfo.MthpSize(
+                    size = values[offset],
+                    mode = PageInfo.ThpMode.fromValue(values[offset + 1].toInt()),
+                )
+            },
+        )
+    }
+
+    private const val ID = 0
+    private const val ONLINE = 1
+    private const val CPUINFO_CURRENT_FREQ = 2
+    private const val CPUINFO_MINIMUM_FREQ = 3
+    private const val CPUINFO_MAXIMUM_FREQ = 4
+    private const val SCALING_CURRENT_FREQ = 5
+    private const val SCALING_MINIMUM_FREQ = 6
+    private const val SCALING_MAXIMUM_FREQ = 7
+    private const val FIELD_COUNT = 8
+
+    private const val LOAD_USER = 0
+    private const val LOAD_SYSTEM = 1
+    private const val LOAD_IOWAIT = 2
+    private const val LOAD_IRQ = 3
+    private const val LOAD_IDLE = 4
+    private const val LOAD_FIELD_COUNT = 5
+    private const val LOAD_HISTORY_LENGTH = 64
+    private const val LOAD_RECORD_SIZE = 1 + LOAD_HISTORY_LENGTH * LOAD_FIELD_COUNT
+
+    private const val PAGE_SIZE = 0
+    private const val THP_MODE = 1
+    private const val THP_SIZE = 2
+    private const val MTHP_COUNT = 3
+    private const val MTHP_SIZES = 4
+
+    private external fun getCpuValues(): LongArray?
+    private external fun getCpuLoadHistory(): FloatArray?
+    private external fun getEffectiveFrequency(id: Int): Long
+
+    private external fun getPageInfoValues(): LongArray?
+}
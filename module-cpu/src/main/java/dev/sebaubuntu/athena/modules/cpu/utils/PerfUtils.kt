@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import dev.sebaubuntu.athena.modules.cpu.models.PerfCounters
+
+object PerfUtils {
+    /**
+     * Get the hardware counters of every processor since the previous call.
+     * Counting other processes needs `perf_event_paranoid` to be 0 or lower, on most devices
+     * this only tells why the counters aren't available.
+     *
+     * Must be kept in sync with PerfMonitor.h.
+     */
+    fun getCounters(): PerfCounters? {
+        val values = getPerfCounters() ?: return null
+
+        var offset = 0
+        fun next() = values[offset++]
+
+        val cpuCount = next().toInt()
+        val intervalNs = next()
+        val errno = next().toInt().takeUnless { it == 0 }
+        val paranoidLevel = next().toInt().takeUnless { it == Int.MIN_VALUE }
+
+        val cpus = List(cpuCount) {
+            val linuxId = next().toUInt()
+            val counts = PerfCounters.Event.entries.associateWith { next() }.filterValues {
+                it >= 0
+            }
+
+            PerfCounters.Cpu(linuxId, counts)
+        }
+
+        return PerfCounters(intervalNs, errno, paranoidLevel, cpus)
+    }
+
+    private external fun getPerfCounters(): LongArray?
+}
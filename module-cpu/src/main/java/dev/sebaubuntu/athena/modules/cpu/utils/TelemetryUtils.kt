@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import dev.sebaubuntu.athena.modules.cpu.models.TelemetryBatch
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Background telemetry sampler.
+ * A native thread samples frequency, load and online state of every CPU at up to 1 kHz,
+ * records are then drained in bulk, so short spikes aren't missed between UI updates.
+ *
+ * Must be kept in sync with TelemetrySampler.h.
+ */
+object TelemetryUtils {
+    const val MAX_RATE_HZ = 1000
+
+    private val cpuIds by lazy { getTelemetryCpuIds()?.map { it.toUInt() } ?: listOf() }
+    private val recordSize by lazy { getTelemetryRecordSize() }
+
+    private val buffer by lazy {
+        ByteBuffer.allocateDirect(recordSize * BUFFER_RECORDS).order(ByteOrder.nativeOrder())
+    }
+
+    /**
+     * Start sampling at the given rate, or change the rate if already started.
+     * Every call must be paired with a [stop] call.
+     */
+    fun start(rateHz: Int) = startTelemetry(rateHz)
+
+    fun stop() = stopTelemetry()
+
+    /**
+     * Get the samples recorded since the previous call, oldest first.
+     */
+    @Synchronized
+    fun drain(): TelemetryBatch {
+        var timestampsNs = LongArray(0)
+        var frequenciesKhz = IntArray(0)
+
+        while (true) {
+            val count = drainTelemetry(buffer)
+            if (count <= 0) {
+                break
+            }
+
+            // Usually a single round, the buffer holds seconds of records
+            val first = timestampsNs.size
+            timestampsNs = timestampsNs.copyOf(first + count)
+            frequenciesKhz = frequenciesKhz.copyOf((first + count) * cpuIds.size)
+
+            for (record in 0 until count) {
+                val offset = record * recordSize
+                timestampsNs[first + record] = buffer.getLong(offset)
+
+                // Only the frequency is shown, skip the online state and the load
+                for (cpu in cpuIds.indices) {
+                    val cpuOffset = offset + Long.SIZE_BYTES + cpu * CPU_SAMPLE_SIZE
+
+                    frequenciesKhz[(first + record) * cpuIds.size + cpu] = buffer.getInt(cpuOffset)
+                }
+            }
+
+            if (count < BUFFER_RECORDS) {
+                break
+            }
+        }
+
+        return TelemetryBatch(cpuIds, timestampsNs, frequenciesKhz)
+    }
+
+    private const val CPU_SAMPLE_SIZE = 12
+    private const val BUFFER_RECORDS = 1024
+
+    private external fun startTelemetry(rateHz: Int)
+    private external fun stopTelemetry()
+    private external fun getTelemetryCpuIds(): IntArray?
+    private external fun getTelemetryRecordSize(): Int
+    private external fun drainTelemetry(buffer: ByteBuffer): Int
+}
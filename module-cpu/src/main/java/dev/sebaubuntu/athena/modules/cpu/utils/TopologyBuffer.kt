@@ -0,0 +1,229 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import dev.sebaubuntu.athena.modules.cpu.models.Cache
+import dev.sebaubuntu.athena.modules.cpu.models.Cluster
+import dev.sebaubuntu.athena.modules.cpu.models.Core
+import dev.sebaubuntu.athena.modules.cpu.models.Package
+import dev.sebaubuntu.athena.modules.cpu.models.Processor
+import dev.sebaubuntu.athena.modules.cpu.models.ProcessorCache
+import dev.sebaubuntu.athena.modules.cpu.models.Topology
+import dev.sebaubuntu.athena.modules.cpu.models.UarchInfo
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Decoder for the structure-of-arrays CPU topology written by TopologyBuffer.cpp.
+ * Rows are only turned into models the first time they're accessed.
+ *
+ * Must be kept in sync with TopologyBuffer.h.
+ */
+class TopologyBuffer(buffer: ByteBuffer) {
+    private class Table(
+        val rowCount: Int,
+        val columnOffsets: IntArray,
+        val columnWidths: IntArray,
+    )
+
+    private val buffer = buffer.duplicate().order(ByteOrder.nativeOrder())
+
+    private val tables: List<Table>
+
+    init {
+        require(this.buffer.getInt(0) == MAGIC) { "Invalid topology buffer" }
+
+        val version = this.buffer.getInt(4)
+        require(version == VERSION) { "Unsupported topology buffer version $version" }
+
+        var offset = 16
+        tables = List(this.buffer.getInt(12)) {
+            val rowCount = this.buffer.getInt(offset)
+            val columnCount = this.buffer.getInt(offset + 4)
+            offset += 8
+
+            val columnOffsets = IntArray(columnCount) { column ->
+                this.buffer.getInt(offset + column * Int.SIZE_BYTES)
+            }
+            offset += columnCount * Int.SIZE_BYTES
+
+            val columnWidths = IntArray(columnCount) { column ->
+                this.buffer.getInt(offset + column * Int.SIZE_BYTES)
+            }
+            offset += columnCount * Int.SIZE_BYTES
+
+            Table(rowCount, columnOffsets, columnWidths)
+        }
+
+        require(tables.size >= TABLE_COUNT) { "Missing topology tables" }
+    }
+
+    val packages: List<Package> = tableList(PACKAGES) { row ->
+        Package.fromCpuInfo(
+            getString(0, row),
+            getInt(1, row),
+            getInt(2, row),
+            getInt(3, row),
+            getInt(4, row),
+            getInt(5, row),
+            getInt(6, row),
+        )
+    }
+
+    val clusters: List<Cluster> = tableList(CLUSTERS) { row ->
+        Cluster.fromCpuInfo(
+            getInt(0, row),
+            getInt(1, row),
+            getInt(2, row),
+            getInt(3, row),
+            getInt(4, row),
+            packages[getInt(5, row)],
+            getInt(6, row),
+            getInt(7, row),
+            getInt(8, row),
+            getInt(9, row),
+            getLong(10, row),
+        )
+    }
+
+    val cores: List<Core> = tableList(CORES) { row ->
+        Core.fromCpuInfo(
+            getInt(0, row),
+            getInt(1, row),
+            getInt(2, row),
+            clusters[getInt(3, row)],
+            packages[getInt(4, row)],
+            getInt(5, row),
+            getInt(6, row),
+            getInt(7, row),
+            getInt(8, row),
+            getLong(9, row),
+        )
+    }
+
+    val uarchs: List<UarchInfo> = tableList(UARCHS) { row ->
+        UarchInfo.fromCpuInfo(
+            getInt(0, row),
+            getInt(1, row),
+            getInt(2, row),
+            getInt(3, row),
+            getInt(4, row),
+        )
+    }
+
+    val l1iCaches = cacheList(L1I_CACHES)
+    val l1dCaches = cacheList(L1D_CACHES)
+    val l2Caches = cacheList(L2_CACHES)
+    val l3Caches = cacheList(L3_CACHES)
+    val l4Caches = cacheList(L4_CACHES)
+
+    val processors: List<Processor> = tableList(PROCESSORS) { row ->
+        Processor.fromCpuInfo(
+            getInt(0, row),
+            cores[getInt(1, row)],
+            clusters[getInt(2, row)],
+            packages[getInt(3, row)],
+            getInt(4, row),
+            getInt(5, row),
+            ProcessorCache.fromCpuInfo(
+                getIndex(6, row)?.let { l1iCaches[it] },
+                getIndex(7, row)?.let { l1dCaches[it] },
+                getIndex(8, row)?.let { l2Caches[it] },
+                getIndex(9, row)?.let { l3Caches[it] },
+                getIndex(10, row)?.let { l4Caches[it] },
+            ),
+            getInt(11, row) != 0,
+        )
+    }
+
+    fun toTopology() = Topology(
+        processors,
+        cores,
+        clusters,
+        packages,
+        uarchs,
+        l1iCaches,
+        l1dCaches,
+        l2Caches,
+        l3Caches,
+        l4Caches,
+    )
+
+    private fun cacheList(table: Int): List<Cache> = tableList(table) { row ->
+        Cache.fromCpuInfo(
+            getInt(0, row),
+            getInt(1, row),
+            getInt(2, row),
+            getInt(3, row),
+            getInt(4, row),
+            getInt(5, row),
+            getInt(6, row),
+            getInt(7, row),
+        )
+    }
+
+    private fun <T : Any> tableList(
+        table: Int,
+        rowToModel: Table.(row: Int) -> T,
+    ) = tables[table].let { LazyList(it.rowCount) { row -> it.rowToModel(row) } }
+
+    private fun Table.getInt(column: Int, row: Int) = buffer.getInt(
+        columnOffsets[column] + row * Int.SIZE_BYTES
+    )
+
+    private fun Table.getLong(column: Int, row: Int) = buffer.getLong(
+        columnOffsets[column] + row * Long.SIZE_BYTES
+    )
+
+    private fun Table.getIndex(column: Int, row: Int) = getInt(column, row).takeUnless {
+        it == NO_INDEX
+    }
+
+    private fun Table.getString(column: Int, row: Int): String {
+        val width = columnWidths[column]
+        val offset = columnOffsets[column] + row * width
+
+        val bytes = ByteArray(width) { buffer.get(offset + it) }
+        val length = bytes.indexOf(0).takeUnless { it == -1 } ?: width
+
+        return bytes.decodeToString(0, length)
+    }
+
+    /**
+     * A list whose elements are created on first access.
+     * Racing readers may both create an element, models are immutable so either copy is fine.
+     */
+    private class LazyList<T : Any>(
+        override val size: Int,
+        private val factory: (Int) -> T,
+    ) : AbstractList<T>() {
+        private val elements = arrayOfNulls<Any>(size)
+
+        @Suppress("UNCHECKED_CAST")
+        override fun get(index: Int) = (elements[index] ?: factory(index).also {
+            elements[index] = it
+        }) as T
+    }
+
+    companion object {
+        private const val MAGIC = 0x54435441
+        private const val VERSION = 3
+
+        private const val NO_INDEX = -1
+
+        private const val PROCESSORS = 0
+        private const val CORES = 1
+        private const val CLUSTERS = 2
+        private const val PACKAGES = 3
+        private const val UARCHS = 4
+        private const val L1I_CACHES = 5
+        private const val L1D_CACHES = 6
+        private const val L2_CACHES = 7
+        private const val L3_CACHES = 8
+        private const val L4_CACHES = 9
+        private const val TABLE_COUNT = 10
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.models
+
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertNull
+import org.junit.Test
+
+class PerfCountersTest {
+    @Test
+    fun computesCyclesPerSecond() {
+        val counters = buildCounters(intervalNs = 500_000_000L, cycles = 1_000_000_000L)
+
+        assertEquals(2_000_000_000L, counters.getCyclesPerSecond(counters.cpus[0]))
+    }
+
+    @Test
+    fun computesCyclesPerSecondOverLongIntervals() {
+        // 3 GHz for a minute, the count times 1e9 is way past Long.MAX_VALUE
+        val counters = buildCounters(intervalNs = 60_000_000_000L, cycles = 180_000_000_000L)
+
+        assertEquals(3_000_000_000L, counters.getCyclesPerSecond(counters.cpus[0]))
+    }
+
+    @Test
+    fun hasNoCyclesPerSecondOnFirstRead() {
+        val counters = buildCounters(intervalNs = 0L, cycles = 0L)
+
+        assertNull(counters.getCyclesPerSecond(counters.cpus[0]))
+    }
+
+    private fun buildCounters(intervalNs: Long, cycles: Long) = PerfCounters(
+        intervalNs = intervalNs,
+        errno = null,
+        paranoidLevel = null,
+        cpus = listOf(
+            PerfCounters.Cpu(0u, mapOf(PerfCounters.Event.CYCLES to cycles)),
+        ),
+    )
+}
@@ -0,0 +1,193 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.cpu.utils
+
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertFalse
+import org.junit.Assert.assertNull
+import org.junit.Assert.assertSame
+import org.junit.Assert.assertTrue
+import org.junit.Test
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Decodes buffers laid out like TopologyBuffer.cpp writes them.
+ */
+class TopologyBufferTest {
+    private class TestTable(
+        val columnWidths: IntArray,
+        val rows: List<List<Any>>,
+    )
+
+    @Test
+    fun decodesAllTables() {
+        val topology = TopologyBuffer(buildBuffer(TABLES)).toTopology()
+
+        assertEquals(2, topology.processors.size)
+        assertEquals(2, topology.cores.size)
+        assertEquals(2, topology.clusters.size)
+        assertEquals(1, topology.packages.size)
+        assertEquals(1, topology.uarchs.size)
+        assertEquals(2, topology.l2Caches.size)
+        assertTrue(topology.l1iCaches.isEmpty())
+
+        assertEquals(1u, topology.clusters[1].clusterId)
+        assertEquals(2_400_000_000uL, topology.clusters[1].frequency)
+        assertEquals(512u * 1024u, topology.l2Caches[1].size)
+    }
+
+    @Test
+    fun resolvesReferencesToSharedModels() {
+        val topology = TopologyBuffer(buildBuffer(TABLES)).toTopology()
+
+        val processor = topology.processors[1]
+        assertEquals(1u, processor.linuxId)
+        assertSame(topology.cores[1], processor.core)
+        assertSame(topology.clusters[1], processor.cluster)
+        assertSame(topology.packages[0], processor.cpuPackage)
+        assertSame(topology.l2Caches[1], processor.cache.l2)
+        assertNull(processor.cache.l1i)
+        assertNull(processor.cache.l3)
+    }
+
+    @Test
+    fun readsOnlineState() {
+        val topology = TopologyBuffer(buildBuffer(TABLES)).toTopology()
+
+        assertTrue(topology.processors[0].isOnline)
+        assertFalse(topology.processors[1].isOnline)
+    }
+
+    @Test
+    fun readsStringWidthFromHeader() {
+        val topology = TopologyBuffer(buildBuffer(TABLES)).toTopology()
+
+        assertEquals(PACKAGE_NAME, topology.packages[0].name)
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun rejectsBadMagic() {
+        TopologyBuffer(buildBuffer(TABLES).putInt(0, 0))
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun rejectsUnknownVersion() {
+        TopologyBuffer(buildBuffer(TABLES).putInt(4, 1))
+    }
+
+    private fun buildBuffer(tables: List<TestTable>): ByteBuffer {
+        val headerSize = 16 + tables.sumOf { 8 + it.columnWidths.size * 2 * Int.SIZE_BYTES }
+
+        var offset = align8(headerSize)
+        val columnOffsets = tables.map { table ->
+            IntArray(table.columnWidths.size) { column ->
+                offset.also {
+                    offset = align8(offset + table.columnWidths[column] * table.rows.size)
+                }
+            }
+        }
+
+        val buffer = ByteBuffer.allocateDirect(offset).order(ByteOrder.nativeOrder())
+
+        buffer.putInt(MAGIC)
+        buffer.putInt(VERSION)
+        buffer.putInt(offset)
+        buffer.putInt(tables.size)
+        tables.forEachIndexed { index, table ->
+            buffer.putInt(table.rows.size)
+            buffer.putInt(table.columnWidths.size)
+            columnOffsets[index].forEach(buffer::putInt)
+            table.columnWidths.forEach(buffer::putInt)
+        }
+
+        tables.forEachIndexed { index, table ->
+            table.rows.forEachIndexed { row, values ->
+                values.forEachIndexed { column, value ->
+                    val width = table.columnWidths[column]
+                    val cellOffset = columnOffsets[index][column] + row * width
+
+                    when (value) {
+                        is Int -> buffer.putInt(cellOffset, value)
+                        is Long -> buffer.putLong(cellOffset, value)
+                        is String -> value.encodeToByteArray().forEachIndexed { i, byte ->
+                            buffer.put(cellOffset + i, byte)
+                        }
+
+                        else -> error("Unsupported value $value")
+                    }
+                }
+            }
+        }
+
+        return buffer
+    }
+
+    private fun align8(value: Int) = (value + 7) and 7.inv()
+
+    companion object {
+        private const val MAGIC = 0x54435441
+        private const val VERSION = 3
+
+        private const val NO_INDEX = -1
+
+        private const val U32 = Int.SIZE_BYTES
+        private const val U64 = Long.SIZE_BYTES
+
+        /**
+         * Longer than cpuinfo's 48 bytes, the decoder must use the width in the header.
+         */
+        private const val PACKAGE_NAME = "A package name longer than forty-eight characters"
+        private const val PACKAGE_NAME_WIDTH = 64
+
+        private val CACHE_WIDTHS = IntArray(8) { U32 }
+
+        private val TABLES = listOf(
+            // Processors
+            TestTable(
+                IntArray(12) { U32 },
+                List(2) {
+                    listOf(0, it, it, 0, it, 0, NO_INDEX, NO_INDEX, it, NO_INDEX, NO_INDEX, 1 - it)
+                },
+            ),
+            // Cores
+            TestTable(
+                IntArray(9) { U32 } + U64,
+                List(2) {
+                    listOf(it, 1, it, it, 0, 0, 0, 0, 0, 1_800_000_000L + it * 600_000_000L)
+                },
+            ),
+            // Clusters
+            TestTable(
+                IntArray(10) { U32 } + U64,
+                List(2) {
+                    listOf(it, 1, it, 1, it, 0, 0, 0, 0, 0, 1_800_000_000L + it * 600_000_000L)
+                },
+            ),
+            // Packages
+            TestTable(
+                intArrayOf(PACKAGE_NAME_WIDTH) + IntArray(6) { U32 },
+                listOf(listOf(PACKAGE_NAME, 0, 2, 0, 2, 0, 2)),
+            ),
+            // Uarchs
+            TestTable(
+                IntArray(5) { U32 },
+                listOf(listOf(0, 0, 0, 2, 2)),
+            ),
+            // L1i, L1d
+            TestTable(CACHE_WIDTHS, listOf()),
+            TestTable(CACHE_WIDTHS, listOf()),
+            // L2
+            TestTable(
+                CACHE_WIDTHS,
+                List(2) { listOf(512 * 1024, 8, 1024, 1, 64, 0, it, 1) },
+            ),
+            // L3, L4
+            TestTable(CACHE_WIDTHS, listOf()),
+            TestTable(CACHE_WIDTHS, listOf()),
+        )
+    }
+}
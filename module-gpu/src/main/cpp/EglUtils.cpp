@@ -5,119 +5,104 @@
 
 #define LOG_TAG "EglUtils"
 
+#include <iterator>
 #include <jni.h>
+#include "EglUtils.h"
+#include "GpuCapabilityCache.h"
 #include "jni_utils.h"
 #include "logging.h"
-#include "egl/EglSession.h"
 
-static const EGLint kConfigAttribs[] = {
-        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
-        EGL_NONE
-};
-
-static const EGLint kContextAttribs[] = {
-        EGL_CONTEXT_CLIENT_VERSION, 2,
-        EGL_NONE
-};
+static struct {
+    jclass clazz;
+    jmethodID constructor;
+    jmethodID addGlInformation;
+    jmethodID build;
+} gEglInformationBuilderClassInfo;
 
-static void
-maybeAddGlInformation(JNIEnv *env, EglSession &eglSession, jobject eglInformationBuilder) {
-    jclass eglInformationBuilderClass = withJniCheck<jclass>(env, [=]() {
-        return env->FindClass("dev/sebaubuntu/athena/modules/gpu/models/EglInformation$Builder");
-    });
-
-    auto eglInformationAddGlInformationMethodId = withJniCheck<jmethodID>(env, [=]() {
-        return env->GetMethodID(
-                eglInformationBuilderClass,
-                "addGlInformation",
-                "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
-    });
-
-    // Choose a configuration
-    auto eglConfig = eglSession.eglChooseConfig(kConfigAttribs);
-    if (!eglConfig) {
-        LOGE("Failed to choose EGL config");
+static void maybeAddGlInformation(JNIEnv *env, const GpuCapabilities &capabilities,
+                                  jobject eglInformationBuilder) {
+    if (!capabilities.hasGl()) {
         return;
     }
 
-    // Create a context
-    auto eglContext = eglSession.createEglContext(eglConfig.value(), kContextAttribs);
-    if (!eglContext) {
-        LOGE("Failed to create EGL context");
-        return;
-    }
-
-    // Make the context current
-    if (!eglSession.eglMakeCurrent(EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext->getContext())) {
-        LOGE("Failed to make EGL context current");
-        return;
-    }
-
-    auto glVendor = eglSession.glGetString(GL_VENDOR);
-    auto glRenderer = eglSession.glGetString(GL_RENDERER);
-    auto glVersion = eglSession.glGetString(GL_VERSION);
-    auto glExtensions = eglSession.glGetString(GL_EXTENSIONS);
+    auto glVendor = capabilities.getGlVendor();
+    auto glRenderer = capabilities.getGlRenderer();
+    auto glVersion = capabilities.getGlVersion();
+    auto glExtensions = capabilities.getGlExtensions();
 
     withJniCheck(env, [=]() {
         return env->CallVoidMethod(
-                eglInformationBuilder, eglInformationAddGlInformationMethodId,
+                eglInformationBuilder, gEglInformationBuilderClassInfo.addGlInformation,
                 glVendor ? env->NewStringUTF(glVendor) : nullptr,
                 glRenderer ? env->NewStringUTF(glRenderer) : nullptr,
                 glVersion ? env->NewStringUTF(glVersion) : nullptr,
                 glExtensions ? env->NewStringUTF(glExtensions) : nullptr);
     });
-
-    // Cleanup the current context
-    eglSession.eglMakeCurrent(EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
 }
 
-extern "C"
-jobject Java_dev_sebaubuntu_athena_modules_gpu_utils_EglUtils_getEglInformation(
-        JNIEnv *env, jobject thiz) {
-    jclass eglInformationBuilderClass = withJniCheck<jclass>(env, [=]() {
-        return env->FindClass("dev/sebaubuntu/athena/modules/gpu/models/EglInformation$Builder");
-    });
-
-    auto eglInformationBuilderConstructorMethodId = withJniCheck<jmethodID>(env, [=]() {
-        return env->GetMethodID(
-                eglInformationBuilderClass,
-                "<init>",
-                "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
-    });
-
-    auto eglInformationBuilderBuildMethodId = withJniCheck<jmethodID>(env, [=]() {
-        return env->GetMethodID(
-                eglInformationBuilderClass,
-                "build",
-                "()Ldev/sebaubuntu/athena/modules/gpu/models/EglInformation;");
-    });
-
-    auto eglSession = EglSession::create();
-    if (!eglSession) {
+static jobject getEglInformation(JNIEnv *env, jobject thiz) {
+    auto capabilities = GpuCapabilityCache::getInstance().getCapabilities();
+    if (!capabilities->hasEgl()) {
         LOGE("Failed to create EGL session");
         return nullptr;
     }
 
-    const char *eglVendor = eglSession->eglQueryString(EGL_VENDOR);
-    const char *eglVersion = eglSession->eglQueryString(EGL_VERSION);
-    const char *eglExtensions = eglSession->eglQueryString(EGL_EXTENSIONS);
-    const char *eglClientApi = eglSession->eglQueryString(EGL_CLIENT_APIS);
+    const char *eglVendor = capabilities->getEglVendor();
+    const char *eglVersion = capabilities->getEglVersion();
+    const char *eglExtensions = capabilities->getEglExtensions();
+    const char *eglClientApi = capabilities->getEglClientApis();
 
     auto eglInformationBuild = withJniCheck<jobject>(env, [=]() {
         return env->NewObject(
-                eglInformationBuilderClass,
-                eglInformationBuilderConstructorMethodId,
+                gEglInformationBuilderClassInfo.clazz,
+                gEglInformationBuilderClassInfo.constructor,
                 eglVendor ? env->NewStringUTF(eglVendor) : nullptr,
                 eglVersion ? env->NewStringUTF(eglVersion) : nullptr,
                 eglExtensions ? env->NewStringUTF(eglExtensions) : nullptr,
                 eglClientApi ? env->NewStringUTF(eglClientApi) : nullptr);
     });
 
-    maybeAddGlInformation(env, *eglSession, eglInformationBuild);
+    maybeAddGlInformation(env, *capabilities, eglInformationBuild);
 
     auto eglInformation = withJniCheck<jobject>(env, [=]() {
-        return env->CallObjectMethod(eglInformationBuild, eglInformationBuilderBuildMethodId);
+        return env->CallObjectMethod(eglInformationBuild, gEglInformationBuilderClassInfo.build);
     });
 
     return eglInformation;
 }
+
+static const JNINativeMethod kMethods[] = {
+        {"getEglInformation", "()Ldev/sebaubuntu/athena/modules/gpu/models/EglInformation;",
+                reinterpret_cast<void *>(getEglInformation)},
+};
+
+void registerEglUtilsNatives(JNIEnv *env) {
+    auto &classInfo = gEglInformationBuilderClassInfo;
+
+    classInfo.clazz = findClassGlobalRef(
+            env, "dev/sebaubuntu/athena/modules/gpu/models/EglInformation$Builder");
+
+    classInfo.constructor = withJniCheck<jmethodID>(env, [=]() {
+        return env->GetMethodID(
+                classInfo.clazz,
+                "<init>",
+                "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
+    });
+
+    classInfo.addGlInformation = withJniCheck<jmethodID>(env, [=]() {
+        return env->GetMethodID(
+                classInfo.clazz,
+                "addGlInformation",
+                "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
+    });
+
+    classInfo.build = withJniCheck<jmethodID>(env, [=]() {
+        return env->GetMethodID(
+                classInfo.clazz,
+                "build",
+                "()Ldev/sebaubuntu/athena/modules/gpu/models/EglInformation;");
+    });
+
+    registerNatives(env, "dev/sebaubuntu/athena/modules/gpu/utils/EglUtils",
+                    kMethods, std::size(kMethods));
+}
@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <iterator>
+#include <jni.h>
+#include "GpuCacheUtils.h"
+#include "GpuCapabilityCache.h"
+#include "jni_utils.h"
+
+static void setCachePath(JNIEnv *env, jobject thiz, jstring path) {
+    auto pathChars = env->GetStringUTFChars(path, nullptr);
+    if (pathChars == nullptr) {
+        return;
+    }
+
+    GpuCapabilityCache::getInstance().setPath(pathChars);
+    env->ReleaseStringUTFChars(path, pathChars);
+}
+
+static const JNINativeMethod kMethods[] = {
+        {"setCachePath", "(Ljava/lang/String;)V", reinterpret_cast<void *>(setCachePath)},
+};
+
+void registerGpuCacheUtilsNatives(JNIEnv *env) {
+    registerNatives(env, "dev/sebaubuntu/athena/modules/gpu/utils/GpuCacheUtils",
+                    kMethods, std::size(kMethods));
+}
@@ -0,0 +1,459 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "GpuCapabilities"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/system_properties.h>
+#include <unistd.h>
+#include "GpuCapabilities.h"
+#include "GpuSessionPool.h"
+#include "logging.h"
+
+static constexpr uint32_t kMagic = 0x55504741; // "AGPU"
+
+/**
+ * Bump on any change to the layout.
+ */
+static constexpr uint32_t kFormatVersion = 2;
+
+static constexpr uint32_t kNoString = UINT32_MAX;
+
+enum Flags : uint32_t {
+    HAS_VULKAN = 1 << 0,
+    HAS_EGL = 1 << 1,
+    HAS_GL = 1 << 2,
+};
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t flags;
+    uint64_t key;
+    uint32_t fingerprint;
+    uint32_t vkDeviceCount;
+    uint32_t vkMemoryHeapCount;
+    uint32_t vkMemoryTypeCount;
+    uint32_t eglVendor;
+    uint32_t eglVersion;
+    uint32_t eglExtensions;
+    uint32_t eglClientApis;
+    uint32_t glVendor;
+    uint32_t glRenderer;
+    uint32_t glVersion;
+    uint32_t glExtensions;
+};
+
+// Every table must keep the next one aligned
+static_assert(sizeof(Header) % alignof(GpuCapabilities::VkMemoryHeapEntry) == 0);
+static_assert(sizeof(GpuCapabilities::VkDeviceEntry) %
+              alignof(GpuCapabilities::VkMemoryHeapEntry) == 0);
+
+static size_t getMemoryHeapTableOffset(const Header *header) {
+    return sizeof(Header) + header->vkDeviceCount * sizeof(GpuCapabilities::VkDeviceEntry);
+}
+
+static size_t getMemoryTypeTableOffset(const Header *header) {
+    return getMemoryHeapTableOffset(header) +
+           header->vkMemoryHeapCount * sizeof(GpuCapabilities::VkMemoryHeapEntry);
+}
+
+static size_t getStringTableOffset(const Header *header) {
+    return getMemoryTypeTableOffset(header) +
+           header->vkMemoryTypeCount * sizeof(GpuCapabilities::VkMemoryTypeEntry);
+}
+
+/**
+ * FNV-1a, stable across builds unlike std::hash.
+ */
+static uint64_t hash(uint64_t seed, const void *data, size_t size) {
+    auto bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+        seed = (seed ^ bytes[i]) * 0x100000001b3;
+    }
+    return seed;
+}
+
+static uint64_t hash(uint64_t seed, const char *string) {
+    // Include the terminator, so that missing and empty strings differ from adjacent ones
+    return string ? hash(seed, string, strlen(string) + 1) : hash(seed, "", 0);
+}
+
+GpuCapabilities::GpuCapabilities(std::vector<uint8_t> buffer) : mBuffer(std::move(buffer)) {
+    mData = mBuffer.data();
+    mSize = mBuffer.size();
+}
+
+GpuCapabilities::GpuCapabilities(void *mapping, size_t size) : mMapping(mapping) {
+    mData = static_cast<const uint8_t *>(mapping);
+    mSize = size;
+}
+
+GpuCapabilities::~GpuCapabilities() {
+    if (mMapping) {
+        munmap(mMapping, mSize);
+    }
+}
+
+std::unique_ptr<GpuCapabilities> GpuCapabilities::probe() {
+    Header header{
+            .magic = kMagic,
+            .version = kFormatVersion,
+            .flags = 0,
+            .eglVendor = kNoString,
+            .eglVersion = kNoString,
+            .eglExtensions = kNoString,
+            .eglClientApis = kNoString,
+            .glVendor = kNoString,
+            .glRenderer = kNoString,
+            .glVersion = kNoString,
+            .glExtensions = kNoString,
+    };
+    std::vector<VkDeviceEntry> vkDevices;
+    std::vector<VkMemoryHeapEntry> vkMemoryHeaps;
+    std::vector<VkMemoryTypeEntry> vkMemoryTypes;
+    std::string strings;
+
+    auto addString = [&strings](const char *string) {
+        if (!string) {
+            return kNoString;
+        }
+
+        auto offset = static_cast<uint32_t>(strings.size());
+        strings.append(string);
+        strings.push_back('\0');
+        return offset;
+    };
+
+    // Always present, which also makes sure the file ends with a terminator
+    auto fingerprint = getBuildFingerprint();
+    header.fingerprint = addString(fingerprint.c_str());
+    uint64_t key = hash(0xcbf29ce484222325, fingerprint.c_str());
+
+    GpuSessionPool::getInstance().withVkSession([&](VkSession &vkSession) {
+        header.flags |= HAS_VULKAN;
+
+        for (const auto &device: vkSession.vkEnumeratePhysicalDevices()) {
+            auto properties = vkSession.vkGetPhysicalDeviceProperties(device);
+            auto memoryProperties = vkSession.vkGetPhysicalDeviceMemoryProperties(device);
+
+            vkDevices.push_back({
+                    .apiVersion = properties.apiVersion,
+                    .driverVersion = properties.driverVersion,
+                    .vendorId = properties.vendorID,
+                    .deviceId = properties.deviceID,
+                    .deviceType = static_cast<uint32_t>(properties.deviceType),
+                    .deviceName = addString(properties.deviceName),
+                    .firstMemoryHeap = static_cast<uint32_t>(vkMemoryHeaps.size()),
+                    .memoryHeapCount = memoryProperties.memoryHeapCount,
+                    .firstMemoryType = static_cast<uint32_t>(vkMemoryTypes.size()),
+                    .memoryTypeCount = memoryProperties.memoryTypeCount,
+            });
+
+            for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+                vkMemoryHeaps.push_back({
+                        .size = memoryProperties.memoryHeaps[i].size,
+                        .flags = memoryProperties.memoryHeaps[i].flags,
+                        .reserved = 0,
+                });
+            }
+
+            for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+                vkMemoryTypes.push_back({
+                        .propertyFlags = memoryProperties.memoryTypes[i].propertyFlags,
+                        .heapIndex = memoryProperties.memoryTypes[i].heapIndex,
+                });
+            }
+
+            key = hash(key, &properties.driverVersion, sizeof(properties.driverVersion));
+            key = hash(key, &properties.vendorID, sizeof(properties.vendorID));
+            key = hash(key, &properties.deviceID, sizeof(properties.deviceID));
+        }
+    });
+
+    GpuSessionPool::getInstance().withEglSession(
+            [&](EglSession &eglSession, EglContext *eglContext) {
+                header.flags |= HAS_EGL;
+                header.eglVendor = addString(eglSession.eglQueryString(EGL_VENDOR));
+                header.eglVersion = addString(eglSession.eglQueryString(EGL_VERSION));
+                header.eglExtensions = addString(eglSession.eglQueryString(EGL_EXTENSIONS));
+                header.eglClientApis = addString(eglSession.eglQueryString(EGL_CLIENT_APIS));
+
+                if (!eglContext) {
+                    return;
+                }
+
+                auto glVersion = eglSession.glGetString(GL_VERSION);
+                auto glRenderer = eglSession.glGetString(GL_RENDERER);
+
+                header.flags |= HAS_GL;
+                header.glVendor = addString(eglSession.glGetString(GL_VENDOR));
+                header.glRenderer = addString(glRenderer);
+                header.glVersion = addString(glVersion);
+                header.glExtensions = addString(eglSession.glGetString(GL_EXTENSIONS));
+
+                key = hash(key, glVersion);
+                key = hash(key, glRenderer);
+            });
+
+    header.key = key;
+    header.vkDeviceCount = static_cast<uint32_t>(vkDevices.size());
+    header.vkMemoryHeapCount = static_cast<uint32_t>(vkMemoryHeaps.size());
+    header.vkMemoryTypeCount = static_cast<uint32_t>(vkMemoryTypes.size());
+
+    auto stringTableOffset = getStringTableOffset(&header);
+    header.size = static_cast<uint32_t>(stringTableOffset + strings.size());
+
+    std::vector<uint8_t> buffer(header.size);
+    memcpy(buffer.data(), &header, sizeof(header));
+    if (!vkDevices.empty()) {
+        memcpy(buffer.data() + sizeof(header), vkDevices.data(),
+               vkDevices.size() * sizeof(VkDeviceEntry));
+    }
+    if (!vkMemoryHeaps.empty()) {
+        memcpy(buffer.data() + getMemoryHeapTableOffset(&header), vkMemoryHeaps.data(),
+               vkMemoryHeaps.size() * sizeof(VkMemoryHeapEntry));
+    }
+    if (!vkMemoryTypes.empty()) {
+        memcpy(buffer.data() + getMemoryTypeTableOffset(&header), vkMemoryTypes.data(),
+               vkMemoryTypes.size() * sizeof(VkMemoryTypeEntry));
+    }
+    memcpy(buffer.data() + stringTableOffset, strings.data(), strings.size());
+
+    return std::unique_ptr<GpuCapabilities>(new GpuCapabilities(std::move(buffer)));
+}
+
+std::unique_ptr<GpuCapabilities> GpuCapabilities::map(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            LOGE("Failed to open %s: %s", path.c_str(), strerror(errno));
+        }
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        return nullptr;
+    }
+
+    auto size = static_cast<size_t>(st.st_size);
+    auto mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        LOGE("Failed to map %s: %s", path.c_str(), strerror(errno));
+        return nullptr;
+    }
+
+    auto capabilities = std::unique_ptr<GpuCapabilities>(new GpuCapabilities(mapping, size));
+    if (!capabilities->isValid()) {
+        LOGE("Invalid GPU capability cache %s", path.c_str());
+        return nullptr;
+    }
+
+    return capabilities;
+}
+
+bool GpuCapabilities::write(const std::string &path) const {
+    // Replace the file atomically, so that it's never seen partially written
+    auto tempPath = path + ".tmp";
+
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        LOGE("Failed to open %s: %s", tempPath.c_str(), strerror(errno));
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < mSize) {
+        auto result = ::write(fd, mData + written, mSize - written);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            LOGE("Failed to write %s: %s", tempPath.c_str(), strerror(errno));
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
+        }
+
+        written += result;
+    }
+    close(fd);
+
+    if (rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOGE("Failed to rename %s: %s", tempPath.c_str(), strerror(errno));
+        unlink(tempPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+const char *GpuCapabilities::getFingerprint() const {
+    return getString(reinterpret_cast<const Header *>(mData)->fingerprint);
+}
+
+uint64_t GpuCapabilities::getKey() const {
+    return reinterpret_cast<const Header *>(mData)->key;
+}
+
+bool GpuCapabilities::hasVulkan() const {
+    return reinterpret_cast<const Header *>(mData)->flags & HAS_VULKAN;
+}
+
+size_t GpuCapabilities::getVkDeviceCount() const {
+    return reinterpret_cast<const Header *>(mData)->vkDeviceCount;
+}
+
+const GpuCapabilities::VkDeviceEntry &GpuCapabilities::getVkDevice(size_t index) const {
+    return reinterpret_cast<const VkDeviceEntry *>(mData + sizeof(Header))[index];
+}
+
+const GpuCapabilities::VkMemoryHeapEntry &GpuCapabilities::getVkMemoryHeap(
+        const VkDeviceEntry &device, size_t index) const {
+    auto header = reinterpret_cast<const Header *>(mData);
+    return reinterpret_cast<const VkMemoryHeapEntry *>(
+            mData + getMemoryHeapTableOffset(header))[device.firstMemoryHeap + index];
+}
+
+const GpuCapabilities::VkMemoryTypeEntry &GpuCapabilities::getVkMemoryType(
+        const VkDeviceEntry &device, size_t index) const {
+    auto header = reinterpret_cast<const Header *>(mData);
+    return reinterpret_cast<const VkMemoryTypeEntry *>(
+            mData + getMemoryTypeTableOffset(header))[device.firstMemoryType + index];
+}
+
+bool GpuCapabilities::hasEgl() const {
+    return reinterpret_cast<const Header *>(mData)->flags & HAS_EGL;
+}
+
+const char *GpuCapabilities::getEglVendor() const {
+    return getString(reinterpret_cast<const Header *>(mData)->eglVendor);
+}
+
+const char *GpuCapabilities::getEglVersion() const {
+    return getString(reinterpret_cast<const Header *>(mData)->eglVersion);
+}
+
+const char *GpuCapabilities::getEglExtensions() const {
+    return getString(reinterpret_cast<const Header *>(mData)->eglExtensions);
+}
+
+const char *GpuCapabilities::getEglClientApis() const {
+    return getString(reinterpret_cast<const Header *>(mData)->eglClientApis);
+}
+
+bool GpuCapabilities::hasGl() const {
+    return reinterpret_cast<const Header *>(mData)->flags & HAS_GL;
+}
+
+const char *GpuCapabilities::getGlVendor() const {
+    return getString(reinterpret_cast<const Header *>(mData)->glVendor);
+}
+
+const char *GpuCapabilities::getGlRenderer() const {
+    return getString(reinterpret_cast<const Header *>(mData)->glRenderer);
+}
+
+const char *GpuCapabilities::getGlVersion() const {
+    return getString(reinterpret_cast<const Header *>(mData)->glVersion);
+}
+
+const char *GpuCapabilities::getGlExtensions() const {
+    return getString(reinterpret_cast<const Header *>(mData)->glExtensions);
+}
+
+const char *GpuCapabilities::getString(uint32_t offset) const {
+    if (offset == kNoString) {
+        return nullptr;
+    }
+
+    auto header = reinterpret_cast<const Header *>(mData);
+    return reinterpret_cast<const char *>(mData + getStringTableOffset(header) + offset);
+}
+
+std::string GpuCapabilities::getBuildFingerprint() {
+    char value[PROP_VALUE_MAX] = {};
+    __system_property_get("ro.build.fingerprint", value);
+    return value;
+}
+
+bool GpuCapabilities::isValid() const {
+    if (mSize < sizeof(Header)) {
+        return false;
+    }
+
+    auto header = reinterpret_cast<const Header *>(mData);
+    if (header->magic != kMagic || header->version != kFormatVersion || header->size != mSize) {
+        return false;
+    }
+
+    // Checked one by one, so that the offsets can't overflow
+    if (header->vkDeviceCount > (mSize - sizeof(Header)) / sizeof(VkDeviceEntry)) {
+        return false;
+    }
+
+    auto memoryHeapTableOffset = getMemoryHeapTableOffset(header);
+    if (header->vkMemoryHeapCount > (mSize - memoryHeapTableOffset) / sizeof(VkMemoryHeapEntry)) {
+        return false;
+    }
+
+    auto memoryTypeTableOffset = getMemoryTypeTableOffset(header);
+    if (header->vkMemoryTypeCount > (mSize - memoryTypeTableOffset) / sizeof(VkMemoryTypeEntry)) {
+        return false;
+    }
+
+    auto stringTableOffset = getStringTableOffset(header);
+    if (stringTableOffset >= mSize || mData[mSize - 1] != '\0') {
+        return false;
+    }
+
+    // With the last byte being a terminator, any offset within the table is a valid string
+    auto isValidString = [&](uint32_t offset) {
+        return offset == kNoString || offset < mSize - stringTableOffset;
+    };
+
+    if (header->fingerprint == kNoString || !isValidString(header->fingerprint)) {
+        return false;
+    }
+
+    for (auto offset: {header->eglVendor, header->eglVersion, header->eglExtensions,
+                       header->eglClientApis, header->glVendor, header->glRenderer,
+                       header->glVersion, header->glExtensions}) {
+        if (!isValidString(offset)) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < header->vkDeviceCount; i++) {
+        const auto &device = getVkDevice(i);
+        if (!isValidString(device.deviceName)) {
+            return false;
+        }
+
+        if (device.firstMemoryHeap > header->vkMemoryHeapCount ||
+            device.memoryHeapCount > header->vkMemoryHeapCount - device.firstMemoryHeap ||
+            device.firstMemoryType > header->vkMemoryTypeCount ||
+            device.memoryTypeCount > header->vkMemoryTypeCount - device.firstMemoryType) {
+            return false;
+        }
+
+        for (size_t j = 0; j < device.memoryTypeCount; j++) {
+            if (getVkMemoryType(device, j).heapIndex >= device.memoryHeapCount) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
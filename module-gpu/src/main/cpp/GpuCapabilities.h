@@ -0,0 +1,130 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Vulkan and EGL/GL probe results, in the compact binary format used by the on-disk cache.
+ *
+ * The layout is a fixed header, followed by one entry per Vulkan physical device, the memory
+ * heaps and memory types of all the devices, and a table of NUL-terminated strings. Every
+ * string is referenced by its offset in the table, so the file can be memory-mapped and handed
+ * to JNI as is, without parsing it.
+ */
+class GpuCapabilities {
+public:
+    struct VkDeviceEntry {
+        uint32_t apiVersion;
+        uint32_t driverVersion;
+        uint32_t vendorId;
+        uint32_t deviceId;
+        uint32_t deviceType;
+        uint32_t deviceName; // Offset in the string table
+        uint32_t firstMemoryHeap; // Index in the memory heap table
+        uint32_t memoryHeapCount;
+        uint32_t firstMemoryType; // Index in the memory type table
+        uint32_t memoryTypeCount;
+    };
+
+    struct VkMemoryHeapEntry {
+        uint64_t size;
+        uint32_t flags; // VkMemoryHeapFlags
+        uint32_t reserved;
+    };
+
+    struct VkMemoryTypeEntry {
+        uint32_t propertyFlags; // VkMemoryPropertyFlags
+        uint32_t heapIndex; // Relative to the first memory heap of the device
+    };
+
+    GpuCapabilities(const GpuCapabilities &) = delete;
+
+    ~GpuCapabilities();
+
+    GpuCapabilities &operator=(const GpuCapabilities &) = delete;
+
+    /**
+     * Query the drivers, this loads libvulkan.so and initializes EGL.
+     */
+    static std::unique_ptr<GpuCapabilities> probe();
+
+    /**
+     * Map a cache file, returns nullptr if it doesn't exist or it's invalid.
+     */
+    static std::unique_ptr<GpuCapabilities> map(const std::string &path);
+
+    bool write(const std::string &path) const;
+
+    /**
+     * The build fingerprint at the time of the probe.
+     */
+    const char *getFingerprint() const;
+
+    /**
+     * Hash of the build fingerprint, the Vulkan driver versions, vendor and device IDs and the
+     * GL version and renderer, changes when any driver does.
+     */
+    uint64_t getKey() const;
+
+    bool hasVulkan() const;
+
+    size_t getVkDeviceCount() const;
+
+    const VkDeviceEntry &getVkDevice(size_t index) const;
+
+    const VkMemoryHeapEntry &getVkMemoryHeap(const VkDeviceEntry &device, size_t index) const;
+
+    const VkMemoryTypeEntry &getVkMemoryType(const VkDeviceEntry &device, size_t index) const;
+
+    bool hasEgl() const;
+
+    const char *getEglVendor() const;
+
+    const char *getEglVersion() const;
+
+    const char *getEglExtensions() const;
+
+    const char *getEglClientApis() const;
+
+    bool hasGl() const;
+
+    const char *getGlVendor() const;
+
+    const char *getGlRenderer() const;
+
+    const char *getGlVersion() const;
+
+    const char *getGlExtensions() const;
+
+    /**
+     * @return The string at the given offset in the string table, nullptr for a missing one
+     */
+    const char *getString(uint32_t offset) const;
+
+    /**
+     * The current build fingerprint, the cheap part of the key that can be checked without
+     * touching any driver.
+     */
+    static std::string getBuildFingerprint();
+
+private:
+    GpuCapabilities(std::vector<uint8_t> buffer);
+
+    GpuCapabilities(void *mapping, size_t size);
+
+    bool isValid() const;
+
+    std::vector<uint8_t> mBuffer;
+    void *mMapping = nullptr;
+
+    const uint8_t *mData;
+    size_t mSize;
+};
@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "GpuCapabilityCache"
+
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "GpuCapabilityCache.h"
+#include "logging.h"
+
+/**
+ * Drivers rarely change without a new build fingerprint, don't pay for a full probe on every
+ * start just to notice.
+ */
+static constexpr time_t kRevalidateIntervalSeconds = 24 * 60 * 60;
+
+GpuCapabilityCache &GpuCapabilityCache::getInstance() {
+    static GpuCapabilityCache instance;
+    return instance;
+}
+
+void GpuCapabilityCache::setPath(std::string path) {
+    std::lock_guard lock(mMutex);
+
+    mPath = std::move(path);
+}
+
+std::shared_ptr<const GpuCapabilities> GpuCapabilityCache::getCapabilities() {
+    std::lock_guard lock(mMutex);
+
+    if (mCapabilities) {
+        return mCapabilities;
+    }
+
+    if (mPath) {
+        std::shared_ptr<const GpuCapabilities> cached = GpuCapabilities::map(mPath.value());
+        if (cached && cached->getFingerprint() == GpuCapabilities::getBuildFingerprint()) {
+            mCapabilities = cached;
+
+            if (isRevalidationDue()) {
+                mRevalidateThread = std::thread(&GpuCapabilityCache::revalidate, this, cached);
+            }
+
+            return mCapabilities;
+        }
+    }
+
+    mCapabilities = GpuCapabilities::probe();
+
+    if (mPath && !mCapabilities->write(mPath.value())) {
+        LOGE("Failed to write GPU capability cache");
+    }
+
+    return mCapabilities;
+}
+
+GpuCapabilityCache::~GpuCapabilityCache() {
+    if (mRevalidateThread.joinable()) {
+        mRevalidateThread.join();
+    }
+}
+
+/**
+ * The modification time of the file is when the drivers were last probed.
+ */
+bool GpuCapabilityCache::isRevalidationDue() const {
+    struct stat st = {};
+    if (stat(mPath.value().c_str(), &st) != 0) {
+        return true;
+    }
+
+    auto age = time(nullptr) - st.st_mtime;
+
+    // Also catch a clock that went backwards
+    return age < 0 || age >= kRevalidateIntervalSeconds;
+}
+
+void GpuCapabilityCache::revalidate(std::shared_ptr<const GpuCapabilities> cached) {
+    pthread_setname_np(pthread_self(), "AthenaGpuCache");
+
+    std::shared_ptr<const GpuCapabilities> capabilities = GpuCapabilities::probe();
+    if (capabilities->getKey() == cached->getKey()) {
+        std::lock_guard lock(mMutex);
+
+        if (mPath && utimensat(AT_FDCWD, mPath.value().c_str(), nullptr, 0) != 0) {
+            LOGE("Failed to touch GPU capability cache");
+        }
+
+        return;
+    }
+
+    LOGI("GPU drivers changed, rebuilding the capability cache");
+
+    std::lock_guard lock(mMutex);
+
+    if (mPath && !capabilities->write(mPath.value())) {
+        LOGE("Failed to write GPU capability cache");
+    }
+
+    mCapabilities = capabilities;
+}
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include "GpuCapabilities.h"
+
+/**
+ * Serves the GPU capabilities from a memory-mapped cache file, so that a cold start doesn't
+ * need to load libvulkan.so nor initialize EGL.
+ *
+ * Only the build fingerprint is checked before serving the file, as the rest of the key needs
+ * the drivers. Once the file is a day old, the drivers are probed again from a background
+ * thread and the file is rebuilt if the full key changed, e.g. after an updatable driver
+ * update, or just touched otherwise.
+ */
+class GpuCapabilityCache {
+public:
+    static GpuCapabilityCache &getInstance();
+
+    /**
+     * Set the path of the cache file. Without one, the drivers are probed on first use and the
+     * result is only kept in memory.
+     */
+    void setPath(std::string path);
+
+    std::shared_ptr<const GpuCapabilities> getCapabilities();
+
+    ~GpuCapabilityCache();
+
+private:
+    friend class GpuCapabilityCacheTest;
+
+    GpuCapabilityCache() = default;
+
+    bool isRevalidationDue() const;
+
+    void revalidate(std::shared_ptr<const GpuCapabilities> cached);
+
+    std::mutex mMutex;
+    std::optional<std::string> mPath;
+    std::shared_ptr<const GpuCapabilities> mCapabilities;
+    std::thread mRevalidateThread;
+};
@@ -0,0 +1,160 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "GpuSessionPool"
+
+#include <optional>
+#include <pthread.h>
+#include "GpuSessionPool.h"
+#include "logging.h"
+
+static const EGLint kConfigAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_NONE
+};
+
+static const EGLint kContextAttribs[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+};
+
+GpuSessionPool &GpuSessionPool::getInstance() {
+    // Never destroyed, the reaper thread waits on it until the process dies
+    static auto instance = new GpuSessionPool();
+    return *instance;
+}
+
+bool GpuSessionPool::withVkSession(const VkProbe &probe) {
+    startReaper();
+
+    VkSession *vkSession;
+
+    {
+        std::lock_guard lock(mMutex);
+
+        if (!mVkSession) {
+            // Probes only query the devices, nothing is ever presented
+            mVkSession = VkSession::createHeadless();
+            if (!mVkSession) {
+                return false;
+            }
+        }
+
+        vkSession = mVkSession.get();
+        mVkProbes++;
+    }
+
+    probe(*vkSession);
+
+    {
+        std::lock_guard lock(mMutex);
+
+        mVkProbes--;
+        mVkLastUsed = Clock::now();
+    }
+    mCondition.notify_one();
+
+    return true;
+}
+
+bool GpuSessionPool::withEglSession(const EglProbe &probe) {
+    startReaper();
+
+    {
+        std::lock_guard eglLock(mEglMutex);
+
+        if (!mEglSession) {
+            mEglSession = EglSession::create();
+            if (!mEglSession) {
+                return false;
+            }
+
+            auto eglConfig = mEglSession->eglChooseConfig(kConfigAttribs);
+            if (eglConfig) {
+                mEglContext = mEglSession->createEglContext(eglConfig.value(), kContextAttribs);
+            } else {
+                LOGE("Failed to choose EGL config");
+            }
+        }
+
+        auto eglContext = mEglContext.get();
+        if (eglContext && !mEglSession->eglMakeCurrent(EGL_NO_SURFACE, EGL_NO_SURFACE,
+                                                        eglContext->getContext())) {
+            LOGE("Failed to make EGL context current");
+            eglContext = nullptr;
+        }
+
+        probe(*mEglSession, eglContext);
+
+        if (eglContext) {
+            mEglSession->eglMakeCurrent(EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+
+        mEglLastUsed = Clock::now();
+    }
+
+    notifyReaper();
+
+    return true;
+}
+
+void GpuSessionPool::startReaper() {
+    std::call_once(mStartFlag, [this]() {
+        mThread = std::thread(&GpuSessionPool::runReaper, this);
+        mThread.detach();
+    });
+}
+
+void GpuSessionPool::notifyReaper() {
+    // The EGL state isn't guarded by mMutex, taking it makes sure the reaper is either waiting
+    // or yet to check it
+    {
+        std::lock_guard lock(mMutex);
+    }
+    mCondition.notify_one();
+}
+
+void GpuSessionPool::runReaper() {
+    pthread_setname_np(pthread_self(), "AthenaGpuPool");
+
+    std::unique_lock lock(mMutex);
+
+    while (true) {
+        auto now = Clock::now();
+        std::optional<Clock::time_point> deadline;
+
+        auto schedule = [&](Clock::time_point time) {
+            if (!deadline || time < deadline.value()) {
+                deadline = time;
+            }
+        };
+
+        if (mVkSession && mVkProbes == 0) {
+            if (now - mVkLastUsed >= kIdleTimeout) {
+                LOGI("Destroying idle Vulkan session");
+                mVkSession.reset();
+            } else {
+                schedule(mVkLastUsed + kIdleTimeout);
+            }
+        }
+
+        // If a probe is running it will wake us up when done
+        if (std::unique_lock eglLock(mEglMutex, std::try_to_lock); eglLock && mEglSession) {
+            if (now - mEglLastUsed >= kIdleTimeout) {
+                LOGI("Destroying idle EGL session");
+                mEglContext.reset();
+                mEglSession.reset();
+            } else {
+                schedule(mEglLastUsed + kIdleTimeout);
+            }
+        }
+
+        if (deadline) {
+            mCondition.wait_until(lock, deadline.value());
+        } else {
+            mCondition.wait(lock);
+        }
+    }
+}
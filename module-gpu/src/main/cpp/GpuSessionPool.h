@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "egl/EglSession.h"
+#include "vulkan/VkSession.h"
+
+/**
+ * Keeps the Vulkan instance and the EGL display, with a surfaceless context, warm across probes.
+ *
+ * Creating them is slow on some drivers (vkCreateInstance alone can take 50-200 ms), so they're
+ * created on first use and handed to every probe. A background thread destroys them once no
+ * probe has used them for kIdleTimeout.
+ */
+class GpuSessionPool {
+public:
+    static constexpr std::chrono::seconds kIdleTimeout{30};
+
+    using VkProbe = std::function<void(VkSession &vkSession)>;
+
+    /**
+     * @param eglContext Current on the calling thread without any surface, nullptr if it
+     *                   couldn't be created
+     */
+    using EglProbe = std::function<void(EglSession &eglSession, EglContext *eglContext)>;
+
+    static GpuSessionPool &getInstance();
+
+    /**
+     * Run a probe with the shared Vulkan session. Probes may run concurrently, the instance is
+     * only externally synchronized for its destruction, which waits for them.
+     *
+     * @return Whether the session could be created, the probe isn't run otherwise
+     */
+    bool withVkSession(const VkProbe &probe);
+
+    /**
+     * Run a probe with the shared EGL session, with its context made current. Probes are
+     * serialized, as a context can only be current on one thread at a time.
+     *
+     * @return Whether the session could be created, the probe isn't run otherwise
+     */
+    bool withEglSession(const EglProbe &probe);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    GpuSessionPool() = default;
+
+    void startReaper();
+
+    /**
+     * Wake the reaper up after a probe is done, so it can reschedule the teardown.
+     */
+    void notifyReaper();
+
+    void runReaper();
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    std::unique_ptr<VkSession> mVkSession;
+    uint32_t mVkProbes = 0;
+    Clock::time_point mVkLastUsed;
+
+    /**
+     * Held for the whole duration of EGL probes, the reaper only tries to take it after mMutex.
+     */
+    std::mutex mEglMutex;
+    std::unique_ptr<EglSession> mEglSession;
+    std::unique_ptr<EglContext> mEglContext;
+    Clock::time_point mEglLastUsed;
+
+    std::once_flag mStartFlag;
+    std::thread mThread;
+};
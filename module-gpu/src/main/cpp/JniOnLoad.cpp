@@ -0,0 +1,40 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "GpuJniOnLoad"
+
+#include <stdexcept>
+#include <jni.h>
+#include "BenchmarkUtils.h"
+#include "EglUtils.h"
+#include "GpuCacheUtils.h"
+#include "VkUtils.h"
+#include "logging.h"
+
+extern "C"
+JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
+    if (vm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
+
+    if (registerBenchmarkUtilsNatives(
+            env, "dev/sebaubuntu/athena/modules/gpu/utils/BenchmarkUtils") != JNI_OK) {
+        LOGE("Failed to register BenchmarkUtils natives");
+        return JNI_ERR;
+    }
+
+    try {
+        registerEglUtilsNatives(env);
+        registerGpuCacheUtilsNatives(env);
+        registerVkUtilsNatives(env);
+    } catch (std::runtime_error &error) {
+        LOGE("Failed to register natives: %s", error.what());
+        return JNI_ERR;
+    }
+
+    return JNI_VERSION_1_6;
+}
@@ -5,76 +5,105 @@
 
 #define LOG_TAG "VkUtils"
 
+#include <iterator>
 #include <vector>
 #include <jni.h>
-#include "vulkan/VkSession.h"
+#include "GpuCapabilityCache.h"
+#include "VkUtils.h"
 #include "jni_utils.h"
 #include "logging.h"
 
-static const std::vector<const char *> kRequiredExtensions = {
-        "VK_KHR_surface",
-        "VK_KHR_android_surface"
-};
-
-extern "C"
-JNIEXPORT jobject JNICALL
-Java_dev_sebaubuntu_athena_modules_gpu_utils_VkUtils_getVkInfo(
-        JNIEnv *env, jobject thiz) {
-    jclass vkPhysicalDevicesClass = withJniCheck<jclass>(env, [=]() {
-        return env->FindClass("dev/sebaubuntu/athena/modules/gpu/utils/VkUtils$VkPhysicalDevices");
-    });
-    auto vkPhysicalDevicesConstructorMethodId = withJniCheck<jmethodID>(env, [=]() {
-        return env->GetMethodID(vkPhysicalDevicesClass, "<init>", "()V");
-    });
-    auto addDeviceMethodId = withJniCheck<jmethodID>(env, [=]() {
-        return env->GetMethodID(
-                vkPhysicalDevicesClass,
-                "addDevice",
-                "(JJJJJLjava/lang/String;)Z");
-    });
+static struct {
+    jclass clazz;
+    jmethodID constructor;
+    jmethodID addDevice;
+} gVkPhysicalDevicesClassInfo;
 
-    VkApplicationInfo appInfo{
-            .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
-            .pApplicationName = "Athena",
-            .applicationVersion = VK_MAKE_VERSION(1, 0, 0),
-            .pEngineName = "No Engine",
-            .engineVersion = VK_MAKE_VERSION(1, 0, 0),
-            .apiVersion = VK_API_VERSION_1_0,
-    };
-
-    VkInstanceCreateInfo createInfo{
-            .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
-            .pApplicationInfo = &appInfo,
-            .enabledLayerCount = 0,
-            .enabledExtensionCount = (uint32_t) kRequiredExtensions.size(),
-            .ppEnabledExtensionNames = kRequiredExtensions.data(),
-    };
-
-    auto vkSession = VkSession::create(&createInfo, nullptr);
-    if (!vkSession) {
+static jobject getVkInfo(JNIEnv *env, jobject thiz) {
+    auto capabilities = GpuCapabilityCache::getInstance().getCapabilities();
+    if (!capabilities->hasVulkan()) {
         LOGE("Failed to create Vulkan session");
         return nullptr;
     }
 
-    auto physicalDevices = vkSession->vkEnumeratePhysicalDevices();
+    auto vkPhysicalDevices = env->NewObject(gVkPhysicalDevicesClassInfo.clazz,
+                                            gVkPhysicalDevicesClassInfo.constructor);
+
+    for (size_t i = 0; i < capabilities->getVkDeviceCount(); i++) {
+        const auto &device = capabilities->getVkDevice(i);
+
+        std::vector<jlong> memoryHeapSizes(device.memoryHeapCount);
+        std::vector<jint> memoryHeapFlags(device.memoryHeapCount);
+        for (size_t j = 0; j < device.memoryHeapCount; j++) {
+            const auto &memoryHeap = capabilities->getVkMemoryHeap(device, j);
+            memoryHeapSizes[j] = static_cast<jlong>(memoryHeap.size);
+            memoryHeapFlags[j] = static_cast<jint>(memoryHeap.flags);
+        }
 
-    auto vkPhysicalDevices = env->NewObject(vkPhysicalDevicesClass,
-                                            vkPhysicalDevicesConstructorMethodId);
+        std::vector<jint> memoryTypePropertyFlags(device.memoryTypeCount);
+        std::vector<jint> memoryTypeHeapIndexes(device.memoryTypeCount);
+        for (size_t j = 0; j < device.memoryTypeCount; j++) {
+            const auto &memoryType = capabilities->getVkMemoryType(device, j);
+            memoryTypePropertyFlags[j] = static_cast<jint>(memoryType.propertyFlags);
+            memoryTypeHeapIndexes[j] = static_cast<jint>(memoryType.heapIndex);
+        }
 
-    for (const auto &device: physicalDevices) {
-        auto deviceProperties = vkSession->vkGetPhysicalDeviceProperties(device);
+        auto deviceName = withJniCheck<jstring>(env, [&]() {
+            return env->NewStringUTF(capabilities->getString(device.deviceName));
+        });
+        auto memoryHeapSizesArray = toJLongArray(env, memoryHeapSizes);
+        auto memoryHeapFlagsArray = toJIntArray(env, memoryHeapFlags);
+        auto memoryTypePropertyFlagsArray = toJIntArray(env, memoryTypePropertyFlags);
+        auto memoryTypeHeapIndexesArray = toJIntArray(env, memoryTypeHeapIndexes);
 
-        withJniCheck<bool>(env, [=]() {
+        withJniCheck<bool>(env, [&]() {
             return env->CallBooleanMethod(
-                    vkPhysicalDevices, addDeviceMethodId,
-                    static_cast<jlong>(deviceProperties.apiVersion),
-                    static_cast<jlong>(deviceProperties.driverVersion),
-                    static_cast<jlong>(deviceProperties.vendorID),
-                    static_cast<jlong>(deviceProperties.deviceID),
-                    static_cast<jlong>(deviceProperties.deviceType),
-                    env->NewStringUTF(deviceProperties.deviceName));
+                    vkPhysicalDevices, gVkPhysicalDevicesClassInfo.addDevice,
+                    static_cast<jlong>(device.apiVersion),
+                    static_cast<jlong>(device.driverVersion),
+                    static_cast<jlong>(device.vendorId),
+                    static_cast<jlong>(device.deviceId),
+                    static_cast<jlong>(device.deviceType),
+                    deviceName,
+                    memoryHeapSizesArray,
+                    memoryHeapFlagsArray,
+                    memoryTypePropertyFlagsArray,
+                    memoryTypeHeapIndexesArray);
         });
+
+        // Don't run out of local refs with many devices
+        env->DeleteLocalRef(deviceName);
+        env->DeleteLocalRef(memoryHeapSizesArray);
+        env->DeleteLocalRef(memoryHeapFlagsArray);
+        env->DeleteLocalRef(memoryTypePropertyFlagsArray);
+        env->DeleteLocalRef(memoryTypeHeapIndexesArray);
     }
 
     return vkPhysicalDevices;
 }
+
+static const JNINativeMethod kMethods[] = {
+        {"getVkInfo", "()Ldev/sebaubuntu/athena/modules/gpu/utils/VkUtils$VkPhysicalDevices;",
+                reinterpret_cast<void *>(getVkInfo)},
+};
+
+void registerVkUtilsNatives(JNIEnv *env) {
+    auto &classInfo = gVkPhysicalDevicesClassInfo;
+
+    classInfo.clazz = findClassGlobalRef(
+            env, "dev/sebaubuntu/athena/modules/gpu/utils/VkUtils$VkPhysicalDevices");
+
+    classInfo.constructor = withJniCheck<jmethodID>(env, [=]() {
+        return env->GetMethodID(classInfo.clazz, "<init>", "()V");
+    });
+
+    classInfo.addDevice = withJniCheck<jmethodID>(env, [=]() {
+        return env->GetMethodID(
+                classInfo.clazz,
+                "addDevice",
+                "(JJJJJLjava/lang/String;[J[I[I[I)Z");
+    });
+
+    registerNatives(env, "dev/sebaubuntu/athena/modules/gpu/utils/VkUtils",
+                    kMethods, std::size(kMethods));
+}
@@ -0,0 +1,13 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <jni.h>
+
+/**
+ * Cache the classes used by VkUtils and bind its native methods.
+ */
+void registerVkUtilsNatives(JNIEnv *env);
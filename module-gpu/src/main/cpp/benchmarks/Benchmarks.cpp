@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <iterator>
+#include "Benchmarks.h"
+#include "VkComputeBenchmark.h"
+#include "VkMemoryBenchmark.h"
+
+/**
+ * Each one creates its own headless Vulkan instance, so that it also runs on GPU-less hosts.
+ */
+static const BenchmarkDefinition kBenchmarks[] = {
+        {"vulkan-compute", "FP32/FP16 FMA, int32, shared memory and subgroup throughput",
+         runVkComputeBenchmark},
+        {"vulkan-memory", "Memory heaps and types, upload, readback and copy bandwidth",
+         runVkMemoryBenchmark},
+};
+
+const BenchmarkDefinition *getBenchmarks(size_t *count) {
+    *count = std::size(kBenchmarks);
+    return kBenchmarks;
+}
+
+const BenchmarkDefinition *findBenchmark(const char *name) {
+    for (auto &benchmark: kBenchmarks) {
+        if (strcmp(benchmark.name, name) == 0) {
+            return &benchmark;
+        }
+    }
+
+    return nullptr;
+}
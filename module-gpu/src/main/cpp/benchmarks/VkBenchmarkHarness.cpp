@@ -0,0 +1,57 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include "VkBenchmarkHarness.h"
+
+namespace benchmark_harness {
+
+std::string getDeviceSectionName(size_t index, const VkPhysicalDeviceProperties &properties) {
+    std::string name = "Device " + std::to_string(index) + ": " + properties.deviceName;
+    std::replace_if(name.begin(), name.end(), [](char c) {
+        return c == ',' || c == '\n' || c == '\r';
+    }, ' ');
+
+    return name;
+}
+
+std::optional<double> measureRate(
+        const std::function<std::optional<double>(uint32_t iterations)> &run,
+        const MeasureOptions &options) {
+    auto iterations = options.minIterations;
+
+    auto durationNs = run(iterations);
+    while (durationNs && durationNs.value() < options.targetNs &&
+           iterations < options.maxIterations) {
+        // Jump close to the target, without trusting tiny durations too much
+        auto scale = std::clamp(options.targetNs / std::max(durationNs.value(), 1.0), 2.0, 16.0);
+        iterations = static_cast<uint32_t>(std::min<double>(iterations * scale,
+                                                            options.maxIterations));
+
+        durationNs = run(iterations);
+    }
+
+    if (!durationNs) {
+        return std::nullopt;
+    }
+
+    auto bestNs = durationNs.value();
+    for (uint32_t i = 1; i < options.repetitions; i++) {
+        auto repetitionNs = run(iterations);
+        if (!repetitionNs) {
+            return std::nullopt;
+        }
+
+        bestNs = std::min(bestNs, repetitionNs.value());
+    }
+
+    if (bestNs <= 0) {
+        return std::nullopt;
+    }
+
+    return iterations / bestNs * 1e9;
+}
+
+} // namespace benchmark_harness
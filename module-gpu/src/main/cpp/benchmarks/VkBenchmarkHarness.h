@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include "../vulkan_wrapper/vulkan_wrapper.h"
+
+namespace benchmark_harness {
+
+/**
+ * Keep the compiler from optimizing away a value or the computation producing it.
+ */
+template<typename T>
+inline void doNotOptimize(T &value) {
+#if defined(__clang__)
+    asm volatile("" : "+r,m"(value) : : "memory");
+#else
+    asm volatile("" : "+m,r"(value) : : "memory");
+#endif
+}
+
+/**
+ * Name of the report section of a device. Names end up in the CSV output, where commas and
+ * newlines aren't allowed.
+ */
+std::string getDeviceSectionName(size_t index, const VkPhysicalDeviceProperties &properties);
+
+struct MeasureOptions {
+    /**
+     * Duration of each timed run, well below the GPU watchdog timeouts.
+     */
+    double targetNs = 20e6;
+    uint32_t minIterations = 1;
+    uint32_t maxIterations = 1u << 20;
+    uint32_t repetitions = 3;
+};
+
+/**
+ * Grow the iterations until a run takes options.targetNs, then keep the fastest of
+ * options.repetitions runs.
+ *
+ * @param run Runs the given number of iterations and returns the elapsed time in nanoseconds,
+ *            std::nullopt on failure
+ * @return Iterations per second, std::nullopt on failure
+ */
+std::optional<double> measureRate(
+        const std::function<std::optional<double>(uint32_t iterations)> &run,
+        const MeasureOptions &options = {});
+
+} // namespace benchmark_harness
@@ -0,0 +1,394 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "VkComputeBenchmark"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "../logging.h"
+#include "../vulkan/VkDeviceSession.h"
+#include "VkBenchmarkHarness.h"
+#include "VkComputeBenchmark.h"
+#include "VkComputeKernels.h"
+
+using namespace benchmark_harness;
+
+using Unit = BenchmarkReport::Unit;
+
+/**
+ * Enough invocations to fill the largest mobile GPUs many times over.
+ */
+static constexpr uint32_t kWorkgroupCount = 1024;
+static constexpr uint32_t kInvocationCount = kWorkgroupCount * VkComputeKernel::kLocalSize;
+
+static constexpr MeasureOptions kMeasureOptions = {
+        .minIterations = 16,
+};
+
+/**
+ * Must be kept in sync with the push constants of the kernels, see VkComputeKernels.h.
+ */
+struct Constants {
+    uint32_t iterations;
+    uint32_t a;
+    uint32_t b;
+};
+
+static uint32_t floatBits(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// x * a + b converges to b / (1 - a), far from denormals and infinities
+static const Constants kFp32Constants = {0, floatBits(0.9999999f), floatBits(0.0000001f)};
+static const Constants kFp16Constants = {0, floatBits(0.999f), floatBits(0.001f)};
+
+// Numerical Recipes LCG, it just has to wrap around
+static const Constants kInt32Constants = {0, 1664525, 1013904223};
+
+static const Constants kNoConstants = {0, 0, 0};
+
+/**
+ * A compute kernel ready to be dispatched, with the output buffer bound.
+ */
+class Kernel {
+public:
+    Kernel(const Kernel &) = delete;
+
+    ~Kernel() {
+        destroy();
+    }
+
+    Kernel &operator=(const Kernel &) = delete;
+
+    static std::unique_ptr<Kernel> create(VkDeviceSession &deviceSession,
+                                          const VkComputeKernel &kernel, VkBuffer output) {
+        try {
+            return std::unique_ptr<Kernel>(new Kernel(deviceSession, kernel, output));
+        } catch (std::runtime_error &error) {
+            LOGE("Failed to create kernel: %s", error.what());
+            return nullptr;
+        }
+    }
+
+    /**
+     * Dispatch kWorkgroupCount workgroups and wait for them.
+     *
+     * @return The elapsed time in nanoseconds, std::nullopt on failure
+     */
+    std::optional<double> run(const Constants &constants) {
+        auto &dispatch = mDeviceSession.getDispatch();
+
+        return mDeviceSession.measure([&](VkCommandBuffer commandBuffer) {
+            dispatch.vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+            dispatch.vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+                                             mPipelineLayout, 0, 1, &mDescriptorSet, 0, nullptr);
+            dispatch.vkCmdPushConstants(commandBuffer, mPipelineLayout,
+                                        VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constants),
+                                        &constants);
+            dispatch.vkCmdDispatch(commandBuffer, kWorkgroupCount, 1, 1);
+        });
+    }
+
+private:
+    Kernel(VkDeviceSession &deviceSession, const VkComputeKernel &kernel, VkBuffer output)
+            : mDeviceSession(deviceSession) {
+        auto device = deviceSession.getDevice();
+        auto &dispatch = deviceSession.getDispatch();
+
+        VkShaderModuleCreateInfo shaderModuleCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+                .codeSize = kernel.size,
+                .pCode = kernel.code,
+        };
+
+        if (dispatch.vkCreateShaderModule(device, &shaderModuleCreateInfo, nullptr,
+                                          &mShaderModule) != VK_SUCCESS) {
+            mShaderModule = VK_NULL_HANDLE;
+            throw std::runtime_error("Failed to create shader module");
+        }
+
+        VkDescriptorSetLayoutBinding binding{
+                .binding = 0,
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .descriptorCount = 1,
+                .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        };
+
+        VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+                .bindingCount = 1,
+                .pBindings = &binding,
+        };
+
+        if (dispatch.vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo,
+                                                 nullptr, &mDescriptorSetLayout) != VK_SUCCESS) {
+            mDescriptorSetLayout = VK_NULL_HANDLE;
+            destroy();
+            throw std::runtime_error("Failed to create descriptor set layout");
+        }
+
+        VkPushConstantRange pushConstantRange{
+                .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+                .offset = 0,
+                .size = sizeof(Constants),
+        };
+
+        VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+                .setLayoutCount = 1,
+                .pSetLayouts = &mDescriptorSetLayout,
+                .pushConstantRangeCount = 1,
+                .pPushConstantRanges = &pushConstantRange,
+        };
+
+        if (dispatch.vkCreatePipelineLayout(device, &pipelineLayoutCreateInfo, nullptr,
+                                            &mPipelineLayout) != VK_SUCCESS) {
+            mPipelineLayout = VK_NULL_HANDLE;
+            destroy();
+            throw std::runtime_error("Failed to create pipeline layout");
+        }
+
+        VkComputePipelineCreateInfo pipelineCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                .stage = {
+                        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                        .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+                        .module = mShaderModule,
+                        .pName = "main",
+                },
+                .layout = mPipelineLayout,
+        };
+
+        if (dispatch.vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineCreateInfo,
+                                              nullptr, &mPipeline) != VK_SUCCESS) {
+            mPipeline = VK_NULL_HANDLE;
+            destroy();
+            throw std::runtime_error("Failed to create compute pipeline");
+        }
+
+        VkDescriptorPoolSize poolSize{
+                .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .descriptorCount = 1,
+        };
+
+        VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+                .maxSets = 1,
+                .poolSizeCount = 1,
+                .pPoolSizes = &poolSize,
+        };
+
+        if (dispatch.vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, nullptr,
+                                            &mDescriptorPool) != VK_SUCCESS) {
+            mDescriptorPool = VK_NULL_HANDLE;
+            destroy();
+            throw std::runtime_error("Failed to create descriptor pool");
+        }
+
+        VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+                .descriptorPool = mDescriptorPool,
+                .descriptorSetCount = 1,
+                .pSetLayouts = &mDescriptorSetLayout,
+        };
+
+        if (dispatch.vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo,
+                                              &mDescriptorSet) != VK_SUCCESS) {
+            destroy();
+            throw std::runtime_error("Failed to allocate descriptor set");
+        }
+
+        VkDescriptorBufferInfo bufferInfo{
+                .buffer = output,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE,
+        };
+
+        VkWriteDescriptorSet writeDescriptorSet{
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .dstSet = mDescriptorSet,
+                .dstBinding = 0,
+                .descriptorCount = 1,
+                .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                .pBufferInfo = &bufferInfo,
+        };
+
+        dispatch.vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
+    }
+
+    void destroy() {
+        auto device = mDeviceSession.getDevice();
+        auto &dispatch = mDeviceSession.getDispatch();
+
+        // Frees the descriptor set too
+        if (mDescriptorPool != VK_NULL_HANDLE) {
+            dispatch.vkDestroyDescriptorPool(device, mDescriptorPool, nullptr);
+        }
+
+        if (mPipeline != VK_NULL_HANDLE) {
+            dispatch.vkDestroyPipeline(device, mPipeline, nullptr);
+        }
+
+        if (mPipelineLayout != VK_NULL_HANDLE) {
+            dispatch.vkDestroyPipelineLayout(device, mPipelineLayout, nullptr);
+        }
+
+        if (mDescriptorSetLayout != VK_NULL_HANDLE) {
+            dispatch.vkDestroyDescriptorSetLayout(device, mDescriptorSetLayout, nullptr);
+        }
+
+        if (mShaderModule != VK_NULL_HANDLE) {
+            dispatch.vkDestroyShaderModule(device, mShaderModule, nullptr);
+        }
+    }
+
+    VkDeviceSession &mDeviceSession;
+    VkShaderModule mShaderModule = VK_NULL_HANDLE;
+    VkDescriptorSetLayout mDescriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout mPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline mPipeline = VK_NULL_HANDLE;
+    VkDescriptorPool mDescriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet mDescriptorSet = VK_NULL_HANDLE;
+};
+
+static void runDeviceBenchmark(VkSession &vkSession, VkPhysicalDevice physicalDevice,
+                               BenchmarkReport::Section &section) {
+    auto properties = vkSession.vkGetPhysicalDeviceProperties(physicalDevice);
+
+    // Device functionality above the instance version can't be used
+    auto apiVersion = std::min(vkSession.getApiVersion(), properties.apiVersion);
+    auto &dispatch = vkSession.getDispatch();
+    auto hasVulkan11 = apiVersion >= VK_API_VERSION_1_1
+                       && dispatch.vkGetPhysicalDeviceFeatures2 != nullptr
+                       && dispatch.vkGetPhysicalDeviceProperties2 != nullptr;
+
+    std::vector<const char *> extensions;
+
+    VkPhysicalDeviceShaderFloat16Int8Features float16Int8Features{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES,
+    };
+
+    // Core in Vulkan 1.2, an extension before, both need vkGetPhysicalDeviceFeatures2
+    auto hasFloat16 = false;
+    if (hasVulkan11) {
+        auto isCore = apiVersion >= VK_API_VERSION_1_2;
+        if (isCore || vkSession.hasDeviceExtension(physicalDevice,
+                                                   VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME)) {
+            VkPhysicalDeviceFeatures2 features{
+                    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+                    .pNext = &float16Int8Features,
+            };
+            dispatch.vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+            hasFloat16 = float16Int8Features.shaderFloat16;
+            if (hasFloat16 && !isCore) {
+                extensions.push_back(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
+            }
+        }
+    }
+
+    // Only enable what we use
+    float16Int8Features.pNext = nullptr;
+    float16Int8Features.shaderInt8 = VK_FALSE;
+
+    VkPhysicalDeviceSubgroupProperties subgroupProperties{
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES,
+    };
+
+    auto hasSubgroupArithmetic = false;
+    if (hasVulkan11) {
+        VkPhysicalDeviceProperties2 properties2{
+                .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+                .pNext = &subgroupProperties,
+        };
+        dispatch.vkGetPhysicalDeviceProperties2(physicalDevice, &properties2);
+
+        hasSubgroupArithmetic =
+                (subgroupProperties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) &&
+                (subgroupProperties.supportedOperations & VK_SUBGROUP_FEATURE_ARITHMETIC_BIT);
+    }
+
+    auto deviceSession = VkDeviceSession::create(vkSession, physicalDevice, extensions,
+                                                 hasFloat16 ? &float16Int8Features : nullptr);
+    if (!deviceSession) {
+        section.add("supported", Unit::BOOLEAN, false);
+        return;
+    }
+
+    section.add("timestamp_queries", Unit::BOOLEAN, deviceSession->hasTimestamps());
+    if (hasVulkan11) {
+        section.add("subgroup_size", Unit::NONE, subgroupProperties.subgroupSize);
+    }
+
+    // Never read back, device local memory is guaranteed to exist
+    auto output = deviceSession->createBufferWithFlags(
+            kInvocationCount * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!output) {
+        section.add("supported", Unit::BOOLEAN, false);
+        return;
+    }
+
+    auto measure = [&](const char *name, Unit unit, const VkComputeKernel &definition,
+                       const Constants &constants) {
+        auto kernel = Kernel::create(*deviceSession, definition, output->getBuffer());
+        if (!kernel) {
+            return;
+        }
+
+        auto rate = measureRate([&](uint32_t iterations) {
+            auto iterationConstants = constants;
+            iterationConstants.iterations = iterations;
+            return kernel->run(iterationConstants);
+        }, kMeasureOptions);
+        if (rate) {
+            auto work = static_cast<double>(kInvocationCount) * definition.workPerIteration;
+            section.add(name, unit, rate.value() * work);
+        } else {
+            LOGE("Failed to measure %s", name);
+        }
+    };
+
+    measure("fp32_fma", Unit::FLOPS, kFp32FmaKernel, kFp32Constants);
+
+    section.add("fp16_supported", Unit::BOOLEAN, hasFloat16);
+    if (hasFloat16) {
+        measure("fp16_fma", Unit::FLOPS, kFp16FmaKernel, kFp16Constants);
+    }
+
+    measure("int32_mad", Unit::OPS_PER_SECOND, kInt32MadKernel, kInt32Constants);
+
+    measure("shared_memory_read", Unit::BYTES_PER_SECOND, kSharedMemoryKernel, kNoConstants);
+
+    section.add("subgroup_arithmetic_supported", Unit::BOOLEAN, hasSubgroupArithmetic);
+    if (hasSubgroupArithmetic) {
+        measure("subgroup_add", Unit::OPS_PER_SECOND, kSubgroupAddKernel, kNoConstants);
+    }
+}
+
+BenchmarkReport runVkComputeBenchmark() {
+    BenchmarkReport report;
+
+    auto vkSession = VkSession::createHeadless();
+    if (!vkSession) {
+        report.addSection("Vulkan").add("supported", Unit::BOOLEAN, false);
+        return report;
+    }
+
+    auto physicalDevices = vkSession->vkEnumeratePhysicalDevices();
+    for (size_t i = 0; i < physicalDevices.size(); i++) {
+        auto properties = vkSession->vkGetPhysicalDeviceProperties(physicalDevices[i]);
+
+        LOGI("Benchmarking %s", properties.deviceName);
+
+        auto &section = report.addSection(getDeviceSectionName(i, properties));
+        runDeviceBenchmark(*vkSession, physicalDevices[i], section);
+    }
+
+    return report;
+}
@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Measure FP32 and FP16 FMA, int32 multiply-add, shared memory read and subgroup reduction
+ * throughput of every Vulkan device, with embedded compute kernels timed by timestamp queries.
+ */
+BenchmarkReport runVkComputeBenchmark();
@@ -0,0 +1,1539 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "VkComputeKernels.h"
+
+// The arithmetic kernels run independent dependency chains, enough to hide the latency of the
+// operation on current GPUs, so we measure throughput. Values are carried across iterations in
+// OpPhi instructions, as a compiler would emit them.
+
+// FP32 FMA throughput, 8 independent chains of 2 FMAs per iteration:
+//   layout(local_size_x = 64) in;
+//   layout(binding = 0) buffer Output { uint data[]; };
+//   layout(push_constant) uniform Constants { uint iterations; float a; float b; };
+//   void main() {
+//       float x[8]; // x[k] = float(gl_GlobalInvocationID.x) + k
+//       for (uint i = 0; i < iterations; i++)
+//           for (int k = 0; k < 8; k++) x[k] = fma(fma(x[k], a, b), a, b);
+//       data[gl_GlobalInvocationID.x] = floatBitsToUint(x[0] + ... + x[7]);
+//   }
+static const uint32_t kFp32FmaKernelCode[] = {
+        // SPIR-V 1.0, bound 91
+        0x07230203, 0x00010000, 0x00000000, 0x0000005b, 0x00000000,
+        // OpCapability Shader
+        0x00020011, 0x00000001,
+        // %glsl = OpExtInstImport "GLSL.std.450"
+        0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000,
+        // OpMemoryModel Logical GLSL450
+        0x0003000e, 0x00000000, 0x00000001,
+        // OpEntryPoint GLCompute %main "main" %gl_GlobalInvocationID
+        0x0006000f, 0x00000005, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003,
+        // OpExecutionMode %main LocalSize 64 1 1
+        0x00060010, 0x00000002, 0x00000011, 0x00000040, 0x00000001, 0x00000001,
+        // OpDecorate %gl_GlobalInvocationID BuiltIn GlobalInvocationId
+        0x00040047, 0x00000003, 0x0000000b, 0x0000001c,
+        // OpDecorate %_runtimearr_uint ArrayStride 4
+        0x00040047, 0x00000004, 0x00000006, 0x00000004,
+        // OpMemberDecorate %Output 0 Offset 0
+        0x00050048, 0x00000005, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Output BufferBlock
+        0x00030047, 0x00000005, 0x00000003,
+        // OpDecorate %output DescriptorSet 0
+        0x00040047, 0x00000006, 0x00000022, 0x00000000,
+        // OpDecorate %output Binding 0
+        0x00040047, 0x00000006, 0x00000021, 0x00000000,
+        // OpMemberDecorate %Constants 0 Offset 0
+        0x00050048, 0x00000007, 0x00000000, 0x00000023, 0x00000000,
+        // OpMemberDecorate %Constants 1 Offset 4
+        0x00050048, 0x00000007, 0x00000001, 0x00000023, 0x00000004,
+        // OpMemberDecorate %Constants 2 Offset 8
+        0x00050048, 0x00000007, 0x00000002, 0x00000023, 0x00000008,
+        // OpDecorate %Constants Block
+        0x00030047, 0x00000007, 0x00000002,
+        // %void = OpTypeVoid
+        0x00020013, 0x00000008,
+        // %fn_void = OpTypeFunction %void
+        0x00030021, 0x00000009, 0x00000008,
+        // %bool = OpTypeBool
+        0x00020014, 0x0000000a,
+        // %uint = OpTypeInt 32 0
+        0x00040015, 0x0000000b, 0x00000020, 0x00000000,
+        // %v3uint = OpTypeVector %uint 3
+        0x00040017, 0x0000000c, 0x0000000b, 0x00000003,
+        // %_ptr_Input_v3uint = OpTypePointer Input %v3uint
+        0x00040020, 0x0000000d, 0x00000001, 0x0000000c,
+        // %_ptr_Input_uint = OpTypePointer Input %uint
+        0x00040020, 0x0000000e, 0x00000001, 0x0000000b,
+        // %_runtimearr_uint = OpTypeRuntimeArray %uint
+        0x0003001d, 0x00000004, 0x0000000b,
+        // %Output = OpTypeStruct %_runtimearr_uint
+        0x0003001e, 0x00000005, 0x00000004,
+        // %_ptr_Uniform_Output = OpTypePointer Uniform %Output
+        0x00040020, 0x0000000f, 0x00000002, 0x00000005,
+        // %_ptr_Uniform_uint = OpTypePointer Uniform %uint
+        0x00040020, 0x00000010, 0x00000002, 0x0000000b,
+        // %float = OpTypeFloat 32
+        0x00030016, 0x00000011, 0x00000020,
+        // %Constants = OpTypeStruct %uint %float %float
+        0x0005001e, 0x00000007, 0x0000000b, 0x00000011, 0x00000011,
+        // %_ptr_PushConstant_Constants = OpTypePointer PushConstant %Constants
+        0x00040020, 0x00000012, 0x00000009, 0x00000007,
+        // %_ptr_PushConstant_uint = OpTypePointer PushConstant %uint
+        0x00040020, 0x00000013, 0x00000009, 0x0000000b,
+        // %_ptr_PushConstant_float = OpTypePointer PushConstant %float
+        0x00040020, 0x00000014, 0x00000009, 0x00000011,
+        // %uint_0 = OpConstant %uint 0
+        0x0004002b, 0x0000000b, 0x00000015, 0x00000000,
+        // %uint_1 = OpConstant %uint 1
+        0x0004002b, 0x0000000b, 0x00000016, 0x00000001,
+        // %uint_2 = OpConstant %uint 2
+        0x0004002b, 0x0000000b, 0x00000017, 0x00000002,
+        // %float_0 = OpConstant %float 0.0
+        0x0004002b, 0x00000011, 0x00000018, 0x00000000,
+        // %float_1 = OpConstant %float 1.0
+        0x0004002b, 0x00000011, 0x00000019, 0x3f800000,
+        // %float_2 = OpConstant %float 2.0
+        0x0004002b, 0x00000011, 0x0000001a, 0x40000000,
+        // %float_3 = OpConstant %float 3.0
+        0x0004002b, 0x00000011, 0x0000001b, 0x40400000,
+        // %float_4 = OpConstant %float 4.0
+        0x0004002b, 0x00000011, 0x0000001c, 0x40800000,
+        // %float_5 = OpConstant %float 5.0
+        0x0004002b, 0x00000011, 0x0000001d, 0x40a00000,
+        // %float_6 = OpConstant %float 6.0
+        0x0004002b, 0x00000011, 0x0000001e, 0x40c00000,
+        // %float_7 = OpConstant %float 7.0
+        0x0004002b, 0x00000011, 0x0000001f, 0x40e00000,
+        // %gl_GlobalInvocationID = OpVariable %_ptr_Input_v3uint Input
+        0x0004003b, 0x0000000d, 0x00000003, 0x00000001,
+        // %output = OpVariable %_ptr_Uniform_Output Uniform
+        0x0004003b, 0x0000000f, 0x00000006, 0x00000002,
+        // %constants = OpVariable %_ptr_PushConstant_Constants PushConstant
+        0x0004003b, 0x00000012, 0x00000020, 0x00000009,
+        // %main = OpFunction %void None %fn_void
+        0x00050036, 0x00000008, 0x00000002, 0x00000000, 0x00000009,
+        // %entry = OpLabel
+        0x000200f8, 0x00000021,
+        // %gid3 = OpLoad %v3uint %gl_GlobalInvocationID
+        0x0004003d, 0x0000000c, 0x00000022, 0x00000003,
+        // %gid = OpCompositeExtract %uint %gid3 0
+        0x00050051, 0x0000000b, 0x00000023, 0x00000022, 0x00000000,
+        // %iterations_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_0
+        0x00050041, 0x00000013, 0x00000024, 0x00000020, 0x00000015,
+        // %iterations = OpLoad %uint %iterations_ptr
+        0x0004003d, 0x0000000b, 0x00000025, 0x00000024,
+        // %a_ptr = OpAccessChain %_ptr_PushConstant_float %constants %uint_1
+        0x00050041, 0x00000014, 0x00000026, 0x00000020, 0x00000016,
+        // %a = OpLoad %float %a_ptr
+        0x0004003d, 0x00000011, 0x00000027, 0x00000026,
+        // %b_ptr = OpAccessChain %_ptr_PushConstant_float %constants %uint_2
+        0x00050041, 0x00000014, 0x00000028, 0x00000020, 0x00000017,
+        // %b = OpLoad %float %b_ptr
+        0x0004003d, 0x00000011, 0x00000029, 0x00000028,
+        // %seed = OpConvertUToF %float %gid
+        0x00040070, 0x00000011, 0x0000002a, 0x00000023,
+        // %x0_init = OpFAdd %float %seed %float_0
+        0x00050081, 0x00000011, 0x0000002b, 0x0000002a, 0x00000018,
+        // %x1_init = OpFAdd %float %seed %float_1
+        0x00050081, 0x00000011, 0x0000002c, 0x0000002a, 0x00000019,
+        // %x2_init = OpFAdd %float %seed %float_2
+        0x00050081, 0x00000011, 0x0000002d, 0x0000002a, 0x0000001a,
+        // %x3_init = OpFAdd %float %seed %float_3
+        0x00050081, 0x00000011, 0x0000002e, 0x0000002a, 0x0000001b,
+        // %x4_init = OpFAdd %float %seed %float_4
+        0x00050081, 0x00000011, 0x0000002f, 0x0000002a, 0x0000001c,
+        // %x5_init = OpFAdd %float %seed %float_5
+        0x00050081, 0x00000011, 0x00000030, 0x0000002a, 0x0000001d,
+        // %x6_init = OpFAdd %float %seed %float_6
+        0x00050081, 0x00000011, 0x00000031, 0x0000002a, 0x0000001e,
+        // %x7_init = OpFAdd %float %seed %float_7
+        0x00050081, 0x00000011, 0x00000032, 0x0000002a, 0x0000001f,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000033,
+        // %loop_header = OpLabel
+        0x000200f8, 0x00000033,
+        // %i = OpPhi %uint %uint_0 %entry %i_next %loop_continue
+        0x000700f5, 0x0000000b, 0x00000037, 0x00000015, 0x00000021, 0x00000038,
+        0x00000035,
+        // %x0 = OpPhi %float %x0_init %entry %x0_next %loop_continue
+        0x000700f5, 0x00000011, 0x00000039, 0x0000002b, 0x00000021, 0x00000041,
+        0x00000035,
+        // %x1 = OpPhi %float %x1_init %entry %x1_next %loop_continue
+        0x000700f5, 0x00000011, 0x0000003a, 0x0000002c, 0x00000021, 0x00000042,
+        0x00000035,
+        // %x2 = OpPhi %float %x2_init %entry %x2_next %loop_continue
+        0x000700f5, 0x00000011, 0x0000003b, 0x0000002d, 0x00000021, 0x00000043,
+        0x00000035,
+        // %x3 = OpPhi %float %x3_init %entry %x3_next %loop_continue
+        0x000700f5, 0x00000011, 0x0000003c, 0x0000002e, 0x00000021, 0x00000044,
+        0x00000035,
+        // %x4 = OpPhi %float %x4_init %entry %x4_next %loop_continue
+        0x000700f5, 0x00000011, 0x0000003d, 0x0000002f, 0x00000021, 0x00000045,
+        0x00000035,
+        // %x5 = OpPhi %float %x5_init %entry %x5_next %loop_continue
+        0x000700f5, 0x00000011, 0x0000003e, 0x00000030, 0x00000021, 0x00000046,
+        0x00000035,
+        // %x6 = OpPhi %float %x6_init %entry %x6_next %loop_continue
+        0x000700f5, 0x00000011, 0x0000003f, 0x00000031, 0x00000021, 0x00000047,
+        0x00000035,
+        // %x7 = OpPhi %float %x7_init %entry %x7_next %loop_continue
+        0x000700f5, 0x00000011, 0x00000040, 0x00000032, 0x00000021, 0x00000048,
+        0x00000035,
+        // %loop_cond = OpULessThan %bool %i %iterations
+        0x000500b0, 0x0000000a, 0x00000049, 0x00000037, 0x00000025,
+        // OpLoopMerge %loop_merge %loop_continue None
+        0x000400f6, 0x00000036, 0x00000035, 0x00000000,
+        // OpBranchConditional %loop_cond %loop_body %loop_merge
+        0x000400fa, 0x00000049, 0x00000034, 0x00000036,
+        // %loop_body = OpLabel
+        0x000200f8, 0x00000034,
+        // %x0_1 = OpExtInst %float %glsl Fma %x0 %a %b
+        0x0008000c, 0x00000011, 0x0000004a, 0x00000001, 0x00000032, 0x00000039,
+        0x00000027, 0x00000029,
+        // %x1_1 = OpExtInst %float %glsl Fma %x1 %a %b
+        0x0008000c, 0x00000011, 0x0000004b, 0x00000001, 0x00000032, 0x0000003a,
+        0x00000027, 0x00000029,
+        // %x2_1 = OpExtInst %float %glsl Fma %x2 %a %b
+        0x0008000c, 0x00000011, 0x0000004c, 0x00000001, 0x00000032, 0x0000003b,
+        0x00000027, 0x00000029,
+        // %x3_1 = OpExtInst %float %glsl Fma %x3 %a %b
+        0x0008000c, 0x00000011, 0x0000004d, 0x00000001, 0x00000032, 0x0000003c,
+        0x00000027, 0x00000029,
+        // %x4_1 = OpExtInst %float %glsl Fma %x4 %a %b
+        0x0008000c, 0x00000011, 0x0000004e, 0x00000001, 0x00000032, 0x0000003d,
+        0x00000027, 0x00000029,
+        // %x5_1 = OpExtInst %float %glsl Fma %x5 %a %b
+        0x0008000c, 0x00000011, 0x0000004f, 0x00000001, 0x00000032, 0x0000003e,
+        0x00000027, 0x00000029,
+        // %x6_1 = OpExtInst %float %glsl Fma %x6 %a %b
+        0x0008000c, 0x00000011, 0x00000050, 0x00000001, 0x00000032, 0x0000003f,
+        0x00000027, 0x00000029,
+        // %x7_1 = OpExtInst %float %glsl Fma %x7 %a %b
+        0x0008000c, 0x00000011, 0x00000051, 0x00000001, 0x00000032, 0x00000040,
+        0x00000027, 0x00000029,
+        // %x0_next = OpExtInst %float %glsl Fma %x0_1 %a %b
+        0x0008000c, 0x00000011, 0x00000041, 0x00000001, 0x00000032, 0x0000004a,
+        0x00000027, 0x00000029,
+        // %x1_next = OpExtInst %float %glsl Fma %x1_1 %a %b
+        0x0008000c, 0x00000011, 0x00000042, 0x00000001, 0x00000032, 0x0000004b,
+        0x00000027, 0x00000029,
+        // %x2_next = OpExtInst %float %glsl Fma %x2_1 %a %b
+        0x0008000c, 0x00000011, 0x00000043, 0x00000001, 0x00000032, 0x0000004c,
+        0x00000027, 0x00000029,
+        // %x3_next = OpExtInst %float %glsl Fma %x3_1 %a %b
+        0x0008000c, 0x00000011, 0x00000044, 0x00000001, 0x00000032, 0x0000004d,
+        0x00000027, 0x00000029,
+        // %x4_next = OpExtInst %float %glsl Fma %x4_1 %a %b
+        0x0008000c, 0x00000011, 0x00000045, 0x00000001, 0x00000032, 0x0000004e,
+        0x00000027, 0x00000029,
+        // %x5_next = OpExtInst %float %glsl Fma %x5_1 %a %b
+        0x0008000c, 0x00000011, 0x00000046, 0x00000001, 0x00000032, 0x0000004f,
+        0x00000027, 0x00000029,
+        // %x6_next = OpExtInst %float %glsl Fma %x6_1 %a %b
+        0x0008000c, 0x00000011, 0x00000047, 0x00000001, 0x00000032, 0x00000050,
+        0x00000027, 0x00000029,
+        // %x7_next = OpExtInst %float %glsl Fma %x7_1 %a %b
+        0x0008000c, 0x00000011, 0x00000048, 0x00000001, 0x00000032, 0x00000051,
+        0x00000027, 0x00000029,
+        // OpBranch %loop_continue
+        0x000200f9, 0x00000035,
+        // %loop_continue = OpLabel
+        0x000200f8, 0x00000035,
+        // %i_next = OpIAdd %uint %i %uint_1
+        0x00050080, 0x0000000b, 0x00000038, 0x00000037, 0x00000016,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000033,
+        // %loop_merge = OpLabel
+        0x000200f8, 0x00000036,
+        // %sum_1 = OpFAdd %float %x0 %x1
+        0x00050081, 0x00000011, 0x00000052, 0x00000039, 0x0000003a,
+        // %sum_2 = OpFAdd %float %sum_1 %x2
+        0x00050081, 0x00000011, 0x00000053, 0x00000052, 0x0000003b,
+        // %sum_3 = OpFAdd %float %sum_2 %x3
+        0x00050081, 0x00000011, 0x00000054, 0x00000053, 0x0000003c,
+        // %sum_4 = OpFAdd %float %sum_3 %x4
+        0x00050081, 0x00000011, 0x00000055, 0x00000054, 0x0000003d,
+        // %sum_5 = OpFAdd %float %sum_4 %x5
+        0x00050081, 0x00000011, 0x00000056, 0x00000055, 0x0000003e,
+        // %sum_6 = OpFAdd %float %sum_5 %x6
+        0x00050081, 0x00000011, 0x00000057, 0x00000056, 0x0000003f,
+        // %sum_7 = OpFAdd %float %sum_6 %x7
+        0x00050081, 0x00000011, 0x00000058, 0x00000057, 0x00000040,
+        // %sum_bits = OpBitcast %uint %sum_7
+        0x0004007c, 0x0000000b, 0x00000059, 0x00000058,
+        // %output_ptr = OpAccessChain %_ptr_Uniform_uint %output %uint_0 %gid
+        0x00060041, 0x00000010, 0x0000005a, 0x00000006, 0x00000015, 0x00000023,
+        // OpStore %output_ptr %sum_bits
+        0x0003003e, 0x0000005a, 0x00000059,
+        // OpReturn
+        0x000100fd,
+        // OpFunctionEnd
+        0x00010038,
+};
+
+// FP16 FMA throughput, same as kFp32FmaKernel on f16vec2, as GPUs with double rate FP16
+// usually need packed operands to reach it. Needs shaderFloat16, but not 16-bit storage:
+//   f16vec2 x[8]; // x[k] = f16vec2(float(gl_GlobalInvocationID.x & 255) + vec2(2 * k, 2 * k + 1))
+//   for (uint i = 0; i < iterations; i++)
+//       for (int k = 0; k < 8; k++) x[k] = fma(fma(x[k], f16vec2(a), f16vec2(b)), ...);
+//   vec2 sum = vec2(x[0] + ... + x[7]);
+//   data[gl_GlobalInvocationID.x] = floatBitsToUint(sum.x + sum.y);
+static const uint32_t kFp16FmaKernelCode[] = {
+        // SPIR-V 1.0, bound 144
+        0x07230203, 0x00010000, 0x00000000, 0x00000090, 0x00000000,
+        // OpCapability Shader
+        0x00020011, 0x00000001,
+        // OpCapability Float16
+        0x00020011, 0x00000009,
+        // %glsl = OpExtInstImport "GLSL.std.450"
+        0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000,
+        // OpMemoryModel Logical GLSL450
+        0x0003000e, 0x00000000, 0x00000001,
+        // OpEntryPoint GLCompute %main "main" %gl_GlobalInvocationID
+        0x0006000f, 0x00000005, 0x00000002, 0x6e69616d, 0x00000000, 0x00000003,
+        // OpExecutionMode %main LocalSize 64 1 1
+        0x00060010, 0x00000002, 0x00000011, 0x00000040, 0x00000001, 0x00000001,
+        // OpDecorate %gl_GlobalInvocationID BuiltIn GlobalInvocationId
+        0x00040047, 0x00000003, 0x0000000b, 0x0000001c,
+        // OpDecorate %_runtimearr_uint ArrayStride 4
+        0x00040047, 0x00000004, 0x00000006, 0x00000004,
+        // OpMemberDecorate %Output 0 Offset 0
+        0x00050048, 0x00000005, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Output BufferBlock
+        0x00030047, 0x00000005, 0x00000003,
+        // OpDecorate %output DescriptorSet 0
+        0x00040047, 0x00000006, 0x00000022, 0x00000000,
+        // OpDecorate %output Binding 0
+        0x00040047, 0x00000006, 0x00000021, 0x00000000,
+        // OpMemberDecorate %Constants 0 Offset 0
+        0x00050048, 0x00000007, 0x00000000, 0x00000023, 0x00000000,
+        // OpMemberDecorate %Constants 1 Offset 4
+        0x00050048, 0x00000007, 0x00000001, 0x00000023, 0x00000004,
+        // OpMemberDecorate %Constants 2 Offset 8
+        0x00050048, 0x00000007, 0x00000002, 0x00000023, 0x00000008,
+        // OpDecorate %Constants Block
+        0x00030047, 0x00000007, 0x00000002,
+        // %void = OpTypeVoid
+        0x00020013, 0x00000008,
+        // %fn_void = OpTypeFunction %void
+        0x00030021, 0x00000009, 0x00000008,
+        // %bool = OpTypeBool
+        0x00020014, 0x0000000a,
+        // %uint = OpTypeInt 32 0
+        0x00040015, 0x0000000b, 0x00000020, 0x00000000,
+        // %v3uint = OpTypeVector %uint 3
+        0x00040017, 0x0000000c, 0x0000000b, 0x00000003,
+        // %_ptr_Input_v3uint = OpTypePointer Input %v3uint
+        0x00040020, 0x0000000d, 0x00000001, 0x0000000c,
+        // %_ptr_Input_uint = OpTypePointer Input %uint
+        0x00040020, 0x0000000e, 0x00000001, 0x0000000b,
+        // %_runtimearr_uint = OpTypeRuntimeArray %uint
+        0x0003001d, 0x00000004, 0x0000000b,
+        // %Output = OpTypeStruct %_runtimearr_uint
+        0x0003001e, 0x00000005, 0x00000004,
+        // %_ptr_Uniform_Output = OpTypePointer Uniform %Output
+        0x00040020, 0x0000000f, 0x00000002, 0x00000005,
+        // %_ptr_Uniform_uint = OpTypePointer Uniform %uint
+        0x00040020, 0x00000010, 0x00000002, 0x0000000b,
+        // %float = OpTypeFloat 32
+        0x00030016, 0x00000011, 0x00000020,
+        // %Constants = OpTypeStruct %uint %float %float
+        0x0005001e, 0x00000007, 0x0000000b, 0x00000011, 0x00000011,
+        // %_ptr_PushConstant_Constants = OpTypePointer PushConstant %Constants
+        0x00040020, 0x00000012, 0x00000009, 0x00000007,
+        // %_ptr_PushConstant_uint = OpTypePointer PushConstant %uint
+        0x00040020, 0x00000013, 0x00000009, 0x0000000b,
+        // %_ptr_PushConstant_float = OpTypePointer PushConstant %float
+        0x00040020, 0x00000014, 0x00000009, 0x00000011,
+        // %half = OpTypeFloat 16
+        0x00030016, 0x00000015, 0x00000010,
+        // %v2half = OpTypeVector %half 2
+        0x00040017, 0x00000016, 0x00000015, 0x00000002,
+        // %v2float = OpTypeVector %float 2
+        0x00040017, 0x00000017, 0x00000011, 0x00000002,
+        // %uint_0 = OpConstant %uint 0
+        0x0004002b, 0x0000000b, 0x00000018, 0x00000000,
+        // %uint_1 = OpConstant %uint 1
+        0x0004002b, 0x0000000b, 0x00000019, 0x00000001,
+        // %uint_2 = OpConstant %uint 2
+        0x0004002b, 0x0000000b, 0x0000001a, 0x00000002,
+        // %uint_255 = OpConstant %uint 255
+        0x0004002b, 0x0000000b, 0x0000001b, 0x000000ff,
+        // %float_0 = OpConstant %float 0.0
+        0x0004002b, 0x00000011, 0x0000001c, 0x00000000,
+        // %float_1 = OpConstant %float 1.0
+        0x0004002b, 0x00000011, 0x0000001d, 0x3f800000,
+        // %float_2 = OpConstant %float 2.0
+        0x0004002b, 0x00000011, 0x0000001e, 0x40000000,
+        // %float_3 = OpConstant %float 3.0
+        0x0004002b, 0x00000011, 0x0000001f, 0x40400000,
+        // %float_4 = OpConstant %float 4.0
+        0x0004002b, 0x00000011, 0x00000020, 0x40800000,
+        // %float_5 = OpConstant %float 5.0
+        0x0004002b, 0x00000011, 0x00000021, 0x40a00000,
+        // %float_6 = OpConstant %float 6.0
+        0x0004002b, 0x00000011, 0x00000022, 0x40c00000,
+        // %float_7 = OpConstant %float 7.0
+        0x0004002b, 0x00000011, 0x00000023, 0x40e00000,
+        // %float_8 = OpConstant %float 8.0
+        0x0004002b, 0x00000011, 0x00000024, 0x41000000,
+        // %float_9 = OpConstant %float 9.0
+        0x0004002b, 0x00000011, 0x00000025, 0x41100000,
+        // %float_10 = OpConstant %float 10.0
+        0x0004002b, 0x00000011, 0x00000026, 0x41200000,
+        // %float_11 = OpConstant %float 11.0
+        0x0004002b, 0x00000011, 0x00000027, 0x41300000,
+        // %float_12 = OpConstant %float 12.0
+        0x0004002b, 0x00000011, 0x00000028, 0x41400000,
+        // %float_13 = OpConstant %float 13.0
+        0x0004002b, 0x00000011, 0x00000029, 0x41500000,
+        // %float_14 = OpConstant %float 14.0
+        0x0004002b, 0x00000011, 0x0000002a, 0x41600000,
+        // %float_15 = OpConstant %float 15.0
+        0x0004002b, 0x00000011, 0x0000002b, 0x41700000,
+        // %gl_GlobalInvocationID = OpVariable %_ptr_Input_v3uint Input
+        0x0004003b, 0x0000000d, 0x00000003, 0x00000001,
+        // %output = OpVariable %_ptr_Uniform_Output Uniform
+        0x0004003b, 0x0000000f, 0x00000006, 0x00000002,
+        // %constants = OpVariable %_ptr_PushConstant_Constants PushConstant
+        0x0004003b, 0x00000012, 0x0000002c, 0x00000009,
+        // %main = OpFunction %void None %fn_void
+        0x00050036, 0x00000008, 0x00000002, 0x00000000, 0x00000009,
+        // %entry = OpLabel
+        0x000200f8, 0x0000002d,
+        // %gid3 = OpLoad %v3uint %gl_GlobalInvocationID
+        0x0004003d, 0x0000000c, 0x0000002e, 0x00000003,
+        // %gid = OpCompositeExtract %uint %gid3 0
+        0x00050051, 0x0000000b, 0x0000002f, 0x0000002e, 0x00000000,
+        // %iterations_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_0
+        0x00050041, 0x00000013, 0x00000030, 0x0000002c, 0x00000018,
+        // %iterations = OpLoad %uint %iterations_ptr
+        0x0004003d, 0x0000000b, 0x00000031, 0x00000030,
+        // %a_ptr = OpAccessChain %_ptr_PushConstant_float %constants %uint_1
+        0x00050041, 0x00000014, 0x00000032, 0x0000002c, 0x00000019,
+        // %a = OpLoad %float %a_ptr
+        0x0004003d, 0x00000011, 0x00000033, 0x00000032,
+        // %b_ptr = OpAccessChain %_ptr_PushConstant_float %constants %uint_2
+        0x00050041, 0x00000014, 0x00000034, 0x0000002c, 0x0000001a,
+        // %b = OpLoad %float %b_ptr
+        0x0004003d, 0x00000011, 0x00000035, 0x00000034,
+        // %gid_low = OpBitwiseAnd %uint %gid %uint_255
+        0x000500c7, 0x0000000b, 0x00000036, 0x0000002f, 0x0000001b,
+        // %seed = OpConvertUToF %float %gid_low
+        0x00040070, 0x00000011, 0x00000037, 0x00000036,
+        // %a_half = OpFConvert %half %a
+        0x00040073, 0x00000015, 0x00000038, 0x00000033,
+        // %b_half = OpFConvert %half %b
+        0x00040073, 0x00000015, 0x00000039, 0x00000035,
+        // %a2 = OpCompositeConstruct %v2half %a_half %a_half
+        0x00050050, 0x00000016, 0x0000003a, 0x00000038, 0x00000038,
+        // %b2 = OpCompositeConstruct %v2half %b_half %b_half
+        0x00050050, 0x00000016, 0x0000003b, 0x00000039, 0x00000039,
+        // %seed_0_x = OpFAdd %float %seed %float_0
+        0x00050081, 0x00000011, 0x0000003c, 0x00000037, 0x0000001c,
+        // %seed_0_y = OpFAdd %float %seed %float_1
+        0x00050081, 0x00000011, 0x0000003d, 0x00000037, 0x0000001d,
+        // %seed_0_x_half = OpFConvert %half %seed_0_x
+        0x00040073, 0x00000015, 0x0000003e, 0x0000003c,
+        // %seed_0_y_half = OpFConvert %half %seed_0_y
+        0x00040073, 0x00000015, 0x0000003f, 0x0000003d,
+        // %x0_init = OpCompositeConstruct %v2half %seed_0_x_half %seed_0_y_half
+        0x00050050, 0x00000016, 0x00000040, 0x0000003e, 0x0000003f,
+        // %seed_1_x = OpFAdd %float %seed %float_2
+        0x00050081, 0x00000011, 0x00000041, 0x00000037, 0x0000001e,
+        // %seed_1_y = OpFAdd %float %seed %float_3
+        0x00050081, 0x00000011, 0x00000042, 0x00000037, 0x0000001f,
+        // %seed_1_x_half = OpFConvert %half %seed_1_x
+        0x00040073, 0x00000015, 0x00000043, 0x00000041,
+        // %seed_1_y_half = OpFConvert %half %seed_1_y
+        0x00040073, 0x00000015, 0x00000044, 0x00000042,
+        // %x1_init = OpCompositeConstruct %v2half %seed_1_x_half %seed_1_y_half
+        0x00050050, 0x00000016, 0x00000045, 0x00000043, 0x00000044,
+        // %seed_2_x = OpFAdd %float %seed %float_4
+        0x00050081, 0x00000011, 0x00000046, 0x00000037, 0x00000020,
+        // %seed_2_y = OpFAdd %float %seed %float_5
+        0x00050081, 0x00000011, 0x00000047, 0x00000037, 0x00000021,
+        // %seed_2_x_half = OpFConvert %half %seed_2_x
+        0x00040073, 0x00000015, 0x00000048, 0x00000046,
+        // %seed_2_y_half = OpFConvert %half %seed_2_y
+        0x00040073, 0x00000015, 0x00000049, 0x00000047,
+        // %x2_init = OpCompositeConstruct %v2half %seed_2_x_half %seed_2_y_half
+        0x00050050, 0x00000016, 0x0000004a, 0x00000048, 0x00000049,
+        // %seed_3_x = OpFAdd %float %seed %float_6
+        0x00050081, 0x00000011, 0x0000004b, 0x00000037, 0x00000022,
+        // %seed_3_y = OpFAdd %float %seed %float_7
+        0x00050081, 0x00000011, 0x0000004c, 0x00000037, 0x00000023,
+        // %seed_3_x_half = OpFConvert %half %seed_3_x
+        0x00040073, 0x00000015, 0x0000004d, 0x0000004b,
+        // %seed_3_y_half = OpFConvert %half %seed_3_y
+        0x00040073, 0x00000015, 0x0000004e, 0x0000004c,
+        // %x3_init = OpCompositeConstruct %v2half %seed_3_x_half %seed_3_y_half
+        0x00050050, 0x00000016, 0x0000004f, 0x0000004d, 0x0000004e,
+        // %seed_4_x = OpFAdd %float %seed %float_8
+        0x00050081, 0x00000011, 0x00000050, 0x00000037, 0x00000024,
+        // %seed_4_y = OpFAdd %float %seed %float_9
+        0x00050081, 0x00000011, 0x00000051, 0x00000037, 0x00000025,
+        // %seed_4_x_half = OpFConvert %half %seed_4_x
+        0x00040073, 0x00000015, 0x00000052, 0x00000050,
+        // %seed_4_y_half = OpFConvert %half %seed_4_y
+        0x00040073, 0x00000015, 0x00000053, 0x00000051,
+        // %x4_init = OpCompositeConstruct %v2half %seed_4_x_half %seed_4_y_half
+        0x00050050, 0x00000016, 0x00000054, 0x00000052, 0x00000053,
+        // %seed_5_x = OpFAdd %float %seed %float_10
+        0x00050081, 0x00000011, 0x00000055, 0x00000037, 0x00000026,
+        // %seed_5_y = OpFAdd %float %seed %float_11
+        0x00050081, 0x00000011, 0x00000056, 0x00000037, 0x00000027,
+        // %seed_5_x_half = OpFConvert %half %seed_5_x
+        0x00040073, 0x00000015, 0x00000057, 0x00000055,
+        // %seed_5_y_half = OpFConvert %half %seed_5_y
+        0x00040073, 0x00000015, 0x00000058, 0x00000056,
+        // %x5_init = OpCompositeConstruct %v2half %seed_5_x_half %seed_5_y_half
+        0x00050050, 0x00000016, 0x00000059, 0x00000057, 0x00000058,
+        // %seed_6_x = OpFAdd %float %seed %float_12
+        0x00050081, 0x00000011, 0x0000005a, 0x00000037, 0x00000028,
+        // %seed_6_y = OpFAdd %float %seed %float_13
+        0x00050081, 0x00000011, 0x0000005b, 0x00000037, 0x00000029,
+        // %seed_6_x_half = OpFConvert %half %seed_6_x
+        0x00040073, 0x00000015, 0x0000005c, 0x0000005a,
+        // %seed_6_y_half = OpFConvert %half %seed_6_y
+        0x00040073, 0x00000015, 0x0000005d, 0x0000005b,
+        // %x6_init = OpCompositeConstruct %v2half %seed_6_x_half %seed_6_y_half
+        0x00050050, 0x00000016, 0x0000005e, 0x0000005c, 0x0000005d,
+        // %seed_7_x = OpFAdd %float %seed %float_14
+        0x00050081, 0x00000011, 0x0000005f, 0x00000037, 0x0000002a,
+        // %seed_7_y = OpFAdd %float %seed %float_15
+        0x00050081, 0x00000011, 0x00000060, 0x00000037, 0x0000002b,
+        // %seed_7_x_half = OpFConvert %half %seed_7_x
+        0x00040073, 0x00000015, 0x00000061, 0x0000005f,
+        // %seed_7_y_half = OpFConvert %half %seed_7_y
+        0x00040073, 0x00000015, 0x00000062, 0x00000060,
+        // %x7_init = OpCompositeConstruct %v2half %seed_7_x_half %seed_7_y_half
+        0x00050050, 0x00000016, 0x00000063, 0x00000061, 0x00000062,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000064,
+        // %loop_header = OpLabel
+        0x000200f8, 0x00000064,
+        // %i = OpPhi %uint %uint_0 %entry %i_next %loop_continue
+        0x000700f5, 0x0000000b, 0x00000068, 0x00000018, 0x0000002d, 0x00000069,
+        0x00000066,
+        // %x0 = OpPhi %v2half %x0_init %entry %x0_next %loop_continue
+        0x000700f5, 0x00000016, 0x0000006a, 0x00000040, 0x0000002d, 0x00000072,
+        0x00000066,
+        // %x1 = OpPhi %v2half %x1_init %entry %x1_next %loop_continue
+        0x000700f5, 0x00000016, 0x0000006b, 0x00000045, 0x0000002d, 0x00000073,
+        0x00000066,
+        // %x2 = OpPhi %v2half %x2_init %entry %x2_next %loop_continue
+        0x000700f5, 0x00000016, 0x0000006c, 0x0000004a, 0x0000002d, 0x00000074,
+        0x00000066,
+        // %x3 = OpPhi %v2half %x3_init %entry %x3_next %loop_continue
+        0x000700f5, 0x00000016, 0x0000006d, 0x0000004f, 0x0000002d, 0x00000075,
+        0x00000066,
+        // %x4 = OpPhi %v2half %x4_init %entry %x4_next %loop_continue
+        0x000700f5, 0x00000016, 0x0000006e, 0x00000054, 0x0000002d, 0x00000076,
+        0x00000066,
+        // %x5 = OpPhi %v2half %x5_init %entry %x5_next %loop_continue
+        0x000700f5, 0x00000016, 0x0000006f, 0x00000059, 0x0000002d, 0x00000077,
+        0x00000066,
+        // %x6 = OpPhi %v2half %x6_init %entry %x6_next %loop_continue
+        0x000700f5, 0x00000016, 0x00000070, 0x0000005e, 0x0000002d, 0x00000078,
+        0x00000066,
+        // %x7 = OpPhi %v2half %x7_init %entry %x7_next %loop_continue
+        0x000700f5, 0x00000016, 0x00000071, 0x00000063, 0x0000002d, 0x00000079,
+        0x00000066,
+        // %loop_cond = OpULessThan %bool %i %iterations
+        0x000500b0, 0x0000000a, 0x0000007a, 0x00000068, 0x00000031,
+        // OpLoopMerge %loop_merge %loop_continue None
+        0x000400f6, 0x00000067, 0x00000066, 0x00000000,
+        // OpBranchConditional %loop_cond %loop_body %loop_merge
+        0x000400fa, 0x0000007a, 0x00000065, 0x00000067,
+        // %loop_body = OpLabel
+        0x000200f8, 0x00000065,
+        // %x0_1 = OpExtInst %v2half %glsl Fma %x0 %a2 %b2
+        0x0008000c, 0x00000016, 0x0000007b, 0x00000001, 0x00000032, 0x0000006a,
+        0x0000003a, 0x0000003b,
+        // %x1_1 = OpExtInst %v2half %glsl Fma %x1 %a2 %b2
+        0x0008000c, 0x00000016, 0x0000007c, 0x00000001, 0x00000032, 0x0000006b,
+        0x0000003a, 0x0000003b,
+        // %x2_1 = OpExtInst %v2half %glsl Fma %x2 %a2 %b2
+        0x0008000c, 0x00000016, 0x0000007d, 0x00000001, 0x00000032, 0x0000006c,
+        0x0000003a, 0x0000003b,
+        // %x3_1 = OpExtInst %v2half %glsl Fma %x3 %a2 %b2
+        0x0008000c, 0x00000016, 0x0000007e, 0x00000001, 0x00000032, 0x0000006d,
+        0x0000003a, 0x0000003b,
+        // %x4_1 = OpExtInst %v2half %glsl Fma %x4 %a2 %b2
+        0x0008000c, 0x00000016, 0x0000007f, 0x00000001, 0x00000032, 0x0000006e,
+        0x0000003a, 0x0000003b,
+        // %x5_1 = OpExtInst %v2half %glsl Fma %x5 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000080, 0x00000001, 0x00000032, 0x0000006f,
+        0x0000003a, 0x0000003b,
+        // %x6_1 = OpExtInst %v2half %glsl Fma %x6 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000081, 0x00000001, 0x00000032, 0x00000070,
+        0x0000003a, 0x0000003b,
+        // %x7_1 = OpExtInst %v2half %glsl Fma %x7 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000082, 0x00000001, 0x00000032, 0x00000071,
+        0x0000003a, 0x0000003b,
+        // %x0_next = OpExtInst %v2half %glsl Fma %x0_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000072, 0x00000001, 0x00000032, 0x0000007b,
+        0x0000003a, 0x0000003b,
+        // %x1_next = OpExtInst %v2half %glsl Fma %x1_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000073, 0x00000001, 0x00000032, 0x0000007c,
+        0x0000003a, 0x0000003b,
+        // %x2_next = OpExtInst %v2half %glsl Fma %x2_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000074, 0x00000001, 0x00000032, 0x0000007d,
+        0x0000003a, 0x0000003b,
+        // %x3_next = OpExtInst %v2half %glsl Fma %x3_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000075, 0x00000001, 0x00000032, 0x0000007e,
+        0x0000003a, 0x0000003b,
+        // %x4_next = OpExtInst %v2half %glsl Fma %x4_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000076, 0x00000001, 0x00000032, 0x0000007f,
+        0x0000003a, 0x0000003b,
+        // %x5_next = OpExtInst %v2half %glsl Fma %x5_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000077, 0x00000001, 0x00000032, 0x00000080,
+        0x0000003a, 0x0000003b,
+        // %x6_next = OpExtInst %v2half %glsl Fma %x6_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000078, 0x00000001, 0x00000032, 0x00000081,
+        0x0000003a, 0x0000003b,
+        // %x7_next = OpExtInst %v2half %glsl Fma %x7_1 %a2 %b2
+        0x0008000c, 0x00000016, 0x00000079, 0x00000001, 0x00000032, 0x00000082,
+        0x0000003a, 0x0000003b,
+        // OpBranch %loop_continue
+        0x000200f9, 0x00000066,
+        // %loop_continue = OpLabel
+        0x000200f8, 0x00000066,
+        // %i_next = OpIAdd %uint %i %uint_1
+        0x00050080, 0x0000000b, 0x00000069, 0x00000068, 0x00000019,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000064,
+        // %loop_merge = OpLabel
+        0x000200f8, 0x00000067,
+        // %sum_1 = OpFAdd %v2half %x0 %x1
+        0x00050081, 0x00000016, 0x00000083, 0x0000006a, 0x0000006b,
+        // %sum_2 = OpFAdd %v2half %sum_1 %x2
+        0x00050081, 0x00000016, 0x00000084, 0x00000083, 0x0000006c,
+        // %sum_3 = OpFAdd %v2half %sum_2 %x3
+        0x00050081, 0x00000016, 0x00000085, 0x00000084, 0x0000006d,
+        // %sum_4 = OpFAdd %v2half %sum_3 %x4
+        0x00050081, 0x00000016, 0x00000086, 0x00000085, 0x0000006e,
+        // %sum_5 = OpFAdd %v2half %sum_4 %x5
+        0x00050081, 0x00000016, 0x00000087, 0x00000086, 0x0000006f,
+        // %sum_6 = OpFAdd %v2half %sum_5 %x6
+        0x00050081, 0x00000016, 0x00000088, 0x00000087, 0x00000070,
+        // %sum_7 = OpFAdd %v2half %sum_6 %x7
+        0x00050081, 0x00000016, 0x00000089, 0x00000088, 0x00000071,
+        // %sum_float = OpFConvert %v2float %sum_7
+        0x00040073, 0x00000017, 0x0000008a, 0x00000089,
+        // %sum_x = OpCompositeExtract %float %sum_float 0
+        0x00050051, 0x00000011, 0x0000008b, 0x0000008a, 0x00000000,
+        // %sum_y = OpCompositeExtract %float %sum_float 1
+        0x00050051, 0x00000011, 0x0000008c, 0x0000008a, 0x00000001,
+        // %sum = OpFAdd %float %sum_x %sum_y
+        0x00050081, 0x00000011, 0x0000008d, 0x0000008b, 0x0000008c,
+        // %sum_bits = OpBitcast %uint %sum
+        0x0004007c, 0x0000000b, 0x0000008e, 0x0000008d,
+        // %output_ptr = OpAccessChain %_ptr_Uniform_uint %output %uint_0 %gid
+        0x00060041, 0x00000010, 0x0000008f, 0x00000006, 0x00000018, 0x0000002f,
+        // OpStore %output_ptr %sum_bits
+        0x0003003e, 0x0000008f, 0x0000008e,
+        // OpReturn
+        0x000100fd,
+        // OpFunctionEnd
+        0x00010038,
+};
+
+// Int32 multiply-add throughput, 8 independent chains of 2 multiply-adds per iteration:
+//   layout(push_constant) uniform Constants { uint iterations; uint a; uint b; };
+//   uint x[8]; // x[k] = gl_GlobalInvocationID.x + k
+//   for (uint i = 0; i < iterations; i++)
+//       for (int k = 0; k < 8; k++) x[k] = (x[k] * a + b) * a + b;
+//   data[gl_GlobalInvocationID.x] = x[0] + ... + x[7];
+static const uint32_t kInt32MadKernelCode[] = {
+        // SPIR-V 1.0, bound 99
+        0x07230203, 0x00010000, 0x00000000, 0x00000063, 0x00000000,
+        // OpCapability Shader
+        0x00020011, 0x00000001,
+        // OpMemoryModel Logical GLSL450
+        0x0003000e, 0x00000000, 0x00000001,
+        // OpEntryPoint GLCompute %main "main" %gl_GlobalInvocationID
+        0x0006000f, 0x00000005, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+        // OpExecutionMode %main LocalSize 64 1 1
+        0x00060010, 0x00000001, 0x00000011, 0x00000040, 0x00000001, 0x00000001,
+        // OpDecorate %gl_GlobalInvocationID BuiltIn GlobalInvocationId
+        0x00040047, 0x00000002, 0x0000000b, 0x0000001c,
+        // OpDecorate %_runtimearr_uint ArrayStride 4
+        0x00040047, 0x00000003, 0x00000006, 0x00000004,
+        // OpMemberDecorate %Output 0 Offset 0
+        0x00050048, 0x00000004, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Output BufferBlock
+        0x00030047, 0x00000004, 0x00000003,
+        // OpDecorate %output DescriptorSet 0
+        0x00040047, 0x00000005, 0x00000022, 0x00000000,
+        // OpDecorate %output Binding 0
+        0x00040047, 0x00000005, 0x00000021, 0x00000000,
+        // OpMemberDecorate %Constants 0 Offset 0
+        0x00050048, 0x00000006, 0x00000000, 0x00000023, 0x00000000,
+        // OpMemberDecorate %Constants 1 Offset 4
+        0x00050048, 0x00000006, 0x00000001, 0x00000023, 0x00000004,
+        // OpMemberDecorate %Constants 2 Offset 8
+        0x00050048, 0x00000006, 0x00000002, 0x00000023, 0x00000008,
+        // OpDecorate %Constants Block
+        0x00030047, 0x00000006, 0x00000002,
+        // %void = OpTypeVoid
+        0x00020013, 0x00000007,
+        // %fn_void = OpTypeFunction %void
+        0x00030021, 0x00000008, 0x00000007,
+        // %bool = OpTypeBool
+        0x00020014, 0x00000009,
+        // %uint = OpTypeInt 32 0
+        0x00040015, 0x0000000a, 0x00000020, 0x00000000,
+        // %v3uint = OpTypeVector %uint 3
+        0x00040017, 0x0000000b, 0x0000000a, 0x00000003,
+        // %_ptr_Input_v3uint = OpTypePointer Input %v3uint
+        0x00040020, 0x0000000c, 0x00000001, 0x0000000b,
+        // %_ptr_Input_uint = OpTypePointer Input %uint
+        0x00040020, 0x0000000d, 0x00000001, 0x0000000a,
+        // %_runtimearr_uint = OpTypeRuntimeArray %uint
+        0x0003001d, 0x00000003, 0x0000000a,
+        // %Output = OpTypeStruct %_runtimearr_uint
+        0x0003001e, 0x00000004, 0x00000003,
+        // %_ptr_Uniform_Output = OpTypePointer Uniform %Output
+        0x00040020, 0x0000000e, 0x00000002, 0x00000004,
+        // %_ptr_Uniform_uint = OpTypePointer Uniform %uint
+        0x00040020, 0x0000000f, 0x00000002, 0x0000000a,
+        // %Constants = OpTypeStruct %uint %uint %uint
+        0x0005001e, 0x00000006, 0x0000000a, 0x0000000a, 0x0000000a,
+        // %_ptr_PushConstant_Constants = OpTypePointer PushConstant %Constants
+        0x00040020, 0x00000010, 0x00000009, 0x00000006,
+        // %_ptr_PushConstant_uint = OpTypePointer PushConstant %uint
+        0x00040020, 0x00000011, 0x00000009, 0x0000000a,
+        // %uint_0 = OpConstant %uint 0
+        0x0004002b, 0x0000000a, 0x00000012, 0x00000000,
+        // %uint_1 = OpConstant %uint 1
+        0x0004002b, 0x0000000a, 0x00000013, 0x00000001,
+        // %uint_2 = OpConstant %uint 2
+        0x0004002b, 0x0000000a, 0x00000014, 0x00000002,
+        // %uint_3 = OpConstant %uint 3
+        0x0004002b, 0x0000000a, 0x00000015, 0x00000003,
+        // %uint_4 = OpConstant %uint 4
+        0x0004002b, 0x0000000a, 0x00000016, 0x00000004,
+        // %uint_5 = OpConstant %uint 5
+        0x0004002b, 0x0000000a, 0x00000017, 0x00000005,
+        // %uint_6 = OpConstant %uint 6
+        0x0004002b, 0x0000000a, 0x00000018, 0x00000006,
+        // %uint_7 = OpConstant %uint 7
+        0x0004002b, 0x0000000a, 0x00000019, 0x00000007,
+        // %gl_GlobalInvocationID = OpVariable %_ptr_Input_v3uint Input
+        0x0004003b, 0x0000000c, 0x00000002, 0x00000001,
+        // %output = OpVariable %_ptr_Uniform_Output Uniform
+        0x0004003b, 0x0000000e, 0x00000005, 0x00000002,
+        // %constants = OpVariable %_ptr_PushConstant_Constants PushConstant
+        0x0004003b, 0x00000010, 0x0000001a, 0x00000009,
+        // %main = OpFunction %void None %fn_void
+        0x00050036, 0x00000007, 0x00000001, 0x00000000, 0x00000008,
+        // %entry = OpLabel
+        0x000200f8, 0x0000001b,
+        // %gid3 = OpLoad %v3uint %gl_GlobalInvocationID
+        0x0004003d, 0x0000000b, 0x0000001c, 0x00000002,
+        // %gid = OpCompositeExtract %uint %gid3 0
+        0x00050051, 0x0000000a, 0x0000001d, 0x0000001c, 0x00000000,
+        // %iterations_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_0
+        0x00050041, 0x00000011, 0x0000001e, 0x0000001a, 0x00000012,
+        // %iterations = OpLoad %uint %iterations_ptr
+        0x0004003d, 0x0000000a, 0x0000001f, 0x0000001e,
+        // %a_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_1
+        0x00050041, 0x00000011, 0x00000020, 0x0000001a, 0x00000013,
+        // %a = OpLoad %uint %a_ptr
+        0x0004003d, 0x0000000a, 0x00000021, 0x00000020,
+        // %b_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_2
+        0x00050041, 0x00000011, 0x00000022, 0x0000001a, 0x00000014,
+        // %b = OpLoad %uint %b_ptr
+        0x0004003d, 0x0000000a, 0x00000023, 0x00000022,
+        // %x0_init = OpIAdd %uint %gid %uint_0
+        0x00050080, 0x0000000a, 0x00000024, 0x0000001d, 0x00000012,
+        // %x1_init = OpIAdd %uint %gid %uint_1
+        0x00050080, 0x0000000a, 0x00000025, 0x0000001d, 0x00000013,
+        // %x2_init = OpIAdd %uint %gid %uint_2
+        0x00050080, 0x0000000a, 0x00000026, 0x0000001d, 0x00000014,
+        // %x3_init = OpIAdd %uint %gid %uint_3
+        0x00050080, 0x0000000a, 0x00000027, 0x0000001d, 0x00000015,
+        // %x4_init = OpIAdd %uint %gid %uint_4
+        0x00050080, 0x0000000a, 0x00000028, 0x0000001d, 0x00000016,
+        // %x5_init = OpIAdd %uint %gid %uint_5
+        0x00050080, 0x0000000a, 0x00000029, 0x0000001d, 0x00000017,
+        // %x6_init = OpIAdd %uint %gid %uint_6
+        0x00050080, 0x0000000a, 0x0000002a, 0x0000001d, 0x00000018,
+        // %x7_init = OpIAdd %uint %gid %uint_7
+        0x00050080, 0x0000000a, 0x0000002b, 0x0000001d, 0x00000019,
+        // OpBranch %loop_header
+        0x000200f9, 0x0000002c,
+        // %loop_header = OpLabel
+        0x000200f8, 0x0000002c,
+        // %i = OpPhi %uint %uint_0 %entry %i_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000030, 0x00000012, 0x0000001b, 0x00000031,
+        0x0000002e,
+        // %x0 = OpPhi %uint %x0_init %entry %x0_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000032, 0x00000024, 0x0000001b, 0x0000003a,
+        0x0000002e,
+        // %x1 = OpPhi %uint %x1_init %entry %x1_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000033, 0x00000025, 0x0000001b, 0x0000003b,
+        0x0000002e,
+        // %x2 = OpPhi %uint %x2_init %entry %x2_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000034, 0x00000026, 0x0000001b, 0x0000003c,
+        0x0000002e,
+        // %x3 = OpPhi %uint %x3_init %entry %x3_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000035, 0x00000027, 0x0000001b, 0x0000003d,
+        0x0000002e,
+        // %x4 = OpPhi %uint %x4_init %entry %x4_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000036, 0x00000028, 0x0000001b, 0x0000003e,
+        0x0000002e,
+        // %x5 = OpPhi %uint %x5_init %entry %x5_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000037, 0x00000029, 0x0000001b, 0x0000003f,
+        0x0000002e,
+        // %x6 = OpPhi %uint %x6_init %entry %x6_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000038, 0x0000002a, 0x0000001b, 0x00000040,
+        0x0000002e,
+        // %x7 = OpPhi %uint %x7_init %entry %x7_next %loop_continue
+        0x000700f5, 0x0000000a, 0x00000039, 0x0000002b, 0x0000001b, 0x00000041,
+        0x0000002e,
+        // %loop_cond = OpULessThan %bool %i %iterations
+        0x000500b0, 0x00000009, 0x00000042, 0x00000030, 0x0000001f,
+        // OpLoopMerge %loop_merge %loop_continue None
+        0x000400f6, 0x0000002f, 0x0000002e, 0x00000000,
+        // OpBranchConditional %loop_cond %loop_body %loop_merge
+        0x000400fa, 0x00000042, 0x0000002d, 0x0000002f,
+        // %loop_body = OpLabel
+        0x000200f8, 0x0000002d,
+        // %x0_mul_0 = OpIMul %uint %x0 %a
+        0x00050084, 0x0000000a, 0x00000043, 0x00000032, 0x00000021,
+        // %x0_1 = OpIAdd %uint %x0_mul_0 %b
+        0x00050080, 0x0000000a, 0x00000044, 0x00000043, 0x00000023,
+        // %x1_mul_0 = OpIMul %uint %x1 %a
+        0x00050084, 0x0000000a, 0x00000045, 0x00000033, 0x00000021,
+        // %x1_1 = OpIAdd %uint %x1_mul_0 %b
+        0x00050080, 0x0000000a, 0x00000046, 0x00000045, 0x00000023,
+        // %x2_mul_0 = OpIMul %uint %x2 %a
+        0x00050084, 0x0000000a, 0x00000047, 0x00000034, 0x00000021,
+        // %x2_1 = OpIAdd %uint %x2_mul_0 %b
+        0x00050080, 0x0000000a, 0x00000048, 0x00000047, 0x00000023,
+        // %x3_mul_0 = OpIMul %uint %x3 %a
+        0x00050084, 0x0000000a, 0x00000049, 0x00000035, 0x00000021,
+        // %x3_1 = OpIAdd %uint %x3_mul_0 %b
+        0x00050080, 0x0000000a, 0x0000004a, 0x00000049, 0x00000023,
+        // %x4_mul_0 = OpIMul %uint %x4 %a
+        0x00050084, 0x0000000a, 0x0000004b, 0x00000036, 0x00000021,
+        // %x4_1 = OpIAdd %uint %x4_mul_0 %b
+        0x00050080, 0x0000000a, 0x0000004c, 0x0000004b, 0x00000023,
+        // %x5_mul_0 = OpIMul %uint %x5 %a
+        0x00050084, 0x0000000a, 0x0000004d, 0x00000037, 0x00000021,
+        // %x5_1 = OpIAdd %uint %x5_mul_0 %b
+        0x00050080, 0x0000000a, 0x0000004e, 0x0000004d, 0x00000023,
+        // %x6_mul_0 = OpIMul %uint %x6 %a
+        0x00050084, 0x0000000a, 0x0000004f, 0x00000038, 0x00000021,
+        // %x6_1 = OpIAdd %uint %x6_mul_0 %b
+        0x00050080, 0x0000000a, 0x00000050, 0x0000004f, 0x00000023,
+        // %x7_mul_0 = OpIMul %uint %x7 %a
+        0x00050084, 0x0000000a, 0x00000051, 0x00000039, 0x00000021,
+        // %x7_1 = OpIAdd %uint %x7_mul_0 %b
+        0x00050080, 0x0000000a, 0x00000052, 0x00000051, 0x00000023,
+        // %x0_mul_1 = OpIMul %uint %x0_1 %a
+        0x00050084, 0x0000000a, 0x00000053, 0x00000044, 0x00000021,
+        // %x1_mul_1 = OpIMul %uint %x1_1 %a
+        0x00050084, 0x0000000a, 0x00000054, 0x00000046, 0x00000021,
+        // %x2_mul_1 = OpIMul %uint %x2_1 %a
+        0x00050084, 0x0000000a, 0x00000055, 0x00000048, 0x00000021,
+        // %x3_mul_1 = OpIMul %uint %x3_1 %a
+        0x00050084, 0x0000000a, 0x00000056, 0x0000004a, 0x00000021,
+        // %x4_mul_1 = OpIMul %uint %x4_1 %a
+        0x00050084, 0x0000000a, 0x00000057, 0x0000004c, 0x00000021,
+        // %x5_mul_1 = OpIMul %uint %x5_1 %a
+        0x00050084, 0x0000000a, 0x00000058, 0x0000004e, 0x00000021,
+        // %x6_mul_1 = OpIMul %uint %x6_1 %a
+        0x00050084, 0x0000000a, 0x00000059, 0x00000050, 0x00000021,
+        // %x7_mul_1 = OpIMul %uint %x7_1 %a
+        0x00050084, 0x0000000a, 0x0000005a, 0x00000052, 0x00000021,
+        // %x0_next = OpIAdd %uint %x0_mul_1 %b
+        0x00050080, 0x0000000a, 0x0000003a, 0x00000053, 0x00000023,
+        // %x1_next = OpIAdd %uint %x1_mul_1 %b
+        0x00050080, 0x0000000a, 0x0000003b, 0x00000054, 0x00000023,
+        // %x2_next = OpIAdd %uint %x2_mul_1 %b
+        0x00050080, 0x0000000a, 0x0000003c, 0x00000055, 0x00000023,
+        // %x3_next = OpIAdd %uint %x3_mul_1 %b
+        0x00050080, 0x0000000a, 0x0000003d, 0x00000056, 0x00000023,
+        // %x4_next = OpIAdd %uint %x4_mul_1 %b
+        0x00050080, 0x0000000a, 0x0000003e, 0x00000057, 0x00000023,
+        // %x5_next = OpIAdd %uint %x5_mul_1 %b
+        0x00050080, 0x0000000a, 0x0000003f, 0x00000058, 0x00000023,
+        // %x6_next = OpIAdd %uint %x6_mul_1 %b
+        0x00050080, 0x0000000a, 0x00000040, 0x00000059, 0x00000023,
+        // %x7_next = OpIAdd %uint %x7_mul_1 %b
+        0x00050080, 0x0000000a, 0x00000041, 0x0000005a, 0x00000023,
+        // OpBranch %loop_continue
+        0x000200f9, 0x0000002e,
+        // %loop_continue = OpLabel
+        0x000200f8, 0x0000002e,
+        // %i_next = OpIAdd %uint %i %uint_1
+        0x00050080, 0x0000000a, 0x00000031, 0x00000030, 0x00000013,
+        // OpBranch %loop_header
+        0x000200f9, 0x0000002c,
+        // %loop_merge = OpLabel
+        0x000200f8, 0x0000002f,
+        // %sum_1 = OpIAdd %uint %x0 %x1
+        0x00050080, 0x0000000a, 0x0000005b, 0x00000032, 0x00000033,
+        // %sum_2 = OpIAdd %uint %sum_1 %x2
+        0x00050080, 0x0000000a, 0x0000005c, 0x0000005b, 0x00000034,
+        // %sum_3 = OpIAdd %uint %sum_2 %x3
+        0x00050080, 0x0000000a, 0x0000005d, 0x0000005c, 0x00000035,
+        // %sum_4 = OpIAdd %uint %sum_3 %x4
+        0x00050080, 0x0000000a, 0x0000005e, 0x0000005d, 0x00000036,
+        // %sum_5 = OpIAdd %uint %sum_4 %x5
+        0x00050080, 0x0000000a, 0x0000005f, 0x0000005e, 0x00000037,
+        // %sum_6 = OpIAdd %uint %sum_5 %x6
+        0x00050080, 0x0000000a, 0x00000060, 0x0000005f, 0x00000038,
+        // %sum_7 = OpIAdd %uint %sum_6 %x7
+        0x00050080, 0x0000000a, 0x00000061, 0x00000060, 0x00000039,
+        // %output_ptr = OpAccessChain %_ptr_Uniform_uint %output %uint_0 %gid
+        0x00060041, 0x0000000f, 0x00000062, 0x00000005, 0x00000012, 0x0000001d,
+        // OpStore %output_ptr %sum_7
+        0x0003003e, 0x00000062, 0x00000061,
+        // OpReturn
+        0x000100fd,
+        // OpFunctionEnd
+        0x00010038,
+};
+
+// Shared memory read bandwidth, 8 16-byte loads per iteration, consecutive invocations reading
+// consecutive entries:
+//   layout(push_constant) uniform Constants { uint iterations; };
+//   uint lid = gl_LocalInvocationIndex;
+//   shared uvec4 tile[1024]; // 16 KiB, the minimum maxComputeSharedMemorySize
+//   for (uint j = 0; j < 16; j++) tile[lid + j * 64] = uvec4(lid + j * 64);
+//   barrier();
+//   uvec4 acc = uvec4(lid);
+//   for (uint i = 0; i < iterations; i++)
+//       for (uint k = 0; k < 8; k++) acc += tile[((i << 9) + lid + k * 64) & 1023];
+//   data[gl_GlobalInvocationID.x] = acc.x + acc.y + acc.z + acc.w;
+static const uint32_t kSharedMemoryKernelCode[] = {
+        // SPIR-V 1.0, bound 158
+        0x07230203, 0x00010000, 0x00000000, 0x0000009e, 0x00000000,
+        // OpCapability Shader
+        0x00020011, 0x00000001,
+        // OpMemoryModel Logical GLSL450
+        0x0003000e, 0x00000000, 0x00000001,
+        // OpEntryPoint GLCompute %main "main" %gl_GlobalInvocationID %gl_LocalInvocationIndex
+        0x0007000f, 0x00000005, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+        0x00000003,
+        // OpExecutionMode %main LocalSize 64 1 1
+        0x00060010, 0x00000001, 0x00000011, 0x00000040, 0x00000001, 0x00000001,
+        // OpDecorate %gl_GlobalInvocationID BuiltIn GlobalInvocationId
+        0x00040047, 0x00000002, 0x0000000b, 0x0000001c,
+        // OpDecorate %gl_LocalInvocationIndex BuiltIn LocalInvocationIndex
+        0x00040047, 0x00000003, 0x0000000b, 0x0000001d,
+        // OpDecorate %_runtimearr_uint ArrayStride 4
+        0x00040047, 0x00000004, 0x00000006, 0x00000004,
+        // OpMemberDecorate %Output 0 Offset 0
+        0x00050048, 0x00000005, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Output BufferBlock
+        0x00030047, 0x00000005, 0x00000003,
+        // OpDecorate %output DescriptorSet 0
+        0x00040047, 0x00000006, 0x00000022, 0x00000000,
+        // OpDecorate %output Binding 0
+        0x00040047, 0x00000006, 0x00000021, 0x00000000,
+        // OpMemberDecorate %Constants 0 Offset 0
+        0x00050048, 0x00000007, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Constants Block
+        0x00030047, 0x00000007, 0x00000002,
+        // %void = OpTypeVoid
+        0x00020013, 0x00000008,
+        // %fn_void = OpTypeFunction %void
+        0x00030021, 0x00000009, 0x00000008,
+        // %bool = OpTypeBool
+        0x00020014, 0x0000000a,
+        // %uint = OpTypeInt 32 0
+        0x00040015, 0x0000000b, 0x00000020, 0x00000000,
+        // %v3uint = OpTypeVector %uint 3
+        0x00040017, 0x0000000c, 0x0000000b, 0x00000003,
+        // %_ptr_Input_v3uint = OpTypePointer Input %v3uint
+        0x00040020, 0x0000000d, 0x00000001, 0x0000000c,
+        // %_ptr_Input_uint = OpTypePointer Input %uint
+        0x00040020, 0x0000000e, 0x00000001, 0x0000000b,
+        // %_runtimearr_uint = OpTypeRuntimeArray %uint
+        0x0003001d, 0x00000004, 0x0000000b,
+        // %Output = OpTypeStruct %_runtimearr_uint
+        0x0003001e, 0x00000005, 0x00000004,
+        // %_ptr_Uniform_Output = OpTypePointer Uniform %Output
+        0x00040020, 0x0000000f, 0x00000002, 0x00000005,
+        // %_ptr_Uniform_uint = OpTypePointer Uniform %uint
+        0x00040020, 0x00000010, 0x00000002, 0x0000000b,
+        // %Constants = OpTypeStruct %uint
+        0x0003001e, 0x00000007, 0x0000000b,
+        // %_ptr_PushConstant_Constants = OpTypePointer PushConstant %Constants
+        0x00040020, 0x00000011, 0x00000009, 0x00000007,
+        // %_ptr_PushConstant_uint = OpTypePointer PushConstant %uint
+        0x00040020, 0x00000012, 0x00000009, 0x0000000b,
+        // %v4uint = OpTypeVector %uint 4
+        0x00040017, 0x00000013, 0x0000000b, 0x00000004,
+        // %uint_0 = OpConstant %uint 0
+        0x0004002b, 0x0000000b, 0x00000014, 0x00000000,
+        // %uint_1 = OpConstant %uint 1
+        0x0004002b, 0x0000000b, 0x00000015, 0x00000001,
+        // %uint_2 = OpConstant %uint 2
+        0x0004002b, 0x0000000b, 0x00000016, 0x00000002,
+        // %uint_9 = OpConstant %uint 9
+        0x0004002b, 0x0000000b, 0x00000017, 0x00000009,
+        // %uint_264 = OpConstant %uint 264
+        0x0004002b, 0x0000000b, 0x00000018, 0x00000108,
+        // %uint_1023 = OpConstant %uint 1023
+        0x0004002b, 0x0000000b, 0x00000019, 0x000003ff,
+        // %uint_1024 = OpConstant %uint 1024
+        0x0004002b, 0x0000000b, 0x0000001a, 0x00000400,
+        // %uint_64 = OpConstant %uint 64
+        0x0004002b, 0x0000000b, 0x0000001b, 0x00000040,
+        // %uint_128 = OpConstant %uint 128
+        0x0004002b, 0x0000000b, 0x0000001c, 0x00000080,
+        // %uint_192 = OpConstant %uint 192
+        0x0004002b, 0x0000000b, 0x0000001d, 0x000000c0,
+        // %uint_256 = OpConstant %uint 256
+        0x0004002b, 0x0000000b, 0x0000001e, 0x00000100,
+        // %uint_320 = OpConstant %uint 320
+        0x0004002b, 0x0000000b, 0x0000001f, 0x00000140,
+        // %uint_384 = OpConstant %uint 384
+        0x0004002b, 0x0000000b, 0x00000020, 0x00000180,
+        // %uint_448 = OpConstant %uint 448
+        0x0004002b, 0x0000000b, 0x00000021, 0x000001c0,
+        // %uint_512 = OpConstant %uint 512
+        0x0004002b, 0x0000000b, 0x00000022, 0x00000200,
+        // %uint_576 = OpConstant %uint 576
+        0x0004002b, 0x0000000b, 0x00000023, 0x00000240,
+        // %uint_640 = OpConstant %uint 640
+        0x0004002b, 0x0000000b, 0x00000024, 0x00000280,
+        // %uint_704 = OpConstant %uint 704
+        0x0004002b, 0x0000000b, 0x00000025, 0x000002c0,
+        // %uint_768 = OpConstant %uint 768
+        0x0004002b, 0x0000000b, 0x00000026, 0x00000300,
+        // %uint_832 = OpConstant %uint 832
+        0x0004002b, 0x0000000b, 0x00000027, 0x00000340,
+        // %uint_896 = OpConstant %uint 896
+        0x0004002b, 0x0000000b, 0x00000028, 0x00000380,
+        // %uint_960 = OpConstant %uint 960
+        0x0004002b, 0x0000000b, 0x00000029, 0x000003c0,
+        // %_arr_v4uint_uint_1024 = OpTypeArray %v4uint %uint_1024
+        0x0004001c, 0x0000002a, 0x00000013, 0x0000001a,
+        // %_ptr_Workgroup_arr = OpTypePointer Workgroup %_arr_v4uint_uint_1024
+        0x00040020, 0x0000002b, 0x00000004, 0x0000002a,
+        // %_ptr_Workgroup_v4uint = OpTypePointer Workgroup %v4uint
+        0x00040020, 0x0000002c, 0x00000004, 0x00000013,
+        // %gl_GlobalInvocationID = OpVariable %_ptr_Input_v3uint Input
+        0x0004003b, 0x0000000d, 0x00000002, 0x00000001,
+        // %gl_LocalInvocationIndex = OpVariable %_ptr_Input_uint Input
+        0x0004003b, 0x0000000e, 0x00000003, 0x00000001,
+        // %output = OpVariable %_ptr_Uniform_Output Uniform
+        0x0004003b, 0x0000000f, 0x00000006, 0x00000002,
+        // %constants = OpVariable %_ptr_PushConstant_Constants PushConstant
+        0x0004003b, 0x00000011, 0x0000002d, 0x00000009,
+        // %tile = OpVariable %_ptr_Workgroup_arr Workgroup
+        0x0004003b, 0x0000002b, 0x0000002e, 0x00000004,
+        // %main = OpFunction %void None %fn_void
+        0x00050036, 0x00000008, 0x00000001, 0x00000000, 0x00000009,
+        // %entry = OpLabel
+        0x000200f8, 0x0000002f,
+        // %gid3 = OpLoad %v3uint %gl_GlobalInvocationID
+        0x0004003d, 0x0000000c, 0x00000030, 0x00000002,
+        // %gid = OpCompositeExtract %uint %gid3 0
+        0x00050051, 0x0000000b, 0x00000031, 0x00000030, 0x00000000,
+        // %iterations_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_0
+        0x00050041, 0x00000012, 0x00000032, 0x0000002d, 0x00000014,
+        // %iterations = OpLoad %uint %iterations_ptr
+        0x0004003d, 0x0000000b, 0x00000033, 0x00000032,
+        // %lid = OpLoad %uint %gl_LocalInvocationIndex
+        0x0004003d, 0x0000000b, 0x00000034, 0x00000003,
+        // %init_value_0 = OpCompositeConstruct %v4uint %lid %lid %lid %lid
+        0x00070050, 0x00000013, 0x00000035, 0x00000034, 0x00000034, 0x00000034,
+        0x00000034,
+        // %init_ptr_0 = OpAccessChain %_ptr_Workgroup_v4uint %tile %lid
+        0x00050041, 0x0000002c, 0x00000036, 0x0000002e, 0x00000034,
+        // OpStore %init_ptr_0 %init_value_0
+        0x0003003e, 0x00000036, 0x00000035,
+        // %init_1 = OpIAdd %uint %lid %uint_64
+        0x00050080, 0x0000000b, 0x00000037, 0x00000034, 0x0000001b,
+        // %init_value_1 = OpCompositeConstruct %v4uint %init_1 %init_1 %init_1 %init_1
+        0x00070050, 0x00000013, 0x00000038, 0x00000037, 0x00000037, 0x00000037,
+        0x00000037,
+        // %init_ptr_1 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_1
+        0x00050041, 0x0000002c, 0x00000039, 0x0000002e, 0x00000037,
+        // OpStore %init_ptr_1 %init_value_1
+        0x0003003e, 0x00000039, 0x00000038,
+        // %init_2 = OpIAdd %uint %lid %uint_128
+        0x00050080, 0x0000000b, 0x0000003a, 0x00000034, 0x0000001c,
+        // %init_value_2 = OpCompositeConstruct %v4uint %init_2 %init_2 %init_2 %init_2
+        0x00070050, 0x00000013, 0x0000003b, 0x0000003a, 0x0000003a, 0x0000003a,
+        0x0000003a,
+        // %init_ptr_2 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_2
+        0x00050041, 0x0000002c, 0x0000003c, 0x0000002e, 0x0000003a,
+        // OpStore %init_ptr_2 %init_value_2
+        0x0003003e, 0x0000003c, 0x0000003b,
+        // %init_3 = OpIAdd %uint %lid %uint_192
+        0x00050080, 0x0000000b, 0x0000003d, 0x00000034, 0x0000001d,
+        // %init_value_3 = OpCompositeConstruct %v4uint %init_3 %init_3 %init_3 %init_3
+        0x00070050, 0x00000013, 0x0000003e, 0x0000003d, 0x0000003d, 0x0000003d,
+        0x0000003d,
+        // %init_ptr_3 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_3
+        0x00050041, 0x0000002c, 0x0000003f, 0x0000002e, 0x0000003d,
+        // OpStore %init_ptr_3 %init_value_3
+        0x0003003e, 0x0000003f, 0x0000003e,
+        // %init_4 = OpIAdd %uint %lid %uint_256
+        0x00050080, 0x0000000b, 0x00000040, 0x00000034, 0x0000001e,
+        // %init_value_4 = OpCompositeConstruct %v4uint %init_4 %init_4 %init_4 %init_4
+        0x00070050, 0x00000013, 0x00000041, 0x00000040, 0x00000040, 0x00000040,
+        0x00000040,
+        // %init_ptr_4 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_4
+        0x00050041, 0x0000002c, 0x00000042, 0x0000002e, 0x00000040,
+        // OpStore %init_ptr_4 %init_value_4
+        0x0003003e, 0x00000042, 0x00000041,
+        // %init_5 = OpIAdd %uint %lid %uint_320
+        0x00050080, 0x0000000b, 0x00000043, 0x00000034, 0x0000001f,
+        // %init_value_5 = OpCompositeConstruct %v4uint %init_5 %init_5 %init_5 %init_5
+        0x00070050, 0x00000013, 0x00000044, 0x00000043, 0x00000043, 0x00000043,
+        0x00000043,
+        // %init_ptr_5 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_5
+        0x00050041, 0x0000002c, 0x00000045, 0x0000002e, 0x00000043,
+        // OpStore %init_ptr_5 %init_value_5
+        0x0003003e, 0x00000045, 0x00000044,
+        // %init_6 = OpIAdd %uint %lid %uint_384
+        0x00050080, 0x0000000b, 0x00000046, 0x00000034, 0x00000020,
+        // %init_value_6 = OpCompositeConstruct %v4uint %init_6 %init_6 %init_6 %init_6
+        0x00070050, 0x00000013, 0x00000047, 0x00000046, 0x00000046, 0x00000046,
+        0x00000046,
+        // %init_ptr_6 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_6
+        0x00050041, 0x0000002c, 0x00000048, 0x0000002e, 0x00000046,
+        // OpStore %init_ptr_6 %init_value_6
+        0x0003003e, 0x00000048, 0x00000047,
+        // %init_7 = OpIAdd %uint %lid %uint_448
+        0x00050080, 0x0000000b, 0x00000049, 0x00000034, 0x00000021,
+        // %init_value_7 = OpCompositeConstruct %v4uint %init_7 %init_7 %init_7 %init_7
+        0x00070050, 0x00000013, 0x0000004a, 0x00000049, 0x00000049, 0x00000049,
+        0x00000049,
+        // %init_ptr_7 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_7
+        0x00050041, 0x0000002c, 0x0000004b, 0x0000002e, 0x00000049,
+        // OpStore %init_ptr_7 %init_value_7
+        0x0003003e, 0x0000004b, 0x0000004a,
+        // %init_8 = OpIAdd %uint %lid %uint_512
+        0x00050080, 0x0000000b, 0x0000004c, 0x00000034, 0x00000022,
+        // %init_value_8 = OpCompositeConstruct %v4uint %init_8 %init_8 %init_8 %init_8
+        0x00070050, 0x00000013, 0x0000004d, 0x0000004c, 0x0000004c, 0x0000004c,
+        0x0000004c,
+        // %init_ptr_8 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_8
+        0x00050041, 0x0000002c, 0x0000004e, 0x0000002e, 0x0000004c,
+        // OpStore %init_ptr_8 %init_value_8
+        0x0003003e, 0x0000004e, 0x0000004d,
+        // %init_9 = OpIAdd %uint %lid %uint_576
+        0x00050080, 0x0000000b, 0x0000004f, 0x00000034, 0x00000023,
+        // %init_value_9 = OpCompositeConstruct %v4uint %init_9 %init_9 %init_9 %init_9
+        0x00070050, 0x00000013, 0x00000050, 0x0000004f, 0x0000004f, 0x0000004f,
+        0x0000004f,
+        // %init_ptr_9 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_9
+        0x00050041, 0x0000002c, 0x00000051, 0x0000002e, 0x0000004f,
+        // OpStore %init_ptr_9 %init_value_9
+        0x0003003e, 0x00000051, 0x00000050,
+        // %init_10 = OpIAdd %uint %lid %uint_640
+        0x00050080, 0x0000000b, 0x00000052, 0x00000034, 0x00000024,
+        // %init_value_10 = OpCompositeConstruct %v4uint %init_10 %init_10 %init_10 %init_10
+        0x00070050, 0x00000013, 0x00000053, 0x00000052, 0x00000052, 0x00000052,
+        0x00000052,
+        // %init_ptr_10 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_10
+        0x00050041, 0x0000002c, 0x00000054, 0x0000002e, 0x00000052,
+        // OpStore %init_ptr_10 %init_value_10
+        0x0003003e, 0x00000054, 0x00000053,
+        // %init_11 = OpIAdd %uint %lid %uint_704
+        0x00050080, 0x0000000b, 0x00000055, 0x00000034, 0x00000025,
+        // %init_value_11 = OpCompositeConstruct %v4uint %init_11 %init_11 %init_11 %init_11
+        0x00070050, 0x00000013, 0x00000056, 0x00000055, 0x00000055, 0x00000055,
+        0x00000055,
+        // %init_ptr_11 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_11
+        0x00050041, 0x0000002c, 0x00000057, 0x0000002e, 0x00000055,
+        // OpStore %init_ptr_11 %init_value_11
+        0x0003003e, 0x00000057, 0x00000056,
+        // %init_12 = OpIAdd %uint %lid %uint_768
+        0x00050080, 0x0000000b, 0x00000058, 0x00000034, 0x00000026,
+        // %init_value_12 = OpCompositeConstruct %v4uint %init_12 %init_12 %init_12 %init_12
+        0x00070050, 0x00000013, 0x00000059, 0x00000058, 0x00000058, 0x00000058,
+        0x00000058,
+        // %init_ptr_12 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_12
+        0x00050041, 0x0000002c, 0x0000005a, 0x0000002e, 0x00000058,
+        // OpStore %init_ptr_12 %init_value_12
+        0x0003003e, 0x0000005a, 0x00000059,
+        // %init_13 = OpIAdd %uint %lid %uint_832
+        0x00050080, 0x0000000b, 0x0000005b, 0x00000034, 0x00000027,
+        // %init_value_13 = OpCompositeConstruct %v4uint %init_13 %init_13 %init_13 %init_13
+        0x00070050, 0x00000013, 0x0000005c, 0x0000005b, 0x0000005b, 0x0000005b,
+        0x0000005b,
+        // %init_ptr_13 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_13
+        0x00050041, 0x0000002c, 0x0000005d, 0x0000002e, 0x0000005b,
+        // OpStore %init_ptr_13 %init_value_13
+        0x0003003e, 0x0000005d, 0x0000005c,
+        // %init_14 = OpIAdd %uint %lid %uint_896
+        0x00050080, 0x0000000b, 0x0000005e, 0x00000034, 0x00000028,
+        // %init_value_14 = OpCompositeConstruct %v4uint %init_14 %init_14 %init_14 %init_14
+        0x00070050, 0x00000013, 0x0000005f, 0x0000005e, 0x0000005e, 0x0000005e,
+        0x0000005e,
+        // %init_ptr_14 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_14
+        0x00050041, 0x0000002c, 0x00000060, 0x0000002e, 0x0000005e,
+        // OpStore %init_ptr_14 %init_value_14
+        0x0003003e, 0x00000060, 0x0000005f,
+        // %init_15 = OpIAdd %uint %lid %uint_960
+        0x00050080, 0x0000000b, 0x00000061, 0x00000034, 0x00000029,
+        // %init_value_15 = OpCompositeConstruct %v4uint %init_15 %init_15 %init_15 %init_15
+        0x00070050, 0x00000013, 0x00000062, 0x00000061, 0x00000061, 0x00000061,
+        0x00000061,
+        // %init_ptr_15 = OpAccessChain %_ptr_Workgroup_v4uint %tile %init_15
+        0x00050041, 0x0000002c, 0x00000063, 0x0000002e, 0x00000061,
+        // OpStore %init_ptr_15 %init_value_15
+        0x0003003e, 0x00000063, 0x00000062,
+        // OpControlBarrier %uint_2 %uint_2 %uint_264
+        0x000400e0, 0x00000016, 0x00000016, 0x00000018,
+        // %acc_init = OpCompositeConstruct %v4uint %lid %lid %lid %lid
+        0x00070050, 0x00000013, 0x00000064, 0x00000034, 0x00000034, 0x00000034,
+        0x00000034,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000065,
+        // %loop_header = OpLabel
+        0x000200f8, 0x00000065,
+        // %i = OpPhi %uint %uint_0 %entry %i_next %loop_continue
+        0x000700f5, 0x0000000b, 0x00000069, 0x00000014, 0x0000002f, 0x0000006a,
+        0x00000067,
+        // %acc = OpPhi %v4uint %acc_init %entry %acc_next %loop_continue
+        0x000700f5, 0x00000013, 0x0000006b, 0x00000064, 0x0000002f, 0x0000006c,
+        0x00000067,
+        // %loop_cond = OpULessThan %bool %i %iterations
+        0x000500b0, 0x0000000a, 0x0000006d, 0x00000069, 0x00000033,
+        // OpLoopMerge %loop_merge %loop_continue None
+        0x000400f6, 0x00000068, 0x00000067, 0x00000000,
+        // OpBranchConditional %loop_cond %loop_body %loop_merge
+        0x000400fa, 0x0000006d, 0x00000066, 0x00000068,
+        // %loop_body = OpLabel
+        0x000200f8, 0x00000066,
+        // %row_base = OpShiftLeftLogical %uint %i %uint_9
+        0x000500c4, 0x0000000b, 0x0000006e, 0x00000069, 0x00000017,
+        // %row_offset = OpIAdd %uint %row_base %lid
+        0x00050080, 0x0000000b, 0x0000006f, 0x0000006e, 0x00000034,
+        // %index_0 = OpBitwiseAnd %uint %row_offset %uint_1023
+        0x000500c7, 0x0000000b, 0x00000070, 0x0000006f, 0x00000019,
+        // %ptr_0 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_0
+        0x00050041, 0x0000002c, 0x00000071, 0x0000002e, 0x00000070,
+        // %value_0 = OpLoad %v4uint %ptr_0
+        0x0004003d, 0x00000013, 0x00000072, 0x00000071,
+        // %acc_1 = OpIAdd %v4uint %acc %value_0
+        0x00050080, 0x00000013, 0x00000073, 0x0000006b, 0x00000072,
+        // %offset_1 = OpIAdd %uint %row_offset %uint_64
+        0x00050080, 0x0000000b, 0x00000074, 0x0000006f, 0x0000001b,
+        // %index_1 = OpBitwiseAnd %uint %offset_1 %uint_1023
+        0x000500c7, 0x0000000b, 0x00000075, 0x00000074, 0x00000019,
+        // %ptr_1 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_1
+        0x00050041, 0x0000002c, 0x00000076, 0x0000002e, 0x00000075,
+        // %value_1 = OpLoad %v4uint %ptr_1
+        0x0004003d, 0x00000013, 0x00000077, 0x00000076,
+        // %acc_2 = OpIAdd %v4uint %acc_1 %value_1
+        0x00050080, 0x00000013, 0x00000078, 0x00000073, 0x00000077,
+        // %offset_2 = OpIAdd %uint %row_offset %uint_128
+        0x00050080, 0x0000000b, 0x00000079, 0x0000006f, 0x0000001c,
+        // %index_2 = OpBitwiseAnd %uint %offset_2 %uint_1023
+        0x000500c7, 0x0000000b, 0x0000007a, 0x00000079, 0x00000019,
+        // %ptr_2 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_2
+        0x00050041, 0x0000002c, 0x0000007b, 0x0000002e, 0x0000007a,
+        // %value_2 = OpLoad %v4uint %ptr_2
+        0x0004003d, 0x00000013, 0x0000007c, 0x0000007b,
+        // %acc_3 = OpIAdd %v4uint %acc_2 %value_2
+        0x00050080, 0x00000013, 0x0000007d, 0x00000078, 0x0000007c,
+        // %offset_3 = OpIAdd %uint %row_offset %uint_192
+        0x00050080, 0x0000000b, 0x0000007e, 0x0000006f, 0x0000001d,
+        // %index_3 = OpBitwiseAnd %uint %offset_3 %uint_1023
+        0x000500c7, 0x0000000b, 0x0000007f, 0x0000007e, 0x00000019,
+        // %ptr_3 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_3
+        0x00050041, 0x0000002c, 0x00000080, 0x0000002e, 0x0000007f,
+        // %value_3 = OpLoad %v4uint %ptr_3
+        0x0004003d, 0x00000013, 0x00000081, 0x00000080,
+        // %acc_4 = OpIAdd %v4uint %acc_3 %value_3
+        0x00050080, 0x00000013, 0x00000082, 0x0000007d, 0x00000081,
+        // %offset_4 = OpIAdd %uint %row_offset %uint_256
+        0x00050080, 0x0000000b, 0x00000083, 0x0000006f, 0x0000001e,
+        // %index_4 = OpBitwiseAnd %uint %offset_4 %uint_1023
+        0x000500c7, 0x0000000b, 0x00000084, 0x00000083, 0x00000019,
+        // %ptr_4 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_4
+        0x00050041, 0x0000002c, 0x00000085, 0x0000002e, 0x00000084,
+        // %value_4 = OpLoad %v4uint %ptr_4
+        0x0004003d, 0x00000013, 0x00000086, 0x00000085,
+        // %acc_5 = OpIAdd %v4uint %acc_4 %value_4
+        0x00050080, 0x00000013, 0x00000087, 0x00000082, 0x00000086,
+        // %offset_5 = OpIAdd %uint %row_offset %uint_320
+        0x00050080, 0x0000000b, 0x00000088, 0x0000006f, 0x0000001f,
+        // %index_5 = OpBitwiseAnd %uint %offset_5 %uint_1023
+        0x000500c7, 0x0000000b, 0x00000089, 0x00000088, 0x00000019,
+        // %ptr_5 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_5
+        0x00050041, 0x0000002c, 0x0000008a, 0x0000002e, 0x00000089,
+        // %value_5 = OpLoad %v4uint %ptr_5
+        0x0004003d, 0x00000013, 0x0000008b, 0x0000008a,
+        // %acc_6 = OpIAdd %v4uint %acc_5 %value_5
+        0x00050080, 0x00000013, 0x0000008c, 0x00000087, 0x0000008b,
+        // %offset_6 = OpIAdd %uint %row_offset %uint_384
+        0x00050080, 0x0000000b, 0x0000008d, 0x0000006f, 0x00000020,
+        // %index_6 = OpBitwiseAnd %uint %offset_6 %uint_1023
+        0x000500c7, 0x0000000b, 0x0000008e, 0x0000008d, 0x00000019,
+        // %ptr_6 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_6
+        0x00050041, 0x0000002c, 0x0000008f, 0x0000002e, 0x0000008e,
+        // %value_6 = OpLoad %v4uint %ptr_6
+        0x0004003d, 0x00000013, 0x00000090, 0x0000008f,
+        // %acc_7 = OpIAdd %v4uint %acc_6 %value_6
+        0x00050080, 0x00000013, 0x00000091, 0x0000008c, 0x00000090,
+        // %offset_7 = OpIAdd %uint %row_offset %uint_448
+        0x00050080, 0x0000000b, 0x00000092, 0x0000006f, 0x00000021,
+        // %index_7 = OpBitwiseAnd %uint %offset_7 %uint_1023
+        0x000500c7, 0x0000000b, 0x00000093, 0x00000092, 0x00000019,
+        // %ptr_7 = OpAccessChain %_ptr_Workgroup_v4uint %tile %index_7
+        0x00050041, 0x0000002c, 0x00000094, 0x0000002e, 0x00000093,
+        // %value_7 = OpLoad %v4uint %ptr_7
+        0x0004003d, 0x00000013, 0x00000095, 0x00000094,
+        // %acc_next = OpIAdd %v4uint %acc_7 %value_7
+        0x00050080, 0x00000013, 0x0000006c, 0x00000091, 0x00000095,
+        // OpBranch %loop_continue
+        0x000200f9, 0x00000067,
+        // %loop_continue = OpLabel
+        0x000200f8, 0x00000067,
+        // %i_next = OpIAdd %uint %i %uint_1
+        0x00050080, 0x0000000b, 0x0000006a, 0x00000069, 0x00000015,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000065,
+        // %loop_merge = OpLabel
+        0x000200f8, 0x00000068,
+        // %acc_x = OpCompositeExtract %uint %acc 0
+        0x00050051, 0x0000000b, 0x00000096, 0x0000006b, 0x00000000,
+        // %acc_y = OpCompositeExtract %uint %acc 1
+        0x00050051, 0x0000000b, 0x00000097, 0x0000006b, 0x00000001,
+        // %acc_z = OpCompositeExtract %uint %acc 2
+        0x00050051, 0x0000000b, 0x00000098, 0x0000006b, 0x00000002,
+        // %acc_w = OpCompositeExtract %uint %acc 3
+        0x00050051, 0x0000000b, 0x00000099, 0x0000006b, 0x00000003,
+        // %sum_xy = OpIAdd %uint %acc_x %acc_y
+        0x00050080, 0x0000000b, 0x0000009a, 0x00000096, 0x00000097,
+        // %sum_xyz = OpIAdd %uint %sum_xy %acc_z
+        0x00050080, 0x0000000b, 0x0000009b, 0x0000009a, 0x00000098,
+        // %sum = OpIAdd %uint %sum_xyz %acc_w
+        0x00050080, 0x0000000b, 0x0000009c, 0x0000009b, 0x00000099,
+        // %output_ptr = OpAccessChain %_ptr_Uniform_uint %output %uint_0 %gid
+        0x00060041, 0x00000010, 0x0000009d, 0x00000006, 0x00000014, 0x00000031,
+        // OpStore %output_ptr %sum
+        0x0003003e, 0x0000009d, 0x0000009c,
+        // OpReturn
+        0x000100fd,
+        // OpFunctionEnd
+        0x00010038,
+};
+
+// Subgroup reduction throughput, 4 independent chains of 2 reductions per iteration. SPIR-V 1.3,
+// needs Vulkan 1.1 and the arithmetic subgroup operations in compute shaders:
+//   layout(push_constant) uniform Constants { uint iterations; };
+//   uint lid = gl_LocalInvocationIndex;
+//   uint x[4]; // x[k] = gl_GlobalInvocationID.x + k
+//   for (uint i = 0; i < iterations; i++)
+//       for (int k = 0; k < 4; k++) x[k] = subgroupAdd(subgroupAdd(x[k] + lid) + lid);
+//   data[gl_GlobalInvocationID.x] = x[0] + ... + x[3];
+static const uint32_t kSubgroupAddKernelCode[] = {
+        // SPIR-V 1.3, bound 65
+        0x07230203, 0x00010300, 0x00000000, 0x00000041, 0x00000000,
+        // OpCapability Shader
+        0x00020011, 0x00000001,
+        // OpCapability GroupNonUniform
+        0x00020011, 0x0000003d,
+        // OpCapability GroupNonUniformArithmetic
+        0x00020011, 0x0000003f,
+        // OpMemoryModel Logical GLSL450
+        0x0003000e, 0x00000000, 0x00000001,
+        // OpEntryPoint GLCompute %main "main" %gl_GlobalInvocationID %gl_LocalInvocationIndex
+        0x0007000f, 0x00000005, 0x00000001, 0x6e69616d, 0x00000000, 0x00000002,
+        0x00000003,
+        // OpExecutionMode %main LocalSize 64 1 1
+        0x00060010, 0x00000001, 0x00000011, 0x00000040, 0x00000001, 0x00000001,
+        // OpDecorate %gl_GlobalInvocationID BuiltIn GlobalInvocationId
+        0x00040047, 0x00000002, 0x0000000b, 0x0000001c,
+        // OpDecorate %gl_LocalInvocationIndex BuiltIn LocalInvocationIndex
+        0x00040047, 0x00000003, 0x0000000b, 0x0000001d,
+        // OpDecorate %_runtimearr_uint ArrayStride 4
+        0x00040047, 0x00000004, 0x00000006, 0x00000004,
+        // OpMemberDecorate %Output 0 Offset 0
+        0x00050048, 0x00000005, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Output BufferBlock
+        0x00030047, 0x00000005, 0x00000003,
+        // OpDecorate %output DescriptorSet 0
+        0x00040047, 0x00000006, 0x00000022, 0x00000000,
+        // OpDecorate %output Binding 0
+        0x00040047, 0x00000006, 0x00000021, 0x00000000,
+        // OpMemberDecorate %Constants 0 Offset 0
+        0x00050048, 0x00000007, 0x00000000, 0x00000023, 0x00000000,
+        // OpDecorate %Constants Block
+        0x00030047, 0x00000007, 0x00000002,
+        // %void = OpTypeVoid
+        0x00020013, 0x00000008,
+        // %fn_void = OpTypeFunction %void
+        0x00030021, 0x00000009, 0x00000008,
+        // %bool = OpTypeBool
+        0x00020014, 0x0000000a,
+        // %uint = OpTypeInt 32 0
+        0x00040015, 0x0000000b, 0x00000020, 0x00000000,
+        // %v3uint = OpTypeVector %uint 3
+        0x00040017, 0x0000000c, 0x0000000b, 0x00000003,
+        // %_ptr_Input_v3uint = OpTypePointer Input %v3uint
+        0x00040020, 0x0000000d, 0x00000001, 0x0000000c,
+        // %_ptr_Input_uint = OpTypePointer Input %uint
+        0x00040020, 0x0000000e, 0x00000001, 0x0000000b,
+        // %_runtimearr_uint = OpTypeRuntimeArray %uint
+        0x0003001d, 0x00000004, 0x0000000b,
+        // %Output = OpTypeStruct %_runtimearr_uint
+        0x0003001e, 0x00000005, 0x00000004,
+        // %_ptr_Uniform_Output = OpTypePointer Uniform %Output
+        0x00040020, 0x0000000f, 0x00000002, 0x00000005,
+        // %_ptr_Uniform_uint = OpTypePointer Uniform %uint
+        0x00040020, 0x00000010, 0x00000002, 0x0000000b,
+        // %Constants = OpTypeStruct %uint
+        0x0003001e, 0x00000007, 0x0000000b,
+        // %_ptr_PushConstant_Constants = OpTypePointer PushConstant %Constants
+        0x00040020, 0x00000011, 0x00000009, 0x00000007,
+        // %_ptr_PushConstant_uint = OpTypePointer PushConstant %uint
+        0x00040020, 0x00000012, 0x00000009, 0x0000000b,
+        // %uint_0 = OpConstant %uint 0
+        0x0004002b, 0x0000000b, 0x00000013, 0x00000000,
+        // %uint_1 = OpConstant %uint 1
+        0x0004002b, 0x0000000b, 0x00000014, 0x00000001,
+        // %uint_2 = OpConstant %uint 2
+        0x0004002b, 0x0000000b, 0x00000015, 0x00000002,
+        // %uint_3 = OpConstant %uint 3
+        0x0004002b, 0x0000000b, 0x00000016, 0x00000003,
+        // %gl_GlobalInvocationID = OpVariable %_ptr_Input_v3uint Input
+        0x0004003b, 0x0000000d, 0x00000002, 0x00000001,
+        // %gl_LocalInvocationIndex = OpVariable %_ptr_Input_uint Input
+        0x0004003b, 0x0000000e, 0x00000003, 0x00000001,
+        // %output = OpVariable %_ptr_Uniform_Output Uniform
+        0x0004003b, 0x0000000f, 0x00000006, 0x00000002,
+        // %constants = OpVariable %_ptr_PushConstant_Constants PushConstant
+        0x0004003b, 0x00000011, 0x00000017, 0x00000009,
+        // %main = OpFunction %void None %fn_void
+        0x00050036, 0x00000008, 0x00000001, 0x00000000, 0x00000009,
+        // %entry = OpLabel
+        0x000200f8, 0x00000018,
+        // %gid3 = OpLoad %v3uint %gl_GlobalInvocationID
+        0x0004003d, 0x0000000c, 0x00000019, 0x00000002,
+        // %gid = OpCompositeExtract %uint %gid3 0
+        0x00050051, 0x0000000b, 0x0000001a, 0x00000019, 0x00000000,
+        // %iterations_ptr = OpAccessChain %_ptr_PushConstant_uint %constants %uint_0
+        0x00050041, 0x00000012, 0x0000001b, 0x00000017, 0x00000013,
+        // %iterations = OpLoad %uint %iterations_ptr
+        0x0004003d, 0x0000000b, 0x0000001c, 0x0000001b,
+        // %lid = OpLoad %uint %gl_LocalInvocationIndex
+        0x0004003d, 0x0000000b, 0x0000001d, 0x00000003,
+        // %x0_init = OpIAdd %uint %gid %uint_0
+        0x00050080, 0x0000000b, 0x0000001e, 0x0000001a, 0x00000013,
+        // %x1_init = OpIAdd %uint %gid %uint_1
+        0x00050080, 0x0000000b, 0x0000001f, 0x0000001a, 0x00000014,
+        // %x2_init = OpIAdd %uint %gid %uint_2
+        0x00050080, 0x0000000b, 0x00000020, 0x0000001a, 0x00000015,
+        // %x3_init = OpIAdd %uint %gid %uint_3
+        0x00050080, 0x0000000b, 0x00000021, 0x0000001a, 0x00000016,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000022,
+        // %loop_header = OpLabel
+        0x000200f8, 0x00000022,
+        // %i = OpPhi %uint %uint_0 %entry %i_next %loop_continue
+        0x000700f5, 0x0000000b, 0x00000026, 0x00000013, 0x00000018, 0x00000027,
+        0x00000024,
+        // %x0 = OpPhi %uint %x0_init %entry %x0_next %loop_continue
+        0x000700f5, 0x0000000b, 0x00000028, 0x0000001e, 0x00000018, 0x0000002c,
+        0x00000024,
+        // %x1 = OpPhi %uint %x1_init %entry %x1_next %loop_continue
+        0x000700f5, 0x0000000b, 0x00000029, 0x0000001f, 0x00000018, 0x0000002d,
+        0x00000024,
+        // %x2 = OpPhi %uint %x2_init %entry %x2_next %loop_continue
+        0x000700f5, 0x0000000b, 0x0000002a, 0x00000020, 0x00000018, 0x0000002e,
+        0x00000024,
+        // %x3 = OpPhi %uint %x3_init %entry %x3_next %loop_continue
+        0x000700f5, 0x0000000b, 0x0000002b, 0x00000021, 0x00000018, 0x0000002f,
+        0x00000024,
+        // %loop_cond = OpULessThan %bool %i %iterations
+        0x000500b0, 0x0000000a, 0x00000030, 0x00000026, 0x0000001c,
+        // OpLoopMerge %loop_merge %loop_continue None
+        0x000400f6, 0x00000025, 0x00000024, 0x00000000,
+        // OpBranchConditional %loop_cond %loop_body %loop_merge
+        0x000400fa, 0x00000030, 0x00000023, 0x00000025,
+        // %loop_body = OpLabel
+        0x000200f8, 0x00000023,
+        // %x0_in_0 = OpIAdd %uint %x0 %lid
+        0x00050080, 0x0000000b, 0x00000031, 0x00000028, 0x0000001d,
+        // %x0_1 = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x0_in_0
+        0x0006015d, 0x0000000b, 0x00000032, 0x00000016, 0x00000000, 0x00000031,
+        // %x1_in_0 = OpIAdd %uint %x1 %lid
+        0x00050080, 0x0000000b, 0x00000033, 0x00000029, 0x0000001d,
+        // %x1_1 = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x1_in_0
+        0x0006015d, 0x0000000b, 0x00000034, 0x00000016, 0x00000000, 0x00000033,
+        // %x2_in_0 = OpIAdd %uint %x2 %lid
+        0x00050080, 0x0000000b, 0x00000035, 0x0000002a, 0x0000001d,
+        // %x2_1 = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x2_in_0
+        0x0006015d, 0x0000000b, 0x00000036, 0x00000016, 0x00000000, 0x00000035,
+        // %x3_in_0 = OpIAdd %uint %x3 %lid
+        0x00050080, 0x0000000b, 0x00000037, 0x0000002b, 0x0000001d,
+        // %x3_1 = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x3_in_0
+        0x0006015d, 0x0000000b, 0x00000038, 0x00000016, 0x00000000, 0x00000037,
+        // %x0_in_1 = OpIAdd %uint %x0_1 %lid
+        0x00050080, 0x0000000b, 0x00000039, 0x00000032, 0x0000001d,
+        // %x1_in_1 = OpIAdd %uint %x1_1 %lid
+        0x00050080, 0x0000000b, 0x0000003a, 0x00000034, 0x0000001d,
+        // %x2_in_1 = OpIAdd %uint %x2_1 %lid
+        0x00050080, 0x0000000b, 0x0000003b, 0x00000036, 0x0000001d,
+        // %x3_in_1 = OpIAdd %uint %x3_1 %lid
+        0x00050080, 0x0000000b, 0x0000003c, 0x00000038, 0x0000001d,
+        // %x0_next = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x0_in_1
+        0x0006015d, 0x0000000b, 0x0000002c, 0x00000016, 0x00000000, 0x00000039,
+        // %x1_next = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x1_in_1
+        0x0006015d, 0x0000000b, 0x0000002d, 0x00000016, 0x00000000, 0x0000003a,
+        // %x2_next = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x2_in_1
+        0x0006015d, 0x0000000b, 0x0000002e, 0x00000016, 0x00000000, 0x0000003b,
+        // %x3_next = OpGroupNonUniformIAdd %uint %uint_3 Reduce %x3_in_1
+        0x0006015d, 0x0000000b, 0x0000002f, 0x00000016, 0x00000000, 0x0000003c,
+        // OpBranch %loop_continue
+        0x000200f9, 0x00000024,
+        // %loop_continue = OpLabel
+        0x000200f8, 0x00000024,
+        // %i_next = OpIAdd %uint %i %uint_1
+        0x00050080, 0x0000000b, 0x00000027, 0x00000026, 0x00000014,
+        // OpBranch %loop_header
+        0x000200f9, 0x00000022,
+        // %loop_merge = OpLabel
+        0x000200f8, 0x00000025,
+        // %sum_1 = OpIAdd %uint %x0 %x1
+        0x00050080, 0x0000000b, 0x0000003d, 0x00000028, 0x00000029,
+        // %sum_2 = OpIAdd %uint %sum_1 %x2
+        0x00050080, 0x0000000b, 0x0000003e, 0x0000003d, 0x0000002a,
+        // %sum_3 = OpIAdd %uint %sum_2 %x3
+        0x00050080, 0x0000000b, 0x0000003f, 0x0000003e, 0x0000002b,
+        // %output_ptr = OpAccessChain %_ptr_Uniform_uint %output %uint_0 %gid
+        0x00060041, 0x00000010, 0x00000040, 0x00000006, 0x00000013, 0x0000001a,
+        // OpStore %output_ptr %sum_3
+        0x0003003e, 0x00000040, 0x0000003f,
+        // OpReturn
+        0x000100fd,
+        // OpFunctionEnd
+        0x00010038,
+};
+
+// 8 chains * 2 FMAs * 2 FLOPs
+const VkComputeKernel kFp32FmaKernel = {kFp32FmaKernelCode, sizeof(kFp32FmaKernelCode), 32};
+
+// 8 chains * 2 FMAs * 2 lanes * 2 FLOPs
+const VkComputeKernel kFp16FmaKernel = {kFp16FmaKernelCode, sizeof(kFp16FmaKernelCode), 64};
+
+// 8 chains * 2 multiply-adds * 2 operations
+const VkComputeKernel kInt32MadKernel = {kInt32MadKernelCode, sizeof(kInt32MadKernelCode), 32};
+
+// 8 loads * 16 bytes
+const VkComputeKernel kSharedMemoryKernel = {
+        kSharedMemoryKernelCode, sizeof(kSharedMemoryKernelCode), 128};
+
+// 4 chains * 2 reductions
+const VkComputeKernel kSubgroupAddKernel = {
+        kSubgroupAddKernelCode, sizeof(kSubgroupAddKernelCode), 8};
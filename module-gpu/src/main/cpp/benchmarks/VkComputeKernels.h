@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Hand-assembled SPIR-V compute kernels, embedded so that no shader compiler is needed at build
+ * or run time. VkComputeKernels.cpp has the GLSL equivalent and the disassembly of each one.
+ *
+ * All of them run kLocalSize invocations per workgroup, take the iteration count as the first
+ * push constant and write one uint per invocation to the storage buffer at set 0, binding 0,
+ * so that the driver can't drop any of the work.
+ */
+struct VkComputeKernel {
+    static constexpr uint32_t kLocalSize = 64;
+
+    const uint32_t *code;
+    size_t size;
+
+    /**
+     * FLOPs, operations or bytes, depending on the kernel, per invocation and loop iteration.
+     */
+    uint32_t workPerIteration;
+};
+
+/**
+ * Push constants: uint iterations, float a, float b.
+ */
+extern const VkComputeKernel kFp32FmaKernel;
+
+/**
+ * Push constants: uint iterations, float a, float b. Needs shaderFloat16.
+ */
+extern const VkComputeKernel kFp16FmaKernel;
+
+/**
+ * Push constants: uint iterations, uint a, uint b.
+ */
+extern const VkComputeKernel kInt32MadKernel;
+
+/**
+ * Push constants: uint iterations. Uses 16 KiB of shared memory.
+ */
+extern const VkComputeKernel kSharedMemoryKernel;
+
+/**
+ * Push constants: uint iterations. SPIR-V 1.3, needs Vulkan 1.1 and
+ * VK_SUBGROUP_FEATURE_ARITHMETIC_BIT in compute shaders.
+ */
+extern const VkComputeKernel kSubgroupAddKernel;
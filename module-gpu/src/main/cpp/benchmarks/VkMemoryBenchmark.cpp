@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "VkMemoryBenchmark"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "../logging.h"
+#include "../vulkan/VkDeviceSession.h"
+#include "VkBenchmarkHarness.h"
+#include "VkMemoryBenchmark.h"
+
+using namespace benchmark_harness;
+
+using Unit = BenchmarkReport::Unit;
+
+/**
+ * From a uniform buffer update to a texture upload.
+ */
+static constexpr VkDeviceSize kTransferSizes[] = {
+        4 * 1024,
+        64 * 1024,
+        1024 * 1024,
+        16 * 1024 * 1024,
+};
+
+static constexpr VkDeviceSize kMaxTransferSize = kTransferSizes[std::size(kTransferSizes) - 1];
+
+/**
+ * Never take more than this share of a heap, it's shared with the rest of the system.
+ */
+static constexpr VkDeviceSize kMaxHeapShare = 4;
+
+static constexpr MeasureOptions kHostMeasureOptions = {
+        .targetNs = 10e6,
+};
+
+/**
+ * Copies are recorded in a single command buffer, keep it reasonably sized.
+ */
+static constexpr MeasureOptions kCopyMeasureOptions = {
+        .targetNs = 10e6,
+        .maxIterations = 4096,
+};
+
+static const struct {
+    VkMemoryPropertyFlags flag;
+    const char *name;
+} kMemoryPropertyFlags[] = {
+        {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, "device_local"},
+        {VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, "host_visible"},
+        {VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, "host_coherent"},
+        {VK_MEMORY_PROPERTY_HOST_CACHED_BIT, "host_cached"},
+        {VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, "lazily_allocated"},
+        {VK_MEMORY_PROPERTY_PROTECTED_BIT, "protected"},
+};
+
+static void addMemoryProperties(const VkPhysicalDeviceMemoryProperties &memoryProperties,
+                                BenchmarkReport::Section &section) {
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        const auto &memoryHeap = memoryProperties.memoryHeaps[i];
+        auto prefix = "heap_" + std::to_string(i) + "_";
+
+        section.add(prefix + "size", Unit::BYTES, memoryHeap.size);
+        section.add(prefix + "device_local", Unit::BOOLEAN,
+                    (memoryHeap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0);
+    }
+
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        const auto &memoryType = memoryProperties.memoryTypes[i];
+        auto prefix = "type_" + std::to_string(i) + "_";
+
+        section.add(prefix + "heap", Unit::NONE, memoryType.heapIndex);
+        for (const auto &[flag, name]: kMemoryPropertyFlags) {
+            section.add(prefix + name, Unit::BOOLEAN, (memoryType.propertyFlags & flag) != 0);
+        }
+    }
+}
+
+/**
+ * Time a host loop, the driver isn't involved besides flushes and invalidations.
+ */
+static std::optional<double> measureHost(const std::function<bool()> &transfer,
+                                         uint32_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < iterations; i++) {
+        if (!transfer()) {
+            return std::nullopt;
+        }
+    }
+
+    return std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+static void runMemoryTypeBenchmark(VkDeviceSession &deviceSession, uint32_t memoryTypeIndex,
+                                   VkDeviceSession::Buffer &deviceLocalBuffer,
+                                   BenchmarkReport::Section &section) {
+    const auto &memoryProperties = deviceSession.getMemoryProperties();
+    const auto &memoryType = memoryProperties.memoryTypes[memoryTypeIndex];
+    const auto &memoryHeap = memoryProperties.memoryHeaps[memoryType.heapIndex];
+
+    auto bufferSize = std::min(kMaxTransferSize, memoryHeap.size / kMaxHeapShare);
+
+    // Lazily allocated and protected memory types can't back plain buffers
+    auto buffer = deviceSession.createBuffer(
+            bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            memoryTypeIndex);
+    section.add("transfer_buffers", Unit::BOOLEAN, buffer != nullptr);
+    if (!buffer) {
+        return;
+    }
+
+    auto isHostVisible = (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    auto isHostCoherent = (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+
+    auto mapping = isHostVisible ? static_cast<uint8_t *>(buffer->map()) : nullptr;
+    std::vector<uint8_t> hostBuffer(isHostVisible ? bufferSize : 0, 0x5a);
+
+    auto nonCoherentAtomSize = deviceSession.getProperties().limits.nonCoherentAtomSize;
+
+    for (auto size: kTransferSizes) {
+        if (size > bufferSize) {
+            break;
+        }
+
+        auto sizeName = std::to_string(size);
+
+        if (mapping != nullptr) {
+            // Ranges must be aligned to nonCoherentAtomSize, unless they cover the whole mapping
+            auto rangeSize = nonCoherentAtomSize > 0 && size % nonCoherentAtomSize == 0
+                             ? size : VK_WHOLE_SIZE;
+
+            auto upload = measureRate([&](uint32_t iterations) {
+                return measureHost([&]() {
+                    memcpy(mapping, hostBuffer.data(), size);
+                    return isHostCoherent || buffer->flush(0, rangeSize);
+                }, iterations);
+            }, kHostMeasureOptions);
+            if (upload) {
+                section.add("upload_" + sizeName, Unit::BYTES_PER_SECOND,
+                            upload.value() * static_cast<double>(size));
+            }
+
+            auto readback = measureRate([&](uint32_t iterations) {
+                return measureHost([&]() {
+                    if (!isHostCoherent && !buffer->invalidate(0, rangeSize)) {
+                        return false;
+                    }
+                    memcpy(hostBuffer.data(), mapping, size);
+                    doNotOptimize(hostBuffer[size - 1]);
+                    return true;
+                }, iterations);
+            }, kHostMeasureOptions);
+            if (readback) {
+                section.add("readback_" + sizeName, Unit::BYTES_PER_SECOND,
+                            readback.value() * static_cast<double>(size));
+            }
+        }
+
+        auto &dispatch = deviceSession.getDispatch();
+
+        VkBufferCopy region{
+                .srcOffset = 0,
+                .dstOffset = 0,
+                .size = size,
+        };
+
+        // Copies to the same destination must not overlap
+        VkMemoryBarrier barrier{
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        };
+
+        auto copy = measureRate([&](uint32_t iterations) {
+            return deviceSession.measure([&](VkCommandBuffer commandBuffer) {
+                for (uint32_t i = 0; i < iterations; i++) {
+                    if (i > 0) {
+                        dispatch.vkCmdPipelineBarrier(
+                                commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0,
+                                nullptr);
+                    }
+
+                    dispatch.vkCmdCopyBuffer(commandBuffer, buffer->getBuffer(),
+                                             deviceLocalBuffer.getBuffer(), 1, &region);
+                }
+            });
+        }, kCopyMeasureOptions);
+        if (copy) {
+            section.add("copy_to_device_local_" + sizeName, Unit::BYTES_PER_SECOND,
+                        copy.value() * static_cast<double>(size));
+        }
+    }
+}
+
+static void runDeviceBenchmark(VkSession &vkSession, VkPhysicalDevice physicalDevice,
+                               const std::string &sectionName, BenchmarkReport &report) {
+    auto &section = report.addSection(sectionName);
+
+    auto memoryProperties = vkSession.vkGetPhysicalDeviceMemoryProperties(physicalDevice);
+    addMemoryProperties(memoryProperties, section);
+
+    auto deviceSession = VkDeviceSession::create(vkSession, physicalDevice);
+    if (!deviceSession) {
+        section.add("supported", Unit::BOOLEAN, false);
+        return;
+    }
+
+    section.add("timestamp_queries", Unit::BOOLEAN, deviceSession->hasTimestamps());
+
+    // The destination of the copies, where a renderer would stream its buffers to
+    auto deviceLocalBuffer = deviceSession->createBufferWithFlags(
+            kMaxTransferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    if (!deviceLocalBuffer) {
+        section.add("supported", Unit::BOOLEAN, false);
+        return;
+    }
+
+    section.add("copy_destination_type", Unit::NONE, deviceLocalBuffer->getMemoryTypeIndex());
+
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        LOGI("Benchmarking memory type %u", i);
+
+        auto &typeSection = report.addSection(sectionName + " type " + std::to_string(i));
+        runMemoryTypeBenchmark(*deviceSession, i, *deviceLocalBuffer, typeSection);
+    }
+}
+
+BenchmarkReport runVkMemoryBenchmark() {
+    BenchmarkReport report;
+
+    auto vkSession = VkSession::createHeadless();
+    if (!vkSession) {
+        report.addSection("Vulkan").add("supported", Unit::BOOLEAN, false);
+        return report;
+    }
+
+    auto physicalDevices = vkSession->vkEnumeratePhysicalDevices();
+    for (size_t i = 0; i < physicalDevices.size(); i++) {
+        auto properties = vkSession->vkGetPhysicalDeviceProperties(physicalDevices[i]);
+
+        LOGI("Benchmarking %s", properties.deviceName);
+
+        runDeviceBenchmark(*vkSession, physicalDevices[i], getDeviceSectionName(i, properties),
+                           report);
+    }
+
+    return report;
+}
@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "BenchmarkReport.h"
+
+/**
+ * Report the memory heaps and types of every Vulkan device, then measure map+memcpy upload,
+ * readback and vkCmdCopyBuffer bandwidth of each memory type over a range of transfer sizes.
+ */
+BenchmarkReport runVkMemoryBenchmark();
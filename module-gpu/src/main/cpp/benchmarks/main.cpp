@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Benchmarks.h"
+
+static void printUsage(const char *program) {
+    fprintf(stderr, "Usage: %s [--csv|--binary] <benchmark>...\n\nBenchmarks:\n", program);
+
+    size_t count;
+    auto benchmarks = getBenchmarks(&count);
+    for (size_t i = 0; i < count; i++) {
+        fprintf(stderr, "  %-24s %s\n", benchmarks[i].name, benchmarks[i].description);
+    }
+}
+
+int main(int argc, char **argv) {
+    auto format = BenchmarkReport::Format::TEXT;
+    std::vector<const BenchmarkDefinition *> benchmarks;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            format = BenchmarkReport::Format::CSV;
+            continue;
+        }
+
+        if (strcmp(argv[i], "--binary") == 0) {
+            format = BenchmarkReport::Format::BINARY;
+            continue;
+        }
+
+        auto benchmark = findBenchmark(argv[i]);
+        if (benchmark == nullptr) {
+            fprintf(stderr, "Unknown benchmark: %s\n", argv[i]);
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        benchmarks.push_back(benchmark);
+    }
+
+    if (benchmarks.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    for (auto benchmark: benchmarks) {
+        benchmark->run().print(stdout, format);
+    }
+
+    return 0;
+}
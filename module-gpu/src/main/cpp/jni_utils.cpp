@@ -29,3 +29,46 @@ jmethodID getArrayListAddMethodID(JNIEnv *env, jobject object) {
 
     return methodID;
 }
+
+jclass findClassGlobalRef(JNIEnv *env, const char *className) {
+    jclass clazz = withJniCheck<jclass>(env, [=]() {
+        return env->FindClass(className);
+    });
+
+    auto globalClazz = static_cast<jclass>(env->NewGlobalRef(clazz));
+    env->DeleteLocalRef(clazz);
+
+    return globalClazz;
+}
+
+jlongArray toJLongArray(JNIEnv *env, const std::vector<jlong> &values) {
+    auto array = withJniCheck<jlongArray>(env, [&]() {
+        return env->NewLongArray(static_cast<jsize>(values.size()));
+    });
+    env->SetLongArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+
+    return array;
+}
+
+jintArray toJIntArray(JNIEnv *env, const std::vector<jint> &values) {
+    auto array = withJniCheck<jintArray>(env, [&]() {
+        return env->NewIntArray(static_cast<jsize>(values.size()));
+    });
+    env->SetIntArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+
+    return array;
+}
+
+void registerNatives(JNIEnv *env, const char *className,
+                     const JNINativeMethod *methods, size_t methodsCount) {
+    jclass clazz = withJniCheck<jclass>(env, [=]() {
+        return env->FindClass(className);
+    });
+
+    auto result = env->RegisterNatives(clazz, methods, static_cast<jint>(methodsCount));
+    env->DeleteLocalRef(clazz);
+
+    if (result != JNI_OK) {
+        throw std::runtime_error("Failed to register natives");
+    }
+}
@@ -6,7 +6,9 @@
 #pragma once
 
 #include <functional>
+#include <stdexcept>
 #include <jni.h>
+#include <vector>
 
 void withJniCheck(JNIEnv *env, const std::function<void()> &func);
 
@@ -24,3 +26,24 @@ T withJniCheck(JNIEnv *env, const std::function<T()> &func) {
 }
 
 jmethodID getArrayListAddMethodID(JNIEnv *env, jobject object);
+
+/**
+ * Find a class and return a global reference to it, to be used to cache it.
+ */
+jclass findClassGlobalRef(JNIEnv *env, const char *className);
+
+/**
+ * Copy values read natively into a new Java array.
+ */
+jlongArray toJLongArray(JNIEnv *env, const std::vector<jlong> &values);
+
+/**
+ * @see toJLongArray
+ */
+jintArray toJIntArray(JNIEnv *env, const std::vector<jint> &values);
+
+/**
+ * Bind the given native methods to a class.
+ */
+void registerNatives(JNIEnv *env, const char *className,
+                     const JNINativeMethod *methods, size_t methodsCount);
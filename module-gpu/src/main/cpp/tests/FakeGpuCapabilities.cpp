@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "FakeGpuCapabilities.h"
+#include "GpuCapabilities.h"
+
+namespace fake_gpu_capabilities {
+
+std::atomic<uint64_t> gDriverKey{0};
+std::atomic<uint32_t> gProbeCount{0};
+const char *gBuildFingerprint = "";
+
+} // namespace fake_gpu_capabilities
+
+using namespace fake_gpu_capabilities;
+
+GpuCapabilities::GpuCapabilities(std::vector<uint8_t> buffer)
+    : mBuffer(std::move(buffer)), mData(mBuffer.data()), mSize(mBuffer.size()) {}
+
+GpuCapabilities::~GpuCapabilities() = default;
+
+std::unique_ptr<GpuCapabilities> GpuCapabilities::probe() {
+    gProbeCount++;
+
+    auto fingerprintSize = strlen(gBuildFingerprint) + 1;
+    uint64_t key = gDriverKey;
+
+    std::vector<uint8_t> buffer(fingerprintSize + sizeof(key));
+    memcpy(buffer.data(), gBuildFingerprint, fingerprintSize);
+    memcpy(buffer.data() + fingerprintSize, &key, sizeof(key));
+
+    return std::unique_ptr<GpuCapabilities>(new GpuCapabilities(std::move(buffer)));
+}
+
+std::unique_ptr<GpuCapabilities> GpuCapabilities::map(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> buffer{std::istreambuf_iterator<char>(file),
+                                std::istreambuf_iterator<char>()};
+
+    auto end = memchr(buffer.data(), '\0', buffer.size());
+    if (end == nullptr
+        || static_cast<uint8_t *>(end) + 1 + sizeof(uint64_t) != buffer.data() + buffer.size()) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<GpuCapabilities>(new GpuCapabilities(std::move(buffer)));
+}
+
+bool GpuCapabilities::write(const std::string &path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(mData), static_cast<std::streamsize>(mSize));
+    return file.good();
+}
+
+const char *GpuCapabilities::getFingerprint() const {
+    return reinterpret_cast<const char *>(mData);
+}
+
+uint64_t GpuCapabilities::getKey() const {
+    uint64_t key;
+    memcpy(&key, mData + mSize - sizeof(key), sizeof(key));
+    return key;
+}
+
+std::string GpuCapabilities::getBuildFingerprint() {
+    return gBuildFingerprint;
+}
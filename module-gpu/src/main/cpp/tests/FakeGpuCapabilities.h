@@ -0,0 +1,29 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Stands in for GpuCapabilities.cpp, so that the cache can be tested without any driver. A
+ * file holds nothing but the fingerprint and the key.
+ */
+namespace fake_gpu_capabilities {
+
+/**
+ * What the next probe finds.
+ */
+extern std::atomic<uint64_t> gDriverKey;
+
+extern std::atomic<uint32_t> gProbeCount;
+
+/**
+ * Stands in for ro.build.fingerprint.
+ */
+extern const char *gBuildFingerprint;
+
+} // namespace fake_gpu_capabilities
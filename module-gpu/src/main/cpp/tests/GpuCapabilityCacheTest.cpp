@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <ctime>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include "FakeGpuCapabilities.h"
+#include "GpuCapabilityCache.h"
+
+using namespace fake_gpu_capabilities;
+
+/**
+ * A cache file with the current fingerprint must be served without probing the drivers,
+ * which are only probed again once a day.
+ */
+class GpuCapabilityCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        mPath = testing::TempDir() + "gpu_capability_cache_test.bin";
+        remove(mPath.c_str());
+
+        gBuildFingerprint = "vendor/device:16/BUILD.1";
+        gDriverKey = 1;
+        gProbeCount = 0;
+    }
+
+    void TearDown() override {
+        remove(mPath.c_str());
+    }
+
+    /**
+     * A new cache, as a new process would have.
+     */
+    std::unique_ptr<GpuCapabilityCache> createCache() {
+        auto cache = std::unique_ptr<GpuCapabilityCache>(new GpuCapabilityCache());
+        cache->setPath(mPath);
+        return cache;
+    }
+
+    /**
+     * Write the cache file as a previous process would have, probed some seconds ago.
+     */
+    void writeCache(time_t ageSeconds) {
+        createCache()->getCapabilities();
+
+        timespec times[2] = {};
+        times[0].tv_sec = times[1].tv_sec = time(nullptr) - ageSeconds;
+        ASSERT_EQ(utimensat(AT_FDCWD, mPath.c_str(), times, 0), 0);
+
+        gProbeCount = 0;
+    }
+
+    time_t getFileTime() const {
+        struct stat st = {};
+        EXPECT_EQ(stat(mPath.c_str(), &st), 0);
+        return st.st_mtime;
+    }
+
+    static constexpr time_t kHourSeconds = 60 * 60;
+    static constexpr time_t kDaySeconds = 24 * kHourSeconds;
+
+    std::string mPath;
+};
+
+TEST_F(GpuCapabilityCacheTest, ProbesAndWritesWithoutFile) {
+    auto cache = createCache();
+
+    auto capabilities = cache->getCapabilities();
+    EXPECT_EQ(capabilities->getKey(), 1u);
+    EXPECT_EQ(cache->getCapabilities(), capabilities);
+    EXPECT_EQ(gProbeCount, 1u);
+
+    EXPECT_EQ(GpuCapabilities::map(mPath)->getKey(), 1u);
+}
+
+TEST_F(GpuCapabilityCacheTest, ServesFreshFileWithoutProbing) {
+    writeCache(kHourSeconds);
+    gDriverKey = 2;
+
+    {
+        auto cache = createCache();
+        EXPECT_EQ(cache->getCapabilities()->getKey(), 1u);
+    }
+
+    // The cache joins any revalidation when destroyed
+    EXPECT_EQ(gProbeCount, 0u);
+}
+
+TEST_F(GpuCapabilityCacheTest, ProbesOnFingerprintChange) {
+    writeCache(kHourSeconds);
+    gBuildFingerprint = "vendor/device:16/BUILD.2";
+    gDriverKey = 2;
+
+    auto cache = createCache();
+    EXPECT_EQ(cache->getCapabilities()->getKey(), 2u);
+    EXPECT_EQ(gProbeCount, 1u);
+
+    EXPECT_STREQ(GpuCapabilities::map(mPath)->getFingerprint(), "vendor/device:16/BUILD.2");
+}
+
+TEST_F(GpuCapabilityCacheTest, RevalidatesStaleFile) {
+    writeCache(2 * kDaySeconds);
+    gDriverKey = 2;
+
+    {
+        auto cache = createCache();
+        // Served right away, the probe runs in the background
+        EXPECT_EQ(cache->getCapabilities()->getKey(), 1u);
+    }
+
+    EXPECT_EQ(gProbeCount, 1u);
+    EXPECT_EQ(GpuCapabilities::map(mPath)->getKey(), 2u);
+}
+
+TEST_F(GpuCapabilityCacheTest, TouchesUnchangedStaleFile) {
+    writeCache(2 * kDaySeconds);
+
+    createCache()->getCapabilities();
+    EXPECT_EQ(gProbeCount, 1u);
+    EXPECT_GT(getFileTime(), time(nullptr) - kHourSeconds);
+
+    // Not due anymore
+    createCache()->getCapabilities();
+    EXPECT_EQ(gProbeCount, 1u);
+}
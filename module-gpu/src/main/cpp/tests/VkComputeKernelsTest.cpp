@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <ostream>
+#include <string>
+#include "VkComputeKernels.h"
+
+/**
+ * The kernels are assembled by hand, check that each one is a well formed module with the
+ * interface the benchmarks expect. When spirv-val is installed the modules are also run
+ * through the full validator.
+ */
+struct KernelParam {
+    const char *name;
+    const VkComputeKernel *kernel;
+};
+
+void PrintTo(const KernelParam &param, std::ostream *os) {
+    *os << param.name;
+}
+
+class VkComputeKernelsTest : public testing::TestWithParam<KernelParam> {
+protected:
+    static constexpr uint32_t kMagic = 0x07230203;
+    static constexpr size_t kHeaderWords = 5;
+
+    static constexpr uint16_t kOpEntryPoint = 15;
+    static constexpr uint16_t kOpExecutionMode = 16;
+    static constexpr uint16_t kOpFunction = 54;
+    static constexpr uint16_t kOpFunctionEnd = 56;
+
+    static constexpr uint32_t kExecutionModelGlCompute = 5;
+    static constexpr uint32_t kExecutionModeLocalSize = 17;
+
+    const uint32_t *getCode() const { return GetParam().kernel->code; }
+
+    size_t getWordCount() const { return GetParam().kernel->size / sizeof(uint32_t); }
+};
+
+TEST_P(VkComputeKernelsTest, Header) {
+    ASSERT_EQ(GetParam().kernel->size % sizeof(uint32_t), 0u);
+    ASSERT_GT(getWordCount(), kHeaderWords);
+
+    auto code = getCode();
+    EXPECT_EQ(code[0], kMagic);
+    // Vulkan 1.1 consumes up to SPIR-V 1.3, the newest we can rely on
+    EXPECT_GE(code[1], 0x00010000u);
+    EXPECT_LE(code[1], 0x00010300u);
+    EXPECT_GT(code[3], 1u);
+    EXPECT_EQ(code[4], 0u);
+}
+
+TEST_P(VkComputeKernelsTest, Instructions) {
+    auto code = getCode();
+    auto wordCount = getWordCount();
+
+    size_t entryPoints = 0;
+    size_t localSizes = 0;
+    size_t functions = 0;
+    uint16_t lastOpcode = 0;
+
+    size_t offset = kHeaderWords;
+    while (offset < wordCount) {
+        auto instructionWordCount = code[offset] >> 16;
+        auto opcode = static_cast<uint16_t>(code[offset] & 0xffff);
+
+        ASSERT_GT(instructionWordCount, 0u) << "at word " << offset;
+        ASSERT_LE(offset + instructionWordCount, wordCount) << "at word " << offset;
+
+        auto operands = &code[offset + 1];
+        switch (opcode) {
+            case kOpEntryPoint:
+                entryPoints++;
+                ASSERT_GE(instructionWordCount, 4u);
+                EXPECT_EQ(operands[0], kExecutionModelGlCompute);
+                EXPECT_STREQ(reinterpret_cast<const char *>(&operands[2]), "main");
+                break;
+            case kOpExecutionMode:
+                if (operands[1] == kExecutionModeLocalSize) {
+                    localSizes++;
+                    ASSERT_EQ(instructionWordCount, 6u);
+                    EXPECT_EQ(operands[2], VkComputeKernel::kLocalSize);
+                    EXPECT_EQ(operands[3], 1u);
+                    EXPECT_EQ(operands[4], 1u);
+                }
+                break;
+            case kOpFunction:
+                functions++;
+                break;
+        }
+
+        lastOpcode = opcode;
+        offset += instructionWordCount;
+    }
+
+    EXPECT_EQ(offset, wordCount);
+    EXPECT_EQ(entryPoints, 1u);
+    EXPECT_EQ(localSizes, 1u);
+    EXPECT_EQ(functions, 1u);
+    EXPECT_EQ(lastOpcode, kOpFunctionEnd);
+}
+
+TEST_P(VkComputeKernelsTest, Validate) {
+#ifdef SPIRV_VAL
+    auto path = testing::TempDir() + GetParam().name + ".spv";
+
+    auto file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_EQ(fwrite(getCode(), 1, GetParam().kernel->size, file), GetParam().kernel->size);
+    fclose(file);
+
+    // SPIR-V 1.3 needs Vulkan 1.1, the others must also load on Vulkan 1.0
+    auto targetEnv = getCode()[1] >= 0x00010300 ? "vulkan1.1" : "vulkan1.0";
+    auto command = std::string(SPIRV_VAL) + " --target-env " + targetEnv + " " + path;
+    EXPECT_EQ(system(command.c_str()), 0) << command;
+
+    remove(path.c_str());
+#else
+    GTEST_SKIP() << "spirv-val not found at configure time";
+#endif
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        Kernels, VkComputeKernelsTest,
+        testing::Values(KernelParam{"Fp32Fma", &kFp32FmaKernel},
+                        KernelParam{"Fp16Fma", &kFp16FmaKernel},
+                        KernelParam{"Int32Mad", &kInt32MadKernel},
+                        KernelParam{"SharedMemory", &kSharedMemoryKernel},
+                        KernelParam{"SubgroupAdd", &kSubgroupAddKernel}),
+        [](const auto &info) { return std::string(info.param.name); });
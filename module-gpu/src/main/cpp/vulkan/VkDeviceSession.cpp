@@ -0,0 +1,434 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define LOG_TAG "VkDeviceSession"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include "VkDeviceSession.h"
+#include "../logging.h"
+
+VkDeviceSession::Buffer::Buffer(const VkDeviceSession &deviceSession, VkBuffer buffer,
+                                VkDeviceMemory memory, VkDeviceSize size,
+                                uint32_t memoryTypeIndex)
+        : mDeviceSession(deviceSession), mBuffer(buffer), mMemory(memory), mSize(size),
+          mMemoryTypeIndex(memoryTypeIndex) {}
+
+VkDeviceSession::Buffer::~Buffer() {
+    auto &dispatch = mDeviceSession.mDispatch;
+
+    if (mMapping != nullptr) {
+        dispatch.vkUnmapMemory(mDeviceSession.mDevice, mMemory);
+    }
+
+    dispatch.vkDestroyBuffer(mDeviceSession.mDevice, mBuffer, nullptr);
+    dispatch.vkFreeMemory(mDeviceSession.mDevice, mMemory, nullptr);
+}
+
+VkBuffer VkDeviceSession::Buffer::getBuffer() const {
+    return mBuffer;
+}
+
+VkDeviceMemory VkDeviceSession::Buffer::getMemory() const {
+    return mMemory;
+}
+
+VkDeviceSize VkDeviceSession::Buffer::getSize() const {
+    return mSize;
+}
+
+uint32_t VkDeviceSession::Buffer::getMemoryTypeIndex() const {
+    return mMemoryTypeIndex;
+}
+
+void *VkDeviceSession::Buffer::map() {
+    if (mMapping == nullptr) {
+        auto result = mDeviceSession.mDispatch.vkMapMemory(mDeviceSession.mDevice, mMemory, 0,
+                                                           VK_WHOLE_SIZE, 0, &mMapping);
+        if (result != VK_SUCCESS) {
+            LOGE("Failed to map memory: %d", result);
+            mMapping = nullptr;
+        }
+    }
+
+    return mMapping;
+}
+
+bool VkDeviceSession::Buffer::flush(VkDeviceSize offset, VkDeviceSize size) {
+    VkMappedMemoryRange range{
+            .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+            .memory = mMemory,
+            .offset = offset,
+            .size = size,
+    };
+
+    auto result = mDeviceSession.mDispatch.vkFlushMappedMemoryRanges(mDeviceSession.mDevice, 1,
+                                                                     &range);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to flush memory: %d", result);
+        return false;
+    }
+
+    return true;
+}
+
+bool VkDeviceSession::Buffer::invalidate(VkDeviceSize offset, VkDeviceSize size) {
+    VkMappedMemoryRange range{
+            .sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+            .memory = mMemory,
+            .offset = offset,
+            .size = size,
+    };
+
+    auto result = mDeviceSession.mDispatch.vkInvalidateMappedMemoryRanges(
+            mDeviceSession.mDevice, 1, &range);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to invalidate memory: %d", result);
+        return false;
+    }
+
+    return true;
+}
+
+VkDeviceSession::VkDeviceSession(VkSession &vkSession, VkPhysicalDevice physicalDevice,
+                                 const std::vector<const char *> &extensions,
+                                 const void *pNext) {
+    mProperties = vkSession.vkGetPhysicalDeviceProperties(physicalDevice);
+    mMemoryProperties = vkSession.vkGetPhysicalDeviceMemoryProperties(physicalDevice);
+
+    // Every compute queue supports transfers, prefer one with timestamps
+    std::optional<uint32_t> queueFamilyIndex;
+    auto queueFamilies = vkSession.vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice);
+    for (uint32_t i = 0; i < queueFamilies.size(); i++) {
+        auto &queueFamily = queueFamilies[i];
+        if (!(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) || queueFamily.queueCount == 0) {
+            continue;
+        }
+
+        if (!queueFamilyIndex ||
+            (queueFamily.timestampValidBits > 0 && mTimestampValidBits == 0)) {
+            queueFamilyIndex = i;
+            mTimestampValidBits = queueFamily.timestampValidBits;
+        }
+    }
+
+    if (!queueFamilyIndex) {
+        throw std::runtime_error("No compute queue");
+    }
+    mQueueFamilyIndex = queueFamilyIndex.value();
+
+    float queuePriority = 1.0f;
+
+    VkDeviceQueueCreateInfo queueCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+            .queueFamilyIndex = mQueueFamilyIndex,
+            .queueCount = 1,
+            .pQueuePriorities = &queuePriority,
+    };
+
+    VkDeviceCreateInfo deviceCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+            .pNext = pNext,
+            .queueCreateInfoCount = 1,
+            .pQueueCreateInfos = &queueCreateInfo,
+            .enabledExtensionCount = static_cast<uint32_t>(extensions.size()),
+            .ppEnabledExtensionNames = extensions.data(),
+    };
+
+    auto &instanceDispatch = vkSession.getDispatch();
+
+    auto result = instanceDispatch.vkCreateDevice(physicalDevice, &deviceCreateInfo, nullptr,
+                                                  &mDevice);
+    if (result != VK_SUCCESS) {
+        mDevice = VK_NULL_HANDLE;
+        throw std::runtime_error("Failed to create device: " + std::to_string(result));
+    }
+
+    InitVulkanDevice(instanceDispatch, mDevice, &mDispatch);
+
+    mDispatch.vkGetDeviceQueue(mDevice, mQueueFamilyIndex, 0, &mQueue);
+
+    VkCommandPoolCreateInfo commandPoolCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+            .queueFamilyIndex = mQueueFamilyIndex,
+    };
+
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1,
+    };
+
+    VkFenceCreateInfo fenceCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+    };
+
+    if (mDispatch.vkCreateCommandPool(mDevice, &commandPoolCreateInfo, nullptr,
+                                      &mCommandPool) != VK_SUCCESS) {
+        mCommandPool = VK_NULL_HANDLE;
+        destroy();
+        throw std::runtime_error("Failed to create command pool");
+    }
+
+    commandBufferAllocateInfo.commandPool = mCommandPool;
+    if (mDispatch.vkAllocateCommandBuffers(mDevice, &commandBufferAllocateInfo,
+                                           &mCommandBuffer) != VK_SUCCESS) {
+        mCommandBuffer = VK_NULL_HANDLE;
+        destroy();
+        throw std::runtime_error("Failed to allocate command buffer");
+    }
+
+    if (mDispatch.vkCreateFence(mDevice, &fenceCreateInfo, nullptr, &mFence) != VK_SUCCESS) {
+        mFence = VK_NULL_HANDLE;
+        destroy();
+        throw std::runtime_error("Failed to create fence");
+    }
+
+    if (mTimestampValidBits > 0 && mProperties.limits.timestampPeriod > 0) {
+        VkQueryPoolCreateInfo queryPoolCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                .queryType = VK_QUERY_TYPE_TIMESTAMP,
+                .queryCount = 2,
+        };
+
+        if (mDispatch.vkCreateQueryPool(mDevice, &queryPoolCreateInfo, nullptr,
+                                        &mQueryPool) != VK_SUCCESS) {
+            LOGE("Failed to create timestamp query pool, falling back to host time");
+            mQueryPool = VK_NULL_HANDLE;
+        }
+    }
+}
+
+VkDeviceSession::~VkDeviceSession() {
+    destroy();
+}
+
+void VkDeviceSession::destroy() {
+    if (mDevice == VK_NULL_HANDLE) {
+        return;
+    }
+
+    mDispatch.vkDeviceWaitIdle(mDevice);
+
+    if (mQueryPool != VK_NULL_HANDLE) {
+        mDispatch.vkDestroyQueryPool(mDevice, mQueryPool, nullptr);
+    }
+
+    if (mFence != VK_NULL_HANDLE) {
+        mDispatch.vkDestroyFence(mDevice, mFence, nullptr);
+    }
+
+    // Frees the command buffer too
+    if (mCommandPool != VK_NULL_HANDLE) {
+        mDispatch.vkDestroyCommandPool(mDevice, mCommandPool, nullptr);
+    }
+
+    mDispatch.vkDestroyDevice(mDevice, nullptr);
+    mDevice = VK_NULL_HANDLE;
+}
+
+VkDevice VkDeviceSession::getDevice() const {
+    return mDevice;
+}
+
+const VkDeviceDispatch &VkDeviceSession::getDispatch() const {
+    return mDispatch;
+}
+
+const VkPhysicalDeviceProperties &VkDeviceSession::getProperties() const {
+    return mProperties;
+}
+
+const VkPhysicalDeviceMemoryProperties &VkDeviceSession::getMemoryProperties() const {
+    return mMemoryProperties;
+}
+
+bool VkDeviceSession::hasTimestamps() const {
+    return mQueryPool != VK_NULL_HANDLE;
+}
+
+std::optional<uint32_t> VkDeviceSession::findMemoryType(uint32_t memoryTypeBits,
+                                                        VkMemoryPropertyFlags flags) const {
+    for (uint32_t i = 0; i < mMemoryProperties.memoryTypeCount; i++) {
+        if ((memoryTypeBits & (1u << i)) &&
+            (mMemoryProperties.memoryTypes[i].propertyFlags & flags) == flags) {
+            return i;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::unique_ptr<VkDeviceSession::Buffer> VkDeviceSession::createBuffer(
+        VkDeviceSize size, VkBufferUsageFlags usage, uint32_t memoryTypeIndex) {
+    VkBufferCreateInfo bufferCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = size,
+            .usage = usage,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+    };
+
+    VkBuffer buffer;
+    auto result = mDispatch.vkCreateBuffer(mDevice, &bufferCreateInfo, nullptr, &buffer);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to create buffer: %d", result);
+        return nullptr;
+    }
+
+    VkMemoryRequirements memoryRequirements;
+    mDispatch.vkGetBufferMemoryRequirements(mDevice, buffer, &memoryRequirements);
+
+    if (!(memoryRequirements.memoryTypeBits & (1u << memoryTypeIndex))) {
+        mDispatch.vkDestroyBuffer(mDevice, buffer, nullptr);
+        return nullptr;
+    }
+
+    VkMemoryAllocateInfo memoryAllocateInfo{
+            .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+            .allocationSize = memoryRequirements.size,
+            .memoryTypeIndex = memoryTypeIndex,
+    };
+
+    VkDeviceMemory memory;
+    result = mDispatch.vkAllocateMemory(mDevice, &memoryAllocateInfo, nullptr, &memory);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to allocate %llu bytes of memory type %u: %d",
+             static_cast<unsigned long long>(memoryRequirements.size), memoryTypeIndex, result);
+        mDispatch.vkDestroyBuffer(mDevice, buffer, nullptr);
+        return nullptr;
+    }
+
+    result = mDispatch.vkBindBufferMemory(mDevice, buffer, memory, 0);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to bind buffer memory: %d", result);
+        mDispatch.vkDestroyBuffer(mDevice, buffer, nullptr);
+        mDispatch.vkFreeMemory(mDevice, memory, nullptr);
+        return nullptr;
+    }
+
+    return std::unique_ptr<Buffer>(new Buffer(*this, buffer, memory, size, memoryTypeIndex));
+}
+
+std::unique_ptr<VkDeviceSession::Buffer> VkDeviceSession::createBufferWithFlags(
+        VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags flags) {
+    for (uint32_t i = 0; i < mMemoryProperties.memoryTypeCount; i++) {
+        if ((mMemoryProperties.memoryTypes[i].propertyFlags & flags) != flags) {
+            continue;
+        }
+
+        // Only fails if the buffer can't use this memory type or it's out of memory
+        auto buffer = createBuffer(size, usage, i);
+        if (buffer) {
+            return buffer;
+        }
+    }
+
+    return nullptr;
+}
+
+bool VkDeviceSession::submit(const Recorder &record) {
+    VkResult result;
+
+    result = mDispatch.vkResetCommandBuffer(mCommandBuffer, 0);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to reset command buffer: %d", result);
+        return false;
+    }
+
+    VkCommandBufferBeginInfo beginInfo{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+
+    result = mDispatch.vkBeginCommandBuffer(mCommandBuffer, &beginInfo);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to begin command buffer: %d", result);
+        return false;
+    }
+
+    record(mCommandBuffer);
+
+    result = mDispatch.vkEndCommandBuffer(mCommandBuffer);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to end command buffer: %d", result);
+        return false;
+    }
+
+    VkSubmitInfo submitInfo{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &mCommandBuffer,
+    };
+
+    mDispatch.vkResetFences(mDevice, 1, &mFence);
+
+    result = mDispatch.vkQueueSubmit(mQueue, 1, &submitInfo, mFence);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to submit command buffer: %d", result);
+        return false;
+    }
+
+    result = mDispatch.vkWaitForFences(mDevice, 1, &mFence, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to wait for fence: %d", result);
+        return false;
+    }
+
+    return true;
+}
+
+std::optional<double> VkDeviceSession::measure(const Recorder &record) {
+    if (!hasTimestamps()) {
+        auto start = std::chrono::steady_clock::now();
+
+        if (!submit(record)) {
+            return std::nullopt;
+        }
+
+        return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start).count();
+    }
+
+    auto recorded = submit([&](VkCommandBuffer commandBuffer) {
+        mDispatch.vkCmdResetQueryPool(commandBuffer, mQueryPool, 0, 2);
+        mDispatch.vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                      mQueryPool, 0);
+        record(commandBuffer);
+        mDispatch.vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                      mQueryPool, 1);
+    });
+    if (!recorded) {
+        return std::nullopt;
+    }
+
+    uint64_t timestamps[2];
+    auto result = mDispatch.vkGetQueryPoolResults(
+            mDevice, mQueryPool, 0, 2, sizeof(timestamps), timestamps, sizeof(timestamps[0]),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to get timestamps: %d", result);
+        return std::nullopt;
+    }
+
+    // The counter wraps at timestampValidBits
+    auto mask = mTimestampValidBits >= 64 ? UINT64_MAX : (1ull << mTimestampValidBits) - 1;
+    auto ticks = (timestamps[1] - timestamps[0]) & mask;
+
+    return static_cast<double>(ticks) * mProperties.limits.timestampPeriod;
+}
+
+std::unique_ptr<VkDeviceSession> VkDeviceSession::create(
+        VkSession &vkSession, VkPhysicalDevice physicalDevice,
+        const std::vector<const char *> &extensions, const void *pNext) {
+    try {
+        return std::unique_ptr<VkDeviceSession>(
+                new VkDeviceSession(vkSession, physicalDevice, extensions, pNext));
+    } catch (std::runtime_error &error) {
+        LOGE("Failed to create Vulkan device session: %s", error.what());
+        return nullptr;
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include "VkSession.h"
+
+/**
+ * A logical device with a single queue able to run compute and transfer work. Work is recorded
+ * in a single command buffer, submitted and waited for, one submission at a time.
+ */
+class VkDeviceSession {
+public:
+    /**
+     * A buffer bound to its own allocation. Must be destroyed before the device session.
+     */
+    class Buffer {
+    public:
+        Buffer(const Buffer &) = delete;
+
+        ~Buffer();
+
+        Buffer &operator=(const Buffer &) = delete;
+
+        VkBuffer getBuffer() const;
+
+        VkDeviceMemory getMemory() const;
+
+        VkDeviceSize getSize() const;
+
+        uint32_t getMemoryTypeIndex() const;
+
+        /**
+         * Map the whole allocation, only valid with host visible memory types.
+         *
+         * @return The mapping, valid until the buffer is destroyed, nullptr on failure
+         */
+        void *map();
+
+        /**
+         * Make host writes to the mapping visible to the device, only needed with memory types
+         * that aren't host coherent. The range must be aligned to nonCoherentAtomSize.
+         */
+        bool flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+        /**
+         * Make device writes visible to host reads of the mapping, only needed with memory
+         * types that aren't host coherent. The range must be aligned to nonCoherentAtomSize.
+         */
+        bool invalidate(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
+
+    private:
+        friend class VkDeviceSession;
+
+        Buffer(const VkDeviceSession &deviceSession, VkBuffer buffer, VkDeviceMemory memory,
+               VkDeviceSize size, uint32_t memoryTypeIndex);
+
+        const VkDeviceSession &mDeviceSession;
+        VkBuffer mBuffer;
+        VkDeviceMemory mMemory;
+        VkDeviceSize mSize;
+        uint32_t mMemoryTypeIndex;
+        void *mMapping = nullptr;
+    };
+
+    using Recorder = std::function<void(VkCommandBuffer commandBuffer)>;
+
+    VkDeviceSession(const VkDeviceSession &) = delete;
+
+    ~VkDeviceSession();
+
+    VkDeviceSession &operator=(const VkDeviceSession &) = delete;
+
+    /**
+     * @param extensions Device extensions to enable, they must be supported
+     * @param pNext Feature structures to chain to VkDeviceCreateInfo
+     */
+    static std::unique_ptr<VkDeviceSession> create(VkSession &vkSession,
+                                                   VkPhysicalDevice physicalDevice,
+                                                   const std::vector<const char *> &extensions = {},
+                                                   const void *pNext = nullptr);
+
+    VkDevice getDevice() const;
+
+    const VkDeviceDispatch &getDispatch() const;
+
+    const VkPhysicalDeviceProperties &getProperties() const;
+
+    const VkPhysicalDeviceMemoryProperties &getMemoryProperties() const;
+
+    /**
+     * Whether measure() uses timestamp queries, the queue may not support them.
+     */
+    bool hasTimestamps() const;
+
+    /**
+     * @return The first memory type allowed by memoryTypeBits with all the given flags
+     */
+    std::optional<uint32_t> findMemoryType(uint32_t memoryTypeBits,
+                                           VkMemoryPropertyFlags flags) const;
+
+    /**
+     * @return The buffer, nullptr if the memory type can't back it or the allocation failed
+     */
+    std::unique_ptr<Buffer> createBuffer(VkDeviceSize size, VkBufferUsageFlags usage,
+                                         uint32_t memoryTypeIndex);
+
+    /**
+     * Create a buffer in the first memory type with all the given flags.
+     */
+    std::unique_ptr<Buffer> createBufferWithFlags(VkDeviceSize size, VkBufferUsageFlags usage,
+                                                  VkMemoryPropertyFlags flags);
+
+    /**
+     * Record a command buffer, submit it and wait for it to complete.
+     */
+    bool submit(const Recorder &record);
+
+    /**
+     * Same as submit(), timing the recorded commands on the GPU with timestamp queries. Without
+     * them the host time of the whole submission is returned instead, which includes the
+     * submission and wake-up latency.
+     *
+     * @return The elapsed time in nanoseconds, std::nullopt on failure
+     */
+    std::optional<double> measure(const Recorder &record);
+
+private:
+    VkDeviceSession(VkSession &vkSession, VkPhysicalDevice physicalDevice,
+                    const std::vector<const char *> &extensions, const void *pNext);
+
+    void destroy();
+
+    VkPhysicalDeviceProperties mProperties;
+    VkPhysicalDeviceMemoryProperties mMemoryProperties;
+    uint32_t mQueueFamilyIndex = 0;
+    uint32_t mTimestampValidBits = 0;
+
+    VkDevice mDevice = VK_NULL_HANDLE;
+    VkDeviceDispatch mDispatch;
+    VkQueue mQueue = VK_NULL_HANDLE;
+    VkCommandPool mCommandPool = VK_NULL_HANDLE;
+    VkCommandBuffer mCommandBuffer = VK_NULL_HANDLE;
+    VkFence mFence = VK_NULL_HANDLE;
+    VkQueryPool mQueryPool = VK_NULL_HANDLE;
+};
@@ -5,6 +5,8 @@
 
 #define LOG_TAG "VkSession"
 
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include "VkSession.h"
 #include "../logging.h"
@@ -18,17 +20,23 @@ VkSession::VkSession(const VkInstanceCreateInfo *pCreateInfo,
     if (vkCreateInstance(pCreateInfo, pAllocator, &mInstance) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create Vulkan instance");
     }
+
+    if (pCreateInfo->pApplicationInfo != nullptr && pCreateInfo->pApplicationInfo->apiVersion) {
+        mApiVersion = pCreateInfo->pApplicationInfo->apiVersion;
+    }
+
+    InitVulkanInstance(mInstance, &mDispatch);
 }
 
 VkSession::~VkSession() {
-    vkDestroyInstance(mInstance, nullptr);
+    mDispatch.vkDestroyInstance(mInstance, nullptr);
 }
 
 std::vector<VkPhysicalDevice> VkSession::vkEnumeratePhysicalDevices() {
     VkResult result;
 
     uint32_t deviceCount = 0;
-    result = ::vkEnumeratePhysicalDevices(mInstance, &deviceCount, nullptr);
+    result = mDispatch.vkEnumeratePhysicalDevices(mInstance, &deviceCount, nullptr);
     if (result != VK_SUCCESS) {
         LOGE("Failed to enumerate Vulkan devices: %d", result);
         return {};
@@ -40,7 +48,7 @@ std::vector<VkPhysicalDevice> VkSession::vkEnumeratePhysicalDevices() {
     }
 
     std::vector<VkPhysicalDevice> devices(deviceCount);
-    result = ::vkEnumeratePhysicalDevices(mInstance, &deviceCount, devices.data());
+    result = mDispatch.vkEnumeratePhysicalDevices(mInstance, &deviceCount, devices.data());
     if (result != VK_SUCCESS) {
         LOGE("Failed to enumerate Vulkan devices: %d", result);
         return {};
@@ -49,12 +57,72 @@ std::vector<VkPhysicalDevice> VkSession::vkEnumeratePhysicalDevices() {
     return devices;
 }
 
+uint32_t VkSession::getApiVersion() const {
+    return mApiVersion;
+}
+
+const VkInstanceDispatch &VkSession::getDispatch() const {
+    return mDispatch;
+}
+
 VkPhysicalDeviceProperties VkSession::vkGetPhysicalDeviceProperties(VkPhysicalDevice device) {
     VkPhysicalDeviceProperties properties;
-    ::vkGetPhysicalDeviceProperties(device, &properties);
+    mDispatch.vkGetPhysicalDeviceProperties(device, &properties);
     return properties;
 }
 
+VkPhysicalDeviceMemoryProperties VkSession::vkGetPhysicalDeviceMemoryProperties(
+        VkPhysicalDevice device) {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    mDispatch.vkGetPhysicalDeviceMemoryProperties(device, &memoryProperties);
+    return memoryProperties;
+}
+
+std::vector<VkQueueFamilyProperties> VkSession::vkGetPhysicalDeviceQueueFamilyProperties(
+        VkPhysicalDevice device) {
+    uint32_t queueFamilyCount = 0;
+    mDispatch.vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount, nullptr);
+
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    mDispatch.vkGetPhysicalDeviceQueueFamilyProperties(device, &queueFamilyCount,
+                                                       queueFamilies.data());
+    queueFamilies.resize(queueFamilyCount);
+
+    return queueFamilies;
+}
+
+std::vector<VkExtensionProperties> VkSession::vkEnumerateDeviceExtensionProperties(
+        VkPhysicalDevice device) {
+    VkResult result;
+
+    uint32_t extensionCount = 0;
+    result = mDispatch.vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount,
+                                                            nullptr);
+    if (result != VK_SUCCESS) {
+        LOGE("Failed to enumerate Vulkan device extensions: %d", result);
+        return {};
+    }
+
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    result = mDispatch.vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount,
+                                                            extensions.data());
+    if (result != VK_SUCCESS && result != VK_INCOMPLETE) {
+        LOGE("Failed to enumerate Vulkan device extensions: %d", result);
+        return {};
+    }
+    extensions.resize(extensionCount);
+
+    return extensions;
+}
+
+bool VkSession::hasDeviceExtension(VkPhysicalDevice device, const char *extensionName) {
+    auto extensions = vkEnumerateDeviceExtensionProperties(device);
+
+    return std::any_of(extensions.begin(), extensions.end(), [=](const auto &extension) {
+        return strcmp(extension.extensionName, extensionName) == 0;
+    });
+}
+
 std::unique_ptr<VkSession> VkSession::create(const VkInstanceCreateInfo *pCreateInfo,
                                              const VkAllocationCallbacks *pAllocator) {
     try {
@@ -64,3 +132,35 @@ std::unique_ptr<VkSession> VkSession::create(const VkInstanceCreateInfo *pCreate
         return nullptr;
     }
 }
+
+std::unique_ptr<VkSession> VkSession::createHeadless() {
+    if (!IsVulkanSupported()) {
+        LOGE("Failed to create Vulkan session: Vulkan not supported");
+        return nullptr;
+    }
+
+    // Vulkan 1.0 loaders don't export vkEnumerateInstanceVersion and fail on any other version
+    uint32_t apiVersion = VK_API_VERSION_1_0;
+    if (vkEnumerateInstanceVersion != nullptr &&
+        vkEnumerateInstanceVersion(&apiVersion) != VK_SUCCESS) {
+        apiVersion = VK_API_VERSION_1_0;
+    }
+
+    VkApplicationInfo appInfo{
+            .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+            .pApplicationName = "Athena",
+            .applicationVersion = VK_MAKE_VERSION(1, 0, 0),
+            .pEngineName = "No Engine",
+            .engineVersion = VK_MAKE_VERSION(1, 0, 0),
+            .apiVersion = std::min(apiVersion, kMaxApiVersion),
+    };
+
+    VkInstanceCreateInfo createInfo{
+            .sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+            .pApplicationInfo = &appInfo,
+            .enabledLayerCount = 0,
+            .enabledExtensionCount = 0,
+    };
+
+    return create(&createInfo, nullptr);
+}
@@ -22,10 +22,42 @@ public:
     static std::unique_ptr<VkSession>
     create(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator);
 
+    /**
+     * Create an instance without any extension, usable for compute and transfer work on any
+     * platform, including GPU-less Linux machines with Mesa lavapipe.
+     * The API version is the loader one, capped to kMaxApiVersion.
+     */
+    static std::unique_ptr<VkSession> createHeadless();
+
+    /**
+     * The apiVersion the instance was created with, device level functionality above it can't
+     * be used even if the device supports it.
+     */
+    uint32_t getApiVersion() const;
+
+    /**
+     * The instance level entry points of this instance.
+     */
+    const VkInstanceDispatch &getDispatch() const;
+
     VkPhysicalDeviceProperties vkGetPhysicalDeviceProperties(VkPhysicalDevice device);
 
+    VkPhysicalDeviceMemoryProperties vkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice device);
+
+    std::vector<VkQueueFamilyProperties> vkGetPhysicalDeviceQueueFamilyProperties(
+            VkPhysicalDevice device);
+
+    std::vector<VkExtensionProperties> vkEnumerateDeviceExtensionProperties(
+            VkPhysicalDevice device);
+
+    bool hasDeviceExtension(VkPhysicalDevice device, const char *extensionName);
+
+    static constexpr uint32_t kMaxApiVersion = VK_API_VERSION_1_2;
+
 private:
     VkSession(const VkInstanceCreateInfo *pCreateInfo, const VkAllocationCallbacks *pAllocator);
 
     VkInstance mInstance = nullptr;
+    VkInstanceDispatch mDispatch;
+    uint32_t mApiVersion = VK_API_VERSION_1_0;
 };
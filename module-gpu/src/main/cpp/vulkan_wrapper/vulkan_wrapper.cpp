@@ -4,407 +4,279 @@
 
 // This file is generated.
 
+#define LOG_TAG "VulkanWrapper"
+
 #include "vulkan_wrapper.h"
+#include <chrono>
 #include <dlfcn.h>
+#include "../logging.h"
+
+static long long elapsedUs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+}
 
 /*
- * Initialize the Vulkan function pointer variables declared in this header.
+ * Load libvulkan.so and initialize the global function pointer variables declared in this header,
+ * the rest is resolved per instance and device by InitVulkanInstance() and InitVulkanDevice().
  * Returns UNSUPPORTED if vulkan is not available, SUPPORTED if it is available.
  */
 static VulkanWrapperStatus InitVulkan() {
+    auto start = std::chrono::steady_clock::now();
+
+#ifdef __ANDROID__
     void* libvulkan = dlopen("libvulkan.so", RTLD_NOW | RTLD_LOCAL);
+#else
+    // Desktop Linux only ships the versioned loader without the development package
+    void* libvulkan = dlopen("libvulkan.so.1", RTLD_NOW | RTLD_LOCAL);
+#endif
     if (!libvulkan) {
         return UNSUPPORTED;
     }
 
-    // Vulkan supported, set function addresses
-    vkCreateInstance = reinterpret_cast<PFN_vkCreateInstance>(dlsym(libvulkan, "vkCreateInstance"));
-    vkDestroyInstance = reinterpret_cast<PFN_vkDestroyInstance>(dlsym(libvulkan, "vkDestroyInstance"));
-    vkEnumeratePhysicalDevices = reinterpret_cast<PFN_vkEnumeratePhysicalDevices>(dlsym(libvulkan, "vkEnumeratePhysicalDevices"));
-    vkGetPhysicalDeviceFeatures = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures>(dlsym(libvulkan, "vkGetPhysicalDeviceFeatures"));
-    vkGetPhysicalDeviceFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceFormatProperties>(dlsym(libvulkan, "vkGetPhysicalDeviceFormatProperties"));
-    vkGetPhysicalDeviceImageFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceImageFormatProperties>(dlsym(libvulkan, "vkGetPhysicalDeviceImageFormatProperties"));
-    vkGetPhysicalDeviceProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties>(dlsym(libvulkan, "vkGetPhysicalDeviceProperties"));
-    vkGetPhysicalDeviceQueueFamilyProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceQueueFamilyProperties>(dlsym(libvulkan, "vkGetPhysicalDeviceQueueFamilyProperties"));
-    vkGetPhysicalDeviceMemoryProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties>(dlsym(libvulkan, "vkGetPhysicalDeviceMemoryProperties"));
+    // The only symbol looked up with dlsym, the loader hands out everything else
     vkGetInstanceProcAddr = reinterpret_cast<PFN_vkGetInstanceProcAddr>(dlsym(libvulkan, "vkGetInstanceProcAddr"));
-    vkGetDeviceProcAddr = reinterpret_cast<PFN_vkGetDeviceProcAddr>(dlsym(libvulkan, "vkGetDeviceProcAddr"));
-    vkCreateDevice = reinterpret_cast<PFN_vkCreateDevice>(dlsym(libvulkan, "vkCreateDevice"));
-    vkDestroyDevice = reinterpret_cast<PFN_vkDestroyDevice>(dlsym(libvulkan, "vkDestroyDevice"));
-    vkEnumerateInstanceExtensionProperties = reinterpret_cast<PFN_vkEnumerateInstanceExtensionProperties>(dlsym(libvulkan, "vkEnumerateInstanceExtensionProperties"));
-    vkEnumerateDeviceExtensionProperties = reinterpret_cast<PFN_vkEnumerateDeviceExtensionProperties>(dlsym(libvulkan, "vkEnumerateDeviceExtensionProperties"));
-    vkEnumerateInstanceLayerProperties = reinterpret_cast<PFN_vkEnumerateInstanceLayerProperties>(dlsym(libvulkan, "vkEnumerateInstanceLayerProperties"));
-    vkEnumerateDeviceLayerProperties = reinterpret_cast<PFN_vkEnumerateDeviceLayerProperties>(dlsym(libvulkan, "vkEnumerateDeviceLayerProperties"));
-    vkGetDeviceQueue = reinterpret_cast<PFN_vkGetDeviceQueue>(dlsym(libvulkan, "vkGetDeviceQueue"));
-    vkQueueSubmit = reinterpret_cast<PFN_vkQueueSubmit>(dlsym(libvulkan, "vkQueueSubmit"));
-    vkQueueWaitIdle = reinterpret_cast<PFN_vkQueueWaitIdle>(dlsym(libvulkan, "vkQueueWaitIdle"));
-    vkDeviceWaitIdle = reinterpret_cast<PFN_vkDeviceWaitIdle>(dlsym(libvulkan, "vkDeviceWaitIdle"));
-    vkAllocateMemory = reinterpret_cast<PFN_vkAllocateMemory>(dlsym(libvulkan, "vkAllocateMemory"));
-    vkFreeMemory = reinterpret_cast<PFN_vkFreeMemory>(dlsym(libvulkan, "vkFreeMemory"));
-    vkMapMemory = reinterpret_cast<PFN_vkMapMemory>(dlsym(libvulkan, "vkMapMemory"));
-    vkUnmapMemory = reinterpret_cast<PFN_vkUnmapMemory>(dlsym(libvulkan, "vkUnmapMemory"));
-    vkFlushMappedMemoryRanges = reinterpret_cast<PFN_vkFlushMappedMemoryRanges>(dlsym(libvulkan, "vkFlushMappedMemoryRanges"));
-    vkInvalidateMappedMemoryRanges = reinterpret_cast<PFN_vkInvalidateMappedMemoryRanges>(dlsym(libvulkan, "vkInvalidateMappedMemoryRanges"));
-    vkGetDeviceMemoryCommitment = reinterpret_cast<PFN_vkGetDeviceMemoryCommitment>(dlsym(libvulkan, "vkGetDeviceMemoryCommitment"));
-    vkBindBufferMemory = reinterpret_cast<PFN_vkBindBufferMemory>(dlsym(libvulkan, "vkBindBufferMemory"));
-    vkBindImageMemory = reinterpret_cast<PFN_vkBindImageMemory>(dlsym(libvulkan, "vkBindImageMemory"));
-    vkGetBufferMemoryRequirements = reinterpret_cast<PFN_vkGetBufferMemoryRequirements>(dlsym(libvulkan, "vkGetBufferMemoryRequirements"));
-    vkGetImageMemoryRequirements = reinterpret_cast<PFN_vkGetImageMemoryRequirements>(dlsym(libvulkan, "vkGetImageMemoryRequirements"));
-    vkGetImageSparseMemoryRequirements = reinterpret_cast<PFN_vkGetImageSparseMemoryRequirements>(dlsym(libvulkan, "vkGetImageSparseMemoryRequirements"));
-    vkGetPhysicalDeviceSparseImageFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceSparseImageFormatProperties>(dlsym(libvulkan, "vkGetPhysicalDeviceSparseImageFormatProperties"));
-    vkQueueBindSparse = reinterpret_cast<PFN_vkQueueBindSparse>(dlsym(libvulkan, "vkQueueBindSparse"));
-    vkCreateFence = reinterpret_cast<PFN_vkCreateFence>(dlsym(libvulkan, "vkCreateFence"));
-    vkDestroyFence = reinterpret_cast<PFN_vkDestroyFence>(dlsym(libvulkan, "vkDestroyFence"));
-    vkResetFences = reinterpret_cast<PFN_vkResetFences>(dlsym(libvulkan, "vkResetFences"));
-    vkGetFenceStatus = reinterpret_cast<PFN_vkGetFenceStatus>(dlsym(libvulkan, "vkGetFenceStatus"));
-    vkWaitForFences = reinterpret_cast<PFN_vkWaitForFences>(dlsym(libvulkan, "vkWaitForFences"));
-    vkCreateSemaphore = reinterpret_cast<PFN_vkCreateSemaphore>(dlsym(libvulkan, "vkCreateSemaphore"));
-    vkDestroySemaphore = reinterpret_cast<PFN_vkDestroySemaphore>(dlsym(libvulkan, "vkDestroySemaphore"));
-    vkCreateEvent = reinterpret_cast<PFN_vkCreateEvent>(dlsym(libvulkan, "vkCreateEvent"));
-    vkDestroyEvent = reinterpret_cast<PFN_vkDestroyEvent>(dlsym(libvulkan, "vkDestroyEvent"));
-    vkGetEventStatus = reinterpret_cast<PFN_vkGetEventStatus>(dlsym(libvulkan, "vkGetEventStatus"));
-    vkSetEvent = reinterpret_cast<PFN_vkSetEvent>(dlsym(libvulkan, "vkSetEvent"));
-    vkResetEvent = reinterpret_cast<PFN_vkResetEvent>(dlsym(libvulkan, "vkResetEvent"));
-    vkCreateQueryPool = reinterpret_cast<PFN_vkCreateQueryPool>(dlsym(libvulkan, "vkCreateQueryPool"));
-    vkDestroyQueryPool = reinterpret_cast<PFN_vkDestroyQueryPool>(dlsym(libvulkan, "vkDestroyQueryPool"));
-    vkGetQueryPoolResults = reinterpret_cast<PFN_vkGetQueryPoolResults>(dlsym(libvulkan, "vkGetQueryPoolResults"));
-    vkCreateBuffer = reinterpret_cast<PFN_vkCreateBuffer>(dlsym(libvulkan, "vkCreateBuffer"));
-    vkDestroyBuffer = reinterpret_cast<PFN_vkDestroyBuffer>(dlsym(libvulkan, "vkDestroyBuffer"));
-    vkCreateBufferView = reinterpret_cast<PFN_vkCreateBufferView>(dlsym(libvulkan, "vkCreateBufferView"));
-    vkDestroyBufferView = reinterpret_cast<PFN_vkDestroyBufferView>(dlsym(libvulkan, "vkDestroyBufferView"));
-    vkCreateImage = reinterpret_cast<PFN_vkCreateImage>(dlsym(libvulkan, "vkCreateImage"));
-    vkDestroyImage = reinterpret_cast<PFN_vkDestroyImage>(dlsym(libvulkan, "vkDestroyImage"));
-    vkGetImageSubresourceLayout = reinterpret_cast<PFN_vkGetImageSubresourceLayout>(dlsym(libvulkan, "vkGetImageSubresourceLayout"));
-    vkCreateImageView = reinterpret_cast<PFN_vkCreateImageView>(dlsym(libvulkan, "vkCreateImageView"));
-    vkDestroyImageView = reinterpret_cast<PFN_vkDestroyImageView>(dlsym(libvulkan, "vkDestroyImageView"));
-    vkCreateShaderModule = reinterpret_cast<PFN_vkCreateShaderModule>(dlsym(libvulkan, "vkCreateShaderModule"));
-    vkDestroyShaderModule = reinterpret_cast<PFN_vkDestroyShaderModule>(dlsym(libvulkan, "vkDestroyShaderModule"));
-    vkCreatePipelineCache = reinterpret_cast<PFN_vkCreatePipelineCache>(dlsym(libvulkan, "vkCreatePipelineCache"));
-    vkDestroyPipelineCache = reinterpret_cast<PFN_vkDestroyPipelineCache>(dlsym(libvulkan, "vkDestroyPipelineCache"));
-    vkGetPipelineCacheData = reinterpret_cast<PFN_vkGetPipelineCacheData>(dlsym(libvulkan, "vkGetPipelineCacheData"));
-    vkMergePipelineCaches = reinterpret_cast<PFN_vkMergePipelineCaches>(dlsym(libvulkan, "vkMergePipelineCaches"));
-    vkCreateGraphicsPipelines = reinterpret_cast<PFN_vkCreateGraphicsPipelines>(dlsym(libvulkan, "vkCreateGraphicsPipelines"));
-    vkCreateComputePipelines = reinterpret_cast<PFN_vkCreateComputePipelines>(dlsym(libvulkan, "vkCreateComputePipelines"));
-    vkDestroyPipeline = reinterpret_cast<PFN_vkDestroyPipeline>(dlsym(libvulkan, "vkDestroyPipeline"));
-    vkCreatePipelineLayout = reinterpret_cast<PFN_vkCreatePipelineLayout>(dlsym(libvulkan, "vkCreatePipelineLayout"));
-    vkDestroyPipelineLayout = reinterpret_cast<PFN_vkDestroyPipelineLayout>(dlsym(libvulkan, "vkDestroyPipelineLayout"));
-    vkCreateSampler = reinterpret_cast<PFN_vkCreateSampler>(dlsym(libvulkan, "vkCreateSampler"));
-    vkDestroySampler = reinterpret_cast<PFN_vkDestroySampler>(dlsym(libvulkan, "vkDestroySampler"));
-    vkCreateDescriptorSetLayout = reinterpret_cast<PFN_vkCreateDescriptorSetLayout>(dlsym(libvulkan, "vkCreateDescriptorSetLayout"));
-    vkDestroyDescriptorSetLayout = reinterpret_cast<PFN_vkDestroyDescriptorSetLayout>(dlsym(libvulkan, "vkDestroyDescriptorSetLayout"));
-    vkCreateDescriptorPool = reinterpret_cast<PFN_vkCreateDescriptorPool>(dlsym(libvulkan, "vkCreateDescriptorPool"));
-    vkDestroyDescriptorPool = reinterpret_cast<PFN_vkDestroyDescriptorPool>(dlsym(libvulkan, "vkDestroyDescriptorPool"));
-    vkResetDescriptorPool = reinterpret_cast<PFN_vkResetDescriptorPool>(dlsym(libvulkan, "vkResetDescriptorPool"));
-    vkAllocateDescriptorSets = reinterpret_cast<PFN_vkAllocateDescriptorSets>(dlsym(libvulkan, "vkAllocateDescriptorSets"));
-    vkFreeDescriptorSets = reinterpret_cast<PFN_vkFreeDescriptorSets>(dlsym(libvulkan, "vkFreeDescriptorSets"));
-    vkUpdateDescriptorSets = reinterpret_cast<PFN_vkUpdateDescriptorSets>(dlsym(libvulkan, "vkUpdateDescriptorSets"));
-    vkCreateFramebuffer = reinterpret_cast<PFN_vkCreateFramebuffer>(dlsym(libvulkan, "vkCreateFramebuffer"));
-    vkDestroyFramebuffer = reinterpret_cast<PFN_vkDestroyFramebuffer>(dlsym(libvulkan, "vkDestroyFramebuffer"));
-    vkCreateRenderPass = reinterpret_cast<PFN_vkCreateRenderPass>(dlsym(libvulkan, "vkCreateRenderPass"));
-    vkDestroyRenderPass = reinterpret_cast<PFN_vkDestroyRenderPass>(dlsym(libvulkan, "vkDestroyRenderPass"));
-    vkGetRenderAreaGranularity = reinterpret_cast<PFN_vkGetRenderAreaGranularity>(dlsym(libvulkan, "vkGetRenderAreaGranularity"));
-    vkCreateCommandPool = reinterpret_cast<PFN_vkCreateCommandPool>(dlsym(libvulkan, "vkCreateCommandPool"));
-    vkDestroyCommandPool = reinterpret_cast<PFN_vkDestroyCommandPool>(dlsym(libvulkan, "vkDestroyCommandPool"));
-    vkResetCommandPool = reinterpret_cast<PFN_vkResetCommandPool>(dlsym(libvulkan, "vkResetCommandPool"));
-    vkAllocateCommandBuffers = reinterpret_cast<PFN_vkAllocateCommandBuffers>(dlsym(libvulkan, "vkAllocateCommandBuffers"));
-    vkFreeCommandBuffers = reinterpret_cast<PFN_vkFreeCommandBuffers>(dlsym(libvulkan, "vkFreeCommandBuffers"));
-    vkBeginCommandBuffer = reinterpret_cast<PFN_vkBeginCommandBuffer>(dlsym(libvulkan, "vkBeginCommandBuffer"));
-    vkEndCommandBuffer = reinterpret_cast<PFN_vkEndCommandBuffer>(dlsym(libvulkan, "vkEndCommandBuffer"));
-    vkResetCommandBuffer = reinterpret_cast<PFN_vkResetCommandBuffer>(dlsym(libvulkan, "vkResetCommandBuffer"));
-    vkCmdBindPipeline = reinterpret_cast<PFN_vkCmdBindPipeline>(dlsym(libvulkan, "vkCmdBindPipeline"));
-    vkCmdSetViewport = reinterpret_cast<PFN_vkCmdSetViewport>(dlsym(libvulkan, "vkCmdSetViewport"));
-    vkCmdSetScissor = reinterpret_cast<PFN_vkCmdSetScissor>(dlsym(libvulkan, "vkCmdSetScissor"));
-    vkCmdSetLineWidth = reinterpret_cast<PFN_vkCmdSetLineWidth>(dlsym(libvulkan, "vkCmdSetLineWidth"));
-    vkCmdSetDepthBias = reinterpret_cast<PFN_vkCmdSetDepthBias>(dlsym(libvulkan, "vkCmdSetDepthBias"));
-    vkCmdSetBlendConstants = reinterpret_cast<PFN_vkCmdSetBlendConstants>(dlsym(libvulkan, "vkCmdSetBlendConstants"));
-    vkCmdSetDepthBounds = reinterpret_cast<PFN_vkCmdSetDepthBounds>(dlsym(libvulkan, "vkCmdSetDepthBounds"));
-    vkCmdSetStencilCompareMask = reinterpret_cast<PFN_vkCmdSetStencilCompareMask>(dlsym(libvulkan, "vkCmdSetStencilCompareMask"));
-    vkCmdSetStencilWriteMask = reinterpret_cast<PFN_vkCmdSetStencilWriteMask>(dlsym(libvulkan, "vkCmdSetStencilWriteMask"));
-    vkCmdSetStencilReference = reinterpret_cast<PFN_vkCmdSetStencilReference>(dlsym(libvulkan, "vkCmdSetStencilReference"));
-    vkCmdBindDescriptorSets = reinterpret_cast<PFN_vkCmdBindDescriptorSets>(dlsym(libvulkan, "vkCmdBindDescriptorSets"));
-    vkCmdBindIndexBuffer = reinterpret_cast<PFN_vkCmdBindIndexBuffer>(dlsym(libvulkan, "vkCmdBindIndexBuffer"));
-    vkCmdBindVertexBuffers = reinterpret_cast<PFN_vkCmdBindVertexBuffers>(dlsym(libvulkan, "vkCmdBindVertexBuffers"));
-    vkCmdDraw = reinterpret_cast<PFN_vkCmdDraw>(dlsym(libvulkan, "vkCmdDraw"));
-    vkCmdDrawIndexed = reinterpret_cast<PFN_vkCmdDrawIndexed>(dlsym(libvulkan, "vkCmdDrawIndexed"));
-    vkCmdDrawIndirect = reinterpret_cast<PFN_vkCmdDrawIndirect>(dlsym(libvulkan, "vkCmdDrawIndirect"));
-    vkCmdDrawIndexedIndirect = reinterpret_cast<PFN_vkCmdDrawIndexedIndirect>(dlsym(libvulkan, "vkCmdDrawIndexedIndirect"));
-    vkCmdDispatch = reinterpret_cast<PFN_vkCmdDispatch>(dlsym(libvulkan, "vkCmdDispatch"));
-    vkCmdDispatchIndirect = reinterpret_cast<PFN_vkCmdDispatchIndirect>(dlsym(libvulkan, "vkCmdDispatchIndirect"));
-    vkCmdCopyBuffer = reinterpret_cast<PFN_vkCmdCopyBuffer>(dlsym(libvulkan, "vkCmdCopyBuffer"));
-    vkCmdCopyImage = reinterpret_cast<PFN_vkCmdCopyImage>(dlsym(libvulkan, "vkCmdCopyImage"));
-    vkCmdBlitImage = reinterpret_cast<PFN_vkCmdBlitImage>(dlsym(libvulkan, "vkCmdBlitImage"));
-    vkCmdCopyBufferToImage = reinterpret_cast<PFN_vkCmdCopyBufferToImage>(dlsym(libvulkan, "vkCmdCopyBufferToImage"));
-    vkCmdCopyImageToBuffer = reinterpret_cast<PFN_vkCmdCopyImageToBuffer>(dlsym(libvulkan, "vkCmdCopyImageToBuffer"));
-    vkCmdUpdateBuffer = reinterpret_cast<PFN_vkCmdUpdateBuffer>(dlsym(libvulkan, "vkCmdUpdateBuffer"));
-    vkCmdFillBuffer = reinterpret_cast<PFN_vkCmdFillBuffer>(dlsym(libvulkan, "vkCmdFillBuffer"));
-    vkCmdClearColorImage = reinterpret_cast<PFN_vkCmdClearColorImage>(dlsym(libvulkan, "vkCmdClearColorImage"));
-    vkCmdClearDepthStencilImage = reinterpret_cast<PFN_vkCmdClearDepthStencilImage>(dlsym(libvulkan, "vkCmdClearDepthStencilImage"));
-    vkCmdClearAttachments = reinterpret_cast<PFN_vkCmdClearAttachments>(dlsym(libvulkan, "vkCmdClearAttachments"));
-    vkCmdResolveImage = reinterpret_cast<PFN_vkCmdResolveImage>(dlsym(libvulkan, "vkCmdResolveImage"));
-    vkCmdSetEvent = reinterpret_cast<PFN_vkCmdSetEvent>(dlsym(libvulkan, "vkCmdSetEvent"));
-    vkCmdResetEvent = reinterpret_cast<PFN_vkCmdResetEvent>(dlsym(libvulkan, "vkCmdResetEvent"));
-    vkCmdWaitEvents = reinterpret_cast<PFN_vkCmdWaitEvents>(dlsym(libvulkan, "vkCmdWaitEvents"));
-    vkCmdPipelineBarrier = reinterpret_cast<PFN_vkCmdPipelineBarrier>(dlsym(libvulkan, "vkCmdPipelineBarrier"));
-    vkCmdBeginQuery = reinterpret_cast<PFN_vkCmdBeginQuery>(dlsym(libvulkan, "vkCmdBeginQuery"));
-    vkCmdEndQuery = reinterpret_cast<PFN_vkCmdEndQuery>(dlsym(libvulkan, "vkCmdEndQuery"));
-    vkCmdResetQueryPool = reinterpret_cast<PFN_vkCmdResetQueryPool>(dlsym(libvulkan, "vkCmdResetQueryPool"));
-    vkCmdWriteTimestamp = reinterpret_cast<PFN_vkCmdWriteTimestamp>(dlsym(libvulkan, "vkCmdWriteTimestamp"));
-    vkCmdCopyQueryPoolResults = reinterpret_cast<PFN_vkCmdCopyQueryPoolResults>(dlsym(libvulkan, "vkCmdCopyQueryPoolResults"));
-    vkCmdPushConstants = reinterpret_cast<PFN_vkCmdPushConstants>(dlsym(libvulkan, "vkCmdPushConstants"));
-    vkCmdBeginRenderPass = reinterpret_cast<PFN_vkCmdBeginRenderPass>(dlsym(libvulkan, "vkCmdBeginRenderPass"));
-    vkCmdNextSubpass = reinterpret_cast<PFN_vkCmdNextSubpass>(dlsym(libvulkan, "vkCmdNextSubpass"));
-    vkCmdEndRenderPass = reinterpret_cast<PFN_vkCmdEndRenderPass>(dlsym(libvulkan, "vkCmdEndRenderPass"));
-    vkCmdExecuteCommands = reinterpret_cast<PFN_vkCmdExecuteCommands>(dlsym(libvulkan, "vkCmdExecuteCommands"));
-    vkDestroySurfaceKHR = reinterpret_cast<PFN_vkDestroySurfaceKHR>(dlsym(libvulkan, "vkDestroySurfaceKHR"));
-    vkGetPhysicalDeviceSurfaceSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceSupportKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceSurfaceSupportKHR"));
-    vkGetPhysicalDeviceSurfaceCapabilitiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"));
-    vkGetPhysicalDeviceSurfaceFormatsKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceFormatsKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceSurfaceFormatsKHR"));
-    vkGetPhysicalDeviceSurfacePresentModesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfacePresentModesKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceSurfacePresentModesKHR"));
-    vkCreateSwapchainKHR = reinterpret_cast<PFN_vkCreateSwapchainKHR>(dlsym(libvulkan, "vkCreateSwapchainKHR"));
-    vkDestroySwapchainKHR = reinterpret_cast<PFN_vkDestroySwapchainKHR>(dlsym(libvulkan, "vkDestroySwapchainKHR"));
-    vkGetSwapchainImagesKHR = reinterpret_cast<PFN_vkGetSwapchainImagesKHR>(dlsym(libvulkan, "vkGetSwapchainImagesKHR"));
-    vkAcquireNextImageKHR = reinterpret_cast<PFN_vkAcquireNextImageKHR>(dlsym(libvulkan, "vkAcquireNextImageKHR"));
-    vkQueuePresentKHR = reinterpret_cast<PFN_vkQueuePresentKHR>(dlsym(libvulkan, "vkQueuePresentKHR"));
-    vkGetPhysicalDeviceDisplayPropertiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceDisplayPropertiesKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceDisplayPropertiesKHR"));
-    vkGetPhysicalDeviceDisplayPlanePropertiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceDisplayPlanePropertiesKHR"));
-    vkGetDisplayPlaneSupportedDisplaysKHR = reinterpret_cast<PFN_vkGetDisplayPlaneSupportedDisplaysKHR>(dlsym(libvulkan, "vkGetDisplayPlaneSupportedDisplaysKHR"));
-    vkGetDisplayModePropertiesKHR = reinterpret_cast<PFN_vkGetDisplayModePropertiesKHR>(dlsym(libvulkan, "vkGetDisplayModePropertiesKHR"));
-    vkCreateDisplayModeKHR = reinterpret_cast<PFN_vkCreateDisplayModeKHR>(dlsym(libvulkan, "vkCreateDisplayModeKHR"));
-    vkGetDisplayPlaneCapabilitiesKHR = reinterpret_cast<PFN_vkGetDisplayPlaneCapabilitiesKHR>(dlsym(libvulkan, "vkGetDisplayPlaneCapabilitiesKHR"));
-    vkCreateDisplayPlaneSurfaceKHR = reinterpret_cast<PFN_vkCreateDisplayPlaneSurfaceKHR>(dlsym(libvulkan, "vkCreateDisplayPlaneSurfaceKHR"));
-    vkCreateSharedSwapchainsKHR = reinterpret_cast<PFN_vkCreateSharedSwapchainsKHR>(dlsym(libvulkan, "vkCreateSharedSwapchainsKHR"));
-
-#ifdef VK_USE_PLATFORM_XLIB_KHR
-    vkCreateXlibSurfaceKHR = reinterpret_cast<PFN_vkCreateXlibSurfaceKHR>(dlsym(libvulkan, "vkCreateXlibSurfaceKHR"));
-    vkGetPhysicalDeviceXlibPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceXlibPresentationSupportKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceXlibPresentationSupportKHR"));
-#endif
-
-#ifdef VK_USE_PLATFORM_XCB_KHR
-    vkCreateXcbSurfaceKHR = reinterpret_cast<PFN_vkCreateXcbSurfaceKHR>(dlsym(libvulkan, "vkCreateXcbSurfaceKHR"));
-    vkGetPhysicalDeviceXcbPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceXcbPresentationSupportKHR"));
-#endif
-
-#ifdef VK_USE_PLATFORM_WAYLAND_KHR
-    vkCreateWaylandSurfaceKHR = reinterpret_cast<PFN_vkCreateWaylandSurfaceKHR>(dlsym(libvulkan, "vkCreateWaylandSurfaceKHR"));
-    vkGetPhysicalDeviceWaylandPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceWaylandPresentationSupportKHR"));
-#endif
+    if (!vkGetInstanceProcAddr) {
+        return UNSUPPORTED;
+    }
 
-#ifdef VK_USE_PLATFORM_MIR_KHR
-    vkCreateMirSurfaceKHR = reinterpret_cast<PFN_vkCreateMirSurfaceKHR>(dlsym(libvulkan, "vkCreateMirSurfaceKHR"));
-    vkGetPhysicalDeviceMirPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceMirPresentationSupportKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceMirPresentationSupportKHR"));
-#endif
+    vkCreateInstance = reinterpret_cast<PFN_vkCreateInstance>(vkGetInstanceProcAddr(nullptr, "vkCreateInstance"));
+    vkEnumerateInstanceExtensionProperties = reinterpret_cast<PFN_vkEnumerateInstanceExtensionProperties>(vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceExtensionProperties"));
+    vkEnumerateInstanceLayerProperties = reinterpret_cast<PFN_vkEnumerateInstanceLayerProperties>(vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceLayerProperties"));
+    vkEnumerateInstanceVersion = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
 
-#ifdef VK_USE_PLATFORM_ANDROID_KHR
-    vkCreateAndroidSurfaceKHR = reinterpret_cast<PFN_vkCreateAndroidSurfaceKHR>(dlsym(libvulkan, "vkCreateAndroidSurfaceKHR"));
-#endif
-
-#ifdef VK_USE_PLATFORM_WIN32_KHR
-    vkCreateWin32SurfaceKHR = reinterpret_cast<PFN_vkCreateWin32SurfaceKHR>(dlsym(libvulkan, "vkCreateWin32SurfaceKHR"));
-    vkGetPhysicalDeviceWin32PresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR>(dlsym(libvulkan, "vkGetPhysicalDeviceWin32PresentationSupportKHR"));
-#endif
-#ifdef USE_DEBUG_EXTENTIONS
-    vkCreateDebugReportCallbackEXT = reinterpret_cast<PFN_vkCreateDebugReportCallbackEXT>(dlsym(libvulkan, "vkCreateDebugReportCallbackEXT"));
-    vkDestroyDebugReportCallbackEXT = reinterpret_cast<PFN_vkDestroyDebugReportCallbackEXT>(dlsym(libvulkan, "vkDestroyDebugReportCallbackEXT"));
-    vkDebugReportMessageEXT = reinterpret_cast<PFN_vkDebugReportMessageEXT>(dlsym(libvulkan, "vkDebugReportMessageEXT"));
-#endif
+    LOGI("Loaded libvulkan.so in %lld us", elapsedUs(start));
 
     return SUPPORTED;
 }
 
-VulkanWrapperStatus kVulkanWrapperStatus = InitVulkan();
-
 bool IsVulkanSupported() {
-    return kVulkanWrapperStatus == SUPPORTED;
+    // Loaded on first use, libvulkan.so isn't needed when serving cached capabilities
+    static VulkanWrapperStatus status = InitVulkan();
+    return status == SUPPORTED;
 }
 
-// No Vulkan support, do not set function addresses
-PFN_vkCreateInstance vkCreateInstance;
-PFN_vkDestroyInstance vkDestroyInstance;
-PFN_vkEnumeratePhysicalDevices vkEnumeratePhysicalDevices;
-PFN_vkGetPhysicalDeviceFeatures vkGetPhysicalDeviceFeatures;
-PFN_vkGetPhysicalDeviceFormatProperties vkGetPhysicalDeviceFormatProperties;
-PFN_vkGetPhysicalDeviceImageFormatProperties vkGetPhysicalDeviceImageFormatProperties;
-PFN_vkGetPhysicalDeviceProperties vkGetPhysicalDeviceProperties;
-PFN_vkGetPhysicalDeviceQueueFamilyProperties vkGetPhysicalDeviceQueueFamilyProperties;
-PFN_vkGetPhysicalDeviceMemoryProperties vkGetPhysicalDeviceMemoryProperties;
-PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
-PFN_vkGetDeviceProcAddr vkGetDeviceProcAddr;
-PFN_vkCreateDevice vkCreateDevice;
-PFN_vkDestroyDevice vkDestroyDevice;
-PFN_vkEnumerateInstanceExtensionProperties vkEnumerateInstanceExtensionProperties;
-PFN_vkEnumerateDeviceExtensionProperties vkEnumerateDeviceExtensionProperties;
-PFN_vkEnumerateInstanceLayerProperties vkEnumerateInstanceLayerProperties;
-PFN_vkEnumerateDeviceLayerProperties vkEnumerateDeviceLayerProperties;
-PFN_vkGetDeviceQueue vkGetDeviceQueue;
-PFN_vkQueueSubmit vkQueueSubmit;
-PFN_vkQueueWaitIdle vkQueueWaitIdle;
-PFN_vkDeviceWaitIdle vkDeviceWaitIdle;
-PFN_vkAllocateMemory vkAllocateMemory;
-PFN_vkFreeMemory vkFreeMemory;
-PFN_vkMapMemory vkMapMemory;
-PFN_vkUnmapMemory vkUnmapMemory;
-PFN_vkFlushMappedMemoryRanges vkFlushMappedMemoryRanges;
-PFN_vkInvalidateMappedMemoryRanges vkInvalidateMappedMemoryRanges;
-PFN_vkGetDeviceMemoryCommitment vkGetDeviceMemoryCommitment;
-PFN_vkBindBufferMemory vkBindBufferMemory;
-PFN_vkBindImageMemory vkBindImageMemory;
-PFN_vkGetBufferMemoryRequirements vkGetBufferMemoryRequirements;
-PFN_vkGetImageMemoryRequirements vkGetImageMemoryRequirements;
-PFN_vkGetImageSparseMemoryRequirements vkGetImageSparseMemoryRequirements;
-PFN_vkGetPhysicalDeviceSparseImageFormatProperties vkGetPhysicalDeviceSparseImageFormatProperties;
-PFN_vkQueueBindSparse vkQueueBindSparse;
-PFN_vkCreateFence vkCreateFence;
-PFN_vkDestroyFence vkDestroyFence;
-PFN_vkResetFences vkResetFences;
-PFN_vkGetFenceStatus vkGetFenceStatus;
-PFN_vkWaitForFences vkWaitForFences;
-PFN_vkCreateSemaphore vkCreateSemaphore;
-PFN_vkDestroySemaphore vkDestroySemaphore;
-PFN_vkCreateEvent vkCreateEvent;
-PFN_vkDestroyEvent vkDestroyEvent;
-PFN_vkGetEventStatus vkGetEventStatus;
-PFN_vkSetEvent vkSetEvent;
-PFN_vkResetEvent vkResetEvent;
-PFN_vkCreateQueryPool vkCreateQueryPool;
-PFN_vkDestroyQueryPool vkDestroyQueryPool;
-PFN_vkGetQueryPoolResults vkGetQueryPoolResults;
-PFN_vkCreateBuffer vkCreateBuffer;
-PFN_vkDestroyBuffer vkDestroyBuffer;
-PFN_vkCreateBufferView vkCreateBufferView;
-PFN_vkDestroyBufferView vkDestroyBufferView;
-PFN_vkCreateImage vkCreateImage;
-PFN_vkDestroyImage vkDestroyImage;
-PFN_vkGetImageSubresourceLayout vkGetImageSubresourceLayout;
-PFN_vkCreateImageView vkCreateImageView;
-PFN_vkDestroyImageView vkDestroyImageView;
-PFN_vkCreateShaderModule vkCreateShaderModule;
-PFN_vkDestroyShaderModule vkDestroyShaderModule;
-PFN_vkCreatePipelineCache vkCreatePipelineCache;
-PFN_vkDestroyPipelineCache vkDestroyPipelineCache;
-PFN_vkGetPipelineCacheData vkGetPipelineCacheData;
-PFN_vkMergePipelineCaches vkMergePipelineCaches;
-PFN_vkCreateGraphicsPipelines vkCreateGraphicsPipelines;
-PFN_vkCreateComputePipelines vkCreateComputePipelines;
-PFN_vkDestroyPipeline vkDestroyPipeline;
-PFN_vkCreatePipelineLayout vkCreatePipelineLayout;
-PFN_vkDestroyPipelineLayout vkDestroyPipelineLayout;
-PFN_vkCreateSampler vkCreateSampler;
-PFN_vkDestroySampler vkDestroySampler;
-PFN_vkCreateDescriptorSetLayout vkCreateDescriptorSetLayout;
-PFN_vkDestroyDescriptorSetLayout vkDestroyDescriptorSetLayout;
-PFN_vkCreateDescriptorPool vkCreateDescriptorPool;
-PFN_vkDestroyDescriptorPool vkDestroyDescriptorPool;
-PFN_vkResetDescriptorPool vkResetDescriptorPool;
-PFN_vkAllocateDescriptorSets vkAllocateDescriptorSets;
-PFN_vkFreeDescriptorSets vkFreeDescriptorSets;
-PFN_vkUpdateDescriptorSets vkUpdateDescriptorSets;
-PFN_vkCreateFramebuffer vkCreateFramebuffer;
-PFN_vkDestroyFramebuffer vkDestroyFramebuffer;
-PFN_vkCreateRenderPass vkCreateRenderPass;
-PFN_vkDestroyRenderPass vkDestroyRenderPass;
-PFN_vkGetRenderAreaGranularity vkGetRenderAreaGranularity;
-PFN_vkCreateCommandPool vkCreateCommandPool;
-PFN_vkDestroyCommandPool vkDestroyCommandPool;
-PFN_vkResetCommandPool vkResetCommandPool;
-PFN_vkAllocateCommandBuffers vkAllocateCommandBuffers;
-PFN_vkFreeCommandBuffers vkFreeCommandBuffers;
-PFN_vkBeginCommandBuffer vkBeginCommandBuffer;
-PFN_vkEndCommandBuffer vkEndCommandBuffer;
-PFN_vkResetCommandBuffer vkResetCommandBuffer;
-PFN_vkCmdBindPipeline vkCmdBindPipeline;
-PFN_vkCmdSetViewport vkCmdSetViewport;
-PFN_vkCmdSetScissor vkCmdSetScissor;
-PFN_vkCmdSetLineWidth vkCmdSetLineWidth;
-PFN_vkCmdSetDepthBias vkCmdSetDepthBias;
-PFN_vkCmdSetBlendConstants vkCmdSetBlendConstants;
-PFN_vkCmdSetDepthBounds vkCmdSetDepthBounds;
-PFN_vkCmdSetStencilCompareMask vkCmdSetStencilCompareMask;
-PFN_vkCmdSetStencilWriteMask vkCmdSetStencilWriteMask;
-PFN_vkCmdSetStencilReference vkCmdSetStencilReference;
-PFN_vkCmdBindDescriptorSets vkCmdBindDescriptorSets;
-PFN_vkCmdBindIndexBuffer vkCmdBindIndexBuffer;
-PFN_vkCmdBindVertexBuffers vkCmdBindVertexBuffers;
-PFN_vkCmdDraw vkCmdDraw;
-PFN_vkCmdDrawIndexed vkCmdDrawIndexed;
-PFN_vkCmdDrawIndirect vkCmdDrawIndirect;
-PFN_vkCmdDrawIndexedIndirect vkCmdDrawIndexedIndirect;
-PFN_vkCmdDispatch vkCmdDispatch;
-PFN_vkCmdDispatchIndirect vkCmdDispatchIndirect;
-PFN_vkCmdCopyBuffer vkCmdCopyBuffer;
-PFN_vkCmdCopyImage vkCmdCopyImage;
-PFN_vkCmdBlitImage vkCmdBlitImage;
-PFN_vkCmdCopyBufferToImage vkCmdCopyBufferToImage;
-PFN_vkCmdCopyImageToBuffer vkCmdCopyImageToBuffer;
-PFN_vkCmdUpdateBuffer vkCmdUpdateBuffer;
-PFN_vkCmdFillBuffer vkCmdFillBuffer;
-PFN_vkCmdClearColorImage vkCmdClearColorImage;
-PFN_vkCmdClearDepthStencilImage vkCmdClearDepthStencilImage;
-PFN_vkCmdClearAttachments vkCmdClearAttachments;
-PFN_vkCmdResolveImage vkCmdResolveImage;
-PFN_vkCmdSetEvent vkCmdSetEvent;
-PFN_vkCmdResetEvent vkCmdResetEvent;
-PFN_vkCmdWaitEvents vkCmdWaitEvents;
-PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier;
-PFN_vkCmdBeginQuery vkCmdBeginQuery;
-PFN_vkCmdEndQuery vkCmdEndQuery;
-PFN_vkCmdResetQueryPool vkCmdResetQueryPool;
-PFN_vkCmdWriteTimestamp vkCmdWriteTimestamp;
-PFN_vkCmdCopyQueryPoolResults vkCmdCopyQueryPoolResults;
-PFN_vkCmdPushConstants vkCmdPushConstants;
-PFN_vkCmdBeginRenderPass vkCmdBeginRenderPass;
-PFN_vkCmdNextSubpass vkCmdNextSubpass;
-PFN_vkCmdEndRenderPass vkCmdEndRenderPass;
-PFN_vkCmdExecuteCommands vkCmdExecuteCommands;
-PFN_vkDestroySurfaceKHR vkDestroySurfaceKHR;
-PFN_vkGetPhysicalDeviceSurfaceSupportKHR vkGetPhysicalDeviceSurfaceSupportKHR;
-PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR vkGetPhysicalDeviceSurfaceCapabilitiesKHR;
-PFN_vkGetPhysicalDeviceSurfaceFormatsKHR vkGetPhysicalDeviceSurfaceFormatsKHR;
-PFN_vkGetPhysicalDeviceSurfacePresentModesKHR vkGetPhysicalDeviceSurfacePresentModesKHR;
-PFN_vkCreateSwapchainKHR vkCreateSwapchainKHR;
-PFN_vkDestroySwapchainKHR vkDestroySwapchainKHR;
-PFN_vkGetSwapchainImagesKHR vkGetSwapchainImagesKHR;
-PFN_vkAcquireNextImageKHR vkAcquireNextImageKHR;
-PFN_vkQueuePresentKHR vkQueuePresentKHR;
-PFN_vkGetPhysicalDeviceDisplayPropertiesKHR vkGetPhysicalDeviceDisplayPropertiesKHR;
-PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR vkGetPhysicalDeviceDisplayPlanePropertiesKHR;
-PFN_vkGetDisplayPlaneSupportedDisplaysKHR vkGetDisplayPlaneSupportedDisplaysKHR;
-PFN_vkGetDisplayModePropertiesKHR vkGetDisplayModePropertiesKHR;
-PFN_vkCreateDisplayModeKHR vkCreateDisplayModeKHR;
-PFN_vkGetDisplayPlaneCapabilitiesKHR vkGetDisplayPlaneCapabilitiesKHR;
-PFN_vkCreateDisplayPlaneSurfaceKHR vkCreateDisplayPlaneSurfaceKHR;
-PFN_vkCreateSharedSwapchainsKHR vkCreateSharedSwapchainsKHR;
+void InitVulkanInstance(VkInstance instance, VkInstanceDispatch *dispatch) {
+    auto start = std::chrono::steady_clock::now();
+
+    // VK_core
+    dispatch->vkDestroyInstance = reinterpret_cast<PFN_vkDestroyInstance>(vkGetInstanceProcAddr(instance, "vkDestroyInstance"));
+    dispatch->vkEnumeratePhysicalDevices = reinterpret_cast<PFN_vkEnumeratePhysicalDevices>(vkGetInstanceProcAddr(instance, "vkEnumeratePhysicalDevices"));
+    dispatch->vkGetPhysicalDeviceFeatures = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures"));
+    dispatch->vkGetPhysicalDeviceFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceFormatProperties>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFormatProperties"));
+    dispatch->vkGetPhysicalDeviceImageFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceImageFormatProperties>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceImageFormatProperties"));
+    dispatch->vkGetPhysicalDeviceProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties"));
+    dispatch->vkGetPhysicalDeviceQueueFamilyProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceQueueFamilyProperties>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceQueueFamilyProperties"));
+    dispatch->vkGetPhysicalDeviceMemoryProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties"));
+    dispatch->vkGetDeviceProcAddr = reinterpret_cast<PFN_vkGetDeviceProcAddr>(vkGetInstanceProcAddr(instance, "vkGetDeviceProcAddr"));
+    dispatch->vkCreateDevice = reinterpret_cast<PFN_vkCreateDevice>(vkGetInstanceProcAddr(instance, "vkCreateDevice"));
+    dispatch->vkEnumerateDeviceExtensionProperties = reinterpret_cast<PFN_vkEnumerateDeviceExtensionProperties>(vkGetInstanceProcAddr(instance, "vkEnumerateDeviceExtensionProperties"));
+    dispatch->vkEnumerateDeviceLayerProperties = reinterpret_cast<PFN_vkEnumerateDeviceLayerProperties>(vkGetInstanceProcAddr(instance, "vkEnumerateDeviceLayerProperties"));
+    dispatch->vkGetPhysicalDeviceSparseImageFormatProperties = reinterpret_cast<PFN_vkGetPhysicalDeviceSparseImageFormatProperties>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSparseImageFormatProperties"));
+
+    // VK_core 1.1
+    dispatch->vkGetPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2"));
+    dispatch->vkGetPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2"));
+
+    // VK_KHR_surface
+    dispatch->vkDestroySurfaceKHR = reinterpret_cast<PFN_vkDestroySurfaceKHR>(vkGetInstanceProcAddr(instance, "vkDestroySurfaceKHR"));
+    dispatch->vkGetPhysicalDeviceSurfaceSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceSupportKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceSupportKHR"));
+    dispatch->vkGetPhysicalDeviceSurfaceCapabilitiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR"));
+    dispatch->vkGetPhysicalDeviceSurfaceFormatsKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfaceFormatsKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfaceFormatsKHR"));
+    dispatch->vkGetPhysicalDeviceSurfacePresentModesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceSurfacePresentModesKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceSurfacePresentModesKHR"));
+
+    // VK_KHR_display
+    dispatch->vkGetPhysicalDeviceDisplayPropertiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceDisplayPropertiesKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceDisplayPropertiesKHR"));
+    dispatch->vkGetPhysicalDeviceDisplayPlanePropertiesKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceDisplayPlanePropertiesKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceDisplayPlanePropertiesKHR"));
+    dispatch->vkGetDisplayPlaneSupportedDisplaysKHR = reinterpret_cast<PFN_vkGetDisplayPlaneSupportedDisplaysKHR>(vkGetInstanceProcAddr(instance, "vkGetDisplayPlaneSupportedDisplaysKHR"));
+    dispatch->vkGetDisplayModePropertiesKHR = reinterpret_cast<PFN_vkGetDisplayModePropertiesKHR>(vkGetInstanceProcAddr(instance, "vkGetDisplayModePropertiesKHR"));
+    dispatch->vkCreateDisplayModeKHR = reinterpret_cast<PFN_vkCreateDisplayModeKHR>(vkGetInstanceProcAddr(instance, "vkCreateDisplayModeKHR"));
+    dispatch->vkGetDisplayPlaneCapabilitiesKHR = reinterpret_cast<PFN_vkGetDisplayPlaneCapabilitiesKHR>(vkGetInstanceProcAddr(instance, "vkGetDisplayPlaneCapabilitiesKHR"));
+    dispatch->vkCreateDisplayPlaneSurfaceKHR = reinterpret_cast<PFN_vkCreateDisplayPlaneSurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateDisplayPlaneSurfaceKHR"));
 
 #ifdef VK_USE_PLATFORM_XLIB_KHR
-PFN_vkCreateXlibSurfaceKHR vkCreateXlibSurfaceKHR;
-PFN_vkGetPhysicalDeviceXlibPresentationSupportKHR vkGetPhysicalDeviceXlibPresentationSupportKHR;
+    // VK_KHR_xlib_surface
+    dispatch->vkCreateXlibSurfaceKHR = reinterpret_cast<PFN_vkCreateXlibSurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateXlibSurfaceKHR"));
+    dispatch->vkGetPhysicalDeviceXlibPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceXlibPresentationSupportKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceXlibPresentationSupportKHR"));
 #endif
 
 #ifdef VK_USE_PLATFORM_XCB_KHR
-PFN_vkCreateXcbSurfaceKHR vkCreateXcbSurfaceKHR;
-PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR vkGetPhysicalDeviceXcbPresentationSupportKHR;
+    // VK_KHR_xcb_surface
+    dispatch->vkCreateXcbSurfaceKHR = reinterpret_cast<PFN_vkCreateXcbSurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateXcbSurfaceKHR"));
+    dispatch->vkGetPhysicalDeviceXcbPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceXcbPresentationSupportKHR"));
 #endif
 
 #ifdef VK_USE_PLATFORM_WAYLAND_KHR
-PFN_vkCreateWaylandSurfaceKHR vkCreateWaylandSurfaceKHR;
-PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR vkGetPhysicalDeviceWaylandPresentationSupportKHR;
+    // VK_KHR_wayland_surface
+    dispatch->vkCreateWaylandSurfaceKHR = reinterpret_cast<PFN_vkCreateWaylandSurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateWaylandSurfaceKHR"));
+    dispatch->vkGetPhysicalDeviceWaylandPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceWaylandPresentationSupportKHR"));
 #endif
 
 #ifdef VK_USE_PLATFORM_MIR_KHR
-PFN_vkCreateMirSurfaceKHR vkCreateMirSurfaceKHR;
-PFN_vkGetPhysicalDeviceMirPresentationSupportKHR vkGetPhysicalDeviceMirPresentationSupportKHR;
+    // VK_KHR_mir_surface
+    dispatch->vkCreateMirSurfaceKHR = reinterpret_cast<PFN_vkCreateMirSurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateMirSurfaceKHR"));
+    dispatch->vkGetPhysicalDeviceMirPresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceMirPresentationSupportKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMirPresentationSupportKHR"));
 #endif
 
 #ifdef VK_USE_PLATFORM_ANDROID_KHR
-PFN_vkCreateAndroidSurfaceKHR vkCreateAndroidSurfaceKHR;
+    // VK_KHR_android_surface
+    dispatch->vkCreateAndroidSurfaceKHR = reinterpret_cast<PFN_vkCreateAndroidSurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateAndroidSurfaceKHR"));
 #endif
 
 #ifdef VK_USE_PLATFORM_WIN32_KHR
-PFN_vkCreateWin32SurfaceKHR vkCreateWin32SurfaceKHR;
-PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR vkGetPhysicalDeviceWin32PresentationSupportKHR;
+    // VK_KHR_win32_surface
+    dispatch->vkCreateWin32SurfaceKHR = reinterpret_cast<PFN_vkCreateWin32SurfaceKHR>(vkGetInstanceProcAddr(instance, "vkCreateWin32SurfaceKHR"));
+    dispatch->vkGetPhysicalDeviceWin32PresentationSupportKHR = reinterpret_cast<PFN_vkGetPhysicalDeviceWin32PresentationSupportKHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceWin32PresentationSupportKHR"));
 #endif
 
 #ifdef USE_DEBUG_EXTENTIONS
-PFN_vkCreateDebugReportCallbackEXT vkCreateDebugReportCallbackEXT;
-PFN_vkDestroyDebugReportCallbackEXT vkDestroyDebugReportCallbackEXT;
-PFN_vkDebugReportMessageEXT vkDebugReportMessageEXT;
+    // VK_EXT_debug_report
+    dispatch->vkCreateDebugReportCallbackEXT = reinterpret_cast<PFN_vkCreateDebugReportCallbackEXT>(vkGetInstanceProcAddr(instance, "vkCreateDebugReportCallbackEXT"));
+    dispatch->vkDestroyDebugReportCallbackEXT = reinterpret_cast<PFN_vkDestroyDebugReportCallbackEXT>(vkGetInstanceProcAddr(instance, "vkDestroyDebugReportCallbackEXT"));
+    dispatch->vkDebugReportMessageEXT = reinterpret_cast<PFN_vkDebugReportMessageEXT>(vkGetInstanceProcAddr(instance, "vkDebugReportMessageEXT"));
 #endif
+
+    LOGI("Resolved the instance entry points in %lld us", elapsedUs(start));
+}
+
+void InitVulkanDevice(const VkInstanceDispatch &instanceDispatch, VkDevice device,
+                      VkDeviceDispatch *dispatch) {
+    // VK_core
+    dispatch->vkDestroyDevice = reinterpret_cast<PFN_vkDestroyDevice>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyDevice"));
+    dispatch->vkGetDeviceQueue = reinterpret_cast<PFN_vkGetDeviceQueue>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetDeviceQueue"));
+    dispatch->vkQueueSubmit = reinterpret_cast<PFN_vkQueueSubmit>(instanceDispatch.vkGetDeviceProcAddr(device, "vkQueueSubmit"));
+    dispatch->vkQueueWaitIdle = reinterpret_cast<PFN_vkQueueWaitIdle>(instanceDispatch.vkGetDeviceProcAddr(device, "vkQueueWaitIdle"));
+    dispatch->vkDeviceWaitIdle = reinterpret_cast<PFN_vkDeviceWaitIdle>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDeviceWaitIdle"));
+    dispatch->vkAllocateMemory = reinterpret_cast<PFN_vkAllocateMemory>(instanceDispatch.vkGetDeviceProcAddr(device, "vkAllocateMemory"));
+    dispatch->vkFreeMemory = reinterpret_cast<PFN_vkFreeMemory>(instanceDispatch.vkGetDeviceProcAddr(device, "vkFreeMemory"));
+    dispatch->vkMapMemory = reinterpret_cast<PFN_vkMapMemory>(instanceDispatch.vkGetDeviceProcAddr(device, "vkMapMemory"));
+    dispatch->vkUnmapMemory = reinterpret_cast<PFN_vkUnmapMemory>(instanceDispatch.vkGetDeviceProcAddr(device, "vkUnmapMemory"));
+    dispatch->vkFlushMappedMemoryRanges = reinterpret_cast<PFN_vkFlushMappedMemoryRanges>(instanceDispatch.vkGetDeviceProcAddr(device, "vkFlushMappedMemoryRanges"));
+    dispatch->vkInvalidateMappedMemoryRanges = reinterpret_cast<PFN_vkInvalidateMappedMemoryRanges>(instanceDispatch.vkGetDeviceProcAddr(device, "vkInvalidateMappedMemoryRanges"));
+    dispatch->vkGetDeviceMemoryCommitment = reinterpret_cast<PFN_vkGetDeviceMemoryCommitment>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetDeviceMemoryCommitment"));
+    dispatch->vkBindBufferMemory = reinterpret_cast<PFN_vkBindBufferMemory>(instanceDispatch.vkGetDeviceProcAddr(device, "vkBindBufferMemory"));
+    dispatch->vkBindImageMemory = reinterpret_cast<PFN_vkBindImageMemory>(instanceDispatch.vkGetDeviceProcAddr(device, "vkBindImageMemory"));
+    dispatch->vkGetBufferMemoryRequirements = reinterpret_cast<PFN_vkGetBufferMemoryRequirements>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetBufferMemoryRequirements"));
+    dispatch->vkGetImageMemoryRequirements = reinterpret_cast<PFN_vkGetImageMemoryRequirements>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetImageMemoryRequirements"));
+    dispatch->vkGetImageSparseMemoryRequirements = reinterpret_cast<PFN_vkGetImageSparseMemoryRequirements>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetImageSparseMemoryRequirements"));
+    dispatch->vkQueueBindSparse = reinterpret_cast<PFN_vkQueueBindSparse>(instanceDispatch.vkGetDeviceProcAddr(device, "vkQueueBindSparse"));
+    dispatch->vkCreateFence = reinterpret_cast<PFN_vkCreateFence>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateFence"));
+    dispatch->vkDestroyFence = reinterpret_cast<PFN_vkDestroyFence>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyFence"));
+    dispatch->vkResetFences = reinterpret_cast<PFN_vkResetFences>(instanceDispatch.vkGetDeviceProcAddr(device, "vkResetFences"));
+    dispatch->vkGetFenceStatus = reinterpret_cast<PFN_vkGetFenceStatus>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetFenceStatus"));
+    dispatch->vkWaitForFences = reinterpret_cast<PFN_vkWaitForFences>(instanceDispatch.vkGetDeviceProcAddr(device, "vkWaitForFences"));
+    dispatch->vkCreateSemaphore = reinterpret_cast<PFN_vkCreateSemaphore>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateSemaphore"));
+    dispatch->vkDestroySemaphore = reinterpret_cast<PFN_vkDestroySemaphore>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroySemaphore"));
+    dispatch->vkCreateEvent = reinterpret_cast<PFN_vkCreateEvent>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateEvent"));
+    dispatch->vkDestroyEvent = reinterpret_cast<PFN_vkDestroyEvent>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyEvent"));
+    dispatch->vkGetEventStatus = reinterpret_cast<PFN_vkGetEventStatus>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetEventStatus"));
+    dispatch->vkSetEvent = reinterpret_cast<PFN_vkSetEvent>(instanceDispatch.vkGetDeviceProcAddr(device, "vkSetEvent"));
+    dispatch->vkResetEvent = reinterpret_cast<PFN_vkResetEvent>(instanceDispatch.vkGetDeviceProcAddr(device, "vkResetEvent"));
+    dispatch->vkCreateQueryPool = reinterpret_cast<PFN_vkCreateQueryPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateQueryPool"));
+    dispatch->vkDestroyQueryPool = reinterpret_cast<PFN_vkDestroyQueryPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyQueryPool"));
+    dispatch->vkGetQueryPoolResults = reinterpret_cast<PFN_vkGetQueryPoolResults>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetQueryPoolResults"));
+    dispatch->vkCreateBuffer = reinterpret_cast<PFN_vkCreateBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateBuffer"));
+    dispatch->vkDestroyBuffer = reinterpret_cast<PFN_vkDestroyBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyBuffer"));
+    dispatch->vkCreateBufferView = reinterpret_cast<PFN_vkCreateBufferView>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateBufferView"));
+    dispatch->vkDestroyBufferView = reinterpret_cast<PFN_vkDestroyBufferView>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyBufferView"));
+    dispatch->vkCreateImage = reinterpret_cast<PFN_vkCreateImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateImage"));
+    dispatch->vkDestroyImage = reinterpret_cast<PFN_vkDestroyImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyImage"));
+    dispatch->vkGetImageSubresourceLayout = reinterpret_cast<PFN_vkGetImageSubresourceLayout>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetImageSubresourceLayout"));
+    dispatch->vkCreateImageView = reinterpret_cast<PFN_vkCreateImageView>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateImageView"));
+    dispatch->vkDestroyImageView = reinterpret_cast<PFN_vkDestroyImageView>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyImageView"));
+    dispatch->vkCreateShaderModule = reinterpret_cast<PFN_vkCreateShaderModule>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateShaderModule"));
+    dispatch->vkDestroyShaderModule = reinterpret_cast<PFN_vkDestroyShaderModule>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyShaderModule"));
+    dispatch->vkCreatePipelineCache = reinterpret_cast<PFN_vkCreatePipelineCache>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreatePipelineCache"));
+    dispatch->vkDestroyPipelineCache = reinterpret_cast<PFN_vkDestroyPipelineCache>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyPipelineCache"));
+    dispatch->vkGetPipelineCacheData = reinterpret_cast<PFN_vkGetPipelineCacheData>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetPipelineCacheData"));
+    dispatch->vkMergePipelineCaches = reinterpret_cast<PFN_vkMergePipelineCaches>(instanceDispatch.vkGetDeviceProcAddr(device, "vkMergePipelineCaches"));
+    dispatch->vkCreateGraphicsPipelines = reinterpret_cast<PFN_vkCreateGraphicsPipelines>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateGraphicsPipelines"));
+    dispatch->vkCreateComputePipelines = reinterpret_cast<PFN_vkCreateComputePipelines>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateComputePipelines"));
+    dispatch->vkDestroyPipeline = reinterpret_cast<PFN_vkDestroyPipeline>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyPipeline"));
+    dispatch->vkCreatePipelineLayout = reinterpret_cast<PFN_vkCreatePipelineLayout>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreatePipelineLayout"));
+    dispatch->vkDestroyPipelineLayout = reinterpret_cast<PFN_vkDestroyPipelineLayout>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyPipelineLayout"));
+    dispatch->vkCreateSampler = reinterpret_cast<PFN_vkCreateSampler>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateSampler"));
+    dispatch->vkDestroySampler = reinterpret_cast<PFN_vkDestroySampler>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroySampler"));
+    dispatch->vkCreateDescriptorSetLayout = reinterpret_cast<PFN_vkCreateDescriptorSetLayout>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateDescriptorSetLayout"));
+    dispatch->vkDestroyDescriptorSetLayout = reinterpret_cast<PFN_vkDestroyDescriptorSetLayout>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyDescriptorSetLayout"));
+    dispatch->vkCreateDescriptorPool = reinterpret_cast<PFN_vkCreateDescriptorPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateDescriptorPool"));
+    dispatch->vkDestroyDescriptorPool = reinterpret_cast<PFN_vkDestroyDescriptorPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyDescriptorPool"));
+    dispatch->vkResetDescriptorPool = reinterpret_cast<PFN_vkResetDescriptorPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkResetDescriptorPool"));
+    dispatch->vkAllocateDescriptorSets = reinterpret_cast<PFN_vkAllocateDescriptorSets>(instanceDispatch.vkGetDeviceProcAddr(device, "vkAllocateDescriptorSets"));
+    dispatch->vkFreeDescriptorSets = reinterpret_cast<PFN_vkFreeDescriptorSets>(instanceDispatch.vkGetDeviceProcAddr(device, "vkFreeDescriptorSets"));
+    dispatch->vkUpdateDescriptorSets = reinterpret_cast<PFN_vkUpdateDescriptorSets>(instanceDispatch.vkGetDeviceProcAddr(device, "vkUpdateDescriptorSets"));
+    dispatch->vkCreateFramebuffer = reinterpret_cast<PFN_vkCreateFramebuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateFramebuffer"));
+    dispatch->vkDestroyFramebuffer = reinterpret_cast<PFN_vkDestroyFramebuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyFramebuffer"));
+    dispatch->vkCreateRenderPass = reinterpret_cast<PFN_vkCreateRenderPass>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateRenderPass"));
+    dispatch->vkDestroyRenderPass = reinterpret_cast<PFN_vkDestroyRenderPass>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyRenderPass"));
+    dispatch->vkGetRenderAreaGranularity = reinterpret_cast<PFN_vkGetRenderAreaGranularity>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetRenderAreaGranularity"));
+    dispatch->vkCreateCommandPool = reinterpret_cast<PFN_vkCreateCommandPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateCommandPool"));
+    dispatch->vkDestroyCommandPool = reinterpret_cast<PFN_vkDestroyCommandPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroyCommandPool"));
+    dispatch->vkResetCommandPool = reinterpret_cast<PFN_vkResetCommandPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkResetCommandPool"));
+    dispatch->vkAllocateCommandBuffers = reinterpret_cast<PFN_vkAllocateCommandBuffers>(instanceDispatch.vkGetDeviceProcAddr(device, "vkAllocateCommandBuffers"));
+    dispatch->vkFreeCommandBuffers = reinterpret_cast<PFN_vkFreeCommandBuffers>(instanceDispatch.vkGetDeviceProcAddr(device, "vkFreeCommandBuffers"));
+    dispatch->vkBeginCommandBuffer = reinterpret_cast<PFN_vkBeginCommandBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkBeginCommandBuffer"));
+    dispatch->vkEndCommandBuffer = reinterpret_cast<PFN_vkEndCommandBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkEndCommandBuffer"));
+    dispatch->vkResetCommandBuffer = reinterpret_cast<PFN_vkResetCommandBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkResetCommandBuffer"));
+    dispatch->vkCmdBindPipeline = reinterpret_cast<PFN_vkCmdBindPipeline>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBindPipeline"));
+    dispatch->vkCmdSetViewport = reinterpret_cast<PFN_vkCmdSetViewport>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetViewport"));
+    dispatch->vkCmdSetScissor = reinterpret_cast<PFN_vkCmdSetScissor>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetScissor"));
+    dispatch->vkCmdSetLineWidth = reinterpret_cast<PFN_vkCmdSetLineWidth>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetLineWidth"));
+    dispatch->vkCmdSetDepthBias = reinterpret_cast<PFN_vkCmdSetDepthBias>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetDepthBias"));
+    dispatch->vkCmdSetBlendConstants = reinterpret_cast<PFN_vkCmdSetBlendConstants>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetBlendConstants"));
+    dispatch->vkCmdSetDepthBounds = reinterpret_cast<PFN_vkCmdSetDepthBounds>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetDepthBounds"));
+    dispatch->vkCmdSetStencilCompareMask = reinterpret_cast<PFN_vkCmdSetStencilCompareMask>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetStencilCompareMask"));
+    dispatch->vkCmdSetStencilWriteMask = reinterpret_cast<PFN_vkCmdSetStencilWriteMask>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetStencilWriteMask"));
+    dispatch->vkCmdSetStencilReference = reinterpret_cast<PFN_vkCmdSetStencilReference>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetStencilReference"));
+    dispatch->vkCmdBindDescriptorSets = reinterpret_cast<PFN_vkCmdBindDescriptorSets>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBindDescriptorSets"));
+    dispatch->vkCmdBindIndexBuffer = reinterpret_cast<PFN_vkCmdBindIndexBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBindIndexBuffer"));
+    dispatch->vkCmdBindVertexBuffers = reinterpret_cast<PFN_vkCmdBindVertexBuffers>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBindVertexBuffers"));
+    dispatch->vkCmdDraw = reinterpret_cast<PFN_vkCmdDraw>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdDraw"));
+    dispatch->vkCmdDrawIndexed = reinterpret_cast<PFN_vkCmdDrawIndexed>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdDrawIndexed"));
+    dispatch->vkCmdDrawIndirect = reinterpret_cast<PFN_vkCmdDrawIndirect>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdDrawIndirect"));
+    dispatch->vkCmdDrawIndexedIndirect = reinterpret_cast<PFN_vkCmdDrawIndexedIndirect>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirect"));
+    dispatch->vkCmdDispatch = reinterpret_cast<PFN_vkCmdDispatch>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdDispatch"));
+    dispatch->vkCmdDispatchIndirect = reinterpret_cast<PFN_vkCmdDispatchIndirect>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdDispatchIndirect"));
+    dispatch->vkCmdCopyBuffer = reinterpret_cast<PFN_vkCmdCopyBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdCopyBuffer"));
+    dispatch->vkCmdCopyImage = reinterpret_cast<PFN_vkCmdCopyImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdCopyImage"));
+    dispatch->vkCmdBlitImage = reinterpret_cast<PFN_vkCmdBlitImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBlitImage"));
+    dispatch->vkCmdCopyBufferToImage = reinterpret_cast<PFN_vkCmdCopyBufferToImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdCopyBufferToImage"));
+    dispatch->vkCmdCopyImageToBuffer = reinterpret_cast<PFN_vkCmdCopyImageToBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdCopyImageToBuffer"));
+    dispatch->vkCmdUpdateBuffer = reinterpret_cast<PFN_vkCmdUpdateBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdUpdateBuffer"));
+    dispatch->vkCmdFillBuffer = reinterpret_cast<PFN_vkCmdFillBuffer>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdFillBuffer"));
+    dispatch->vkCmdClearColorImage = reinterpret_cast<PFN_vkCmdClearColorImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdClearColorImage"));
+    dispatch->vkCmdClearDepthStencilImage = reinterpret_cast<PFN_vkCmdClearDepthStencilImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdClearDepthStencilImage"));
+    dispatch->vkCmdClearAttachments = reinterpret_cast<PFN_vkCmdClearAttachments>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdClearAttachments"));
+    dispatch->vkCmdResolveImage = reinterpret_cast<PFN_vkCmdResolveImage>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdResolveImage"));
+    dispatch->vkCmdSetEvent = reinterpret_cast<PFN_vkCmdSetEvent>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdSetEvent"));
+    dispatch->vkCmdResetEvent = reinterpret_cast<PFN_vkCmdResetEvent>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdResetEvent"));
+    dispatch->vkCmdWaitEvents = reinterpret_cast<PFN_vkCmdWaitEvents>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdWaitEvents"));
+    dispatch->vkCmdPipelineBarrier = reinterpret_cast<PFN_vkCmdPipelineBarrier>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdPipelineBarrier"));
+    dispatch->vkCmdBeginQuery = reinterpret_cast<PFN_vkCmdBeginQuery>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBeginQuery"));
+    dispatch->vkCmdEndQuery = reinterpret_cast<PFN_vkCmdEndQuery>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdEndQuery"));
+    dispatch->vkCmdResetQueryPool = reinterpret_cast<PFN_vkCmdResetQueryPool>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdResetQueryPool"));
+    dispatch->vkCmdWriteTimestamp = reinterpret_cast<PFN_vkCmdWriteTimestamp>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdWriteTimestamp"));
+    dispatch->vkCmdCopyQueryPoolResults = reinterpret_cast<PFN_vkCmdCopyQueryPoolResults>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdCopyQueryPoolResults"));
+    dispatch->vkCmdPushConstants = reinterpret_cast<PFN_vkCmdPushConstants>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdPushConstants"));
+    dispatch->vkCmdBeginRenderPass = reinterpret_cast<PFN_vkCmdBeginRenderPass>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdBeginRenderPass"));
+    dispatch->vkCmdNextSubpass = reinterpret_cast<PFN_vkCmdNextSubpass>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdNextSubpass"));
+    dispatch->vkCmdEndRenderPass = reinterpret_cast<PFN_vkCmdEndRenderPass>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdEndRenderPass"));
+    dispatch->vkCmdExecuteCommands = reinterpret_cast<PFN_vkCmdExecuteCommands>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCmdExecuteCommands"));
+
+    // VK_KHR_swapchain
+    dispatch->vkCreateSwapchainKHR = reinterpret_cast<PFN_vkCreateSwapchainKHR>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateSwapchainKHR"));
+    dispatch->vkDestroySwapchainKHR = reinterpret_cast<PFN_vkDestroySwapchainKHR>(instanceDispatch.vkGetDeviceProcAddr(device, "vkDestroySwapchainKHR"));
+    dispatch->vkGetSwapchainImagesKHR = reinterpret_cast<PFN_vkGetSwapchainImagesKHR>(instanceDispatch.vkGetDeviceProcAddr(device, "vkGetSwapchainImagesKHR"));
+    dispatch->vkAcquireNextImageKHR = reinterpret_cast<PFN_vkAcquireNextImageKHR>(instanceDispatch.vkGetDeviceProcAddr(device, "vkAcquireNextImageKHR"));
+    dispatch->vkQueuePresentKHR = reinterpret_cast<PFN_vkQueuePresentKHR>(instanceDispatch.vkGetDeviceProcAddr(device, "vkQueuePresentKHR"));
+
+    // VK_KHR_display_swapchain
+    dispatch->vkCreateSharedSwapchainsKHR = reinterpret_cast<PFN_vkCreateSharedSwapchainsKHR>(instanceDispatch.vkGetDeviceProcAddr(device, "vkCreateSharedSwapchainsKHR"));
+}
+
+// No Vulkan support, do not set function addresses
+PFN_vkGetInstanceProcAddr vkGetInstanceProcAddr;
+PFN_vkCreateInstance vkCreateInstance;
+PFN_vkEnumerateInstanceExtensionProperties vkEnumerateInstanceExtensionProperties;
+PFN_vkEnumerateInstanceLayerProperties vkEnumerateInstanceLayerProperties;
+PFN_vkEnumerateInstanceVersion vkEnumerateInstanceVersion;
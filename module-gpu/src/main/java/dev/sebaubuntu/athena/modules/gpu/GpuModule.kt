@@ -6,6 +6,7 @@
 package dev.sebaubuntu.athena.modules.gpu
 
 import android.content.Context
+import dev.sebaubuntu.athena.core.models.BenchmarkReport
 import dev.sebaubuntu.athena.core.models.Element
 import dev.sebaubuntu.athena.core.models.Error
 import dev.sebaubuntu.athena.core.models.LocalizedString
@@ -14,19 +15,25 @@ import dev.sebaubuntu.athena.core.models.Resource
 import dev.sebaubuntu.athena.core.models.Result
 import dev.sebaubuntu.athena.core.models.Screen
 import dev.sebaubuntu.athena.core.models.Value
+import dev.sebaubuntu.athena.modules.gpu.models.Benchmark
 import dev.sebaubuntu.athena.modules.gpu.models.EglInformation
 import dev.sebaubuntu.athena.modules.gpu.models.GlInformation
+import dev.sebaubuntu.athena.modules.gpu.models.VkMemoryHeapFlag
+import dev.sebaubuntu.athena.modules.gpu.models.VkMemoryPropertyFlag
 import dev.sebaubuntu.athena.modules.gpu.models.VkPhysicalDevice
 import dev.sebaubuntu.athena.modules.gpu.models.VkPhysicalDeviceType
 import dev.sebaubuntu.athena.modules.gpu.models.VkVendorId
+import dev.sebaubuntu.athena.modules.gpu.utils.BenchmarkUtils
 import dev.sebaubuntu.athena.modules.gpu.utils.EglUtils
+import dev.sebaubuntu.athena.modules.gpu.utils.GpuCacheUtils
 import dev.sebaubuntu.athena.modules.gpu.utils.VkUtils
 import kotlinx.coroutines.flow.asFlow
+import kotlinx.coroutines.flow.flow
 import kotlinx.coroutines.flow.flowOf
 
-class GpuModule : Module {
+class GpuModule(context: Context) : Module {
     class Factory : Module.Factory {
-        override fun create(context: Context) = GpuModule()
+        override fun create(context: Context) = GpuModule(context)
     }
 
     override val id = "gpu"
@@ -39,6 +46,10 @@ class GpuModule : Module {
 
     override val requiredPermissions = arrayOf<String>()
 
+    init {
+        GpuCacheUtils.setCachePath(context.cacheDir.resolve(CACHE_FILE_NAME).absolutePath)
+    }
+
     override fun resolve(identifier: Resource.Identifier) = when (identifier.path.firstOrNull()) {
         null -> suspend {
             val vkPhysicalDevices = VkUtils.getVkInfo()
@@ -50,6 +61,7 @@ class GpuModule : Module {
                 elements = buildList {
                     vkPhysicalDevices?.withIndex()?.forEach { (i, vkPhysicalDevice) ->
                         add(vkPhysicalDevice.getCard(i))
+                        add(vkPhysicalDevice.getMemoryCard(i))
                     }
 
                     eglInformation?.let { eglInformation ->
@@ -59,12 +71,98 @@ class GpuModule : Module {
                             add(it.getCard())
                         }
                     }
+
+                    add(
+                        Element.Card(
+                            name = "general",
+                            title = LocalizedString(dev.sebaubuntu.athena.core.R.string.general),
+                            elements = listOf(
+                                Element.Item(
+                                    name = "benchmarks",
+                                    title = LocalizedString(R.string.gpu_benchmarks),
+                                    navigateTo = identifier / "benchmarks",
+                                    exportable = false,
+                                    drawableResId = dev.sebaubuntu.athena.core.R.drawable.ic_build,
+                                ),
+                            ),
+                        )
+                    )
                 },
             )
 
             Result.Success<Resource, Error>(screen)
         }.asFlow()
 
+        "benchmarks" -> when (identifier.path.getOrNull(1)) {
+            null -> flowOf(
+                Result.Success<Resource, Error>(
+                    Screen.ItemListScreen(
+                        identifier = identifier,
+                        title = LocalizedString(R.string.gpu_benchmarks),
+                        elements = Benchmark.entries.map {
+                            Element.Item(
+                                name = it.nativeName,
+                                title = LocalizedString(benchmarkToStringResId.getValue(it)),
+                                navigateTo = identifier / it.nativeName,
+                                exportable = false,
+                                drawableResId = dev.sebaubuntu.athena.core.R.drawable.ic_build,
+                            )
+                        },
+                    )
+                )
+            )
+
+            else -> Benchmark.entries.firstOrNull {
+                it.nativeName == identifier.path[1]
+            }?.let { benchmark ->
+                when (identifier.path.getOrNull(2)) {
+                    // Nothing runs until the user explicitly asks for it
+                    null -> flowOf(
+                        Result.Success<Resource, Error>(
+                            Screen.ItemListScreen(
+                                identifier = identifier,
+                                title = LocalizedString(
+                                    benchmarkToStringResId.getValue(benchmark)
+                                ),
+                                elements = listOf(
+                                    Element.Item(
+                                        name = "run",
+                                        title = LocalizedString(R.string.gpu_benchmark_run),
+                                        navigateTo = identifier / "run",
+                                        exportable = false,
+                                        drawableResId = dev.sebaubuntu.athena.core.R.drawable.ic_build,
+                                    ),
+                                ),
+                            )
+                        )
+                    )
+
+                    // Runs once per collection, benchmarks take seconds and load the whole GPU
+                    "run" -> flow {
+                        val screen = BenchmarkUtils.run(benchmark)?.let { report ->
+                            Screen.CardListScreen(
+                                identifier = identifier,
+                                title = LocalizedString(
+                                    benchmarkToStringResId.getValue(benchmark)
+                                ),
+                                elements = report.sections.map { section ->
+                                    section.getCardElement()
+                                },
+                            )
+                        }
+
+                        emit(
+                            screen?.let {
+                                Result.Success<Resource, Error>(it)
+                            } ?: Result.Error(Error.NOT_FOUND)
+                        )
+                    }
+
+                    else -> null
+                }
+            } ?: flowOf(Result.Error(Error.NOT_FOUND))
+        }
+
         else -> flowOf(Result.Error(Error.NOT_FOUND))
     }
 
@@ -125,6 +223,43 @@ class GpuModule : Module {
         ),
     )
 
+    private fun VkPhysicalDevice.getMemoryCard(index: Int) = Element.Card(
+        name = "vulkan_${index}_memory",
+        title = LocalizedString(R.string.gpu_vulkan_device_memory, index),
+        elements = buildList {
+            memoryHeaps.withIndex().forEach { (i, memoryHeap) ->
+                add(
+                    Element.Item(
+                        name = "memory_heap_${i}_size",
+                        title = LocalizedString(R.string.gpu_vulkan_memory_heap_size, i),
+                        value = Value.Bytes(memoryHeap.size.toLong()),
+                    )
+                )
+                add(
+                    Element.Item(
+                        name = "memory_heap_${i}_flags",
+                        title = LocalizedString(R.string.gpu_vulkan_memory_heap_flags, i),
+                        value = Value(memoryHeap.flags, vkMemoryHeapFlagToStringResId),
+                    )
+                )
+            }
+
+            memoryTypes.withIndex().forEach { (i, memoryType) ->
+                add(
+                    Element.Item(
+                        name = "memory_type_${i}",
+                        title = LocalizedString(
+                            R.string.gpu_vulkan_memory_type, i, memoryType.heapIndex
+                        ),
+                        value = Value(
+                            memoryType.propertyFlags, vkMemoryPropertyFlagToStringResId
+                        ),
+                    )
+                )
+            }
+        },
+    )
+
     private fun EglInformation.getCard() = Element.Card(
         name = "egl",
         title = LocalizedString(R.string.gpu_egl),
@@ -196,6 +331,13 @@ class GpuModule : Module {
     )
 
     companion object {
+        private const val CACHE_FILE_NAME = "gpu_capabilities.bin"
+
+        private val benchmarkToStringResId = mapOf(
+            Benchmark.VULKAN_COMPUTE to R.string.gpu_benchmark_vulkan_compute,
+            Benchmark.VULKAN_MEMORY to R.string.gpu_benchmark_vulkan_memory,
+        )
+
         private val vkPhysicalDeviceTypeToStringResId = mapOf(
             VkPhysicalDeviceType.OTHER.value to R.string.vulkan_physical_device_type_other,
             VkPhysicalDeviceType.INTEGRATED_GPU.value to
@@ -206,6 +348,32 @@ class GpuModule : Module {
             VkPhysicalDeviceType.CPU.value to R.string.vulkan_physical_device_type_cpu,
         )
 
+        private val vkMemoryHeapFlagToStringResId = mapOf(
+            VkMemoryHeapFlag.DEVICE_LOCAL.value to R.string.vulkan_memory_heap_flag_device_local,
+            VkMemoryHeapFlag.MULTI_INSTANCE.value to
+                    R.string.vulkan_memory_heap_flag_multi_instance,
+        )
+
+        private val vkMemoryPropertyFlagToStringResId = mapOf(
+            VkMemoryPropertyFlag.DEVICE_LOCAL.value to
+                    R.string.vulkan_memory_property_flag_device_local,
+            VkMemoryPropertyFlag.HOST_VISIBLE.value to
+                    R.string.vulkan_memory_property_flag_host_visible,
+            VkMemoryPropertyFlag.HOST_COHERENT.value to
+                    R.string.vulkan_memory_property_flag_host_coherent,
+            VkMemoryPropertyFlag.HOST_CACHED.value to
+                    R.string.vulkan_memory_property_flag_host_cached,
+            VkMemoryPropertyFlag.LAZILY_ALLOCATED.value to
+                    R.string.vulkan_memory_property_flag_lazily_allocated,
+            VkMemoryPropertyFlag.PROTECTED.value to R.string.vulkan_memory_property_flag_protected,
+            VkMemoryPropertyFlag.DEVICE_COHERENT_AMD.value to
+                    R.string.vulkan_memory_property_flag_device_coherent_amd,
+            VkMemoryPropertyFlag.DEVICE_UNCACHED_AMD.value to
+                    R.string.vulkan_memory_property_flag_device_uncached_amd,
+            VkMemoryPropertyFlag.RDMA_CAPABLE_NV.value to
+                    R.string.vulkan_memory_property_flag_rdma_capable_nv,
+        )
+
         private val vkVendorIdToStringResId = mapOf(
             VkVendorId.KHRONOS to R.string.vulkan_vendor_khronos,
             VkVendorId.VIV to R.string.vulkan_vendor_viv,
@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.models
+
+/**
+ * Native benchmarks.
+ *
+ * Must be kept in sync with Benchmarks.cpp.
+ */
+enum class Benchmark(
+    val nativeName: String,
+) {
+    /**
+     * FP32 and FP16 FMA, int32 multiply-add, shared memory and subgroup reduction throughput of
+     * every Vulkan device, timed with timestamp queries.
+     */
+    VULKAN_COMPUTE("vulkan-compute"),
+
+    /**
+     * Memory heaps and types of every Vulkan device, then map+memcpy upload, readback and
+     * vkCmdCopyBuffer bandwidth of each memory type over transfer sizes from 4 KiB to 16 MiB.
+     */
+    VULKAN_MEMORY("vulkan-memory"),
+}
@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.models
+
+/**
+ * A Vulkan memory heap.
+ *
+ * @param size Size in bytes
+ * @param flags [VkMemoryHeapFlag] bitmask
+ */
+data class VkMemoryHeap(
+    val size: ULong,
+    val flags: Int,
+)
@@ -0,0 +1,11 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.models
+
+enum class VkMemoryHeapFlag(val value: Int) {
+    DEVICE_LOCAL(1 shl 0),
+    MULTI_INSTANCE(1 shl 1),
+}
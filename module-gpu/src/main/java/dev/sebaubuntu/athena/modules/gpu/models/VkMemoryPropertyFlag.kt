@@ -0,0 +1,18 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.models
+
+enum class VkMemoryPropertyFlag(val value: Int) {
+    DEVICE_LOCAL(1 shl 0),
+    HOST_VISIBLE(1 shl 1),
+    HOST_COHERENT(1 shl 2),
+    HOST_CACHED(1 shl 3),
+    LAZILY_ALLOCATED(1 shl 4),
+    PROTECTED(1 shl 5),
+    DEVICE_COHERENT_AMD(1 shl 6),
+    DEVICE_UNCACHED_AMD(1 shl 7),
+    RDMA_CAPABLE_NV(1 shl 8),
+}
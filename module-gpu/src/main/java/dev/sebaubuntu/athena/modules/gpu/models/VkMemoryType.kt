@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.models
+
+/**
+ * A Vulkan memory type.
+ *
+ * @param propertyFlags [VkMemoryPropertyFlag] bitmask
+ * @param heapIndex Index of the [VkMemoryHeap] it allocates from
+ */
+data class VkMemoryType(
+    val propertyFlags: Int,
+    val heapIndex: Int,
+)
@@ -12,6 +12,8 @@ data class VkPhysicalDevice(
     val deviceId: ULong,
     val deviceType: ULong,
     val deviceName: String,
+    val memoryHeaps: List<VkMemoryHeap>,
+    val memoryTypes: List<VkMemoryType>,
 ) {
     val registeredVendorId = VkVendorId.fromValue(vendorId)
 }
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.utils
+
+import dev.sebaubuntu.athena.core.models.BenchmarkReport
+import dev.sebaubuntu.athena.core.utils.BenchmarkLock
+import dev.sebaubuntu.athena.modules.gpu.models.Benchmark
+
+object BenchmarkUtils {
+    /**
+     * Run a benchmark on the calling thread, blocking until it's done, which can take seconds.
+     * Only one benchmark runs at a time across all the modules, concurrent calls wait for the
+     * previous one to finish.
+     */
+    fun run(benchmark: Benchmark) = BenchmarkLock.withLock {
+        runBenchmark(benchmark.nativeName)
+    }?.let {
+        BenchmarkReport.fromCsv(it)
+    }
+
+    private external fun runBenchmark(name: String): String?
+}
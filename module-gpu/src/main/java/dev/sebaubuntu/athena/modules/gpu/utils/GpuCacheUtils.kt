@@ -0,0 +1,14 @@
+/*
+ * SPDX-FileCopyrightText: Sebastiano Barezzi
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package dev.sebaubuntu.athena.modules.gpu.utils
+
+object GpuCacheUtils {
+    /**
+     * Set the file where the GPU capabilities are cached across process restarts.
+     * Must be called before [VkUtils] and [EglUtils] are used.
+     */
+    external fun setCachePath(path: String)
+}
@@ -6,6 +6,8 @@
 package dev.sebaubuntu.athena.modules.gpu.utils
 
 import dev.sebaubuntu.athena.modules.gpu.models.VkApiVersion
+import dev.sebaubuntu.athena.modules.gpu.models.VkMemoryHeap
+import dev.sebaubuntu.athena.modules.gpu.models.VkMemoryType
 import dev.sebaubuntu.athena.modules.gpu.models.VkPhysicalDevice
 
 object VkUtils {
@@ -17,6 +19,10 @@ object VkUtils {
             deviceId: Long,
             deviceType: Long,
             deviceName: String,
+            memoryHeapSizes: LongArray,
+            memoryHeapFlags: IntArray,
+            memoryTypePropertyFlags: IntArray,
+            memoryTypeHeapIndexes: IntArray,
         ) = add(
             VkPhysicalDevice(
                 VkApiVersion.fromVersion(apiVersion.toULong()),
@@ -25,6 +31,12 @@ object VkUtils {
                 deviceId.toULong(),
                 deviceType.toULong(),
                 deviceName,
+                memoryHeapSizes.indices.map {
+                    VkMemoryHeap(memoryHeapSizes[it].toULong(), memoryHeapFlags[it])
+                },
+                memoryTypePropertyFlags.indices.map {
+                    VkMemoryType(memoryTypePropertyFlags[it], memoryTypeHeapIndexes[it])
+                },
             )
         )
     }